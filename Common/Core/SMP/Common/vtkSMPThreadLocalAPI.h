@@ -0,0 +1,191 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadLocalAPI.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPThreadLocalAPI - Runtime dispatch of vtkSMPThreadLocal.
+// .SECTION Description
+// vtkSMPThreadLocalAPI holds the thread local storage of every backend
+// compiled into VTK and uses the one of the backend currently selected in
+// vtkSMPToolsAPI. Values stored while one backend is in use are not visible
+// after switching to another one.
+
+#ifndef vtkSMPThreadLocalAPI_h
+#define vtkSMPThreadLocalAPI_h
+
+#include "vtkSMP.h" // For SMP preprocessor information
+
+#include "SMP/Common/vtkSMPThreadLocalImplAbstract.h"
+#include "SMP/Common/vtkSMPToolsAPI.h" // For the backend in use
+#include "SMP/Sequential/vtkSMPThreadLocalImpl.h"
+#if VTK_SMP_ENABLE_STDTHREAD
+#include "SMP/STDThread/vtkSMPThreadLocalImpl.h"
+#endif
+#if VTK_SMP_ENABLE_TBB
+#include "SMP/TBB/vtkSMPThreadLocalImpl.h"
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+#include "SMP/OpenMP/vtkSMPThreadLocalImpl.h"
+#endif
+
+#include <array>    // For std::array
+#include <iterator> // For std::iterator
+#include <memory>   // For std::unique_ptr
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+template <typename T>
+class vtkSMPThreadLocalAPI
+{
+  typedef vtkSMPThreadLocalImplAbstract<T> ThreadLocalImpl;
+  typedef typename ThreadLocalImpl::ItImpl ItImplAbstract;
+
+public:
+  //--------------------------------------------------------------------------------
+  vtkSMPThreadLocalAPI()
+  {
+    this->BackendsImpl[static_cast<int>(BackendType::Sequential)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::Sequential, T>());
+#if VTK_SMP_ENABLE_STDTHREAD
+    this->BackendsImpl[static_cast<int>(BackendType::STDThread)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::STDThread, T>());
+#endif
+#if VTK_SMP_ENABLE_TBB
+    this->BackendsImpl[static_cast<int>(BackendType::TBB)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::TBB, T>());
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+    this->BackendsImpl[static_cast<int>(BackendType::OpenMP)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::OpenMP, T>());
+#endif
+  }
+
+  //--------------------------------------------------------------------------------
+  explicit vtkSMPThreadLocalAPI(const T& exemplar)
+  {
+    this->BackendsImpl[static_cast<int>(BackendType::Sequential)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::Sequential, T>(exemplar));
+#if VTK_SMP_ENABLE_STDTHREAD
+    this->BackendsImpl[static_cast<int>(BackendType::STDThread)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::STDThread, T>(exemplar));
+#endif
+#if VTK_SMP_ENABLE_TBB
+    this->BackendsImpl[static_cast<int>(BackendType::TBB)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::TBB, T>(exemplar));
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+    this->BackendsImpl[static_cast<int>(BackendType::OpenMP)].reset(
+      new vtkSMPThreadLocalImpl<BackendType::OpenMP, T>(exemplar));
+#endif
+  }
+
+  //--------------------------------------------------------------------------------
+  T& Local() { return this->GetImpl().Local(); }
+
+  //--------------------------------------------------------------------------------
+  size_t size() const { return this->GetImpl().size(); }
+
+  //--------------------------------------------------------------------------------
+  class iterator : public std::iterator<std::forward_iterator_tag, T> // for iterator_traits
+  {
+  public:
+    iterator() = default;
+
+    iterator(const iterator& other)
+      : ImplAbstract(other.ImplAbstract ? other.ImplAbstract->Clone() : nullptr)
+    {
+    }
+
+    iterator(iterator&&) noexcept = default;
+
+    iterator& operator=(const iterator& other)
+    {
+      if (this != &other)
+      {
+        this->ImplAbstract = other.ImplAbstract ? other.ImplAbstract->Clone() : nullptr;
+      }
+      return *this;
+    }
+
+    iterator& operator=(iterator&&) noexcept = default;
+
+    iterator& operator++()
+    {
+      this->ImplAbstract->Increment();
+      return *this;
+    }
+
+    iterator operator++(int)
+    {
+      iterator copy = *this;
+      this->ImplAbstract->Increment();
+      return copy;
+    }
+
+    bool operator==(const iterator& other)
+    {
+      return this->ImplAbstract->Compare(other.ImplAbstract.get());
+    }
+
+    bool operator!=(const iterator& other) { return !(*this == other); }
+
+    T& operator*() { return this->ImplAbstract->GetContent(); }
+
+    T* operator->() { return this->ImplAbstract->GetContentPtr(); }
+
+  private:
+    std::unique_ptr<ItImplAbstract> ImplAbstract;
+
+    friend class vtkSMPThreadLocalAPI<T>;
+  };
+
+  //--------------------------------------------------------------------------------
+  iterator begin()
+  {
+    iterator iter;
+    iter.ImplAbstract = this->GetImpl().begin();
+    return iter;
+  }
+
+  //--------------------------------------------------------------------------------
+  iterator end()
+  {
+    iterator iter;
+    iter.ImplAbstract = this->GetImpl().end();
+    return iter;
+  }
+
+  // disable copying
+  vtkSMPThreadLocalAPI(const vtkSMPThreadLocalAPI&) = delete;
+  vtkSMPThreadLocalAPI& operator=(const vtkSMPThreadLocalAPI&) = delete;
+
+private:
+  ThreadLocalImpl& GetImpl() const
+  {
+    const int backend = static_cast<int>(vtkSMPToolsAPI::GetInstance().GetBackendType());
+    return *this->BackendsImpl[backend];
+  }
+
+  std::array<std::unique_ptr<ThreadLocalImpl>, NumberOfBackends> BackendsImpl;
+};
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPThreadLocalAPI.h
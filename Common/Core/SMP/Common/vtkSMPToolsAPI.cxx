@@ -0,0 +1,222 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsAPI.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "SMP/Common/vtkSMPToolsAPI.h"
+
+#include "vtkObject.h" // For vtkGenericWarningMacro
+
+#include <algorithm> // For std::transform
+#include <cctype>    // For std::toupper
+#include <cstdlib>   // For std::getenv
+#include <string>    // For std::string
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+namespace
+{
+std::string ToUpper(const char* type)
+{
+  std::string upper(type);
+  std::transform(upper.cbegin(), upper.cend(), upper.begin(),
+    [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+  return upper;
+}
+}
+
+//------------------------------------------------------------------------------
+vtkSMPThreadSettings& GetSMPThreadSettings()
+{
+  static thread_local vtkSMPThreadSettings settings = { 0, false, false };
+  return settings;
+}
+
+//------------------------------------------------------------------------------
+vtkSMPToolsAPI::vtkSMPToolsAPI()
+{
+  // Set backend from env if set
+  const char* smpBackendInUse = std::getenv("VTK_SMP_BACKEND_IN_USE");
+  if (smpBackendInUse)
+  {
+    this->SetBackend(smpBackendInUse);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkSMPToolsAPI& vtkSMPToolsAPI::GetInstance()
+{
+  static vtkSMPToolsAPI instance;
+  return instance;
+}
+
+//------------------------------------------------------------------------------
+const char* vtkSMPToolsAPI::GetBackend() const
+{
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::STDThread:
+      return "STDThread";
+    case BackendType::TBB:
+      return "TBB";
+    case BackendType::OpenMP:
+      return "OpenMP";
+    case BackendType::Sequential:
+    default:
+      return "Sequential";
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPToolsAPI::SetBackend(const char* type)
+{
+  if (!type)
+  {
+    return false;
+  }
+  const std::string backend = ToUpper(type);
+
+  BackendType requested = BackendType::Sequential;
+  bool enabled = false;
+  if (backend == "SEQUENTIAL")
+  {
+    requested = BackendType::Sequential;
+    enabled = true;
+  }
+  else if (backend == "STDTHREAD")
+  {
+    requested = BackendType::STDThread;
+    enabled = VTK_SMP_ENABLE_STDTHREAD;
+  }
+  else if (backend == "TBB")
+  {
+    requested = BackendType::TBB;
+    enabled = VTK_SMP_ENABLE_TBB;
+  }
+  else if (backend == "OPENMP")
+  {
+    requested = BackendType::OpenMP;
+    enabled = VTK_SMP_ENABLE_OPENMP;
+  }
+  else
+  {
+    vtkGenericWarningMacro("Unknown SMP backend " << type << ", keeping " << this->GetBackend());
+    return false;
+  }
+
+  if (!enabled)
+  {
+    vtkGenericWarningMacro(
+      "SMP backend " << type << " was not built with VTK, keeping " << this->GetBackend());
+    return false;
+  }
+
+  this->ActivatedBackend = requested;
+  this->Initialize(this->DesiredNumberOfThread);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::SetLocalBackend(const char* type)
+{
+  if (!type || ToUpper(this->GetBackend()) == ToUpper(type))
+  {
+    return;
+  }
+  if (GetSMPThreadSettings().InParallelScope)
+  {
+    vtkGenericWarningMacro(
+      "The SMP backend cannot be changed in a parallel scope, keeping " << this->GetBackend());
+    return;
+  }
+  this->SetBackend(type);
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::RestoreBackend(BackendType backend)
+{
+  if (backend != this->ActivatedBackend)
+  {
+    this->ActivatedBackend = backend;
+    this->Initialize(this->DesiredNumberOfThread);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::Initialize(int numThreads)
+{
+  if (GetSMPThreadSettings().InParallelScope)
+  {
+    // The threads executing the For() cannot be changed from one of them.
+    return;
+  }
+  this->DesiredNumberOfThread = numThreads;
+  switch (this->ActivatedBackend)
+  {
+#if VTK_SMP_ENABLE_STDTHREAD
+    case BackendType::STDThread:
+      this->STDThreadBackend.Initialize(numThreads);
+      break;
+#endif
+#if VTK_SMP_ENABLE_TBB
+    case BackendType::TBB:
+      this->TBBBackend.Initialize(numThreads);
+      break;
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+    case BackendType::OpenMP:
+      this->OpenMPBackend.Initialize(numThreads);
+      break;
+#endif
+    default:
+      this->SequentialBackend.Initialize(numThreads);
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkSMPToolsAPI::GetEstimatedNumberOfThreads()
+{
+  int numThreads;
+  switch (this->ActivatedBackend)
+  {
+#if VTK_SMP_ENABLE_STDTHREAD
+    case BackendType::STDThread:
+      numThreads = this->STDThreadBackend.GetEstimatedNumberOfThreads();
+      break;
+#endif
+#if VTK_SMP_ENABLE_TBB
+    case BackendType::TBB:
+      numThreads = this->TBBBackend.GetEstimatedNumberOfThreads();
+      break;
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+    case BackendType::OpenMP:
+      numThreads = this->OpenMPBackend.GetEstimatedNumberOfThreads();
+      break;
+#endif
+    default:
+      numThreads = this->SequentialBackend.GetEstimatedNumberOfThreads();
+      break;
+  }
+  return GetSMPThreadSettings().GetNumberOfThreads(numThreads);
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
@@ -0,0 +1,406 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsAPI.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPToolsAPI - Runtime dispatch of vtkSMPTools to the backend in use.
+// .SECTION Description
+// vtkSMPToolsAPI owns one vtkSMPToolsImpl per backend compiled into VTK and
+// forwards every vtkSMPTools call to the backend selected with SetBackend(),
+// or with the VTK_SMP_BACKEND_IN_USE environment variable. When neither is
+// used, the backend chosen with VTK_SMP_IMPLEMENTATION_TYPE at configure
+// time is used.
+
+#ifndef vtkSMPToolsAPI_h
+#define vtkSMPToolsAPI_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSMP.h"              // For SMP preprocessor information
+
+#include "SMP/Common/vtkSMPToolsImpl.h"
+#include "SMP/Sequential/vtkSMPToolsImpl.txx"
+#if VTK_SMP_ENABLE_STDTHREAD
+#include "SMP/STDThread/vtkSMPToolsImpl.txx"
+#endif
+#if VTK_SMP_ENABLE_TBB
+#include "SMP/TBB/vtkSMPToolsImpl.txx"
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+#include "SMP/OpenMP/vtkSMPToolsImpl.txx"
+#endif
+
+#ifndef __VTK_WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+class VTKCOMMONCORE_EXPORT vtkSMPToolsAPI
+{
+public:
+  //--------------------------------------------------------------------------------
+  static vtkSMPToolsAPI& GetInstance();
+
+  //--------------------------------------------------------------------------------
+  BackendType GetBackendType() const { return this->ActivatedBackend; }
+
+  //--------------------------------------------------------------------------------
+  const char* GetBackend() const;
+
+  //--------------------------------------------------------------------------------
+  bool SetBackend(const char* type);
+
+  //--------------------------------------------------------------------------------
+  void Initialize(int numThreads = 0);
+
+  //--------------------------------------------------------------------------------
+  int GetEstimatedNumberOfThreads();
+
+  //--------------------------------------------------------------------------------
+  void SetNestedParallelism(bool isNested) { GetSMPThreadSettings().NestedParallelism = isNested; }
+
+  //--------------------------------------------------------------------------------
+  bool GetNestedParallelism() { return GetSMPThreadSettings().NestedParallelism; }
+
+  //--------------------------------------------------------------------------------
+  bool IsParallelScope() { return GetSMPThreadSettings().InParallelScope; }
+
+  //--------------------------------------------------------------------------------
+  template <typename Config, typename T>
+  void LocalScope(Config const& config, T&& lambda)
+  {
+    // Restores the settings even if lambda throws.
+    struct RestoreSettings
+    {
+      vtkSMPToolsAPI& API;
+      vtkSMPThreadSettings Settings;
+      BackendType Backend;
+      ~RestoreSettings()
+      {
+        GetSMPThreadSettings() = this->Settings;
+        this->API.RestoreBackend(this->Backend);
+      }
+    } restore = { *this, GetSMPThreadSettings(), this->ActivatedBackend };
+
+    this->SetLocalBackend(config.Backend.c_str());
+    vtkSMPThreadSettings& settings = GetSMPThreadSettings();
+    settings.MaxNumberOfThreads = config.MaxNumberOfThreads;
+    settings.NestedParallelism = config.NestedParallelism;
+    lambda();
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename FunctorInternal>
+  void For(vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
+  {
+    switch (this->ActivatedBackend)
+    {
+#if VTK_SMP_ENABLE_STDTHREAD
+      case BackendType::STDThread:
+        this->STDThreadBackend.For(first, last, grain, fi);
+        break;
+#endif
+#if VTK_SMP_ENABLE_TBB
+      case BackendType::TBB:
+        this->TBBBackend.For(first, last, grain, fi);
+        break;
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+      case BackendType::OpenMP:
+        this->OpenMPBackend.For(first, last, grain, fi);
+        break;
+#endif
+      default:
+        this->SequentialBackend.For(first, last, grain, fi);
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator>
+  void Sort(RandomAccessIterator begin, RandomAccessIterator end)
+  {
+    switch (this->ActivatedBackend)
+    {
+#if VTK_SMP_ENABLE_STDTHREAD
+      case BackendType::STDThread:
+        this->STDThreadBackend.Sort(begin, end);
+        break;
+#endif
+#if VTK_SMP_ENABLE_TBB
+      case BackendType::TBB:
+        this->TBBBackend.Sort(begin, end);
+        break;
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+      case BackendType::OpenMP:
+        this->OpenMPBackend.Sort(begin, end);
+        break;
+#endif
+      default:
+        this->SequentialBackend.Sort(begin, end);
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator, typename Compare>
+  void Sort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+  {
+    switch (this->ActivatedBackend)
+    {
+#if VTK_SMP_ENABLE_STDTHREAD
+      case BackendType::STDThread:
+        this->STDThreadBackend.Sort(begin, end, comp);
+        break;
+#endif
+#if VTK_SMP_ENABLE_TBB
+      case BackendType::TBB:
+        this->TBBBackend.Sort(begin, end, comp);
+        break;
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+      case BackendType::OpenMP:
+        this->OpenMPBackend.Sort(begin, end, comp);
+        break;
+#endif
+      default:
+        this->SequentialBackend.Sort(begin, end, comp);
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename Functor>
+  void Transform(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Functor& transform)
+  {
+    switch (this->ActivatedBackend)
+    {
+#if VTK_SMP_ENABLE_STDTHREAD
+      case BackendType::STDThread:
+        this->STDThreadBackend.Transform(inBegin, inEnd, outBegin, transform);
+        break;
+#endif
+#if VTK_SMP_ENABLE_TBB
+      case BackendType::TBB:
+        this->TBBBackend.Transform(inBegin, inEnd, outBegin, transform);
+        break;
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+      case BackendType::OpenMP:
+        this->OpenMPBackend.Transform(inBegin, inEnd, outBegin, transform);
+        break;
+#endif
+      default:
+        this->SequentialBackend.Transform(inBegin, inEnd, outBegin, transform);
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt1, typename InputIt2, typename OutputIt, typename Functor>
+  void Transform(
+    InputIt1 inBegin1, InputIt1 inEnd, InputIt2 inBegin2, OutputIt outBegin, Functor& transform)
+  {
+    switch (this->ActivatedBackend)
+    {
+#if VTK_SMP_ENABLE_STDTHREAD
+      case BackendType::STDThread:
+        this->STDThreadBackend.Transform(inBegin1, inEnd, inBegin2, outBegin, transform);
+        break;
+#endif
+#if VTK_SMP_ENABLE_TBB
+      case BackendType::TBB:
+        this->TBBBackend.Transform(inBegin1, inEnd, inBegin2, outBegin, transform);
+        break;
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+      case BackendType::OpenMP:
+        this->OpenMPBackend.Transform(inBegin1, inEnd, inBegin2, outBegin, transform);
+        break;
+#endif
+      default:
+        this->SequentialBackend.Transform(inBegin1, inEnd, inBegin2, outBegin, transform);
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename Iterator, typename T>
+  void Fill(Iterator begin, Iterator end, const T& value)
+  {
+    switch (this->ActivatedBackend)
+    {
+#if VTK_SMP_ENABLE_STDTHREAD
+      case BackendType::STDThread:
+        this->STDThreadBackend.Fill(begin, end, value);
+        break;
+#endif
+#if VTK_SMP_ENABLE_TBB
+      case BackendType::TBB:
+        this->TBBBackend.Fill(begin, end, value);
+        break;
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+      case BackendType::OpenMP:
+        this->OpenMPBackend.Fill(begin, end, value);
+        break;
+#endif
+      default:
+        this->SequentialBackend.Fill(begin, end, value);
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename T, typename ReduceFunctor, typename TransformFunctor>
+  T TransformReduce(InputIt begin, InputIt end, T init, ReduceFunctor& reduce,
+    TransformFunctor& transform)
+  {
+    switch (this->ActivatedBackend)
+    {
+#if VTK_SMP_ENABLE_STDTHREAD
+      case BackendType::STDThread:
+        return this->STDThreadBackend.TransformReduce(begin, end, init, reduce, transform);
+#endif
+#if VTK_SMP_ENABLE_TBB
+      case BackendType::TBB:
+        return this->TBBBackend.TransformReduce(begin, end, init, reduce, transform);
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+      case BackendType::OpenMP:
+        return this->OpenMPBackend.TransformReduce(begin, end, init, reduce, transform);
+#endif
+      default:
+        return this->SequentialBackend.TransformReduce(begin, end, init, reduce, transform);
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename T, typename Functor>
+  OutputIt ExclusiveScan(
+    InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, Functor& operation)
+  {
+    switch (this->ActivatedBackend)
+    {
+#if VTK_SMP_ENABLE_STDTHREAD
+      case BackendType::STDThread:
+        return this->STDThreadBackend.ExclusiveScan(inBegin, inEnd, outBegin, init, operation);
+#endif
+#if VTK_SMP_ENABLE_TBB
+      case BackendType::TBB:
+        return this->TBBBackend.ExclusiveScan(inBegin, inEnd, outBegin, init, operation);
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+      case BackendType::OpenMP:
+        return this->OpenMPBackend.ExclusiveScan(inBegin, inEnd, outBegin, init, operation);
+#endif
+      default:
+        return this->SequentialBackend.ExclusiveScan(inBegin, inEnd, outBegin, init, operation);
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename Functor>
+  OutputIt InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Functor& operation)
+  {
+    switch (this->ActivatedBackend)
+    {
+#if VTK_SMP_ENABLE_STDTHREAD
+      case BackendType::STDThread:
+        return this->STDThreadBackend.InclusiveScan(inBegin, inEnd, outBegin, operation);
+#endif
+#if VTK_SMP_ENABLE_TBB
+      case BackendType::TBB:
+        return this->TBBBackend.InclusiveScan(inBegin, inEnd, outBegin, operation);
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+      case BackendType::OpenMP:
+        return this->OpenMPBackend.InclusiveScan(inBegin, inEnd, outBegin, operation);
+#endif
+      default:
+        return this->SequentialBackend.InclusiveScan(inBegin, inEnd, outBegin, operation);
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename Predicate>
+  OutputIt CopyIf(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Predicate& pred)
+  {
+    switch (this->ActivatedBackend)
+    {
+#if VTK_SMP_ENABLE_STDTHREAD
+      case BackendType::STDThread:
+        return this->STDThreadBackend.CopyIf(inBegin, inEnd, outBegin, pred);
+#endif
+#if VTK_SMP_ENABLE_TBB
+      case BackendType::TBB:
+        return this->TBBBackend.CopyIf(inBegin, inEnd, outBegin, pred);
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+      case BackendType::OpenMP:
+        return this->OpenMPBackend.CopyIf(inBegin, inEnd, outBegin, pred);
+#endif
+      default:
+        return this->SequentialBackend.CopyIf(inBegin, inEnd, outBegin, pred);
+    }
+  }
+
+  // disable copying
+  vtkSMPToolsAPI(vtkSMPToolsAPI const&) = delete;
+  void operator=(vtkSMPToolsAPI const&) = delete;
+
+private:
+  //--------------------------------------------------------------------------------
+  vtkSMPToolsAPI();
+
+  //--------------------------------------------------------------------------------
+  // Backend changes of LocalScope(). They are ignored, with a warning, from
+  // a thread executing a For().
+  void SetLocalBackend(const char* type);
+  void RestoreBackend(BackendType backend);
+
+  /**
+   * Number of threads requested with Initialize(), applied again when the
+   * backend is changed.
+   */
+  int DesiredNumberOfThread = 0;
+
+  /**
+   * Backend in use.
+   */
+  BackendType ActivatedBackend = DefaultBackend;
+
+  /**
+   * One instance per compiled backend.
+   */
+  vtkSMPToolsImpl<BackendType::Sequential> SequentialBackend;
+#if VTK_SMP_ENABLE_STDTHREAD
+  vtkSMPToolsImpl<BackendType::STDThread> STDThreadBackend;
+#endif
+#if VTK_SMP_ENABLE_TBB
+  vtkSMPToolsImpl<BackendType::TBB> TBBBackend;
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+  vtkSMPToolsImpl<BackendType::OpenMP> OpenMPBackend;
+#endif
+};
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+#endif // __VTK_WRAP__
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsAPI.h
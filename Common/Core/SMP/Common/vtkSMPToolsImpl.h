@@ -0,0 +1,250 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsImpl.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPToolsImpl - Interface implemented by every vtkSMPTools backend.
+// .SECTION Description
+// vtkSMPToolsImpl is specialized for each BackendType compiled into VTK
+// (see SMP/<Backend>/vtkSMPToolsImpl.txx). vtkSMPToolsAPI owns one instance
+// per compiled backend and forwards vtkSMPTools calls to the one selected
+// at runtime. The algorithms other than For() and Sort() have a default
+// implementation built on For() that backends may specialize.
+
+#ifndef vtkSMPToolsImpl_h
+#define vtkSMPToolsImpl_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSMP.h"              // For SMP preprocessor information
+#include "vtkSystemIncludes.h"
+
+#include "SMP/Common/vtkSMPToolsInternal.h" // For the default algorithms
+
+#include <iterator> // For std::distance
+#include <vector>   // For std::vector
+
+#ifndef __VTK_WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+enum class BackendType
+{
+  Sequential = 0,
+  STDThread = 1,
+  TBB = 2,
+  OpenMP = 3
+};
+
+// Number of values in BackendType.
+const int NumberOfBackends = 4;
+
+#if defined(VTK_SMP_STDThread)
+const BackendType DefaultBackend = BackendType::STDThread;
+#elif defined(VTK_SMP_TBB)
+const BackendType DefaultBackend = BackendType::TBB;
+#elif defined(VTK_SMP_OpenMP)
+const BackendType DefaultBackend = BackendType::OpenMP;
+#else
+const BackendType DefaultBackend = BackendType::Sequential;
+#endif
+
+// Settings of vtkSMPTools::LocalScope() for the calling thread. They are
+// carried over to the threads that execute a For() started by that thread.
+struct vtkSMPThreadSettings
+{
+  // Upper bound on the number of threads executing a For(), 0 for none.
+  int MaxNumberOfThreads;
+  // Whether a For() started while executing a For() runs in parallel.
+  bool NestedParallelism;
+  // Whether the thread is executing part of a For().
+  bool InParallelScope;
+
+  int GetNumberOfThreads(int backendNumberOfThreads) const
+  {
+    return this->MaxNumberOfThreads > 0 && this->MaxNumberOfThreads < backendNumberOfThreads
+      ? this->MaxNumberOfThreads
+      : backendNumberOfThreads;
+  }
+
+  bool RunNestedSequentially() const { return this->InParallelScope && !this->NestedParallelism; }
+};
+
+// Settings of the calling thread.
+VTKCOMMONCORE_EXPORT vtkSMPThreadSettings& GetSMPThreadSettings();
+
+// Gives a thread executing part of a For() the settings of the thread that
+// started it, and restores its own settings when destroyed.
+class vtkSMPParallelScope
+{
+public:
+  explicit vtkSMPParallelScope(const vtkSMPThreadSettings& caller)
+    : Saved(GetSMPThreadSettings())
+  {
+    vtkSMPThreadSettings& settings = GetSMPThreadSettings();
+    settings = caller;
+    settings.InParallelScope = true;
+  }
+
+  ~vtkSMPParallelScope() { GetSMPThreadSettings() = this->Saved; }
+
+private:
+  vtkSMPThreadSettings Saved;
+
+  vtkSMPParallelScope(const vtkSMPParallelScope&) = delete;
+  void operator=(const vtkSMPParallelScope&) = delete;
+};
+
+template <BackendType Backend>
+class vtkSMPToolsImpl
+{
+public:
+  void Initialize(int numThreads = 0);
+
+  int GetEstimatedNumberOfThreads();
+
+  template <typename FunctorInternal>
+  void For(vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi);
+
+  template <typename RandomAccessIterator>
+  void Sort(RandomAccessIterator begin, RandomAccessIterator end);
+
+  template <typename RandomAccessIterator, typename Compare>
+  void Sort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp);
+
+  template <typename InputIt, typename OutputIt, typename Functor>
+  void Transform(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Functor& transform)
+  {
+    vtkIdType size = static_cast<vtkIdType>(std::distance(inBegin, inEnd));
+    UnaryTransformCall<InputIt, OutputIt, Functor> exec(inBegin, outBegin, transform);
+    this->For(0, size, 0, exec);
+  }
+
+  template <typename InputIt1, typename InputIt2, typename OutputIt, typename Functor>
+  void Transform(
+    InputIt1 inBegin1, InputIt1 inEnd, InputIt2 inBegin2, OutputIt outBegin, Functor& transform)
+  {
+    vtkIdType size = static_cast<vtkIdType>(std::distance(inBegin1, inEnd));
+    BinaryTransformCall<InputIt1, InputIt2, OutputIt, Functor> exec(
+      inBegin1, inBegin2, outBegin, transform);
+    this->For(0, size, 0, exec);
+  }
+
+  template <typename Iterator, typename T>
+  void Fill(Iterator begin, Iterator end, const T& value)
+  {
+    vtkIdType size = static_cast<vtkIdType>(std::distance(begin, end));
+    FillCall<Iterator, T> exec(begin, value);
+    this->For(0, size, 0, exec);
+  }
+
+  template <typename InputIt, typename T, typename ReduceFunctor, typename TransformFunctor>
+  T TransformReduce(InputIt begin, InputIt end, T init, ReduceFunctor& reduce,
+    TransformFunctor& transform)
+  {
+    vtkSMPToolsBlocks blocks(static_cast<vtkIdType>(std::distance(begin, end)));
+    std::vector<T> partials(blocks.GetNumberOfBlocks(), init);
+    TransformReduceCall<InputIt, T, ReduceFunctor, TransformFunctor> exec(
+      begin, blocks, reduce, transform, partials);
+    this->For(0, blocks.GetNumberOfBlocks(), 1, exec);
+    for (const T& partial : partials)
+    {
+      init = reduce(init, partial);
+    }
+    return init;
+  }
+
+  template <typename InputIt, typename OutputIt, typename T, typename Functor>
+  OutputIt ExclusiveScan(
+    InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, Functor& operation)
+  {
+    return this->Scan(inBegin, inEnd, outBegin, init, true, false, operation);
+  }
+
+  template <typename InputIt, typename OutputIt, typename Functor>
+  OutputIt InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Functor& operation)
+  {
+    typedef typename std::iterator_traits<InputIt>::value_type ValueType;
+    if (inBegin == inEnd)
+    {
+      return outBegin;
+    }
+    // The first value only sets the type of the offsets, it is not used.
+    ValueType first = *inBegin;
+    return this->Scan(inBegin, inEnd, outBegin, first, false, true, operation);
+  }
+
+  template <typename InputIt, typename OutputIt, typename Predicate>
+  OutputIt CopyIf(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Predicate& pred)
+  {
+    vtkSMPToolsBlocks blocks(static_cast<vtkIdType>(std::distance(inBegin, inEnd)));
+    std::vector<vtkIdType> offsets(blocks.GetNumberOfBlocks(), 0);
+    CountIfCall<InputIt, Predicate> count(inBegin, blocks, pred, offsets);
+    this->For(0, blocks.GetNumberOfBlocks(), 1, count);
+    vtkIdType total = 0;
+    for (vtkIdType& offset : offsets)
+    {
+      const vtkIdType blockCount = offset;
+      offset = total;
+      total += blockCount;
+    }
+    CopyIfCall<InputIt, OutputIt, Predicate> copy(inBegin, outBegin, blocks, pred, offsets);
+    this->For(0, blocks.GetNumberOfBlocks(), 1, copy);
+    std::advance(outBegin, total);
+    return outBegin;
+  }
+
+private:
+  // Two passes: the blocks are reduced, the reductions are scanned
+  // sequentially into the offset of every block and then the blocks are
+  // scanned from their offset.
+  template <typename InputIt, typename OutputIt, typename T, typename Functor>
+  OutputIt Scan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, bool hasInit,
+    bool inclusive, Functor& operation)
+  {
+    vtkSMPToolsBlocks blocks(static_cast<vtkIdType>(std::distance(inBegin, inEnd)));
+    const vtkIdType numBlocks = blocks.GetNumberOfBlocks();
+    std::vector<T> offsets(numBlocks, init);
+    if (numBlocks > 1)
+    {
+      IdentityFunctor identity;
+      TransformReduceCall<InputIt, T, Functor, IdentityFunctor> reduce(
+        inBegin, blocks, operation, identity, offsets);
+      this->For(0, numBlocks - 1, 1, reduce);
+      T offset = hasInit ? operation(init, offsets[0]) : offsets[0];
+      offsets[0] = init;
+      for (vtkIdType block = 1; block < numBlocks - 1; ++block)
+      {
+        T partial = offsets[block];
+        offsets[block] = offset;
+        offset = operation(offset, partial);
+      }
+      offsets[numBlocks - 1] = offset;
+    }
+    ScanCall<InputIt, OutputIt, T, Functor> scan(
+      inBegin, outBegin, blocks, operation, offsets, inclusive, hasInit);
+    this->For(0, numBlocks, 1, scan);
+    std::advance(outBegin, std::distance(inBegin, inEnd));
+    return outBegin;
+  }
+};
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+#endif // __VTK_WRAP__
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsImpl.h
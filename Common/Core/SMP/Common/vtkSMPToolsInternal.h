@@ -0,0 +1,377 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPToolsInternal - Functors used to build the vtkSMPTools
+// algorithms on top of For().
+// .SECTION Description
+// Each class below exposes the Execute(begin, end) method expected by the
+// For() of every backend. The reductions, scans and compaction work on
+// blocks whose layout only depends on the size of the range (see
+// vtkSMPToolsBlocks), so that their result does not depend on the backend
+// or on the number of threads, even for non associative floating point
+// operations.
+
+#ifndef vtkSMPToolsInternal_h
+#define vtkSMPToolsInternal_h
+
+#include "vtkSystemIncludes.h" // For vtkIdType
+
+#include <algorithm> // For std::min
+#include <iterator>  // For std::advance
+#include <vector>    // For std::vector
+
+#ifndef __VTK_WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+//--------------------------------------------------------------------------------
+template <typename InputIt, typename OutputIt, typename Functor>
+class UnaryTransformCall
+{
+protected:
+  InputIt In;
+  OutputIt Out;
+  Functor& Transform;
+
+public:
+  UnaryTransformCall(InputIt _in, OutputIt _out, Functor& _transform)
+    : In(_in)
+    , Out(_out)
+    , Transform(_transform)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    InputIt itIn(In);
+    OutputIt itOut(Out);
+    std::advance(itIn, begin);
+    std::advance(itOut, begin);
+    for (vtkIdType it = begin; it < end; it++)
+    {
+      *itOut = Transform(*itIn);
+      ++itIn;
+      ++itOut;
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+template <typename InputIt1, typename InputIt2, typename OutputIt, typename Functor>
+class BinaryTransformCall : public UnaryTransformCall<InputIt1, OutputIt, Functor>
+{
+  InputIt2 In2;
+
+public:
+  BinaryTransformCall(InputIt1 _in1, InputIt2 _in2, OutputIt _out, Functor& _transform)
+    : UnaryTransformCall<InputIt1, OutputIt, Functor>(_in1, _out, _transform)
+    , In2(_in2)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    InputIt1 itIn1(this->In);
+    InputIt2 itIn2(In2);
+    OutputIt itOut(this->Out);
+    std::advance(itIn1, begin);
+    std::advance(itIn2, begin);
+    std::advance(itOut, begin);
+    for (vtkIdType it = begin; it < end; it++)
+    {
+      *itOut = this->Transform(*itIn1, *itIn2);
+      ++itIn1;
+      ++itIn2;
+      ++itOut;
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+template <typename Iterator, typename T>
+class FillCall
+{
+  Iterator Begin;
+  const T& Value;
+
+public:
+  FillCall(Iterator _begin, const T& _value)
+    : Begin(_begin)
+    , Value(_value)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    Iterator it(Begin);
+    std::advance(it, begin);
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      *it = Value;
+      ++it;
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Transform used by Reduce() and the scans.
+struct IdentityFunctor
+{
+  template <typename T>
+  const T& operator()(const T& value) const
+  {
+    return value;
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Cuts [0, size) in contiguous blocks. The layout only depends on size.
+class vtkSMPToolsBlocks
+{
+public:
+  explicit vtkSMPToolsBlocks(vtkIdType size)
+    : Size(size)
+  {
+    // Small enough to balance the load on many threads, large enough for
+    // the per-block results to stay cheap to combine.
+    const vtkIdType minimumBlockSize = 1024;
+    const vtkIdType maximumNumberOfBlocks = 1024;
+    this->BlockSize = (size + maximumNumberOfBlocks - 1) / maximumNumberOfBlocks;
+    this->BlockSize = std::max(this->BlockSize, minimumBlockSize);
+    this->NumberOfBlocks = (size + this->BlockSize - 1) / this->BlockSize;
+  }
+
+  vtkIdType GetNumberOfBlocks() const { return this->NumberOfBlocks; }
+  vtkIdType GetBegin(vtkIdType block) const { return block * this->BlockSize; }
+  vtkIdType GetEnd(vtkIdType block) const
+  {
+    return std::min(this->Size, (block + 1) * this->BlockSize);
+  }
+
+private:
+  vtkIdType Size;
+  vtkIdType BlockSize;
+  vtkIdType NumberOfBlocks;
+};
+
+//--------------------------------------------------------------------------------
+// Reduces each block of a non empty range, starting from its first
+// transformed value, into Partials.
+template <typename InputIt, typename T, typename ReduceFunctor, typename TransformFunctor>
+class TransformReduceCall
+{
+  InputIt In;
+  const vtkSMPToolsBlocks& Blocks;
+  ReduceFunctor& Reduce;
+  TransformFunctor& Transform;
+  std::vector<T>& Partials;
+
+public:
+  TransformReduceCall(InputIt _in, const vtkSMPToolsBlocks& _blocks, ReduceFunctor& _reduce,
+    TransformFunctor& _transform, std::vector<T>& _partials)
+    : In(_in)
+    , Blocks(_blocks)
+    , Reduce(_reduce)
+    , Transform(_transform)
+    , Partials(_partials)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const vtkIdType last = Blocks.GetEnd(block);
+      vtkIdType it = Blocks.GetBegin(block);
+      InputIt itIn(In);
+      std::advance(itIn, it);
+      T value = Transform(*itIn);
+      for (++it, ++itIn; it < last; ++it, ++itIn)
+      {
+        value = Reduce(value, Transform(*itIn));
+      }
+      Partials[block] = value;
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Second pass of the scans: each block is scanned starting from the
+// combination of the blocks before it, given in Offsets. With Inclusive and
+// no initial value, the first block starts from its first element.
+template <typename InputIt, typename OutputIt, typename T, typename Functor>
+class ScanCall
+{
+  InputIt In;
+  OutputIt Out;
+  const vtkSMPToolsBlocks& Blocks;
+  Functor& Operation;
+  const std::vector<T>& Offsets;
+  bool Inclusive;
+  bool HasInit;
+
+public:
+  ScanCall(InputIt _in, OutputIt _out, const vtkSMPToolsBlocks& _blocks, Functor& _operation,
+    const std::vector<T>& _offsets, bool _inclusive, bool _hasInit)
+    : In(_in)
+    , Out(_out)
+    , Blocks(_blocks)
+    , Operation(_operation)
+    , Offsets(_offsets)
+    , Inclusive(_inclusive)
+    , HasInit(_hasInit)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const vtkIdType last = Blocks.GetEnd(block);
+      vtkIdType it = Blocks.GetBegin(block);
+      InputIt itIn(In);
+      OutputIt itOut(Out);
+      std::advance(itIn, it);
+      std::advance(itOut, it);
+      if (block == 0 && !HasInit)
+      {
+        T value = *itIn;
+        *itOut = value;
+        for (++it, ++itIn, ++itOut; it < last; ++it, ++itIn, ++itOut)
+        {
+          value = Operation(value, *itIn);
+          *itOut = value;
+        }
+      }
+      else if (Inclusive)
+      {
+        T value = Offsets[block];
+        for (; it < last; ++it, ++itIn, ++itOut)
+        {
+          value = Operation(value, *itIn);
+          *itOut = value;
+        }
+      }
+      else
+      {
+        T value = Offsets[block];
+        for (; it < last; ++it, ++itIn, ++itOut)
+        {
+          // Read before writing so that the scan can be done in place.
+          T next = Operation(value, *itIn);
+          *itOut = value;
+          value = next;
+        }
+      }
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// First pass of CopyIf: number of selected values of each block.
+template <typename InputIt, typename Predicate>
+class CountIfCall
+{
+  InputIt In;
+  const vtkSMPToolsBlocks& Blocks;
+  Predicate& Pred;
+  std::vector<vtkIdType>& Counts;
+
+public:
+  CountIfCall(InputIt _in, const vtkSMPToolsBlocks& _blocks, Predicate& _pred,
+    std::vector<vtkIdType>& _counts)
+    : In(_in)
+    , Blocks(_blocks)
+    , Pred(_pred)
+    , Counts(_counts)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const vtkIdType last = Blocks.GetEnd(block);
+      vtkIdType it = Blocks.GetBegin(block);
+      InputIt itIn(In);
+      std::advance(itIn, it);
+      vtkIdType count = 0;
+      for (; it < last; ++it, ++itIn)
+      {
+        if (Pred(*itIn))
+        {
+          ++count;
+        }
+      }
+      Counts[block] = count;
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Second pass of CopyIf: each block copies its selected values starting at
+// the output position given in Offsets.
+template <typename InputIt, typename OutputIt, typename Predicate>
+class CopyIfCall
+{
+  InputIt In;
+  OutputIt Out;
+  const vtkSMPToolsBlocks& Blocks;
+  Predicate& Pred;
+  const std::vector<vtkIdType>& Offsets;
+
+public:
+  CopyIfCall(InputIt _in, OutputIt _out, const vtkSMPToolsBlocks& _blocks, Predicate& _pred,
+    const std::vector<vtkIdType>& _offsets)
+    : In(_in)
+    , Out(_out)
+    , Blocks(_blocks)
+    , Pred(_pred)
+    , Offsets(_offsets)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      const vtkIdType last = Blocks.GetEnd(block);
+      vtkIdType it = Blocks.GetBegin(block);
+      InputIt itIn(In);
+      OutputIt itOut(Out);
+      std::advance(itIn, it);
+      std::advance(itOut, Offsets[block]);
+      for (; it < last; ++it, ++itIn)
+      {
+        if (Pred(*itIn))
+        {
+          *itOut = *itIn;
+          ++itOut;
+        }
+      }
+    }
+  }
+};
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+#endif // __VTK_WRAP__
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPToolsInternal.h
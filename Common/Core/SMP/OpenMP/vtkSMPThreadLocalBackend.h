@@ -1,7 +1,7 @@
 /*=========================================================================
 
   Program:   Visualization Toolkit
-  Module:    vtkSMPThreadLocalImpl.h
+  Module:    vtkSMPThreadLocalBackend.h
 
   Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
   All rights reserved.
@@ -29,8 +29,8 @@
 // safe and only blocks when a new array needs to be allocated, which should be
 // rare.
 
-#ifndef vtkSMPThreadLocalImpl_h
-#define vtkSMPThreadLocalImpl_h
+#ifndef OpenMPvtkSMPThreadLocalBackend_h
+#define OpenMPvtkSMPThreadLocalBackend_h
 
 #include "vtkCommonCoreModule.h" // For export macro
 #include "vtkConfigure.h"
@@ -39,9 +39,15 @@
 #include <atomic>
 #include <omp.h>
 
-
+#ifndef __VTK_WRAP__
+namespace vtk
+{
 namespace detail
 {
+namespace smp
+{
+namespace OpenMP
+{
 
 typedef void* ThreadIdType;
 typedef vtkTypeUInt32 HashType;
@@ -182,7 +188,11 @@ private:
   size_t CurrentSlot;
 };
 
-} // detail;
+} // namespace OpenMP
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+#endif // __VTK_WRAP__
 
 #endif
-// VTK-HeaderTest-Exclude: vtkSMPThreadLocalImpl.h
+// VTK-HeaderTest-Exclude: vtkSMPThreadLocalBackend.h
@@ -0,0 +1,88 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsImpl.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "SMP/OpenMP/vtkSMPToolsImpl.txx"
+
+#include <omp.h>
+
+#include <algorithm>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+static int vtkSMPNumberOfSpecifiedThreads = 0;
+
+//------------------------------------------------------------------------------
+template <>
+void vtkSMPToolsImpl<BackendType::OpenMP>::Initialize(int numThreads)
+{
+#pragma omp single
+  if (numThreads)
+  {
+    vtkSMPNumberOfSpecifiedThreads = numThreads;
+    omp_set_num_threads(numThreads);
+  }
+}
+
+//------------------------------------------------------------------------------
+template <>
+int vtkSMPToolsImpl<BackendType::OpenMP>::GetEstimatedNumberOfThreads()
+{
+  return GetNumberOfThreadsOpenMP();
+}
+
+//------------------------------------------------------------------------------
+int GetNumberOfThreadsOpenMP()
+{
+  return vtkSMPNumberOfSpecifiedThreads ? vtkSMPNumberOfSpecifiedThreads : omp_get_max_threads();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
+  ExecuteFunctorPtrType functorExecuter, void* functor)
+{
+  const vtkSMPThreadSettings settings = GetSMPThreadSettings();
+  const int numThreads = settings.GetNumberOfThreads(GetNumberOfThreadsOpenMP());
+  if (grain <= 0)
+  {
+    vtkIdType estimateGrain = (last - first) / (numThreads * 4);
+    grain = (estimateGrain > 0) ? estimateGrain : 1;
+  }
+
+  // Nested parallel regions only get more than one thread when the number
+  // of active levels allows it.
+  if (settings.InParallelScope && omp_get_active_level() >= omp_get_max_active_levels())
+  {
+    omp_set_max_active_levels(omp_get_active_level() + 1);
+  }
+
+#pragma omp parallel num_threads(numThreads)
+  {
+    vtkSMPParallelScope scope(settings);
+#pragma omp for schedule(runtime)
+    for (vtkIdType from = first; from < last; from += grain)
+    {
+      functorExecuter(functor, from, grain, last);
+    }
+  }
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
@@ -0,0 +1,396 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadPool.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "SMP/STDThread/vtkSMPThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+namespace
+{
+// A parallel for submitted to the pool. It lives on the stack of the
+// submitting thread, which does not return before Remaining drops to 0.
+struct Job
+{
+  vtkSMPThreadPool::RangeFunctionType Function;
+  void* Data;
+  vtkIdType Grain;
+  // Whether tasks are halved while executed for other threads to steal.
+  bool Split;
+  std::atomic<vtkIdType> Remaining;
+};
+
+struct Task
+{
+  Job* Owner;
+  vtkIdType From;
+  vtkIdType To;
+};
+
+// Double-ended queue of tasks. The owner pushes and pops at the back,
+// thieves take from the front where the largest ranges are.
+class WorkQueue
+{
+public:
+  void Push(const Task& task)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Tasks.push_back(task);
+  }
+
+  // When job is not null, only a task belonging to job is returned.
+  bool Pop(Task& task, const Job* job)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    if (this->Tasks.empty() || (job && this->Tasks.back().Owner != job))
+    {
+      return false;
+    }
+    task = this->Tasks.back();
+    this->Tasks.pop_back();
+    return true;
+  }
+
+  bool Steal(Task& task, const Job* job)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto it = this->Tasks.begin();
+    if (job)
+    {
+      it = std::find_if(this->Tasks.begin(), this->Tasks.end(),
+        [job](const Task& candidate) { return candidate.Owner == job; });
+    }
+    if (it == this->Tasks.end())
+    {
+      return false;
+    }
+    task = *it;
+    this->Tasks.erase(it);
+    return true;
+  }
+
+private:
+  std::mutex Mutex;
+  std::deque<Task> Tasks;
+};
+
+// Pool and queue owned by the calling thread. Only set for pool workers.
+thread_local vtkSMPThreadPool::vtkInternals* vtkSMPThreadPoolOwner = nullptr;
+thread_local int vtkSMPThreadPoolQueueIndex = 0;
+}
+
+//------------------------------------------------------------------------------
+class vtkSMPThreadPool::vtkInternals
+{
+public:
+  // Guards NumberOfThreads, Queues and Workers against re-initialization.
+  std::mutex ConfigureMutex;
+  std::atomic<bool> Running{ false };
+  int NumberOfThreads = 0;
+
+  // Queues [0, NumberOfThreads - 1) belong to the workers, the last one is
+  // shared by all threads that are not part of the pool.
+  std::vector<std::unique_ptr<WorkQueue>> Queues;
+  std::vector<std::thread> Workers;
+
+  std::mutex WakeMutex;
+  std::condition_variable WakeCondition;
+  std::atomic<vtkIdType> QueuedTasks{ 0 };
+  std::atomic<int> Sleeping{ 0 };
+  bool Stop = false;
+
+  ~vtkInternals() { this->Shutdown(); }
+
+  int GetDefaultNumberOfThreads() const
+  {
+    int numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    return numThreads > 0 ? numThreads : 1;
+  }
+
+  void EnsureRunning()
+  {
+    if (this->Running.load())
+    {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(this->ConfigureMutex);
+    if (this->Running.load())
+    {
+      return;
+    }
+    if (this->NumberOfThreads <= 0)
+    {
+      this->NumberOfThreads = this->GetDefaultNumberOfThreads();
+    }
+    this->Queues.clear();
+    for (int i = 0; i < this->NumberOfThreads; ++i)
+    {
+      this->Queues.emplace_back(new WorkQueue);
+    }
+    this->Stop = false;
+    for (int i = 0; i < this->NumberOfThreads - 1; ++i)
+    {
+      this->Workers.emplace_back(&vtkInternals::WorkerLoop, this, i);
+    }
+    this->Running.store(true);
+  }
+
+  // Caller must hold ConfigureMutex or be the destructor.
+  void Shutdown()
+  {
+    if (!this->Running.load())
+    {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(this->WakeMutex);
+      this->Stop = true;
+    }
+    this->WakeCondition.notify_all();
+    for (auto& worker : this->Workers)
+    {
+      worker.join();
+    }
+    this->Workers.clear();
+    this->Queues.clear();
+    this->QueuedTasks.store(0);
+    this->Running.store(false);
+  }
+
+  int GetQueueIndex()
+  {
+    return vtkSMPThreadPoolOwner == this ? vtkSMPThreadPoolQueueIndex
+                                         : this->NumberOfThreads - 1;
+  }
+
+  void Push(int queueIndex, const Task& task)
+  {
+    this->Queues[queueIndex]->Push(task);
+    ++this->QueuedTasks;
+    if (this->Sleeping.load() > 0)
+    {
+      // Taking the lock guarantees that a worker that just decided to
+      // sleep is waiting on the condition before it gets notified.
+      {
+        std::lock_guard<std::mutex> lock(this->WakeMutex);
+      }
+      this->WakeCondition.notify_one();
+    }
+  }
+
+  bool Acquire(int queueIndex, Task& task, const Job* job)
+  {
+    const int numQueues = static_cast<int>(this->Queues.size());
+    bool found = this->Queues[queueIndex]->Pop(task, job);
+    for (int i = 1; !found && i < numQueues; ++i)
+    {
+      found = this->Queues[(queueIndex + i) % numQueues]->Steal(task, job);
+    }
+    if (found)
+    {
+      --this->QueuedTasks;
+    }
+    return found;
+  }
+
+  void Execute(int queueIndex, Task task)
+  {
+    Job* job = task.Owner;
+    // Split in halves (in multiples of the grain) and expose the upper
+    // halves to thieves until the range is a single grain.
+    while (job->Split && task.To - task.From > job->Grain)
+    {
+      vtkIdType numGrains = (task.To - task.From + job->Grain - 1) / job->Grain;
+      vtkIdType middle = task.From + (numGrains / 2) * job->Grain;
+      ++job->Remaining;
+      this->Push(queueIndex, Task{ job, middle, task.To });
+      task.To = middle;
+    }
+    for (vtkIdType from = task.From; from < task.To; from += job->Grain)
+    {
+      job->Function(job->Data, from, std::min(from + job->Grain, task.To));
+    }
+    // job must not be accessed past this point.
+    --job->Remaining;
+  }
+
+  void WorkerLoop(int queueIndex)
+  {
+    vtkSMPThreadPoolOwner = this;
+    vtkSMPThreadPoolQueueIndex = queueIndex;
+    for (;;)
+    {
+      Task task;
+      if (this->Acquire(queueIndex, task, nullptr))
+      {
+        this->Execute(queueIndex, task);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(this->WakeMutex);
+      ++this->Sleeping;
+      this->WakeCondition.wait(
+        lock, [this]() { return this->Stop || this->QueuedTasks.load() > 0; });
+      --this->Sleeping;
+      if (this->Stop)
+      {
+        return;
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkSMPThreadPool::vtkSMPThreadPool()
+  : Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkSMPThreadPool::~vtkSMPThreadPool()
+{
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+vtkSMPThreadPool& vtkSMPThreadPool::GetInstance()
+{
+  static vtkSMPThreadPool instance;
+  return instance;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::Initialize(int numThreads)
+{
+  if (vtkSMPThreadPool::IsWorkerThread())
+  {
+    // A worker cannot join itself.
+    return;
+  }
+  std::lock_guard<std::mutex> lock(this->Internals->ConfigureMutex);
+  if (numThreads <= 0)
+  {
+    numThreads = this->Internals->GetDefaultNumberOfThreads();
+  }
+  if (numThreads != this->Internals->NumberOfThreads)
+  {
+    this->Internals->Shutdown();
+    this->Internals->NumberOfThreads = numThreads;
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkSMPThreadPool::GetNumberOfThreads()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->ConfigureMutex);
+  return this->Internals->NumberOfThreads > 0 ? this->Internals->NumberOfThreads
+                                              : this->Internals->GetDefaultNumberOfThreads();
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPThreadPool::IsWorkerThread()
+{
+  return vtkSMPThreadPoolOwner != nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::ParallelFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+  RangeFunctionType function, void* data, int maxThreads)
+{
+  if (last <= first)
+  {
+    return;
+  }
+  grain = std::max<vtkIdType>(grain, 1);
+
+  vtkInternals* internals = this->Internals;
+  internals->EnsureRunning();
+  const int poolSize = internals->NumberOfThreads;
+  const bool limited = maxThreads > 0 && maxThreads < poolSize;
+  const int numThreads = limited ? maxThreads : poolSize;
+  if (numThreads == 1 || last - first <= grain)
+  {
+    for (vtkIdType from = first; from < last; from += grain)
+    {
+      function(data, from, std::min(from + grain, last));
+    }
+    return;
+  }
+
+  Job job;
+  job.Function = function;
+  job.Data = data;
+  job.Grain = grain;
+  job.Split = !limited;
+
+  // Hand one contiguous block to each thread. Blocks get split further
+  // when they are executed, so the initial partition only has to be even.
+  const vtkIdType numGrains = (last - first + grain - 1) / grain;
+  const vtkIdType numBlocks = std::min<vtkIdType>(numThreads, numGrains);
+  const vtkIdType grainsPerBlock = numGrains / numBlocks;
+  const vtkIdType extraGrains = numGrains % numBlocks;
+  const int queueIndex = internals->GetQueueIndex();
+
+  job.Remaining.store(numBlocks);
+  Task ownTask{ &job, first, first };
+  vtkIdType from = first;
+  for (vtkIdType block = 0; block < numBlocks; ++block)
+  {
+    vtkIdType to = std::min(from + (grainsPerBlock + (block < extraGrains ? 1 : 0)) * grain, last);
+    if (block == 0)
+    {
+      ownTask.To = to;
+    }
+    else
+    {
+      internals->Push(static_cast<int>((queueIndex + block) % poolSize), Task{ &job, from, to });
+    }
+    from = to;
+  }
+
+  internals->Execute(queueIndex, ownTask);
+
+  // Help with the remaining tasks of this job only. Running a task of
+  // another job here could re-enter a functor that is already on the
+  // stack of this thread.
+  while (job.Remaining.load() > 0)
+  {
+    Task task;
+    if (internals->Acquire(queueIndex, task, &job))
+    {
+      internals->Execute(queueIndex, task);
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
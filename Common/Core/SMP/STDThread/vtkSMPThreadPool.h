@@ -0,0 +1,102 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadPool.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPThreadPool - A persistent work-stealing thread pool.
+// .SECTION Description
+// vtkSMPThreadPool owns a set of worker threads that live for the duration
+// of the program (or until the pool is re-initialized with a different
+// number of threads). Each worker owns a double-ended work queue. A worker
+// pops tasks from the back of its own queue and, when it runs out of work,
+// steals tasks from the front of the queues of other workers.
+//
+// A parallel for is submitted as a small number of range tasks. When a
+// task is executed, it is recursively halved (in multiples of the grain)
+// and the upper halves are pushed on the queue of the executing thread so
+// that idle threads can steal them. The thread that submitted the work
+// participates in its execution until all of its tasks are done. This also
+// makes nested parallel fors safe: a worker that submits work from inside
+// a task keeps executing tasks instead of blocking.
+
+#ifndef vtkSMPThreadPool_h
+#define vtkSMPThreadPool_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSystemIncludes.h"
+
+#ifndef __VTK_WRAP__
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+class VTKCOMMONCORE_EXPORT vtkSMPThreadPool
+{
+public:
+  // Description:
+  // Signature of the function executed by the pool for a range [from, to).
+  typedef void (*RangeFunctionType)(void* data, vtkIdType from, vtkIdType to);
+
+  // Description:
+  // Returns the pool shared by all vtkSMPTools calls. The worker threads
+  // are started the first time parallel work is submitted.
+  static vtkSMPThreadPool& GetInstance();
+
+  // Description:
+  // Set the total number of threads (workers plus the submitting thread)
+  // used by the pool. A value <= 0 selects the hardware concurrency. If the
+  // pool is already running with a different number of threads, the workers
+  // are joined and restarted. This must not be called while parallel work
+  // is in flight.
+  void Initialize(int numThreads);
+
+  // Description:
+  // Total number of threads that may execute a parallel for, including the
+  // submitting thread.
+  int GetNumberOfThreads();
+
+  // Description:
+  // Returns true if the calling thread is one of the pool workers.
+  static bool IsWorkerThread();
+
+  // Description:
+  // Execute function over [first, last) in chunks of at least grain
+  // elements. Returns when all chunks have been executed. When maxThreads
+  // is positive and lower than the number of threads of the pool, the range
+  // is cut in maxThreads tasks that are not split further, so that at most
+  // maxThreads threads execute it at the same time.
+  void ParallelFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+    RangeFunctionType function, void* data, int maxThreads = 0);
+
+  ~vtkSMPThreadPool();
+
+  class vtkInternals;
+
+private:
+  vtkSMPThreadPool();
+
+  vtkInternals* Internals;
+
+  vtkSMPThreadPool(const vtkSMPThreadPool&) = delete;
+  void operator=(const vtkSMPThreadPool&) = delete;
+};
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+#endif // __VTK_WRAP__
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPThreadPool.h
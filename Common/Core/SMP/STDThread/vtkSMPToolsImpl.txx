@@ -0,0 +1,192 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsImpl.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef STDThreadvtkSMPToolsImpl_txx
+#define STDThreadvtkSMPToolsImpl_txx
+
+#include "SMP/Common/vtkSMPToolsImpl.h"
+#include "SMP/STDThread/vtkSMPThreadPool.h" // For vtkSMPThreadPool
+
+#include <algorithm>  //for std::sort()
+#include <functional> // for std::less
+#include <iterator>
+#include <vector>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+int VTKCOMMONCORE_EXPORT GetNumberOfThreadsSTDThread();
+
+//--------------------------------------------------------------------------------
+// Data of a For() given to the pool: the functor and the settings of the
+// thread that started it.
+template <typename FunctorInternal>
+struct vtkSMPToolsForSTDThread
+{
+  FunctorInternal& Functor;
+  vtkSMPThreadSettings Settings;
+};
+
+//--------------------------------------------------------------------------------
+template <typename FunctorInternal>
+void ExecuteFunctorSTDThread(void* data, vtkIdType from, vtkIdType to)
+{
+  vtkSMPToolsForSTDThread<FunctorInternal>& call =
+    *reinterpret_cast<vtkSMPToolsForSTDThread<FunctorInternal>*>(data);
+  vtkSMPParallelScope scope(call.Settings);
+  call.Functor.Execute(from, to);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename FunctorInternal>
+void vtkSMPToolsImpl<BackendType::STDThread>::For(
+  vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
+{
+  vtkIdType n = last - first;
+  if (n <= 0)
+  {
+    return;
+  }
+
+  const vtkSMPThreadSettings& settings = GetSMPThreadSettings();
+  if (grain >= n || settings.RunNestedSequentially())
+  {
+    fi.Execute(first, last);
+    return;
+  }
+
+  const int numThreads = settings.GetNumberOfThreads(GetNumberOfThreadsSTDThread());
+  if (grain <= 0)
+  {
+    vtkIdType estimateGrain = n / (numThreads * 4);
+    grain = (estimateGrain > 0) ? estimateGrain : 1;
+  }
+
+  vtkSMPToolsForSTDThread<FunctorInternal> call = { fi, settings };
+  vtkSMPThreadPool::GetInstance().ParallelFor(
+    first, last, grain, ExecuteFunctorSTDThread<FunctorInternal>, &call, numThreads);
+}
+
+//--------------------------------------------------------------------------------
+// Parallel merge sort: the range is cut in a power of two number of pieces
+// that are sorted concurrently, then neighboring pieces are merged pairwise.
+template <typename RandomAccessIterator, typename Compare>
+class vtkSMPToolsSortSTDThread
+{
+public:
+  vtkSMPToolsSortSTDThread(std::vector<RandomAccessIterator>& bounds, Compare comp)
+    : Bounds(bounds)
+    , Comp(comp)
+    , Width(0)
+  {
+  }
+
+  void Sort()
+  {
+    const vtkIdType numPieces = static_cast<vtkIdType>(this->Bounds.size()) - 1;
+    this->Width = 0;
+    vtkSMPThreadPool::GetInstance().ParallelFor(
+      0, numPieces, 1, vtkSMPToolsSortSTDThread::Execute, this);
+    for (this->Width = 1; this->Width < numPieces; this->Width *= 2)
+    {
+      vtkSMPThreadPool::GetInstance().ParallelFor(
+        0, numPieces / (2 * this->Width), 1, vtkSMPToolsSortSTDThread::Execute, this);
+    }
+  }
+
+private:
+  static void Execute(void* data, vtkIdType from, vtkIdType to)
+  {
+    vtkSMPToolsSortSTDThread& self = *reinterpret_cast<vtkSMPToolsSortSTDThread*>(data);
+    for (vtkIdType i = from; i < to; ++i)
+    {
+      if (self.Width == 0)
+      {
+        std::sort(self.Bounds[i], self.Bounds[i + 1], self.Comp);
+      }
+      else
+      {
+        const vtkIdType left = 2 * i * self.Width;
+        std::inplace_merge(self.Bounds[left], self.Bounds[left + self.Width],
+          self.Bounds[left + 2 * self.Width], self.Comp);
+      }
+    }
+  }
+
+  std::vector<RandomAccessIterator>& Bounds;
+  Compare Comp;
+  vtkIdType Width;
+};
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::STDThread>::Sort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+  // Below this size the merge passes cost more than they save.
+  const vtkIdType minimumPieceSize = 4096;
+  const vtkIdType n = static_cast<vtkIdType>(std::distance(begin, end));
+  const vtkSMPThreadSettings& settings = GetSMPThreadSettings();
+  const int numThreads = settings.GetNumberOfThreads(GetNumberOfThreadsSTDThread());
+  if (numThreads <= 1 || n < 2 * minimumPieceSize || settings.RunNestedSequentially())
+  {
+    std::sort(begin, end, comp);
+    return;
+  }
+
+  vtkIdType numPieces = 1;
+  while (numPieces < numThreads && n / (2 * numPieces) >= minimumPieceSize)
+  {
+    numPieces *= 2;
+  }
+
+  std::vector<RandomAccessIterator> bounds(numPieces + 1);
+  for (vtkIdType i = 0; i <= numPieces; ++i)
+  {
+    bounds[i] = begin + (n * i) / numPieces;
+  }
+  vtkSMPToolsSortSTDThread<RandomAccessIterator, Compare> sorter(bounds, comp);
+  sorter.Sort();
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator>
+void vtkSMPToolsImpl<BackendType::STDThread>::Sort(
+  RandomAccessIterator begin, RandomAccessIterator end)
+{
+  typedef typename std::iterator_traits<RandomAccessIterator>::value_type ValueType;
+  this->Sort(begin, end, std::less<ValueType>());
+}
+
+//--------------------------------------------------------------------------------
+template <>
+VTKCOMMONCORE_EXPORT void vtkSMPToolsImpl<BackendType::STDThread>::Initialize(int);
+
+//--------------------------------------------------------------------------------
+template <>
+VTKCOMMONCORE_EXPORT int vtkSMPToolsImpl<BackendType::STDThread>::GetEstimatedNumberOfThreads();
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
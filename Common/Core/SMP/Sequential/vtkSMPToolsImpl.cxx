@@ -1,7 +1,7 @@
 /*=========================================================================
 
   Program:   Visualization Toolkit
-  Module:    vtkSMPTools.cxx
+  Module:    vtkSMPToolsImpl.cxx
 
   Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
   All rights reserved.
@@ -13,21 +13,30 @@
 
 =========================================================================*/
 
-#include "vtkSMPTools.h"
+#include "SMP/Sequential/vtkSMPToolsImpl.txx"
 
-#include "vtkSMP.h"
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
 
 // Simple implementation that runs everything sequentially.
 
-const char* vtkSMPTools::GetBackend()
+//------------------------------------------------------------------------------
+template <>
+void vtkSMPToolsImpl<BackendType::Sequential>::Initialize(int)
 {
-  return VTK_SMP_BACKEND;
 }
 
 //------------------------------------------------------------------------------
-void vtkSMPTools::Initialize(int) {}
-
-int vtkSMPTools::GetEstimatedNumberOfThreads()
+template <>
+int vtkSMPToolsImpl<BackendType::Sequential>::GetEstimatedNumberOfThreads()
 {
   return 1;
 }
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
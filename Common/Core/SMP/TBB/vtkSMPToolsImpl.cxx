@@ -0,0 +1,95 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsImpl.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "SMP/TBB/vtkSMPToolsImpl.txx"
+
+#ifdef _MSC_VER
+#pragma push_macro("__TBB_NO_IMPLICIT_LINKAGE")
+#define __TBB_NO_IMPLICIT_LINKAGE 1
+#endif
+
+#include <tbb/task_arena.h>
+
+#ifdef _MSC_VER
+#pragma pop_macro("__TBB_NO_IMPLICIT_LINKAGE")
+#endif
+
+#include <mutex>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+static tbb::task_arena vtkSMPToolsTaskArena;
+static int vtkTBBNumSpecifiedThreads = 0;
+static std::mutex vtkSMPToolsCS;
+
+//------------------------------------------------------------------------------
+template <>
+void vtkSMPToolsImpl<BackendType::TBB>::Initialize(int numThreads)
+{
+  std::lock_guard<std::mutex> lock(vtkSMPToolsCS);
+  if (numThreads == vtkTBBNumSpecifiedThreads && vtkSMPToolsTaskArena.is_active())
+  {
+    return;
+  }
+  // If numThreads <= 0, let TBB do the default thing.
+  if (vtkSMPToolsTaskArena.is_active())
+  {
+    vtkSMPToolsTaskArena.terminate();
+  }
+  vtkTBBNumSpecifiedThreads = numThreads > 0 ? numThreads : 0;
+  vtkSMPToolsTaskArena.initialize(
+    numThreads > 0 ? numThreads : static_cast<int>(tbb::task_arena::automatic));
+}
+
+//------------------------------------------------------------------------------
+template <>
+int vtkSMPToolsImpl<BackendType::TBB>::GetEstimatedNumberOfThreads()
+{
+  return vtkTBBNumSpecifiedThreads ? vtkTBBNumSpecifiedThreads
+                                   : tbb::this_task_arena::max_concurrency();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsImplForTBB(vtkIdType first, vtkIdType last, vtkIdType grain,
+  void (*functorExecuter)(void*, vtkIdType, vtkIdType, vtkIdType), void* functor)
+{
+  {
+    std::lock_guard<std::mutex> lock(vtkSMPToolsCS);
+    if (!vtkSMPToolsTaskArena.is_active())
+    {
+      vtkSMPToolsTaskArena.initialize();
+    }
+  }
+  // A thread count limit from vtkSMPTools::LocalScope() is honored by
+  // running the loop in a smaller arena.
+  const int maxThreads = GetSMPThreadSettings().MaxNumberOfThreads;
+  if (maxThreads > 0 && maxThreads < vtkSMPToolsTaskArena.max_concurrency())
+  {
+    tbb::task_arena limitedArena(maxThreads);
+    limitedArena.execute([&]() { functorExecuter(functor, first, last, grain); });
+    return;
+  }
+  vtkSMPToolsTaskArena.execute(
+    [&]() { functorExecuter(functor, first, last, grain); });
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
@@ -0,0 +1,172 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsImpl.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef TBBvtkSMPToolsImpl_txx
+#define TBBvtkSMPToolsImpl_txx
+
+#include "SMP/Common/vtkSMPToolsImpl.h"
+
+#ifdef _MSC_VER
+#pragma push_macro("__TBB_NO_IMPLICIT_LINKAGE")
+#define __TBB_NO_IMPLICIT_LINKAGE 1
+#endif
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#ifdef _MSC_VER
+#pragma pop_macro("__TBB_NO_IMPLICIT_LINKAGE")
+#endif
+
+#include <algorithm> // For std::sort
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+// The parallel loops are run inside a task arena owned by vtkSMPToolsImpl.cxx
+// so that Initialize() can limit the number of threads. This replaces
+// tbb::task_scheduler_init, which is not available in oneTBB.
+void VTKCOMMONCORE_EXPORT vtkSMPToolsImplForTBB(vtkIdType first, vtkIdType last,
+  vtkIdType grain, void (*functorExecuter)(void*, vtkIdType, vtkIdType, vtkIdType),
+  void* functor);
+
+//--------------------------------------------------------------------------------
+template <typename T>
+class FuncCall
+{
+  T& o;
+  // Settings of the thread that started the For().
+  vtkSMPThreadSettings Settings;
+
+  void operator=(const FuncCall&) = delete;
+
+public:
+  void operator()(const tbb::blocked_range<vtkIdType>& r) const
+  {
+    vtkSMPParallelScope scope(this->Settings);
+    o.Execute(r.begin(), r.end());
+  }
+
+  FuncCall(T& _o)
+    : o(_o)
+    , Settings(GetSMPThreadSettings())
+  {
+  }
+};
+
+//--------------------------------------------------------------------------------
+template <typename FunctorInternal>
+void ExecuteFunctorTBB(void* functor, vtkIdType first, vtkIdType last, vtkIdType grain)
+{
+  FunctorInternal& fi = *reinterpret_cast<FunctorInternal*>(functor);
+
+  vtkIdType range = last - first;
+  if (range <= 0)
+  {
+    return;
+  }
+  if (grain > 0)
+  {
+    tbb::parallel_for(
+      tbb::blocked_range<vtkIdType>(first, last, grain), FuncCall<FunctorInternal>(fi));
+  }
+  else
+  {
+    // When the grain is not specified, automatically calculate an appropriate grain size so
+    // most of the time will still be spent running the calculation and not task overhead.
+    const vtkIdType numberThreadsEstimate =
+      40; // Estimate of how many threads we might be able to run
+    const vtkIdType batchesPerThread =
+      5; // Plan for a few batches per thread so one busy core doesn't stall the whole system
+    const vtkIdType batches = numberThreadsEstimate * batchesPerThread;
+
+    if (range >= batches)
+    {
+      vtkIdType calculatedGrain =
+        ((range - 1) / batches) + 1; // std::ceil round up for systems without cmath
+      tbb::parallel_for(tbb::blocked_range<vtkIdType>(first, last, calculatedGrain),
+        FuncCall<FunctorInternal>(fi));
+    }
+    else
+    {
+      // Data is too small to generate a reasonable grain. Fallback to default so data still runs
+      // on as many threads as possible (Jan 2020: Default is one index per tbb task).
+      tbb::parallel_for(tbb::blocked_range<vtkIdType>(first, last), FuncCall<FunctorInternal>(fi));
+    }
+  }
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename FunctorInternal>
+void vtkSMPToolsImpl<BackendType::TBB>::For(
+  vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
+{
+  if (GetSMPThreadSettings().RunNestedSequentially())
+  {
+    if (last > first)
+    {
+      fi.Execute(first, last);
+    }
+    return;
+  }
+  vtkSMPToolsImplForTBB(first, last, grain, ExecuteFunctorTBB<FunctorInternal>, &fi);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator>
+void vtkSMPToolsImpl<BackendType::TBB>::Sort(RandomAccessIterator begin, RandomAccessIterator end)
+{
+  if (GetSMPThreadSettings().RunNestedSequentially())
+  {
+    std::sort(begin, end);
+    return;
+  }
+  tbb::parallel_sort(begin, end);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::TBB>::Sort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+  if (GetSMPThreadSettings().RunNestedSequentially())
+  {
+    std::sort(begin, end, comp);
+    return;
+  }
+  tbb::parallel_sort(begin, end, comp);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+VTKCOMMONCORE_EXPORT void vtkSMPToolsImpl<BackendType::TBB>::Initialize(int);
+
+//--------------------------------------------------------------------------------
+template <>
+VTKCOMMONCORE_EXPORT int vtkSMPToolsImpl<BackendType::TBB>::GetEstimatedNumberOfThreads();
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
@@ -0,0 +1,153 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestArrayDispatchSOA.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the float and double struct-of-arrays arrays are part of the
+// default dispatch list, and that the vtkDataArray copy and interpolation
+// methods give the same results when they mix them with array-of-structs.
+
+#include "vtkArrayDispatch.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkTypeList.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <type_traits>
+
+namespace
+{
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    std::cerr << message << std::endl;
+  }
+  return condition;
+}
+
+// Records that the dispatch reached the expected array types.
+template <typename ExpectedArray1T, typename ExpectedArray2T>
+struct TypeWorker
+{
+  bool Matched = false;
+
+  template <typename Array1T, typename Array2T>
+  void operator()(Array1T*, Array2T*)
+  {
+    this->Matched =
+      std::is_same<Array1T, ExpectedArray1T>::value && std::is_same<Array2T, ExpectedArray2T>::value;
+  }
+};
+
+template <typename ArrayT>
+void FillArray(ArrayT* array, vtkIdType numTuples)
+{
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(numTuples);
+  for (vtkIdType t = 0; t < numTuples; ++t)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      array->SetTypedComponent(t, c, static_cast<typename ArrayT::ValueType>(10 * t + c));
+    }
+  }
+}
+
+// Copies and interpolates the tuples of source into two destinations, one
+// array-of-structs and one struct-of-arrays, and compares them.
+template <typename ValueT>
+bool CheckMixedCopies(vtkDataArray* source)
+{
+  vtkNew<vtkAOSDataArrayTemplate<ValueT>> aos;
+  vtkNew<vtkSOADataArrayTemplate<ValueT>> soa;
+  vtkDataArray* destinations[2] = { aos, soa };
+  vtkNew<vtkIdList> srcIds;
+  srcIds->InsertNextId(3);
+  srcIds->InsertNextId(1);
+  vtkNew<vtkIdList> dstIds;
+  dstIds->InsertNextId(0);
+  dstIds->InsertNextId(1);
+  double weights[2] = { 0.25, 0.75 };
+
+  for (vtkDataArray* destination : destinations)
+  {
+    destination->SetNumberOfComponents(3);
+    destination->SetNumberOfTuples(4);
+    destination->InsertTuples(dstIds, srcIds, source);
+    destination->InsertTuple(2, 2, source);
+    destination->InterpolateTuple(3, srcIds, source, weights);
+  }
+
+  const double expected[4][3] = { { 30, 31, 32 }, { 10, 11, 12 }, { 20, 21, 22 },
+    { 15, 16, 17 } };
+  for (vtkDataArray* destination : destinations)
+  {
+    for (vtkIdType t = 0; t < 4; ++t)
+    {
+      for (int c = 0; c < 3; ++c)
+      {
+        if (destination->GetComponent(t, c) != expected[t][c])
+        {
+          std::cerr << "Wrong component " << c << " of the tuple " << t << " copied from a "
+                    << source->GetClassName() << " to a " << destination->GetClassName()
+                    << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestArrayDispatchSOA(int, char*[])
+{
+  bool success = true;
+
+  success &= Check(vtkTypeList::IndexOf<vtkArrayDispatch::Arrays,
+                     vtkSOADataArrayTemplate<double>>::Result >= 0 &&
+      vtkTypeList::IndexOf<vtkArrayDispatch::Arrays, vtkSOADataArrayTemplate<float>>::Result >= 0,
+    "The real struct-of-arrays arrays are not in the dispatch list");
+
+  vtkNew<vtkDoubleArray> aosDouble;
+  FillArray(aosDouble.GetPointer(), 4);
+  vtkNew<vtkSOADataArrayTemplate<double>> soaDouble;
+  FillArray(soaDouble.GetPointer(), 4);
+  vtkNew<vtkSOADataArrayTemplate<float>> soaFloat;
+  FillArray(soaFloat.GetPointer(), 4);
+
+  TypeWorker<vtkSOADataArrayTemplate<double>, vtkAOSDataArrayTemplate<double>> mixedWorker;
+  success &= Check(vtkArrayDispatch::Dispatch2SameValueType::Execute(
+                     soaDouble.GetPointer(), aosDouble.GetPointer(), mixedWorker) &&
+      mixedWorker.Matched,
+    "Mixed double arrays not dispatched");
+  TypeWorker<vtkSOADataArrayTemplate<float>, vtkSOADataArrayTemplate<double>> soaWorker;
+  success &= Check(vtkArrayDispatch::Dispatch2::Execute(
+                     soaFloat.GetPointer(), soaDouble.GetPointer(), soaWorker) &&
+      soaWorker.Matched,
+    "Struct-of-arrays arrays not dispatched");
+
+  success &= CheckMixedCopies<double>(soaDouble);
+  success &= CheckMixedCopies<double>(aosDouble);
+  success &= CheckMixedCopies<float>(soaFloat);
+
+  double range[2];
+  soaDouble->GetRange(range, 2);
+  success &= Check(range[0] == 2 && range[1] == 32, "Wrong range of a struct-of-arrays array");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
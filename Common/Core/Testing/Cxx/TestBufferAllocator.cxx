@@ -0,0 +1,116 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBufferAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the alignment of the buffers allocated with each combination of
+// vtkBufferAllocator flags, and that arrays keep their values when they grow
+// and shrink.
+
+#include "vtkBuffer.h"
+#include "vtkBufferAllocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+bool Check(bool condition, const char* message, int flags)
+{
+  if (!condition)
+  {
+    std::cerr << message << " with the flags " << flags << std::endl;
+  }
+  return condition;
+}
+
+bool IsAligned(const void* pointer, size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+// Fills an array by insertion, so that it is reallocated, then shrinks it.
+bool CheckGrowth(vtkDataArray* array, int flags)
+{
+  const vtkIdType numValues = 1000000;
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    array->InsertNextTuple1(static_cast<double>(i));
+  }
+  array->Resize(numValues / 2);
+  bool success = true;
+  for (vtkIdType i = 0; i < numValues / 2 && success; ++i)
+  {
+    success = array->GetComponent(i, 0) == static_cast<double>(i);
+  }
+  return Check(success, "Values lost by a reallocation", flags);
+}
+}
+
+int TestBufferAllocator(int, char*[])
+{
+  bool success = true;
+  const int allFlags =
+    vtkBufferAllocator::ALIGNED | vtkBufferAllocator::HUGE_PAGES | vtkBufferAllocator::FIRST_TOUCH;
+  const vtkIdType largeSize =
+    static_cast<vtkIdType>(vtkBufferAllocator::GetLargeBufferSize() / sizeof(double)) + 17;
+
+  for (int flags = 0; flags <= allFlags; ++flags)
+  {
+    vtkNew<vtkBuffer<double>> buffer;
+    buffer->SetAllocationFlags(flags);
+
+    success &= Check(buffer->Allocate(3), "Allocation failed", flags);
+    if (flags & vtkBufferAllocator::ALIGNED)
+    {
+      success &= Check(IsAligned(buffer->GetBuffer(), vtkBufferAllocator::GetAlignment()),
+        "Small buffer not aligned", flags);
+    }
+
+    success &= Check(buffer->Reallocate(largeSize), "Reallocation failed", flags);
+    buffer->GetBuffer()[largeSize - 1] = 1.0;
+    if (flags & vtkBufferAllocator::HUGE_PAGES)
+    {
+      success &= Check(IsAligned(buffer->GetBuffer(), vtkBufferAllocator::GetLargeBufferSize()),
+        "Large buffer not aligned on a huge page", flags);
+    }
+    else if (flags & vtkBufferAllocator::ALIGNED)
+    {
+      success &= Check(IsAligned(buffer->GetBuffer(), vtkBufferAllocator::GetAlignment()),
+        "Large buffer not aligned", flags);
+    }
+
+    // The arrays created with default flags.
+    vtkBufferAllocator::SetDefaultFlags(flags);
+    vtkNew<vtkDoubleArray> aosArray;
+    success &= CheckGrowth(aosArray, flags);
+    if (flags & vtkBufferAllocator::ALIGNED)
+    {
+      success &= Check(IsAligned(aosArray->GetPointer(0), vtkBufferAllocator::GetAlignment()),
+        "Array not aligned", flags);
+    }
+    vtkNew<vtkSOADataArrayTemplate<double>> soaArray;
+    soaArray->SetNumberOfComponents(1);
+    success &= CheckGrowth(soaArray, flags);
+    vtkBufferAllocator::SetDefaultFlags(0);
+  }
+
+  vtkBufferAllocator::SetDefaultFlags(~0);
+  success &= Check(vtkBufferAllocator::GetDefaultFlags() == allFlags, "Unknown flags kept", ~0);
+  vtkBufferAllocator::SetDefaultFlags(0);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
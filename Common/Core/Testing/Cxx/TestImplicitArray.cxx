@@ -0,0 +1,239 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the values of the implicit arrays through the vtkDataArray API,
+// vtk::DataArrayValueRange and vtkArrayDispatch, and that they are copied into
+// regular arrays.
+
+#include "vtkAffineArray.h"
+#include "vtkArrayDispatch.h"
+#include "vtkConstantArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIndexedArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredPointArray.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    std::cerr << message << std::endl;
+  }
+  return condition;
+}
+
+// Compares the values of an implicit array to the ones of expected, through
+// the virtual API and the value and tuple ranges.
+template <typename ArrayT>
+bool CheckValues(ArrayT* array, vtkDataArray* expected, const char* name)
+{
+  if (array->GetNumberOfComponents() != expected->GetNumberOfComponents() ||
+    array->GetNumberOfTuples() != expected->GetNumberOfTuples())
+  {
+    std::cerr << "Wrong shape for the " << name << " array" << std::endl;
+    return false;
+  }
+
+  vtkDataArray* virtualArray = array;
+  const auto values = vtk::DataArrayValueRange(array);
+  const auto expectedValues = vtk::DataArrayValueRange(expected);
+  vtkIdType valueIdx = 0;
+  for (const auto value : values)
+  {
+    if (value != expectedValues[valueIdx] || array->GetValue(valueIdx) != value)
+    {
+      std::cerr << "Wrong value " << valueIdx << " for the " << name << " array" << std::endl;
+      return false;
+    }
+    ++valueIdx;
+  }
+
+  const auto tuples = vtk::DataArrayTupleRange(array);
+  for (vtkIdType tupleIdx = 0; tupleIdx < array->GetNumberOfTuples(); ++tupleIdx)
+  {
+    for (int comp = 0; comp < array->GetNumberOfComponents(); ++comp)
+    {
+      if (virtualArray->GetComponent(tupleIdx, comp) != expected->GetComponent(tupleIdx, comp) ||
+        tuples[tupleIdx][comp] != array->GetTypedComponent(tupleIdx, comp))
+      {
+        std::cerr << "Wrong tuple " << tupleIdx << " for the " << name << " array" << std::endl;
+        return false;
+      }
+    }
+  }
+
+  double range[2], expectedRange[2];
+  virtualArray->GetRange(range, -1);
+  expected->GetRange(expectedRange, -1);
+  return Check(range[0] == expectedRange[0] && range[1] == expectedRange[1], "Wrong range");
+}
+
+// Sums the values of the arrays, whatever their type.
+struct SumWorker
+{
+  double Sum = 0.0;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    const auto values = vtk::DataArrayValueRange(array);
+    this->Sum = std::accumulate(values.cbegin(), values.cend(), 0.0);
+  }
+};
+}
+
+int TestImplicitArray(int, char*[])
+{
+  bool success = true;
+
+  // A constant array, as the cell data of a uniform field.
+  vtkNew<vtkConstantArray<int>> constant;
+  constant->ConstructBackend(42);
+  constant->SetNumberOfComponents(2);
+  constant->SetNumberOfTuples(1000);
+  vtkNew<vtkIntArray> expectedConstant;
+  expectedConstant->SetNumberOfComponents(2);
+  expectedConstant->SetNumberOfTuples(1000);
+  expectedConstant->Fill(42);
+  success &= CheckValues(constant.GetPointer(), expectedConstant, "constant");
+
+  // An affine array, as the ids of vtkIdFilter.
+  vtkNew<vtkAffineArray<vtkIdType>> ids;
+  ids->SetNumberOfTuples(1000);
+  vtkNew<vtkIdTypeArray> expectedIds;
+  expectedIds->SetNumberOfTuples(1000);
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    expectedIds->SetValue(i, i);
+  }
+  success &= CheckValues(ids.GetPointer(), expectedIds, "affine");
+  success &= Check(ids->GetActualMemorySize() <= 1, "An implicit array should take no memory");
+
+  vtkNew<vtkAffineArray<double>> ramp;
+  ramp->ConstructBackend(-0.5, 3.0);
+  ramp->SetNumberOfTuples(5);
+  success &= Check(ramp->GetValue(4) == 1.0, "Wrong value for the ramp");
+
+  // The points of an image with a rotated direction.
+  const int extent[6] = { -1, 3, 2, 4, 0, 5 };
+  const double origin[3] = { 1.0, -2.0, 0.5 };
+  const double spacing[3] = { 0.5, 2.0, 0.25 };
+  const double direction[9] = { 0.0, -1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0 };
+  vtkNew<vtkStructuredPointArray<double>> coordinates;
+  coordinates->ConstructBackend(extent, origin, spacing, direction);
+  coordinates->SetNumberOfComponents(3);
+  coordinates->SetNumberOfTuples(5 * 3 * 6);
+  vtkNew<vtkDoubleArray> expectedCoordinates;
+  expectedCoordinates->SetNumberOfComponents(3);
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        const double ijk[3] = { i * spacing[0], j * spacing[1], k * spacing[2] };
+        double point[3];
+        for (int comp = 0; comp < 3; ++comp)
+        {
+          point[comp] = origin[comp] + direction[3 * comp] * ijk[0] +
+            direction[3 * comp + 1] * ijk[1] + direction[3 * comp + 2] * ijk[2];
+        }
+        expectedCoordinates->InsertNextTuple(point);
+      }
+    }
+  }
+  success &= CheckValues(coordinates.GetPointer(), expectedCoordinates, "structured point");
+
+  // A view of some tuples of an array, of the same value type or not.
+  vtkNew<vtkDoubleArray> source;
+  source->SetNumberOfComponents(2);
+  for (int i = 0; i < 50; ++i)
+  {
+    source->InsertNextTuple2(i, -2.0 * i);
+  }
+  vtkNew<vtkIdList> indices;
+  vtkNew<vtkDoubleArray> expectedView;
+  expectedView->SetNumberOfComponents(2);
+  for (vtkIdType i = 0; i < 30; ++i)
+  {
+    indices->InsertNextId((7 * i) % 50);
+    expectedView->InsertNextTuple(source->GetTuple((7 * i) % 50));
+  }
+  vtkNew<vtkIndexedArray<double>> view;
+  view->ConstructBackend(indices.GetPointer(), source.GetPointer());
+  view->SetNumberOfComponents(2);
+  view->SetNumberOfTuples(30);
+  success &= CheckValues(view.GetPointer(), expectedView, "indexed");
+  vtkNew<vtkIndexedArray<int>> intView;
+  intView->ConstructBackend(indices.GetPointer(), source.GetPointer());
+  intView->SetNumberOfComponents(2);
+  intView->SetNumberOfTuples(30);
+  success &= CheckValues(intView.GetPointer(), expectedView, "converting indexed");
+
+  // Dispatch, with the implicit arrays in the list or the fallback.
+  typedef vtkTypeList::Create<vtkConstantArray<int>, vtkAffineArray<vtkIdType>,
+    vtkStructuredPointArray<double>, vtkIndexedArray<double>>
+    ImplicitArrays;
+  vtkDataArray* arrays[4] = { constant, ids, coordinates, view };
+  vtkDataArray* expectedArrays[4] = { expectedConstant, expectedIds, expectedCoordinates,
+    expectedView };
+  for (int i = 0; i < 4; ++i)
+  {
+    SumWorker worker, expectedWorker;
+    success &= Check(vtkArrayDispatch::DispatchByArray<ImplicitArrays>::Execute(arrays[i], worker),
+      "Dispatch failed");
+    if (!vtkArrayDispatch::Dispatch::Execute(expectedArrays[i], expectedWorker))
+    {
+      expectedWorker(expectedArrays[i]);
+    }
+    success &= Check(worker.Sum == expectedWorker.Sum, "Wrong sum of a dispatched array");
+  }
+
+  // Copies are regular arrays, except between implicit arrays.
+  vtkSmartPointer<vtkAOSDataArrayTemplate<vtkIdType>> copy =
+    vtkSmartPointer<vtkAOSDataArrayTemplate<vtkIdType>>::Take(ids->NewInstance());
+  if (!Check(copy != nullptr, "NewInstance is not an AoS array"))
+  {
+    return EXIT_FAILURE;
+  }
+  copy->DeepCopy(ids);
+  success &= CheckValues(copy.GetPointer(), expectedIds, "copied");
+  vtkNew<vtkStructuredPointArray<double>> implicitCopy;
+  implicitCopy->DeepCopy(coordinates);
+  success &= CheckValues(implicitCopy.GetPointer(), expectedCoordinates, "implicit copy");
+  vtkNew<vtkStructuredPointArray<double>> shallowCopy;
+  shallowCopy->ShallowCopy(coordinates);
+  success &= Check(shallowCopy->GetBackend() == coordinates->GetBackend(), "Backend not shared");
+
+  // Materialization of the values.
+  std::vector<double> buffer(coordinates->GetNumberOfValues());
+  coordinates->ExportToVoidPointer(buffer.data());
+  success &= Check(std::equal(buffer.begin(), buffer.end(), expectedCoordinates->GetPointer(0)),
+    "Wrong exported values");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -15,10 +15,15 @@
 #include "vtkNew.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMP.h"
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include <algorithm>
+#include <atomic>
 #include <functional>
+#include <string>
+#include <thread>
 #include <vector>
 
 static const int Target = 10000;
@@ -84,10 +89,8 @@ bool myComp(double a, double b)
   return (a < b);
 }
 
-int TestSMP(int, char*[])
+int doTestSMP()
 {
-  // vtkSMPTools::Initialize(8);
-
   ARangeFunctor functor1;
 
   vtkSMPTools::For(0, Target, functor1);
@@ -157,5 +160,199 @@ int TestSMP(int, char*[])
     }
   }
 
+  // Test the algorithms on enough values to use several blocks
+  const vtkIdType size = 100003;
+  std::vector<vtkIdType> values(size);
+  vtkSMPTools::Fill(values.begin(), values.end(), 3);
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    if (values[i] != 3)
+    {
+      cerr << "Error: Bad fill!" << endl;
+      return 1;
+    }
+  }
+
+  vtkSMPTools::Transform(values.begin(), values.end(), values.begin(),
+    [](vtkIdType v) { return v * 2; });
+  std::vector<vtkIdType> indices(size);
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    indices[i] = i;
+  }
+  std::vector<vtkIdType> sums(size);
+  vtkSMPTools::Transform(values.begin(), values.end(), indices.begin(), sums.begin(),
+    [](vtkIdType v, vtkIdType i) { return v + i; });
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    if (values[i] != 6 || sums[i] != 6 + i)
+    {
+      cerr << "Error: Bad transform!" << endl;
+      return 1;
+    }
+  }
+
+  if (vtkSMPTools::Reduce(indices.begin(), indices.end(), vtkIdType(7)) !=
+    7 + size * (size - 1) / 2)
+  {
+    cerr << "Error: Bad reduce!" << endl;
+    return 1;
+  }
+  vtkIdType maximum = vtkSMPTools::TransformReduce(indices.begin(), indices.end(), vtkIdType(0),
+    [](vtkIdType a, vtkIdType b) { return std::max(a, b); },
+    [](vtkIdType i) { return (i * 7919) % size; });
+  if (maximum != size - 1)
+  {
+    cerr << "Error: Bad transform reduce!" << endl;
+    return 1;
+  }
+
+  std::vector<vtkIdType> scan(size);
+  if (vtkSMPTools::ExclusiveScan(indices.begin(), indices.end(), scan.begin(), vtkIdType(5)) !=
+    scan.end())
+  {
+    cerr << "Error: Bad exclusive scan end!" << endl;
+    return 1;
+  }
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    if (scan[i] != 5 + i * (i - 1) / 2)
+    {
+      cerr << "Error: Bad exclusive scan!" << endl;
+      return 1;
+    }
+  }
+  // In place
+  vtkSMPTools::InclusiveScan(sums.begin(), sums.end(), sums.begin());
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    if (sums[i] != 6 * (i + 1) + i * (i + 1) / 2)
+    {
+      cerr << "Error: Bad inclusive scan!" << endl;
+      return 1;
+    }
+  }
+
+  std::vector<vtkIdType> selected(size);
+  auto selectedEnd = vtkSMPTools::CopyIf(
+    indices.begin(), indices.end(), selected.begin(), [](vtkIdType i) { return i % 3 == 1; });
+  if (selectedEnd - selected.begin() != size / 3)
+  {
+    cerr << "Error: Bad copy if size!" << endl;
+    return 1;
+  }
+  for (vtkIdType i = 0; i < size / 3; ++i)
+  {
+    if (selected[i] != 3 * i + 1)
+    {
+      cerr << "Error: Bad copy if!" << endl;
+      return 1;
+    }
+  }
+
+  // Test nested parallelism and local scopes
+  if (vtkSMPTools::IsParallelScope() || vtkSMPTools::GetNestedParallelism())
+  {
+    cerr << "Error: Bad default parallel scope!" << endl;
+    return 1;
+  }
+  for (int nested = 0; nested < 2; ++nested)
+  {
+    std::atomic<int> inScope(0);
+    std::atomic<int> otherThread(0);
+    std::atomic<vtkIdType> count(0);
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ nested != 0 }, [&]() {
+      vtkSMPTools::For(0, 16, 1, [&](vtkIdType begin, vtkIdType end) {
+        const std::thread::id outerThread = std::this_thread::get_id();
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          inScope += vtkSMPTools::IsParallelScope() ? 1 : 0;
+          vtkSMPTools::For(0, 1000, 10, [&](vtkIdType b, vtkIdType e) {
+            otherThread += std::this_thread::get_id() != outerThread ? 1 : 0;
+            count += e - b;
+          });
+        }
+      });
+    });
+    if (inScope != 16 || count != 16000)
+    {
+      cerr << "Error: Bad nested for!" << endl;
+      return 1;
+    }
+    if (!nested && otherThread != 0)
+    {
+      cerr << "Error: Nested for did not run sequentially!" << endl;
+      return 1;
+    }
+  }
+  if (vtkSMPTools::GetNestedParallelism())
+  {
+    cerr << "Error: Nested parallelism not restored!" << endl;
+    return 1;
+  }
+
+  const int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  int scopeThreads = 0;
+  std::atomic<int> scopeOtherThread(0);
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() {
+    scopeThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+    const std::thread::id thread = std::this_thread::get_id();
+    vtkSMPTools::For(0, 1000, 10, [&](vtkIdType, vtkIdType) {
+      scopeOtherThread += std::this_thread::get_id() != thread ? 1 : 0;
+    });
+  });
+  if (scopeThreads != 1 || scopeOtherThread != 0)
+  {
+    cerr << "Error: Local scope used more than one thread!" << endl;
+    return 1;
+  }
+  if (vtkSMPTools::GetEstimatedNumberOfThreads() != numThreads)
+  {
+    cerr << "Error: Number of threads not restored!" << endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+int TestSMP(int, char*[])
+{
+  std::vector<std::string> backends;
+  backends.push_back("Sequential");
+#if VTK_SMP_ENABLE_STDTHREAD
+  backends.push_back("STDThread");
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+  backends.push_back("OpenMP");
+#endif
+#if VTK_SMP_ENABLE_TBB
+  backends.push_back("TBB");
+#endif
+  if (vtkSMPTools::GetAvailableBackends() != backends)
+  {
+    cerr << "Error: wrong list of available backends" << endl;
+    return 1;
+  }
+
+  for (const std::string& backend : backends)
+  {
+    if (!vtkSMPTools::SetBackend(backend.c_str()) || backend != vtkSMPTools::GetBackend())
+    {
+      cerr << "Error: could not select the " << backend << " backend" << endl;
+      return 1;
+    }
+    cout << "Testing SMP backend " << vtkSMPTools::GetBackend() << endl;
+    if (doTestSMP() != 0)
+    {
+      return 1;
+    }
+  }
+
+  if (vtkSMPTools::SetBackend("NotABackend"))
+  {
+    cerr << "Error: an unknown backend was accepted" << endl;
+    return 1;
+  }
+
   return 0;
 }
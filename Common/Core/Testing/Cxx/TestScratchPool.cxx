@@ -0,0 +1,124 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestScratchPool.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkScratchPool reuses the released objects of a thread, keeps
+// at most GetMaximumSize() of them, and can be used concurrently with every
+// SMP backend.
+
+#include "vtkIdList.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSMPTools.h"
+#include "vtkScratchPool.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    std::cerr << message << std::endl;
+  }
+  return condition;
+}
+
+using vtkIdListPool = vtkScratchPool<vtkIdList>;
+
+// Fills scratch lists for each index, and counts the lists which do not hold
+// the values of their index.
+struct FillWorker
+{
+  std::atomic<int>* Errors;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      auto ids = vtkIdListPool::Acquire();
+      ids->Reset();
+      for (vtkIdType j = 0; j < i % 50; ++j)
+      {
+        ids->InsertNextId(i + j);
+      }
+      for (vtkIdType j = 0; j < ids->GetNumberOfIds(); ++j)
+      {
+        if (ids->GetId(j) != i + j)
+        {
+          ++*this->Errors;
+        }
+      }
+    }
+  }
+};
+}
+
+int TestScratchPool(int, char*[])
+{
+  bool success = true;
+  vtkIdListPool::Clear();
+
+  // The objects released are acquired again, with their memory.
+  vtkIdList* first;
+  {
+    auto ids = vtkIdListPool::Acquire();
+    first = ids;
+    ids->SetNumberOfIds(1000);
+  }
+  success &= Check(vtkIdListPool::GetNumberOfIdleObjects() == 1, "Object not released");
+  {
+    auto ids = vtkIdListPool::Acquire();
+    success &= Check(ids.Get() == first && ids->GetNumberOfIds() == 1000, "Object not reused");
+    success &= Check(vtkIdListPool::GetNumberOfIdleObjects() == 0, "Object acquired twice");
+
+    // Handles are moved, and released once.
+    vtkScratchPool<vtkIdList>::Handle moved(std::move(ids));
+    success &= Check(!ids.Get() && moved.Get() == first, "Handle not moved");
+    moved.Reset();
+    success &= Check(vtkIdListPool::GetNumberOfIdleObjects() == 1, "Moved object not released");
+  }
+  success &= Check(vtkIdListPool::GetNumberOfIdleObjects() == 1, "Object released twice");
+
+  // A thread keeps a limited number of idle objects.
+  {
+    std::vector<vtkIdListPool::Handle> handles;
+    for (size_t i = 0; i < 2 * vtkIdListPool::GetMaximumSize(); ++i)
+    {
+      handles.push_back(vtkIdListPool::Acquire());
+    }
+  }
+  success &= Check(vtkIdListPool::GetNumberOfIdleObjects() == vtkIdListPool::GetMaximumSize(),
+    "Too many idle objects");
+  vtkIdListPool::Clear();
+  success &= Check(vtkIdListPool::GetNumberOfIdleObjects() == 0, "Idle objects not cleared");
+
+  // Concurrent use, with each backend.
+  vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+    std::atomic<int> errors(0);
+    FillWorker worker = { &errors };
+    vtkSMPTools::For(0, 10000, 100, worker);
+    if (errors)
+    {
+      std::cerr << "Wrong scratch lists with the " << backend << " backend" << std::endl;
+      success = false;
+    }
+  });
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,69 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAffineArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAffineArray
+ * @brief   An implicit array whose values are an affine function of their
+ * index.
+ *
+ *
+ * vtkAffineArray<ValueType> is the vtkImplicitArray using
+ * vtkAffineImplicitBackend<ValueType>, whose value at index valueIdx (in AOS
+ * ordering) is Slope * valueIdx + Intercept. For instance, the ids 0, 1, 2...
+ * of the points of a dataset are:
+ *
+ * \code{.cpp}
+ * vtkNew<vtkAffineArray<vtkIdType>> ids;
+ * ids->ConstructBackend(1, 0);
+ * ids->SetNumberOfTuples(numberOfPoints);
+ * \endcode
+ *
+ * @sa
+ * vtkImplicitArray
+ */
+
+#ifndef vtkAffineArray_h
+#define vtkAffineArray_h
+
+#include "vtkImplicitArray.h"
+
+template <typename ValueType>
+struct vtkAffineImplicitBackend
+{
+  vtkAffineImplicitBackend()
+    : Slope(1)
+    , Intercept(0)
+  {
+  }
+  vtkAffineImplicitBackend(ValueType slope, ValueType intercept)
+    : Slope(slope)
+    , Intercept(intercept)
+  {
+  }
+
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    return static_cast<ValueType>(this->Slope * valueIdx + this->Intercept);
+  }
+
+  ValueType Slope;
+  ValueType Intercept;
+};
+
+template <typename ValueType>
+using vtkAffineArray = vtkImplicitArray<vtkAffineImplicitBackend<ValueType>>;
+
+#endif // header guard
+
+// VTK-HeaderTest-Exclude: vtkAffineArray.h
@@ -20,11 +20,15 @@
  * vtkBuffer makes it easier to keep data pointers in vtkDataArray subclasses.
  * This is an internal class and not intended for direct use expect when writing
  * new types of vtkDataArray subclasses.
+ *
+ * The memory is allocated with the functions of vtkBufferAllocator for its
+ * default flags, or with memkind when extended memory is in use.
  */
 
 #ifndef vtkBuffer_h
 #define vtkBuffer_h
 
+#include "vtkBufferAllocator.h" // For the allocation functions
 #include "vtkObject.h"
 #include "vtkObjectFactory.h" // New() implementation
 
@@ -71,6 +75,13 @@ public:
    **/
   void SetFreeFunction(bool noFreeFunction, vtkFreeingFunction deleteFunction = free);
 
+  /**
+   * Use the allocation functions of vtkBufferAllocator for @a flags, a
+   * combination of vtkBufferAllocator::AllocationFlags. The current buffer is
+   * released: call it before allocating.
+   */
+  void SetAllocationFlags(int flags);
+
   /**
    * Return the number of elements the current buffer can hold.
    */
@@ -92,9 +103,16 @@ protected:
     : Pointer(nullptr)
     , Size(0)
   {
-    this->SetMallocFunction(vtkObjectBase::GetCurrentMallocFunction());
-    this->SetReallocFunction(vtkObjectBase::GetCurrentReallocFunction());
-    this->SetFreeFunction(false, vtkObjectBase::GetCurrentFreeFunction());
+    if (vtkObjectBase::GetUsingMemkind())
+    {
+      this->SetMallocFunction(vtkObjectBase::GetCurrentMallocFunction());
+      this->SetReallocFunction(vtkObjectBase::GetCurrentReallocFunction());
+      this->SetFreeFunction(false, vtkObjectBase::GetCurrentFreeFunction());
+    }
+    else
+    {
+      this->SetAllocationFlags(vtkBufferAllocator::GetDefaultFlags());
+    }
   }
 
   ~vtkBuffer() override { this->SetBuffer(nullptr, 0); }
@@ -164,6 +182,16 @@ void vtkBuffer<ScalarT>::SetFreeFunction(bool noFreeFunction, vtkFreeingFunction
   }
 }
 
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+void vtkBuffer<ScalarT>::SetAllocationFlags(int flags)
+{
+  this->SetBuffer(nullptr, 0);
+  this->SetMallocFunction(vtkBufferAllocator::GetMallocFunction(flags));
+  this->SetReallocFunction(vtkBufferAllocator::GetReallocFunction(flags));
+  this->SetFreeFunction(false, vtkBufferAllocator::GetFreeFunction(flags));
+}
+
 //------------------------------------------------------------------------------
 template <typename ScalarT>
 bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
@@ -199,12 +227,14 @@ bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
 template <typename ScalarT>
 bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
 {
-  if (newsize == 0)
+  if (newsize == 0 || !this->Pointer)
   {
-    return this->Allocate(0);
+    // Nothing to preserve: allocate with the malloc function, which may align
+    // the buffer unlike realloc.
+    return this->Allocate(newsize);
   }
 
-  if (this->Pointer && this->DeleteFunction != free)
+  if (this->DeleteFunction != free)
   {
     ScalarType* newArray;
     if (this->MallocFunction)
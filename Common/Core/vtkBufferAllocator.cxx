@@ -0,0 +1,157 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBufferAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBufferAllocator.h"
+
+#include "vtkSMPTools.h"
+
+#include <atomic>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <malloc.h> // For _aligned_malloc
+#else
+#include <sys/mman.h> // For madvise
+#endif
+
+namespace
+{
+std::atomic<int> DefaultFlags(0);
+
+const int AllFlags =
+  vtkBufferAllocator::ALIGNED | vtkBufferAllocator::HUGE_PAGES | vtkBufferAllocator::FIRST_TOUCH;
+const size_t Alignment = 64;
+const size_t LargeBufferSize = 2 << 20;
+const size_t PageSize = 4096;
+
+void* AlignedMalloc(size_t size, size_t alignment)
+{
+#ifdef _WIN32
+  return _aligned_malloc(size, alignment);
+#else
+  void* buffer = nullptr;
+  return posix_memalign(&buffer, alignment, size) == 0 ? buffer : nullptr;
+#endif
+}
+
+void AlignedFree(void* buffer)
+{
+#ifdef _WIN32
+  _aligned_free(buffer);
+#else
+  free(buffer);
+#endif
+}
+
+// All the buffers allocated with flags are released by AlignedFree, even
+// the ones which are not aligned beyond malloc.
+template <int Flags>
+void* Malloc(size_t size)
+{
+  const bool large = size >= LargeBufferSize;
+  const bool hugePages = (Flags & vtkBufferAllocator::HUGE_PAGES) && large;
+  size_t alignment = (Flags & vtkBufferAllocator::ALIGNED) ? Alignment : 2 * sizeof(void*);
+  if (hugePages)
+  {
+    alignment = LargeBufferSize;
+  }
+
+  void* buffer = AlignedMalloc(size, alignment);
+  if (!buffer)
+  {
+    return nullptr;
+  }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // Transparent huge pages may be disabled, or only enabled on request.
+  if (hugePages)
+  {
+    madvise(buffer, size, MADV_HUGEPAGE);
+  }
+#endif
+
+  if ((Flags & vtkBufferAllocator::FIRST_TOUCH) && large)
+  {
+    vtkBufferAllocator::FirstTouch(buffer, size);
+  }
+  return buffer;
+}
+
+const vtkMallocingFunction MallocFunctions[AllFlags + 1] = { malloc, Malloc<1>, Malloc<2>,
+  Malloc<3>, Malloc<4>, Malloc<5>, Malloc<6>, Malloc<7> };
+}
+
+//------------------------------------------------------------------------------
+void vtkBufferAllocator::SetDefaultFlags(int flags)
+{
+  DefaultFlags = flags & AllFlags;
+}
+
+//------------------------------------------------------------------------------
+int vtkBufferAllocator::GetDefaultFlags()
+{
+  return DefaultFlags;
+}
+
+//------------------------------------------------------------------------------
+vtkMallocingFunction vtkBufferAllocator::GetMallocFunction(int flags)
+{
+  return MallocFunctions[flags & AllFlags];
+}
+
+//------------------------------------------------------------------------------
+vtkReallocingFunction vtkBufferAllocator::GetReallocFunction(int flags)
+{
+  return (flags & AllFlags) ? nullptr : realloc;
+}
+
+//------------------------------------------------------------------------------
+vtkFreeingFunction vtkBufferAllocator::GetFreeFunction(int flags)
+{
+  return (flags & AllFlags) ? AlignedFree : free;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkBufferAllocator::GetAlignment()
+{
+  return Alignment;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkBufferAllocator::GetLargeBufferSize()
+{
+  return LargeBufferSize;
+}
+
+//------------------------------------------------------------------------------
+void vtkBufferAllocator::FirstTouch(void* buffer, size_t size)
+{
+  if (!buffer || size == 0)
+  {
+    return;
+  }
+  char* bytes = static_cast<char*>(buffer);
+  const vtkIdType numPages = static_cast<vtkIdType>((size + PageSize - 1) / PageSize);
+  vtkSMPTools::For(0, numPages, [bytes, size, numPages](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType page = begin; page < end; ++page)
+    {
+      bytes[page * PageSize] = 0;
+    }
+    // The buffer may end on one more page than it has page sizes.
+    if (end == numPages)
+    {
+      bytes[size - 1] = 0;
+    }
+  });
+}
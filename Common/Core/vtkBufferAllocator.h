@@ -0,0 +1,109 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBufferAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkBufferAllocator
+ * @brief   allocation functions for the memory of vtkBuffer
+ *
+ * vtkBufferAllocator provides the malloc, realloc and free functions that
+ * vtkBuffer, hence vtkAOSDataArrayTemplate and vtkSOADataArrayTemplate, use
+ * for a combination of allocation flags:
+ *
+ * - ALIGNED aligns the buffers on GetAlignment() bytes, for SIMD loads.
+ * - HUGE_PAGES backs the large buffers with 2 MiB pages, which reduces the
+ *   TLB misses of the loops over them. On Linux, they are aligned on 2 MiB
+ *   and advised to use transparent huge pages (MADV_HUGEPAGE). Elsewhere, they
+ *   are aligned only.
+ * - FIRST_TOUCH touches the pages of the large buffers in parallel with
+ *   vtkSMPTools when they are allocated. On NUMA systems, a page is placed on
+ *   the node of the thread that first touches it: the pages are spread over
+ *   the nodes of the threads which later process them with vtkSMPTools,
+ *   instead of all landing on the node of the allocating thread. The
+ *   placement matches best with backends partitioning the ranges statically,
+ *   as the OpenMP backend does.
+ *
+ * New buffers use the default flags, SetDefaultFlags(), unless they are
+ * allocated in extended memory (see vtkObjectBase::SetMemkindDirectory()).
+ * With no flags, the default, buffers use malloc, realloc and free.
+ *
+ * \code{.cpp}
+ * // Align all the new arrays, and spread the large ones over NUMA nodes.
+ * vtkBufferAllocator::SetDefaultFlags(
+ *   vtkBufferAllocator::ALIGNED | vtkBufferAllocator::FIRST_TOUCH);
+ * \endcode
+ *
+ * @sa
+ * vtkBuffer vtkSMPTools
+ */
+
+#ifndef vtkBufferAllocator_h
+#define vtkBufferAllocator_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObjectBase.h"       // For vtkMallocingFunction
+
+#include <cstddef> // For size_t
+
+class VTKCOMMONCORE_EXPORT VTK_WRAPEXCLUDE vtkBufferAllocator
+{
+public:
+  enum AllocationFlags
+  {
+    ALIGNED = 0x1,
+    HUGE_PAGES = 0x2,
+    FIRST_TOUCH = 0x4
+  };
+
+  //@{
+  /**
+   * Set/Get the allocation flags of the buffers created from now on. The
+   * default is 0, i.e. malloc, realloc and free. Thread-safe.
+   */
+  static void SetDefaultFlags(int flags);
+  static int GetDefaultFlags();
+  //@}
+
+  //@{
+  /**
+   * Return the allocation functions for @a flags. The memory allocated by
+   * GetMallocFunction(flags) must be released by GetFreeFunction(flags).
+   * GetReallocFunction() returns nullptr when realloc cannot keep the
+   * alignment: the buffers then allocate a new block and copy their values.
+   */
+  static vtkMallocingFunction GetMallocFunction(int flags);
+  static vtkReallocingFunction GetReallocFunction(int flags);
+  static vtkFreeingFunction GetFreeFunction(int flags);
+  //@}
+
+  /**
+   * Return the alignment, in bytes, of the ALIGNED buffers: 64, the size of
+   * a cache line and of an AVX-512 register.
+   */
+  static size_t GetAlignment();
+
+  /**
+   * Return the size, in bytes, from which HUGE_PAGES and FIRST_TOUCH apply
+   * to a buffer: 2 MiB, the size of a huge page.
+   */
+  static size_t GetLargeBufferSize();
+
+  /**
+   * Write a byte of each page of [@a buffer, @a buffer + @a size) in
+   * parallel with vtkSMPTools, so that the pages are placed on the NUMA nodes
+   * of the threads.
+   */
+  static void FirstTouch(void* buffer, size_t size);
+};
+
+#endif
@@ -0,0 +1,60 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConstantArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConstantArray
+ * @brief   An implicit array whose values are all equal.
+ *
+ *
+ * vtkConstantArray<ValueType> is the vtkImplicitArray using
+ * vtkConstantImplicitBackend<ValueType>, whose every value is the same:
+ *
+ * \code{.cpp}
+ * vtkNew<vtkConstantArray<float>> ones;
+ * ones->ConstructBackend(1.0f);
+ * ones->SetNumberOfTuples(numberOfCells);
+ * \endcode
+ *
+ * @sa
+ * vtkImplicitArray
+ */
+
+#ifndef vtkConstantArray_h
+#define vtkConstantArray_h
+
+#include "vtkImplicitArray.h"
+
+template <typename ValueType>
+struct vtkConstantImplicitBackend
+{
+  vtkConstantImplicitBackend()
+    : Value()
+  {
+  }
+  explicit vtkConstantImplicitBackend(ValueType value)
+    : Value(value)
+  {
+  }
+
+  ValueType operator()(vtkIdType) const { return this->Value; }
+
+  ValueType Value;
+};
+
+template <typename ValueType>
+using vtkConstantArray = vtkImplicitArray<vtkConstantImplicitBackend<ValueType>>;
+
+#endif // header guard
+
+// VTK-HeaderTest-Exclude: vtkConstantArray.h
@@ -11,10 +11,20 @@
 # - VTK_DISPATCH_SOA_ARRAYS (default: OFF)
 #   Include vtkSOADataArrayTemplate<ValueType> for the basic types supported
 #   by VTK.
+# - VTK_DISPATCH_SOA_REAL_ARRAYS (default: ON)
+#   Include vtkSOADataArrayTemplate<ValueType> for float and double only, so
+#   that the point coordinates and fields handed over as separate component
+#   arrays (e.g. by in-situ adaptors) take the fast paths without the compile
+#   time cost of VTK_DISPATCH_SOA_ARRAYS. Ignored if VTK_DISPATCH_SOA_ARRAYS
+#   is ON.
 # - VTK_DISPATCH_TYPED_ARRAYS (default: OFF)
 #   Include vtkTypedDataArray<ValueType> for the basic types supported
 #   by VTK. This enables the old-style in-situ vtkMappedDataArray subclasses
 #   to be used.
+# - VTK_DISPATCH_IMPLICIT_ARRAYS (default: OFF)
+#   Include vtkConstantArray<ValueType>, vtkAffineArray<ValueType> and
+#   vtkIndexedArray<ValueType> for the basic types supported by VTK, and
+#   vtkStructuredPointArray<ValueType> for float and double.
 #
 # At a lower level, specific arrays can be added to the list individually in
 # two ways:
@@ -136,6 +146,21 @@ if (VTK_DISPATCH_SOA_ARRAYS)
       ${vtkArrayDispatch_all_types}
     )
   endif()
+elseif (VTK_DISPATCH_SOA_REAL_ARRAYS)
+  list(APPEND vtkArrayDispatch_containers vtkSOADataArrayTemplate)
+  set(vtkArrayDispatch_vtkSOADataArrayTemplate_header vtkSOADataArrayTemplate.h)
+  set(vtkArrayDispatch_vtkSOADataArrayTemplate_types
+    "double"
+    "float"
+  )
+  if (VTK_BUILD_SCALED_SOA_ARRAYS)
+    list(APPEND vtkArrayDispatch_containers vtkScaledSOADataArrayTemplate)
+    set(vtkArrayDispatch_vtkScaledSOADataArrayTemplate_header vtkScaledSOADataArrayTemplate.h)
+    set(vtkArrayDispatch_vtkScaledSOADataArrayTemplate_types
+      "double"
+      "float"
+    )
+  endif()
 endif()
 
 if (VTK_DISPATCH_TYPED_ARRAYS)
@@ -146,6 +171,31 @@ if (VTK_DISPATCH_TYPED_ARRAYS)
   )
 endif()
 
+if (VTK_DISPATCH_IMPLICIT_ARRAYS)
+  list(APPEND vtkArrayDispatch_containers
+    vtkConstantArray
+    vtkAffineArray
+    vtkIndexedArray
+    vtkStructuredPointArray)
+  set(vtkArrayDispatch_vtkConstantArray_header vtkConstantArray.h)
+  set(vtkArrayDispatch_vtkConstantArray_types
+    ${vtkArrayDispatch_all_types}
+  )
+  set(vtkArrayDispatch_vtkAffineArray_header vtkAffineArray.h)
+  set(vtkArrayDispatch_vtkAffineArray_types
+    ${vtkArrayDispatch_all_types}
+  )
+  set(vtkArrayDispatch_vtkIndexedArray_header vtkIndexedArray.h)
+  set(vtkArrayDispatch_vtkIndexedArray_types
+    ${vtkArrayDispatch_all_types}
+  )
+  set(vtkArrayDispatch_vtkStructuredPointArray_header vtkStructuredPointArray.h)
+  set(vtkArrayDispatch_vtkStructuredPointArray_types
+    "float"
+    "double"
+  )
+endif()
+
 endmacro()
 
 # Concatenates a list of strings into a single string, since string(CONCAT ...)
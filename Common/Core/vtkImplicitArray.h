@@ -0,0 +1,225 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImplicitArray
+ * @brief   Read-only implementation of vtkGenericDataArray computing its
+ * values on access.
+ *
+ *
+ * vtkImplicitArray stores no values: they are computed on access by a
+ * backend, a default constructible functor called with the index of a value
+ * in AOS ordering (tupleIdx * numberOfComponents + compIdx):
+ *
+ * \code{.cpp}
+ * struct SquareBackend
+ * {
+ *   double operator()(vtkIdType valueIdx) const { return valueIdx * valueIdx; }
+ * };
+ *
+ * vtkNew<vtkImplicitArray<SquareBackend>> squares;
+ * squares->SetNumberOfTuples(1000000); // allocates nothing
+ * \endcode
+ *
+ * The value type of the array is the return type of the backend. VTK provides
+ * backends for constant arrays (vtkConstantArray), affine ramps
+ * (vtkAffineArray), the point coordinates of an image (vtkStructuredPointArray)
+ * and views over the tuples of another array (vtkIndexedArray).
+ *
+ * Implicit arrays are read through the vtkDataArray API, vtkArrayDispatch and
+ * vtk::DataArrayValueRange / vtk::DataArrayTupleRange like any other
+ * vtkGenericDataArray. The provided implicit arrays are part of the default
+ * dispatch list when VTK_DISPATCH_IMPLICIT_ARRAYS is enabled.
+ *
+ * NewInstance() returns a vtkAOSDataArrayTemplate of the same value type, so
+ * that the copies the pipeline makes (CopyAllocate(), DeepCopy() of a
+ * dataset...) are regular, writable arrays.
+ *
+ * @warning
+ * The Set and Insert methods report an error, as there is no storage to
+ * modify. GetVoidPointer() computes all the values into an internal buffer at
+ * each call, as vtkSOADataArrayTemplate does.
+ *
+ * @sa
+ * vtkGenericDataArray vtkConstantArray vtkAffineArray vtkStructuredPointArray
+ * vtkIndexedArray
+ */
+
+#ifndef vtkImplicitArray_h
+#define vtkImplicitArray_h
+
+#include "vtkAOSDataArrayTemplate.h" // For NewInstance
+#include "vtkBuffer.h"                // For AoSCopy
+#include "vtkGenericDataArray.h"
+
+#include <memory>      // For std::shared_ptr
+#include <type_traits> // For std::decay
+#include <typeinfo>    // For typeid
+#include <utility>     // For std::declval
+
+namespace vtk
+{
+namespace detail
+{
+// The value type of the arrays using BackendT.
+template <class BackendT>
+struct ImplicitArrayValueType
+{
+  typedef typename std::decay<decltype(
+    std::declval<const BackendT&>()(std::declval<vtkIdType>()))>::type type;
+};
+} // namespace detail
+} // namespace vtk
+
+template <class BackendT>
+class vtkImplicitArray
+  : public vtkGenericDataArray<vtkImplicitArray<BackendT>,
+      typename vtk::detail::ImplicitArrayValueType<BackendT>::type>
+{
+  typedef typename vtk::detail::ImplicitArrayValueType<BackendT>::type ValueTypeT;
+  typedef vtkGenericDataArray<vtkImplicitArray<BackendT>, ValueTypeT> GenericDataArrayType;
+
+public:
+  typedef vtkImplicitArray<BackendT> SelfType;
+  // NewInstance() returns a regular array, see NewInstanceInternal().
+  vtkAbstractTypeMacroWithNewInstanceType(SelfType, GenericDataArrayType,
+    vtkAOSDataArrayTemplate<ValueTypeT>, typeid(SelfType).name());
+  typedef typename Superclass::ValueType ValueType;
+  typedef BackendT BackendType;
+
+  static vtkImplicitArray* New();
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Get the value at @a valueIdx. @a valueIdx assumes AOS ordering.
+   */
+  inline ValueType GetValue(vtkIdType valueIdx) const { return (*this->Backend)(valueIdx); }
+
+  /**
+   * Not supported, implicit arrays are read-only.
+   */
+  void SetValue(vtkIdType valueIdx, ValueType value);
+
+  /**
+   * Copy the tuple at @a tupleIdx into @a tuple.
+   */
+  inline void GetTypedTuple(vtkIdType tupleIdx, ValueType* tuple) const
+  {
+    const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
+    for (int cc = 0; cc < this->NumberOfComponents; ++cc)
+    {
+      tuple[cc] = (*this->Backend)(valueIdx + cc);
+    }
+  }
+
+  /**
+   * Not supported, implicit arrays are read-only.
+   */
+  void SetTypedTuple(vtkIdType tupleIdx, const ValueType* tuple);
+
+  /**
+   * Get component @a compIdx of the tuple at @a tupleIdx.
+   */
+  inline ValueType GetTypedComponent(vtkIdType tupleIdx, int compIdx) const
+  {
+    return (*this->Backend)(tupleIdx * this->NumberOfComponents + compIdx);
+  }
+
+  /**
+   * Not supported, implicit arrays are read-only.
+   */
+  void SetTypedComponent(vtkIdType tupleIdx, int compIdx, ValueType value);
+
+  //@{
+  /**
+   * Set/Get the backend computing the values. The backend may be shared by
+   * several arrays. SetBackend() and ConstructBackend() mark the array as
+   * modified; call Modified() after changing the parameters of the current
+   * backend.
+   */
+  void SetBackend(const std::shared_ptr<BackendT>& backend);
+  const std::shared_ptr<BackendT>& GetBackend() const { return this->Backend; }
+  template <typename... Args>
+  void ConstructBackend(Args&&... args)
+  {
+    this->SetBackend(std::make_shared<BackendT>(std::forward<Args>(args)...));
+  }
+  //@}
+
+  /**
+   * Use of this method is discouraged, it computes all the values into a
+   * contiguous AoS-ordered buffer and prints a warning.
+   */
+  void* GetVoidPointer(vtkIdType valueIdx) override;
+
+  /**
+   * Export the values in AoS ordering to the preallocated memory buffer.
+   */
+  void ExportToVoidPointer(void* ptr) override;
+
+  //@{
+  /**
+   * Copy the backend, the shape and the information of @a other, which must be
+   * an implicit array of the same type. DeepCopy() copies the backend,
+   * ShallowCopy() shares it.
+   */
+  using Superclass::DeepCopy;
+  void DeepCopy(vtkDataArray* other) override;
+  void ShallowCopy(vtkDataArray* other) override;
+  //@}
+
+  /**
+   * Return the memory of the materialized values, if any, in kibibytes (1024
+   * bytes). The values themselves take no memory.
+   */
+  unsigned long GetActualMemorySize() const override;
+
+  int GetArrayType() const override { return vtkAbstractArray::ImplicitArray; }
+
+protected:
+  vtkImplicitArray();
+  ~vtkImplicitArray() override;
+
+  //@{
+  /**
+   * There is nothing to allocate.
+   */
+  bool AllocateTuples(vtkIdType) { return true; }
+  bool ReallocateTuples(vtkIdType) { return true; }
+  //@}
+
+  /**
+   * Return a vtkAOSDataArrayTemplate of the same value type, which the
+   * pipeline can copy values into.
+   */
+  vtkObjectBase* NewInstanceInternal() const override;
+
+  std::shared_ptr<BackendT> Backend;
+  vtkBuffer<ValueType>* AoSCopy;
+
+private:
+  vtkImplicitArray(const vtkImplicitArray&) = delete;
+  void operator=(const vtkImplicitArray&) = delete;
+
+  // Returns other as an implicit array of this type, or reports an error.
+  SelfType* CheckCopySource(vtkDataArray* other);
+
+  friend class vtkGenericDataArray<vtkImplicitArray<BackendT>, ValueType>;
+};
+
+#include "vtkImplicitArray.txx"
+
+#endif // header guard
+
+// VTK-HeaderTest-Exclude: vtkImplicitArray.h
@@ -0,0 +1,224 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkImplicitArray_txx
+#define vtkImplicitArray_txx
+
+#include "vtkImplicitArray.h"
+
+#include "vtkObjectFactory.h"
+
+#include <cstdlib>
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>* vtkImplicitArray<BackendT>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkImplicitArray<BackendT>);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>::vtkImplicitArray()
+  : Backend(std::make_shared<BackendT>())
+  , AoSCopy(nullptr)
+{
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>::~vtkImplicitArray()
+{
+  if (this->AoSCopy)
+  {
+    this->AoSCopy->Delete();
+    this->AoSCopy = nullptr;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Backend: " << this->Backend.get() << "\n";
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkObjectBase* vtkImplicitArray<BackendT>::NewInstanceInternal() const
+{
+  if (vtkDataArray* da = vtkDataArray::CreateDataArray(SelfType::VTK_DATA_TYPE))
+  {
+    return da;
+  }
+  return vtkAOSDataArrayTemplate<ValueType>::New();
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::SetValue(vtkIdType, ValueType)
+{
+  vtkErrorMacro("Cannot set the values of a read-only implicit array.");
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::SetTypedTuple(vtkIdType, const ValueType*)
+{
+  vtkErrorMacro("Cannot set the tuples of a read-only implicit array.");
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::SetTypedComponent(vtkIdType, int, ValueType)
+{
+  vtkErrorMacro("Cannot set the components of a read-only implicit array.");
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::SetBackend(const std::shared_ptr<BackendT>& backend)
+{
+  if (!backend)
+  {
+    vtkErrorMacro("The backend of an implicit array cannot be null.");
+    return;
+  }
+  this->Backend = backend;
+  this->DataChanged();
+  this->Modified();
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void* vtkImplicitArray<BackendT>::GetVoidPointer(vtkIdType valueIdx)
+{
+  // Allow warnings to be silenced:
+  const char* silence = getenv("VTK_SILENCE_GET_VOID_POINTER_WARNINGS");
+  if (!silence)
+  {
+    vtkWarningMacro(<< "GetVoidPointer called. This is very expensive for "
+                       "implicit arrays, as all the values must be computed "
+                       "for each call. Using the vtkGenericDataArray API with "
+                       "vtkArrayDispatch are preferred. Define the environment "
+                       "variable VTK_SILENCE_GET_VOID_POINTER_WARNINGS to "
+                       "silence this warning.");
+  }
+
+  const vtkIdType numValues = this->GetNumberOfValues();
+
+  if (!this->AoSCopy)
+  {
+    this->AoSCopy = vtkBuffer<ValueType>::New();
+  }
+
+  if (!this->AoSCopy->Allocate(numValues))
+  {
+    vtkErrorMacro(<< "Error allocating a buffer of " << numValues << " '"
+                  << this->GetDataTypeAsString() << "' elements.");
+    return nullptr;
+  }
+
+  this->ExportToVoidPointer(static_cast<void*>(this->AoSCopy->GetBuffer()));
+
+  return static_cast<void*>(this->AoSCopy->GetBuffer() + valueIdx);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::ExportToVoidPointer(void* voidPtr)
+{
+  const vtkIdType numValues = this->GetNumberOfValues();
+  if (numValues == 0)
+  {
+    // Nothing to do.
+    return;
+  }
+
+  if (!voidPtr)
+  {
+    vtkErrorMacro(<< "Buffer is nullptr.");
+    return;
+  }
+
+  ValueType* ptr = static_cast<ValueType*>(voidPtr);
+  const BackendT& backend = *this->Backend;
+  for (vtkIdType valueIdx = 0; valueIdx < numValues; ++valueIdx)
+  {
+    ptr[valueIdx] = backend(valueIdx);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+typename vtkImplicitArray<BackendT>::SelfType* vtkImplicitArray<BackendT>::CheckCopySource(
+  vtkDataArray* other)
+{
+  SelfType* source = dynamic_cast<SelfType*>(other);
+  if (!source)
+  {
+    vtkErrorMacro(<< "Cannot copy a " << other->GetClassName()
+                  << " into a read-only implicit array.");
+  }
+  return source;
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::DeepCopy(vtkDataArray* other)
+{
+  if (!other || other == this)
+  {
+    return;
+  }
+  SelfType* source = this->CheckCopySource(other);
+  if (source)
+  {
+    this->vtkAbstractArray::DeepCopy(source); // copy Information object
+    this->SetNumberOfComponents(source->GetNumberOfComponents());
+    this->SetNumberOfTuples(source->GetNumberOfTuples());
+    this->SetBackend(std::make_shared<BackendT>(*source->Backend));
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::ShallowCopy(vtkDataArray* other)
+{
+  if (!other || other == this)
+  {
+    return;
+  }
+  SelfType* source = this->CheckCopySource(other);
+  if (source)
+  {
+    this->vtkAbstractArray::DeepCopy(source); // copy Information object
+    this->SetNumberOfComponents(source->GetNumberOfComponents());
+    this->SetNumberOfTuples(source->GetNumberOfTuples());
+    this->SetBackend(source->Backend);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+unsigned long vtkImplicitArray<BackendT>::GetActualMemorySize() const
+{
+  const vtkIdType numValues = this->AoSCopy ? this->AoSCopy->GetSize() : 0;
+  return static_cast<unsigned long>(
+    (numValues * static_cast<vtkIdType>(sizeof(ValueType)) + sizeof(BackendT) + 1023) / 1024);
+}
+
+#endif // header guard
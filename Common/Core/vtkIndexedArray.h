@@ -0,0 +1,95 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkIndexedArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkIndexedArray
+ * @brief   An implicit array viewing the tuples of another array.
+ *
+ *
+ * vtkIndexedArray<ValueType> is the vtkImplicitArray using
+ * vtkIndexedImplicitBackend<ValueType>, whose tuple i is the tuple
+ * indices->GetId(i) of another array, converted to ValueType. It gathers
+ * tuples without copying them, e.g. the data of a subset of points:
+ *
+ * \code{.cpp}
+ * vtkNew<vtkIndexedArray<float>> subset;
+ * subset->ConstructBackend(pointIds, temperature);
+ * subset->SetNumberOfComponents(temperature->GetNumberOfComponents());
+ * subset->SetNumberOfTuples(pointIds->GetNumberOfIds());
+ * \endcode
+ *
+ * The backend holds references to the indices and the array, which must not
+ * be modified while the view is in use.
+ *
+ * @sa
+ * vtkImplicitArray
+ */
+
+#ifndef vtkIndexedArray_h
+#define vtkIndexedArray_h
+
+#include "vtkAOSDataArrayTemplate.h" // For the fast path
+#include "vtkIdList.h"               // For the indices
+#include "vtkImplicitArray.h"
+#include "vtkSmartPointer.h" // For the references
+
+template <typename ValueType>
+class vtkIndexedImplicitBackend
+{
+public:
+  /**
+   * An empty view.
+   */
+  vtkIndexedImplicitBackend()
+    : TypedArray(nullptr)
+    , NumberOfComponents(1)
+  {
+  }
+
+  /**
+   * A view of the tuples @a indices of @a array.
+   */
+  vtkIndexedImplicitBackend(vtkIdList* indices, vtkDataArray* array)
+    : Indices(indices)
+    , Array(array)
+    , TypedArray(vtkAOSDataArrayTemplate<ValueType>::FastDownCast(array))
+    , NumberOfComponents(array ? array->GetNumberOfComponents() : 1)
+  {
+  }
+
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    const vtkIdType tupleIdx = this->Indices->GetId(valueIdx / this->NumberOfComponents);
+    const int comp = static_cast<int>(valueIdx % this->NumberOfComponents);
+    // Values of the same type are read without a virtual call.
+    return this->TypedArray ? this->TypedArray->GetTypedComponent(tupleIdx, comp)
+                            : static_cast<ValueType>(this->Array->GetComponent(tupleIdx, comp));
+  }
+
+  vtkIdList* GetIndices() const { return this->Indices; }
+  vtkDataArray* GetArray() const { return this->Array; }
+
+private:
+  vtkSmartPointer<vtkIdList> Indices;
+  vtkSmartPointer<vtkDataArray> Array;
+  vtkAOSDataArrayTemplate<ValueType>* TypedArray;
+  int NumberOfComponents;
+};
+
+template <typename ValueType>
+using vtkIndexedArray = vtkImplicitArray<vtkIndexedImplicitBackend<ValueType>>;
+
+#endif // header guard
+
+// VTK-HeaderTest-Exclude: vtkIndexedArray.h
@@ -1,47 +1,83 @@
 set(VTK_SMP_IMPLEMENTATION_TYPE "Sequential"
-  CACHE STRING "Which multi-threaded parallelism implementation to use. Options are Sequential, OpenMP or TBB")
+  CACHE STRING "Which multi-threaded parallelism implementation to use by default. Options are Sequential, STDThread, OpenMP or TBB")
 set_property(CACHE VTK_SMP_IMPLEMENTATION_TYPE
   PROPERTY
-    STRINGS Sequential OpenMP TBB)
+    STRINGS Sequential STDThread OpenMP TBB)
 
 if (NOT (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP" OR
-         VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB"))
+         VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB" OR
+         VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "STDThread"))
   set_property(CACHE VTK_SMP_IMPLEMENTATION_TYPE
     PROPERTY
       VALUE "Sequential")
 endif ()
 
-set(vtk_smp_headers_to_configure)
+# All enabled backends are built into CommonCore; the one in use can be
+# changed at runtime with vtkSMPTools::SetBackend() or the
+# VTK_SMP_BACKEND_IN_USE environment variable. Sequential is always built.
+option(VTK_SMP_ENABLE_STDTHREAD "Enable the STDThread backend for vtkSMPTools" ON)
+option(VTK_SMP_ENABLE_OPENMP "Enable the OpenMP backend for vtkSMPTools" OFF)
+option(VTK_SMP_ENABLE_TBB "Enable the TBB backend for vtkSMPTools" OFF)
+mark_as_advanced(
+  VTK_SMP_ENABLE_STDTHREAD
+  VTK_SMP_ENABLE_OPENMP
+  VTK_SMP_ENABLE_TBB)
+
+# The default backend is always built.
+set(VTK_SMP_ENABLE_SEQUENTIAL ON)
+if (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "STDThread")
+  set(VTK_SMP_ENABLE_STDTHREAD ON)
+elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP")
+  set(VTK_SMP_ENABLE_OPENMP ON)
+elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB")
+  set(VTK_SMP_ENABLE_TBB ON)
+endif ()
+
 set(vtk_smp_defines)
 set(vtk_smp_use_default_atomics ON)
 
-if (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "TBB")
-  vtk_module_find_package(PACKAGE TBB)
-  list(APPEND vtk_smp_libraries
-    TBB::tbb)
+set(vtk_smp_common_headers
+  SMP/Common/vtkSMPThreadLocalAPI.h
+  SMP/Common/vtkSMPThreadLocalImplAbstract.h
+  SMP/Common/vtkSMPToolsAPI.h
+  SMP/Common/vtkSMPToolsImpl.h
+  SMP/Common/vtkSMPToolsInternal.h)
+list(APPEND vtk_smp_sources
+  SMP/Common/vtkSMPToolsAPI.cxx)
 
-  set(vtk_smp_use_default_atomics OFF)
-  set(vtk_smp_implementation_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/TBB")
+set(vtk_smp_sequential_headers
+  SMP/Sequential/vtkSMPThreadLocalImpl.h
+  SMP/Sequential/vtkSMPToolsImpl.txx)
+list(APPEND vtk_smp_sources
+  SMP/Sequential/vtkSMPToolsImpl.cxx)
+
+set(vtk_smp_stdthread_headers)
+if (VTK_SMP_ENABLE_STDTHREAD)
+  list(APPEND vtk_smp_stdthread_headers
+    SMP/STDThread/vtkSMPThreadLocalBackend.h
+    SMP/STDThread/vtkSMPThreadLocalImpl.h
+    SMP/STDThread/vtkSMPThreadPool.h
+    SMP/STDThread/vtkSMPToolsImpl.txx)
   list(APPEND vtk_smp_sources
-    "${vtk_smp_implementation_dir}/vtkSMPTools.cxx")
-  list(APPEND vtk_smp_headers_to_configure
-    vtkSMPToolsInternal.h
-    vtkSMPThreadLocal.h)
+    SMP/STDThread/vtkSMPThreadLocalBackend.cxx
+    SMP/STDThread/vtkSMPThreadPool.cxx
+    SMP/STDThread/vtkSMPToolsImpl.cxx)
+endif ()
 
-elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP")
+set(vtk_smp_openmp_headers)
+if (VTK_SMP_ENABLE_OPENMP)
   vtk_module_find_package(PACKAGE OpenMP)
 
   list(APPEND vtk_smp_libraries
     OpenMP::OpenMP_CXX)
 
-  set(vtk_smp_implementation_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/OpenMP")
+  list(APPEND vtk_smp_openmp_headers
+    SMP/OpenMP/vtkSMPThreadLocalBackend.h
+    SMP/OpenMP/vtkSMPThreadLocalImpl.h
+    SMP/OpenMP/vtkSMPToolsImpl.txx)
   list(APPEND vtk_smp_sources
-    "${vtk_smp_implementation_dir}/vtkSMPTools.cxx"
-    "${vtk_smp_implementation_dir}/vtkSMPThreadLocalImpl.cxx")
-  list(APPEND vtk_smp_headers_to_configure
-    vtkSMPThreadLocal.h
-    vtkSMPThreadLocalImpl.h
-    vtkSMPToolsInternal.h)
+    SMP/OpenMP/vtkSMPThreadLocalBackend.cxx
+    SMP/OpenMP/vtkSMPToolsImpl.cxx)
 
   if (OpenMP_CXX_SPEC_DATE AND NOT "${OpenMP_CXX_SPEC_DATE}" LESS "201107")
     set(vtk_smp_use_default_atomics OFF)
@@ -50,15 +86,21 @@ elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "OpenMP")
       "Required OpenMP version (3.1) for atomics not detected. Using default "
       "atomics implementation.")
   endif()
+endif ()
 
-elseif (VTK_SMP_IMPLEMENTATION_TYPE STREQUAL "Sequential")
-  set(vtk_smp_implementation_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/Sequential")
+set(vtk_smp_tbb_headers)
+if (VTK_SMP_ENABLE_TBB)
+  vtk_module_find_package(PACKAGE TBB)
+  list(APPEND vtk_smp_libraries
+    TBB::tbb)
+
+  set(vtk_smp_use_default_atomics OFF)
+  list(APPEND vtk_smp_tbb_headers
+    SMP/TBB/vtkSMPThreadLocalImpl.h
+    SMP/TBB/vtkSMPToolsImpl.txx)
   list(APPEND vtk_smp_sources
-    "${vtk_smp_implementation_dir}/vtkSMPTools.cxx")
-  list(APPEND vtk_smp_headers_to_configure
-    vtkSMPThreadLocal.h
-    vtkSMPToolsInternal.h)
-endif()
+    SMP/TBB/vtkSMPToolsImpl.cxx)
+endif ()
 
 if (vtk_smp_use_default_atomics)
   include(CheckSymbolExists)
@@ -68,15 +110,10 @@ if (vtk_smp_use_default_atomics)
   set(vtk_atomics_default_impl_dir "${CMAKE_CURRENT_SOURCE_DIR}/SMP/Sequential")
 endif()
 
-foreach (vtk_smp_header IN LISTS vtk_smp_headers_to_configure)
-  configure_file(
-    "${vtk_smp_implementation_dir}/${vtk_smp_header}.in"
-    "${CMAKE_CURRENT_BINARY_DIR}/${vtk_smp_header}"
-    COPYONLY)
-  list(APPEND vtk_smp_headers
-    "${CMAKE_CURRENT_BINARY_DIR}/${vtk_smp_header}")
-endforeach()
+list(APPEND vtk_smp_sources
+  vtkSMPTools.cxx)
 
 list(APPEND vtk_smp_headers
   vtkSMPTools.h
+  vtkSMPThreadLocal.h
   vtkSMPThreadLocalObject.h)
@@ -0,0 +1,89 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkSMPTools.h"
+
+#include "SMP/Common/vtkSMPToolsAPI.h"
+
+//------------------------------------------------------------------------------
+const char* vtkSMPTools::GetBackend()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetBackend();
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::SetBackend(const char* backend)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.SetBackend(backend);
+}
+
+//------------------------------------------------------------------------------
+std::vector<std::string> vtkSMPTools::GetAvailableBackends()
+{
+  std::vector<std::string> backends = { "Sequential" };
+#if VTK_SMP_ENABLE_STDTHREAD
+  backends.emplace_back("STDThread");
+#endif
+#if VTK_SMP_ENABLE_OPENMP
+  backends.emplace_back("OpenMP");
+#endif
+#if VTK_SMP_ENABLE_TBB
+  backends.emplace_back("TBB");
+#endif
+  return backends;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::Initialize(int numThreads)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.Initialize(numThreads);
+}
+
+//------------------------------------------------------------------------------
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetEstimatedNumberOfThreads();
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTools::SetNestedParallelism(bool isNested)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  SMPToolsAPI.SetNestedParallelism(isNested);
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::GetNestedParallelism()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetNestedParallelism();
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::IsParallelScope()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.IsParallelScope();
+}
+
+//------------------------------------------------------------------------------
+int vtkSMPTools::GetLocalMaxNumberOfThreads()
+{
+  return vtk::detail::smp::GetSMPThreadSettings().MaxNumberOfThreads;
+}
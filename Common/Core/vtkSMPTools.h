@@ -19,7 +19,7 @@
  * vtkSMPTools provides a set of utility functions that can
  * be used to parallelize parts of VTK code using multiple threads.
  * There are several back-end implementations of parallel functionality
- * (currently Sequential, TBB and X-Kaapi) that actual execution is
+ * (currently Sequential, STDThread, OpenMP and TBB) that actual execution is
  * delegated to.
  */
 
@@ -29,8 +29,13 @@
 #include "vtkCommonCoreModule.h" // For export macro
 #include "vtkObject.h"
 
-#include "vtkSMPThreadLocal.h" // For Initialized
-#include "vtkSMPToolsInternal.h"
+#include "SMP/Common/vtkSMPToolsAPI.h" // For SMPToolsAPI
+#include "vtkSMPThreadLocal.h"          // For Initialized
+
+#include <functional> // For std::plus
+#include <iterator>   // For std::iterator_traits
+#include <string>     // For std::string
+#include <vector>     // For GetAvailableBackends
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 #ifndef __VTK_WRAP__
@@ -90,7 +95,8 @@ struct vtkSMPTools_FunctorInternal<Functor, false>
   void Execute(vtkIdType first, vtkIdType last) { this->F(first, last); }
   void For(vtkIdType first, vtkIdType last, vtkIdType grain)
   {
-    vtk::detail::smp::vtkSMPTools_Impl_For(first, last, grain, *this);
+    auto& SMPToolsAPI = vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.For(first, last, grain, *this);
   }
   vtkSMPTools_FunctorInternal<Functor, false>& operator=(
     const vtkSMPTools_FunctorInternal<Functor, false>&);
@@ -119,7 +125,8 @@ struct vtkSMPTools_FunctorInternal<Functor, true>
   }
   void For(vtkIdType first, vtkIdType last, vtkIdType grain)
   {
-    vtk::detail::smp::vtkSMPTools_Impl_For(first, last, grain, *this);
+    auto& SMPToolsAPI = vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.For(first, last, grain, *this);
     this->F.Reduce();
   }
   vtkSMPTools_FunctorInternal<Functor, true>& operator=(
@@ -224,15 +231,31 @@ public:
    */
   static const char* GetBackend();
 
+  /**
+   * Change the backend in use.
+   * The options can be: "Sequential", "STDThread", "TBB" or "OpenMP"
+   *
+   * VTK_SMP_BACKEND_IN_USE env variable can also be used to set the default
+   * SMPTools backend. Only backends enabled at configure time can be
+   * selected; for any other value a warning is printed, the backend in use
+   * is left unchanged and false is returned.
+   */
+  static bool SetBackend(const char* backend);
+
+  /**
+   * Get the names of the backends enabled at configure time, which
+   * SetBackend() accepts. "Sequential" comes first.
+   */
+  static std::vector<std::string> GetAvailableBackends();
+
   /**
    * Initialize the underlying libraries for execution. This is
    * not required as it is automatically called before the first
    * execution of any parallel code. However, it can be used to
    * control the maximum number of threads used when the back-end
-   * supports it (currently Simple and TBB only). Make sure to call
-   * it before any other parallel operation.
-   * When using Kaapi, use the KAAPI_CPUCOUNT env. variable to control
-   * the number of threads used in the thread pool.
+   * supports it (currently STDThread, OpenMP and TBB). Make sure to call
+   * it before any other parallel operation. The requested number of threads
+   * is kept when the backend is changed with SetBackend().
    */
   static void Initialize(int numThreads = 0);
 
@@ -244,6 +267,106 @@ public:
    */
   static int GetEstimatedNumberOfThreads();
 
+  /**
+   * Enable or disable nested parallelism for the calling thread. When
+   * disabled (the default), a For() started from a thread that is
+   * executing a For() runs sequentially on that thread. When enabled, it
+   * runs in parallel on the threads of the backend. The setting is carried
+   * over to the threads that execute a For() started by the calling thread.
+   */
+  static void SetNestedParallelism(bool isNested);
+
+  /**
+   * Get the nested parallelism setting of the calling thread.
+   */
+  static bool GetNestedParallelism();
+
+  /**
+   * Returns true if the calling thread is executing a For().
+   */
+  static bool IsParallelScope();
+
+  /**
+   * Settings of LocalScope(). The settings that are not given keep the
+   * value of the calling thread.
+   */
+  struct Config
+  {
+    /**
+     * Upper bound on the number of threads executing a For() in the scope,
+     * 0 for the number of threads of the backend.
+     */
+    int MaxNumberOfThreads;
+    std::string Backend;
+    bool NestedParallelism;
+
+    Config()
+      : MaxNumberOfThreads(vtkSMPTools::GetLocalMaxNumberOfThreads())
+      , Backend(vtkSMPTools::GetBackend())
+      , NestedParallelism(vtkSMPTools::GetNestedParallelism())
+    {
+    }
+    Config(int maxNumberOfThreads)
+      : MaxNumberOfThreads(maxNumberOfThreads)
+      , Backend(vtkSMPTools::GetBackend())
+      , NestedParallelism(vtkSMPTools::GetNestedParallelism())
+    {
+    }
+    Config(std::string backend)
+      : MaxNumberOfThreads(vtkSMPTools::GetLocalMaxNumberOfThreads())
+      , Backend(backend)
+      , NestedParallelism(vtkSMPTools::GetNestedParallelism())
+    {
+    }
+    Config(const char* backend)
+      : MaxNumberOfThreads(vtkSMPTools::GetLocalMaxNumberOfThreads())
+      , Backend(backend)
+      , NestedParallelism(vtkSMPTools::GetNestedParallelism())
+    {
+    }
+    Config(bool nestedParallelism)
+      : MaxNumberOfThreads(vtkSMPTools::GetLocalMaxNumberOfThreads())
+      , Backend(vtkSMPTools::GetBackend())
+      , NestedParallelism(nestedParallelism)
+    {
+    }
+    Config(int maxNumberOfThreads, std::string backend, bool nestedParallelism)
+      : MaxNumberOfThreads(maxNumberOfThreads)
+      , Backend(backend)
+      , NestedParallelism(nestedParallelism)
+    {
+    }
+  };
+
+  /**
+   * Execute lambda with the given settings, then restore the previous ones.
+   * The thread count and nested parallelism settings only apply to the
+   * calling thread and to the threads executing a For() it starts, so
+   * several scopes can be used concurrently, for instance to process N
+   * blocks of a composite dataset in parallel with M threads each:
+   *
+   * \code
+   * vtkSMPTools::LocalScope(vtkSMPTools::Config{ N, backend, true }, [&]() {
+   *   vtkSMPTools::For(0, N, [&](vtkIdType begin, vtkIdType end) {
+   *     for (vtkIdType block = begin; block < end; ++block)
+   *     {
+   *       vtkSMPTools::LocalScope(vtkSMPTools::Config{ M }, [&]() { Process(block); });
+   *     }
+   *   });
+   * });
+   * \endcode
+   *
+   * The thread count can only lower the number of threads of the backend,
+   * use Initialize() to raise it. The backend can only be changed outside of
+   * a parallel scope, as with SetBackend().
+   */
+  template <typename T>
+  static void LocalScope(Config const& config, T&& lambda)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.LocalScope<vtkSMPTools::Config>(config, lambda);
+  }
+
   /**
    * A convenience method for sorting data. It is a drop in replacement for
    * std::sort(). Under the hood different methods are used. For example,
@@ -252,7 +375,8 @@ public:
   template <typename RandomAccessIterator>
   static void Sort(RandomAccessIterator begin, RandomAccessIterator end)
   {
-    vtk::detail::smp::vtkSMPTools_Impl_Sort(begin, end);
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.Sort(begin, end);
   }
 
   /**
@@ -264,8 +388,164 @@ public:
   template <typename RandomAccessIterator, typename Compare>
   static void Sort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
   {
-    vtk::detail::smp::vtkSMPTools_Impl_Sort(begin, end, comp);
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.Sort(begin, end, comp);
+  }
+
+  /**
+   * A convenience method for transforming data. It is a drop in replacement
+   * for std::transform(), it does a unary operation on the input ranges.
+   * The data array must have the same length. The performance gain is
+   * observed when the operation done by the functor is expensive. The
+   * functor may be called concurrently from several threads.
+   *
+   * Usage example:
+   * \code
+   * vtkSMPTools::Transform(array->Begin(), array->End(), output->Begin(),
+   *   [](double x) { return x - 1; });
+   * \endcode
+   */
+  template <typename InputIt, typename OutputIt, typename Functor>
+  static void Transform(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Functor transform)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.Transform(inBegin, inEnd, outBegin, transform);
+  }
+
+  /**
+   * A convenience method for transforming data. It is a drop in replacement
+   * for std::transform(), it does a binary operation on the input ranges.
+   * The data array must have the same length. The performance gain is
+   * observed when the operation done by the functor is expensive. The
+   * functor may be called concurrently from several threads.
+   */
+  template <typename InputIt1, typename InputIt2, typename OutputIt, typename Functor>
+  static void Transform(
+    InputIt1 inBegin1, InputIt1 inEnd, InputIt2 inBegin2, OutputIt outBegin, Functor transform)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.Transform(inBegin1, inEnd, inBegin2, outBegin, transform);
+  }
+
+  /**
+   * A convenience method for filling data. It is a drop in replacement for
+   * std::fill(), it assigns the given value to every element of the range.
+   */
+  template <typename Iterator, typename T>
+  static void Fill(Iterator begin, Iterator end, const T& value)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.Fill(begin, end, value);
+  }
+
+  //@{
+  /**
+   * Parallel reduction, similar to std::reduce(). The range is cut in
+   * blocks that only depend on its size: every block is reduced starting
+   * from its first value, then init and the block results are combined in
+   * order. reduce must be associative; the result does not depend on the
+   * backend or on the number of threads, even for floating point values.
+   * The version without reduce sums the values.
+   */
+  template <typename Iterator, typename T, typename ReduceFunctor>
+  static T Reduce(Iterator begin, Iterator end, T init, ReduceFunctor reduce)
+  {
+    vtk::detail::smp::IdentityFunctor identity;
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.TransformReduce(begin, end, init, reduce, identity);
+  }
+  template <typename Iterator, typename T>
+  static T Reduce(Iterator begin, Iterator end, T init)
+  {
+    return vtkSMPTools::Reduce(begin, end, init, std::plus<T>());
+  }
+  //@}
+
+  /**
+   * Parallel reduction of transformed values, similar to
+   * std::transform_reduce(): returns the reduction of init and of
+   * transform(x) for every x of the range. transform is called once per
+   * value. The same rules as for Reduce() apply.
+   *
+   * Usage example, computing the range of an array:
+   * \code
+   * auto range = vtkSMPTools::TransformReduce(values.begin(), values.end(),
+   *   std::make_pair(VTK_DOUBLE_MAX, VTK_DOUBLE_MIN),
+   *   [](std::pair<double, double> a, std::pair<double, double> b) {
+   *     return std::make_pair(std::min(a.first, b.first), std::max(a.second, b.second));
+   *   },
+   *   [](double x) { return std::make_pair(x, x); });
+   * \endcode
+   */
+  template <typename Iterator, typename T, typename ReduceFunctor, typename TransformFunctor>
+  static T TransformReduce(
+    Iterator begin, Iterator end, T init, ReduceFunctor reduce, TransformFunctor transform)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.TransformReduce(begin, end, init, reduce, transform);
+  }
+
+  //@{
+  /**
+   * Parallel exclusive prefix scan, similar to std::exclusive_scan(): the
+   * i-th output is the combination of init and of the i - 1 first inputs.
+   * Returns the end of the output range. The input and output ranges can be
+   * the same but must not partially overlap. operation must be associative.
+   * The version without operation computes prefix sums, for instance to
+   * turn a per-cell number of points into connectivity offsets.
+   */
+  template <typename InputIt, typename OutputIt, typename T, typename Functor>
+  static OutputIt ExclusiveScan(
+    InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, Functor operation)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.ExclusiveScan(inBegin, inEnd, outBegin, init, operation);
+  }
+  template <typename InputIt, typename OutputIt, typename T>
+  static OutputIt ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init)
+  {
+    return vtkSMPTools::ExclusiveScan(inBegin, inEnd, outBegin, init, std::plus<T>());
   }
+  //@}
+
+  //@{
+  /**
+   * Parallel inclusive prefix scan, similar to std::inclusive_scan(): the
+   * i-th output is the combination of the i first inputs. Returns the end
+   * of the output range. The same rules as for ExclusiveScan() apply.
+   */
+  template <typename InputIt, typename OutputIt, typename Functor>
+  static OutputIt InclusiveScan(
+    InputIt inBegin, InputIt inEnd, OutputIt outBegin, Functor operation)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.InclusiveScan(inBegin, inEnd, outBegin, operation);
+  }
+  template <typename InputIt, typename OutputIt>
+  static OutputIt InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin)
+  {
+    typedef typename std::iterator_traits<InputIt>::value_type ValueType;
+    return vtkSMPTools::InclusiveScan(inBegin, inEnd, outBegin, std::plus<ValueType>());
+  }
+  //@}
+
+  /**
+   * Parallel stream compaction, similar to std::copy_if(): copies the
+   * values for which pred returns true, keeping their order, and returns
+   * the end of the output range. pred is called twice per value, once to
+   * count the output size of every block and once to copy, so it must not
+   * have side effects. The output range must not overlap the input range.
+   */
+  template <typename InputIt, typename OutputIt, typename Predicate>
+  static OutputIt CopyIf(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Predicate pred)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.CopyIf(inBegin, inEnd, outBegin, pred);
+  }
+
+private:
+  // Thread count limit of the calling thread, used by Config.
+  static int GetLocalMaxNumberOfThreads();
 };
 
 #endif
@@ -0,0 +1,183 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkScratchPool.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkScratchPool
+ * @brief   thread local pool of scratch VTK objects
+ *
+ * vtkScratchPool keeps, for each thread, the scratch objects that were used
+ * and released, such as the vtkIdList and vtkGenericCell instances that the
+ * cell traversal loops create for each call or each execution. Acquire()
+ * returns an idle object of the calling thread if there is one, and only
+ * creates one with ObjectT::New() otherwise. The object goes back to the pool
+ * of the releasing thread when its handle is destroyed, with its memory: a
+ * vtkIdList keeps its capacity, a vtkGenericCell its cells. Hence the loops
+ * executed again, or by the same threads, do not allocate.
+ *
+ * Acquired objects are in the state of their last use, and must be reset
+ * as needed, e.g. with vtkIdList::Reset(). A thread keeps at most
+ * GetMaximumSize() idle objects of a type, and deletes them when it exits.
+ * As handles go back to the pool of the current thread, they must not
+ * outlive it, e.g. in static variables.
+ *
+ * \code{.cpp}
+ * void vtkDataSet::GetCellNeighbors(vtkIdType cellId, vtkIdList* ptIds, vtkIdList* cellIds)
+ * {
+ *   auto otherCells = vtkScratchPool<vtkIdList>::Acquire();
+ *   ...
+ *   this->GetPointCells(ptIds->GetId(i), otherCells);
+ * }
+ * \endcode
+ *
+ * @sa
+ * vtkSMPThreadLocalObject
+ */
+
+#ifndef vtkScratchPool_h
+#define vtkScratchPool_h
+
+#include <vector> // For the idle objects
+
+template <typename ObjectT>
+class vtkScratchPool
+{
+public:
+  /**
+   * Owner of an acquired object, which releases it to the pool when
+   * destroyed. It converts to ObjectT* to be passed to the VTK methods.
+   */
+  class Handle
+  {
+  public:
+    Handle()
+      : Object(nullptr)
+    {
+    }
+    explicit Handle(ObjectT* object)
+      : Object(object)
+    {
+    }
+    Handle(Handle&& other)
+      : Object(other.Object)
+    {
+      other.Object = nullptr;
+    }
+    Handle& operator=(Handle&& other)
+    {
+      if (this != &other)
+      {
+        this->Reset();
+        this->Object = other.Object;
+        other.Object = nullptr;
+      }
+      return *this;
+    }
+    Handle(const Handle&) = delete;
+    Handle& operator=(const Handle&) = delete;
+    ~Handle() { this->Reset(); }
+
+    /**
+     * Release the object to the pool of the calling thread.
+     */
+    void Reset()
+    {
+      if (this->Object)
+      {
+        vtkScratchPool::Release(this->Object);
+        this->Object = nullptr;
+      }
+    }
+
+    ObjectT* Get() const { return this->Object; }
+    ObjectT* operator->() const { return this->Object; }
+    ObjectT& operator*() const { return *this->Object; }
+    operator ObjectT*() const { return this->Object; }
+
+  private:
+    ObjectT* Object;
+  };
+
+  /**
+   * Return an idle object of the calling thread, or a new object.
+   */
+  static Handle Acquire()
+  {
+    std::vector<ObjectT*>& idle = vtkScratchPool::GetIdleObjects().Objects;
+    if (idle.empty())
+    {
+      return Handle(ObjectT::New());
+    }
+    ObjectT* object = idle.back();
+    idle.pop_back();
+    return Handle(object);
+  }
+
+  /**
+   * Return the number of idle objects of the calling thread.
+   */
+  static size_t GetNumberOfIdleObjects()
+  {
+    return vtkScratchPool::GetIdleObjects().Objects.size();
+  }
+
+  /**
+   * Delete the idle objects of the calling thread, e.g. to release the
+   * memory of large id lists.
+   */
+  static void Clear() { vtkScratchPool::GetIdleObjects().Clear(); }
+
+  /**
+   * Return the maximum number of idle objects kept by each thread. The
+   * objects released to a full pool are deleted.
+   */
+  static constexpr size_t GetMaximumSize() { return 16; }
+
+private:
+  struct IdleObjects
+  {
+    std::vector<ObjectT*> Objects;
+
+    ~IdleObjects() { this->Clear(); }
+    void Clear()
+    {
+      for (ObjectT* object : this->Objects)
+      {
+        object->Delete();
+      }
+      this->Objects.clear();
+    }
+  };
+
+  static IdleObjects& GetIdleObjects()
+  {
+    static thread_local IdleObjects idle;
+    return idle;
+  }
+
+  static void Release(ObjectT* object)
+  {
+    std::vector<ObjectT*>& idle = vtkScratchPool::GetIdleObjects().Objects;
+    if (idle.size() < vtkScratchPool::GetMaximumSize())
+    {
+      idle.push_back(object);
+    }
+    else
+    {
+      object->Delete();
+    }
+  }
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkScratchPool.h
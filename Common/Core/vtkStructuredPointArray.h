@@ -0,0 +1,119 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStructuredPointArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkStructuredPointArray
+ * @brief   An implicit array of the point coordinates of an image.
+ *
+ *
+ * vtkStructuredPointArray<ValueType> is the 3-component vtkImplicitArray
+ * using vtkStructuredPointBackend<ValueType>, whose tuples are the
+ * coordinates of the points of an image with the given extent, origin,
+ * spacing and direction matrix, in the order of vtkImageData:
+ *
+ * \code{.cpp}
+ * vtkNew<vtkStructuredPointArray<double>> coordinates;
+ * coordinates->ConstructBackend(image->GetExtent(), image->GetOrigin(),
+ *   image->GetSpacing(), image->GetDirectionMatrix()->GetData());
+ * coordinates->SetNumberOfComponents(3);
+ * coordinates->SetNumberOfTuples(image->GetNumberOfPoints());
+ * vtkNew<vtkPoints> points;
+ * points->SetData(coordinates);
+ * \endcode
+ *
+ * @sa
+ * vtkImplicitArray
+ */
+
+#ifndef vtkStructuredPointArray_h
+#define vtkStructuredPointArray_h
+
+#include "vtkImplicitArray.h"
+
+template <typename ValueType>
+class vtkStructuredPointBackend
+{
+public:
+  /**
+   * A single point at the origin.
+   */
+  vtkStructuredPointBackend()
+  {
+    const int extent[6] = { 0, 0, 0, 0, 0, 0 };
+    const double origin[3] = { 0.0, 0.0, 0.0 };
+    const double spacing[3] = { 1.0, 1.0, 1.0 };
+    this->Initialize(extent, origin, spacing, nullptr);
+  }
+
+  /**
+   * The points of an image. A null @a direction is the identity; otherwise
+   * it is the 3x3 direction matrix in row-major order, see
+   * vtkImageData::GetDirectionMatrix().
+   */
+  vtkStructuredPointBackend(const int extent[6], const double origin[3], const double spacing[3],
+    const double direction[9] = nullptr)
+  {
+    this->Initialize(extent, origin, spacing, direction);
+  }
+
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    const vtkIdType pointIdx = valueIdx / 3;
+    const int comp = static_cast<int>(valueIdx - 3 * pointIdx);
+    const vtkIdType i = pointIdx % this->Dimensions[0];
+    const vtkIdType jk = pointIdx / this->Dimensions[0];
+    const vtkIdType j = jk % this->Dimensions[1];
+    const vtkIdType k = jk / this->Dimensions[1];
+    const double* row = this->IndexToPoint + 4 * comp;
+    return static_cast<ValueType>(row[0] * i + row[1] * j + row[2] * k + row[3]);
+  }
+
+  vtkIdType Dimensions[3];
+
+  // The rows of the affine transform from the (i, j, k) index relative to
+  // the first point of the extent to the coordinates.
+  double IndexToPoint[12];
+
+private:
+  void Initialize(
+    const int extent[6], const double origin[3], const double spacing[3], const double direction[9])
+  {
+    static const double identity[9] = { 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0 };
+    if (!direction)
+    {
+      direction = identity;
+    }
+    for (int dim = 0; dim < 3; ++dim)
+    {
+      this->Dimensions[dim] = extent[2 * dim + 1] - extent[2 * dim] + 1;
+    }
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      double* row = this->IndexToPoint + 4 * comp;
+      row[3] = origin[comp];
+      for (int dim = 0; dim < 3; ++dim)
+      {
+        row[dim] = direction[3 * comp + dim] * spacing[dim];
+        row[3] += row[dim] * extent[2 * dim];
+      }
+    }
+  }
+};
+
+template <typename ValueType>
+using vtkStructuredPointArray = vtkImplicitArray<vtkStructuredPointBackend<ValueType>>;
+
+#endif // header guard
+
+// VTK-HeaderTest-Exclude: vtkStructuredPointArray.h
@@ -0,0 +1,288 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the queries of vtkBVHCellLocator against vtkCellLocator and the
+// cells along the segments, that IntersectWithLineBatch() gives, with every
+// vtkSMPTools backend, the results of IntersectWithLine(), and that
+// BuildLocator() honors LazyEvaluation and UseExistingSearchStructure.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellArray.h"
+#include "vtkCellLocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// A triangulated, wavy surface.
+void MakeSurface(vtkPolyData* surface, int resolution)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> triangles;
+  for (int j = 0; j <= resolution; ++j)
+  {
+    for (int i = 0; i <= resolution; ++i)
+    {
+      const double x = -1.0 + 2.0 * i / resolution;
+      const double y = -1.0 + 2.0 * j / resolution;
+      points->InsertNextPoint(x, y, 0.3 * std::sin(3.0 * x) * std::cos(2.0 * y));
+    }
+  }
+  for (int j = 0; j < resolution; ++j)
+  {
+    for (int i = 0; i < resolution; ++i)
+    {
+      const vtkIdType p0 = j * (resolution + 1) + i;
+      const vtkIdType lower[3] = { p0, p0 + 1, p0 + resolution + 2 };
+      const vtkIdType upper[3] = { p0, p0 + resolution + 2, p0 + resolution + 1 };
+      triangles->InsertNextCell(3, lower);
+      triangles->InsertNextCell(3, upper);
+    }
+  }
+  surface->SetPoints(points);
+  surface->SetPolys(triangles);
+}
+
+bool Check(bool condition, const char* input, const char* query, vtkIdType i)
+{
+  if (!condition)
+  {
+    std::cerr << query << " differs from vtkCellLocator for query " << i << " on the "
+              << input << std::endl;
+  }
+  return condition;
+}
+
+// Compares the single queries to the ones of vtkCellLocator.
+bool CheckQueries(vtkDataSet* input, const char* name, vtkDoubleArray* p1, vtkDoubleArray* p2)
+{
+  vtkNew<vtkBVHCellLocator> locator;
+  locator->SetDataSet(input);
+  locator->BuildLocator();
+  vtkNew<vtkCellLocator> reference;
+  reference->SetDataSet(input);
+  reference->BuildLocator();
+
+  vtkNew<vtkGenericCell> cell;
+  vtkNew<vtkIdList> cells;
+  double pcoords[3], weights[8];
+  bool success = true;
+  for (vtkIdType i = 0; success && i < p1->GetNumberOfTuples(); ++i)
+  {
+    double a0[3], a1[3];
+    p1->GetTuple(i, a0);
+    p2->GetTuple(i, a1);
+
+    success &= Check(locator->FindCell(a0, 0.0, cell, pcoords, weights) ==
+        reference->FindCell(a0, 0.0, cell, pcoords, weights),
+      name, "FindCell", i);
+
+    double closest[3], dist2, referenceDist2;
+    vtkIdType cellId, referenceCellId;
+    int subId;
+    locator->FindClosestPoint(a0, closest, cell, cellId, subId, dist2);
+    reference->FindClosestPoint(a0, closest, cell, referenceCellId, subId, referenceDist2);
+    success &= Check(std::abs(dist2 - referenceDist2) <= 1e-12, name, "FindClosestPoint", i);
+
+    // The closest intersection among the cells along the segment, the one
+    // with the smallest cell id among equal ones.
+    double t, x[3];
+    const int hit = locator->IntersectWithLine(a0, a1, 0.0, t, x, pcoords, subId, cellId, cell);
+    double referenceT = VTK_DOUBLE_MAX;
+    referenceCellId = -1;
+    reference->FindCellsAlongLine(a0, a1, 0.0, cells);
+    for (vtkIdType j = 0; j < cells->GetNumberOfIds(); ++j)
+    {
+      double cellT;
+      input->GetCell(cells->GetId(j), cell);
+      if (cell->IntersectWithLine(a0, a1, 0.0, cellT, x, pcoords, subId) &&
+        (cellT < referenceT || (cellT == referenceT && cells->GetId(j) < referenceCellId)))
+      {
+        referenceT = cellT;
+        referenceCellId = cells->GetId(j);
+      }
+    }
+    success &= Check(hit ? cellId == referenceCellId && t == referenceT : referenceCellId < 0,
+      name, "IntersectWithLine", i);
+  }
+  return success;
+}
+
+// Compares IntersectWithLineBatch() to IntersectWithLine().
+bool CheckBatch(vtkBVHCellLocator* locator, vtkDoubleArray* p1, vtkDoubleArray* p2)
+{
+  vtkNew<vtkIdTypeArray> cellIds;
+  vtkNew<vtkDoubleArray> ts;
+  vtkNew<vtkDoubleArray> xs;
+  locator->IntersectWithLineBatch(p1, p2, 0.001, cellIds, ts, xs);
+  if (cellIds->GetNumberOfValues() != p1->GetNumberOfTuples())
+  {
+    return false;
+  }
+
+  vtkNew<vtkGenericCell> cell;
+  vtkIdType numHits = 0;
+  for (vtkIdType i = 0; i < p1->GetNumberOfTuples(); ++i)
+  {
+    double a0[3], a1[3], t, x[3], pcoords[3];
+    int subId;
+    vtkIdType cellId;
+    p1->GetTuple(i, a0);
+    p2->GetTuple(i, a1);
+    if (!locator->IntersectWithLine(a0, a1, 0.001, t, x, pcoords, subId, cellId, cell))
+    {
+      cellId = -1;
+    }
+    if (cellIds->GetValue(i) != cellId ||
+      (cellId >= 0 &&
+        (ts->GetValue(i) != t || xs->GetComponent(i, 0) != x[0] ||
+          xs->GetComponent(i, 1) != x[1] || xs->GetComponent(i, 2) != x[2])))
+    {
+      return false;
+    }
+    numHits += cellId >= 0;
+  }
+  return numHits > 0;
+}
+}
+
+int TestBVHCellLocator(int, char*[])
+{
+  vtkNew<vtkPolyData> surface;
+  MakeSurface(surface, 60);
+
+  // Voxels, whose faces are often hit by several segments.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 20, 0, 16, 0, 12);
+  image->SetSpacing(0.1, 0.125, 0.15);
+  image->SetOrigin(-1.0, -1.0, -0.9);
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(3141);
+  auto nextValue = [&random](double rangeMin, double rangeMax) {
+    const double value = random->GetRangeValue(rangeMin, rangeMax);
+    random->Next();
+    return value;
+  };
+
+  // Random segments, then coherent ones from a common origin, some of them
+  // along the axes.
+  vtkNew<vtkDoubleArray> p1;
+  p1->SetNumberOfComponents(3);
+  vtkNew<vtkDoubleArray> p2;
+  p2->SetNumberOfComponents(3);
+  for (int i = 0; i < 1000; ++i)
+  {
+    p1->InsertNextTuple3(nextValue(-1.2, 1.2), nextValue(-1.2, 1.2), nextValue(-1.2, 1.2));
+    p2->InsertNextTuple3(nextValue(-1.2, 1.2), nextValue(-1.2, 1.2), nextValue(-1.2, 1.2));
+  }
+  for (int j = 0; j < 30; ++j)
+  {
+    for (int i = 0; i < 30; ++i)
+    {
+      p1->InsertNextTuple3(0.05, -0.02, 2.0);
+      p2->InsertNextTuple3(-1.0 + i / 15.0, -1.0 + j / 15.0, -2.0);
+    }
+  }
+  for (int i = 0; i < 100; ++i)
+  {
+    const double x = -1.0 + i / 50.0;
+    p1->InsertNextTuple3(x, 0.25, 2.0);
+    p2->InsertNextTuple3(x, 0.25, -2.0);
+    p1->InsertNextTuple3(-2.0, x, 0.0);
+    p2->InsertNextTuple3(2.0, x, 0.0);
+  }
+
+  int status = EXIT_SUCCESS;
+  if (!CheckQueries(surface, "surface", p1, p2) || !CheckQueries(image, "image", p1, p2))
+  {
+    status = EXIT_FAILURE;
+  }
+
+  std::vector<vtkDataSet*> inputs = { surface, image };
+  for (vtkDataSet* input : inputs)
+  {
+    vtkIdType numberOfNodes = 0;
+    vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+      vtkNew<vtkBVHCellLocator> locator;
+      locator->SetDataSet(input);
+      locator->BuildLocator();
+      if (numberOfNodes == 0)
+      {
+        numberOfNodes = locator->GetNumberOfNodes();
+      }
+      if (locator->GetNumberOfNodes() != numberOfNodes || !CheckBatch(locator, p1, p2))
+      {
+        std::cerr << "IntersectWithLineBatch failed with the " << backend << " backend on a "
+                  << input->GetClassName() << std::endl;
+        status = EXIT_FAILURE;
+      }
+    });
+  }
+
+  vtkNew<vtkBVHCellLocator> locator;
+  locator->SetDataSet(surface);
+  vtkNew<vtkPolyData> representation;
+  locator->GenerateRepresentation(3, representation);
+  if (representation->GetNumberOfCells() != 6 * 8)
+  {
+    std::cerr << "GenerateRepresentation produced " << representation->GetNumberOfCells()
+              << " faces instead of 48" << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  // With LazyEvaluation, the hierarchy is built by the first query.
+  vtkNew<vtkBVHCellLocator> lazyLocator;
+  lazyLocator->SetDataSet(image);
+  lazyLocator->LazyEvaluationOn();
+  lazyLocator->BuildLocator();
+  const vtkIdType numberOfNodes = lazyLocator->GetNumberOfNodes();
+  double center[3] = { 0.1, 0.2, 0.3 };
+  if (numberOfNodes != 0 || lazyLocator->FindCell(center) < 0 ||
+    lazyLocator->GetNumberOfNodes() == 0)
+  {
+    std::cerr << "LazyEvaluation not honored" << std::endl;
+    status = EXIT_FAILURE;
+  }
+
+  // With UseExistingSearchStructure, the hierarchy of the image is kept.
+  locator->SetDataSet(image);
+  locator->BuildLocator();
+  const vtkIdType imageNodes = locator->GetNumberOfNodes();
+  locator->SetDataSet(surface);
+  locator->UseExistingSearchStructureOn();
+  locator->BuildLocator();
+  const bool kept = locator->GetNumberOfNodes() == imageNodes;
+  locator->UseExistingSearchStructureOff();
+  locator->BuildLocator();
+  if (!kept || locator->GetNumberOfNodes() == imageNodes)
+  {
+    std::cerr << "UseExistingSearchStructure not honored" << std::endl;
+    status = EXIT_FAILURE;
+  }
+  return status;
+}
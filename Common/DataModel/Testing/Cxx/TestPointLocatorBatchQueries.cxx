@@ -0,0 +1,183 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPointLocatorBatchQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the batched queries of the point locators give, with every
+// vtkSMPTools backend, the results of the single point queries.
+
+#include "vtkAbstractPointLocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkOctreePointLocator.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Checks the ids of query i, from offsets[i] to offsets[i + 1], against the
+// single point query.
+template <typename TQuery>
+bool CheckPointLists(vtkDataArray* queryPoints, vtkIdTypeArray* offsets, vtkIdTypeArray* ids,
+  const TQuery& query)
+{
+  if (offsets->GetNumberOfValues() != queryPoints->GetNumberOfTuples() + 1 ||
+    offsets->GetValue(0) != 0 ||
+    offsets->GetValue(queryPoints->GetNumberOfTuples()) != ids->GetNumberOfValues())
+  {
+    return false;
+  }
+  vtkNew<vtkIdList> result;
+  for (vtkIdType i = 0; i < queryPoints->GetNumberOfTuples(); ++i)
+  {
+    query(queryPoints->GetTuple3(i), result);
+    const vtkIdType begin = offsets->GetValue(i);
+    if (offsets->GetValue(i + 1) - begin != result->GetNumberOfIds())
+    {
+      return false;
+    }
+    for (vtkIdType j = 0; j < result->GetNumberOfIds(); ++j)
+    {
+      if (ids->GetValue(begin + j) != result->GetId(j))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CheckLocator(vtkAbstractPointLocator* locator, vtkDataArray* queryPoints)
+{
+  locator->BuildLocator();
+  bool success = true;
+
+  vtkNew<vtkIdTypeArray> closestIds;
+  locator->FindClosestPointBatch(queryPoints, closestIds);
+  if (closestIds->GetNumberOfValues() != queryPoints->GetNumberOfTuples())
+  {
+    success = false;
+  }
+  for (vtkIdType i = 0; success && i < queryPoints->GetNumberOfTuples(); ++i)
+  {
+    success = closestIds->GetValue(i) == locator->FindClosestPoint(queryPoints->GetTuple3(i));
+  }
+  if (!success)
+  {
+    std::cerr << locator->GetClassName() << "::FindClosestPointBatch failed" << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> ids;
+  locator->FindClosestNPointsBatch(7, queryPoints, offsets, ids);
+  if (!CheckPointLists(queryPoints, offsets, ids,
+        [locator](const double* x, vtkIdList* result) {
+          locator->FindClosestNPoints(7, x, result);
+        }))
+  {
+    std::cerr << locator->GetClassName() << "::FindClosestNPointsBatch failed" << std::endl;
+    return false;
+  }
+
+  locator->FindPointsWithinRadiusBatch(0.08, queryPoints, offsets, ids);
+  if (ids->GetNumberOfValues() == 0 ||
+    !CheckPointLists(queryPoints, offsets, ids, [locator](const double* x, vtkIdList* result) {
+      locator->FindPointsWithinRadius(0.08, x, result);
+    }))
+  {
+    std::cerr << locator->GetClassName() << "::FindPointsWithinRadiusBatch failed" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPointLocatorBatchQueries(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(8775070);
+  auto nextValue = [&random](double rangeMin, double rangeMax) {
+    const double value = random->GetRangeValue(rangeMin, rangeMax);
+    random->Next();
+    return value;
+  };
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(20000);
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      x[i] = nextValue(-1.0, 1.0);
+    }
+    points->SetPoint(ptId, x);
+  }
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+
+  // Query points in double and in single precision, some of them outside of
+  // the bounds of the points.
+  vtkNew<vtkDoubleArray> doubleQueries;
+  doubleQueries->SetNumberOfComponents(3);
+  doubleQueries->SetNumberOfTuples(2000);
+  vtkNew<vtkFloatArray> floatQueries;
+  floatQueries->SetNumberOfComponents(3);
+  floatQueries->SetNumberOfTuples(2000);
+  for (vtkIdType i = 0; i < doubleQueries->GetNumberOfTuples(); ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      doubleQueries->SetComponent(i, j, nextValue(-1.2, 1.2));
+      floatQueries->SetComponent(i, j, nextValue(-1.2, 1.2));
+    }
+  }
+  std::vector<vtkDataArray*> queries = { doubleQueries, floatQueries };
+
+  int status = EXIT_SUCCESS;
+  vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+    std::vector<vtkSmartPointer<vtkAbstractPointLocator>> locators = {
+      vtkSmartPointer<vtkStaticPointLocator>::New(),
+      vtkSmartPointer<vtkKdTreePointLocator>::New(),
+      vtkSmartPointer<vtkOctreePointLocator>::New(),
+      vtkSmartPointer<vtkPointLocator>::New(),
+    };
+    for (vtkAbstractPointLocator* locator : locators)
+    {
+      locator->SetDataSet(polyData);
+      for (vtkDataArray* queryPoints : queries)
+      {
+        if (!CheckLocator(locator, queryPoints))
+        {
+          std::cerr << "with the " << backend << " backend and "
+                    << queryPoints->GetClassName() << " query points" << std::endl;
+          status = EXIT_FAILURE;
+        }
+      }
+    }
+  });
+  return status;
+}
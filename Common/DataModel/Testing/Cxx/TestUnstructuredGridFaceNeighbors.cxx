@@ -0,0 +1,232 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestUnstructuredGridFaceNeighbors.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the face adjacency built by vtkUnstructuredGrid::BuildFaceNeighbors()
+// for linear, polyhedral and 2D cells with every SMP backend, that it is
+// rebuilt when the grid is modified, that GetCellNeighbors() and
+// IsCellBoundary() answer the same with and without it, and that the getters
+// are safe before it is built.
+
+#include "vtkCell.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    std::cerr << message << std::endl;
+  }
+  return condition;
+}
+
+// The points of a 4x2x2 lattice, and of two triangles away from it.
+vtkIdType LatticeId(int i, int j, int k)
+{
+  return i + 4 * (j + 2 * k);
+}
+
+void FillGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int j = 0; j < 2; ++j)
+    {
+      for (int i = 0; i < 4; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  const vtkIdType p = points->InsertNextPoint(0, 0, 5);
+  points->InsertNextPoint(1, 0, 5);
+  points->InsertNextPoint(0, 1, 5);
+  points->InsertNextPoint(1, 1, 5);
+  grid->SetPoints(points);
+  grid->Allocate(8);
+
+  // Two hexahedra and a cubic polyhedron along x.
+  for (int i = 0; i < 2; ++i)
+  {
+    const vtkIdType hex[8] = { LatticeId(i, 0, 0), LatticeId(i + 1, 0, 0), LatticeId(i + 1, 1, 0),
+      LatticeId(i, 1, 0), LatticeId(i, 0, 1), LatticeId(i + 1, 0, 1), LatticeId(i + 1, 1, 1),
+      LatticeId(i, 1, 1) };
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+  }
+  const vtkIdType cube[8] = { LatticeId(2, 0, 0), LatticeId(3, 0, 0), LatticeId(3, 1, 0),
+    LatticeId(2, 1, 0), LatticeId(2, 0, 1), LatticeId(3, 0, 1), LatticeId(3, 1, 1),
+    LatticeId(2, 1, 1) };
+  const vtkIdType faces[30] = { 4, cube[0], cube[3], cube[7], cube[4], 4, cube[1], cube[2],
+    cube[6], cube[5], 4, cube[0], cube[1], cube[5], cube[4], 4, cube[3], cube[2], cube[6], cube[7],
+    4, cube[0], cube[1], cube[2], cube[3], 4, cube[4], cube[5], cube[6], cube[7] };
+  grid->InsertNextCell(VTK_POLYHEDRON, 8, cube, 6, faces);
+
+  // Two triangles sharing an edge, and a line without faces.
+  const vtkIdType triangles[2][3] = { { p, p + 1, p + 2 }, { p + 1, p + 3, p + 2 } };
+  grid->InsertNextCell(VTK_TRIANGLE, 3, triangles[0]);
+  grid->InsertNextCell(VTK_TRIANGLE, 3, triangles[1]);
+  const vtkIdType line[2] = { p, p + 3 };
+  grid->InsertNextCell(VTK_LINE, 2, line);
+}
+
+// Returns the neighbors of the faces of the cells, and whether they are on the
+// boundary, from GetCellNeighbors() and IsCellBoundary().
+std::vector<vtkIdType> GetNeighbors(vtkUnstructuredGrid* grid)
+{
+  std::vector<vtkIdType> result;
+  vtkNew<vtkGenericCell> cell;
+  vtkNew<vtkIdList> cellIds;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    grid->GetCell(cellId, cell);
+    const int dimension = cell->GetCellDimension();
+    const int numFaces =
+      dimension == 3 ? cell->GetNumberOfFaces() : (dimension == 2 ? cell->GetNumberOfEdges() : 0);
+    for (int faceId = 0; faceId < numFaces; ++faceId)
+    {
+      vtkIdList* facePts =
+        (dimension == 3 ? cell->GetFace(faceId) : cell->GetEdge(faceId))->GetPointIds();
+      grid->GetCellNeighbors(cellId, facePts, cellIds);
+      std::sort(cellIds->begin(), cellIds->end());
+      result.insert(result.end(), cellIds->begin(), cellIds->end());
+      result.push_back(grid->IsCellBoundary(
+                         cellId, facePts->GetNumberOfIds(), facePts->GetPointer(0))
+          ? -1
+          : -2);
+    }
+  }
+  return result;
+}
+
+// Compares the face adjacency with the neighbors of the faces of the cells.
+bool CheckNeighbors(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkGenericCell> cell;
+  vtkNew<vtkIdList> cellIds;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    grid->GetCell(cellId, cell);
+    const bool is3D = cell->GetCellDimension() == 3;
+    const int numFaces = is3D ? cell->GetNumberOfFaces()
+                              : (cell->GetCellDimension() == 2 ? cell->GetNumberOfEdges() : 0);
+    vtkIdType nfaces;
+    const vtkIdType* neighbors;
+    grid->GetFaceNeighbors(cellId, nfaces, neighbors);
+    if (nfaces != numFaces)
+    {
+      std::cerr << "Wrong number of faces for the cell " << cellId << std::endl;
+      return false;
+    }
+    for (int faceId = 0; faceId < numFaces; ++faceId)
+    {
+      vtkCell* face = is3D ? cell->GetFace(faceId) : cell->GetEdge(faceId);
+      grid->GetCellNeighbors(cellId, face->GetPointIds(), cellIds);
+      const vtkIdType expected = cellIds->GetNumberOfIds() > 0
+        ? *std::min_element(cellIds->begin(), cellIds->end())
+        : -1;
+      if (neighbors[faceId] != expected || grid->GetFaceNeighbor(cellId, faceId) != expected)
+      {
+        std::cerr << "Wrong neighbor of the face " << faceId << " of the cell " << cellId
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestUnstructuredGridFaceNeighbors(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  vtkIdType nfaces;
+  const vtkIdType* neighbors;
+  grid->GetFaceNeighbors(0, nfaces, neighbors);
+  bool success = Check(nfaces == 0 && grid->GetFaceNeighbor(0, 0) == -1 &&
+      !grid->AreFaceNeighborsCurrent(),
+    "Face neighbors before the first build");
+
+  FillGrid(grid);
+  const std::vector<vtkIdType> reference = GetNeighbors(grid);
+  vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+    grid->GetCells()->Modified();
+    grid->BuildFaceNeighbors();
+    if (!CheckNeighbors(grid))
+    {
+      std::cerr << "Wrong face neighbors with the " << backend << " backend" << std::endl;
+      success = false;
+    }
+    success &= Check(grid->AreFaceNeighborsCurrent() && GetNeighbors(grid) == reference,
+      "Wrong cell neighbors from the face neighbors");
+  });
+
+  // The shared faces.
+  success &= Check(grid->GetFaceNeighbor(0, 1) == 1 && grid->GetFaceNeighbor(1, 0) == 0 &&
+      grid->GetFaceNeighbor(1, 1) == 2 && grid->GetFaceNeighbor(2, 0) == 1,
+    "Wrong neighbors of the volume cells");
+  grid->GetFaceNeighbors(3, nfaces, neighbors);
+  success &= Check(nfaces == 3 && std::count(neighbors, neighbors + 3, 4) == 1 &&
+      std::count(neighbors, neighbors + 3, -1) == 2,
+    "Wrong neighbors of the triangle");
+  grid->GetFaceNeighbors(5, nfaces, neighbors);
+  success &= Check(nfaces == 0, "The line has faces");
+
+  // A hexahedron inserted before the first one is a neighbor once rebuilt.
+  const vtkIdType p = grid->GetPoints()->InsertNextPoint(-1, 0, 0);
+  grid->GetPoints()->InsertNextPoint(-1, 1, 0);
+  grid->GetPoints()->InsertNextPoint(-1, 0, 1);
+  grid->GetPoints()->InsertNextPoint(-1, 1, 1);
+  const vtkIdType hex[8] = { p, LatticeId(0, 0, 0), LatticeId(0, 1, 0), p + 1, p + 2,
+    LatticeId(0, 0, 1), LatticeId(0, 1, 1), p + 3 };
+  grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+  success &= Check(!grid->AreFaceNeighborsCurrent() && grid->GetFaceNeighbor(6, 0) == -1,
+    "Face neighbors current after a cell is inserted");
+  grid->BuildFaceNeighbors();
+  success &= Check(grid->GetFaceNeighbor(0, 0) == 6, "Face neighbors not rebuilt");
+  success &= Check(CheckNeighbors(grid), "Wrong rebuilt face neighbors");
+
+  // A third triangle on an edge: the face neighbors no longer answer
+  // GetCellNeighbors(), which returns both other triangles.
+  vtkIdType npts;
+  const vtkIdType* pts;
+  grid->GetCellPoints(3, npts, pts);
+  const vtkIdType triangle[3] = { pts[1], pts[2], grid->GetPoints()->InsertNextPoint(0, 0, 6) };
+  grid->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+  grid->BuildLinks();
+  const std::vector<vtkIdType> nonManifold = GetNeighbors(grid);
+  grid->BuildFaceNeighbors();
+  success &= Check(GetNeighbors(grid) == nonManifold, "Wrong non manifold cell neighbors");
+  success &= Check(CheckNeighbors(grid), "Wrong non manifold face neighbors");
+
+  grid->Initialize();
+  grid->GetFaceNeighbors(0, nfaces, neighbors);
+  success &= Check(nfaces == 0 && grid->GetFaceNeighbor(0, 0) == -1,
+    "Face neighbors after Initialize()");
+  grid->BuildFaceNeighbors();
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -22,6 +22,7 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -51,10 +52,21 @@ bool vtkAbstractCellLocator::StoreCellBounds()
   // Allocate space for cell bounds storage, then fill
   vtkIdType numCells = this->DataSet->GetNumberOfCells();
   this->CellBounds = new double[numCells][6];
-  for (vtkIdType j = 0; j < numCells; j++)
+  if (numCells < 1)
   {
-    this->DataSet->GetCellBounds(j, CellBounds[j]);
+    return true;
   }
+  // Call GetCellBounds() once on this thread so that its side effects (for
+  // example building the cells of a vtkPolyData) do not happen in parallel.
+  vtkDataSet* dataSet = this->DataSet;
+  double(*cellBounds)[6] = this->CellBounds;
+  dataSet->GetCellBounds(0, cellBounds[0]);
+  vtkSMPTools::For(1, numCells, [dataSet, cellBounds](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      dataSet->GetCellBounds(cellId, cellBounds[cellId]);
+    }
+  });
   return true;
 }
 //------------------------------------------------------------------------------
@@ -265,7 +265,8 @@ protected:
    * all cell Bounds into the internal CellBounds array. Subsequent
    * calls to InsideCellBounds(...) can make use of the data
    * A valid dataset must be present for this to work. Returns true
-   * if bounds wre copied, false otherwise.
+   * if bounds wre copied, false otherwise. The bounds are computed in
+   * parallel using vtkSMPTools.
    */
   virtual bool StoreCellBounds();
   virtual void FreeCellBounds();
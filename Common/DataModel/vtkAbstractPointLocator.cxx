@@ -16,6 +16,8 @@
 
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
 
 //------------------------------------------------------------------------------
 vtkAbstractPointLocator::vtkAbstractPointLocator()
@@ -64,6 +66,93 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(
   this->FindPointsWithinRadius(R, p, result);
 }
 
+//------------------------------------------------------------------------------
+bool vtkAbstractPointLocator::CheckQueryPoints(vtkDataArray* points)
+{
+  if (!points || points->GetNumberOfComponents() != 3)
+  {
+    vtkErrorMacro("Query points must have 3 components.");
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Find the closest point of each query point, one query after the other.
+void vtkAbstractPointLocator::FindClosestPointBatch(
+  vtkDataArray* points, vtkIdTypeArray* closestIds)
+{
+  if (!this->CheckQueryPoints(points))
+  {
+    return;
+  }
+  const vtkIdType numQueries = points->GetNumberOfTuples();
+  closestIds->SetNumberOfComponents(1);
+  closestIds->SetNumberOfValues(numQueries);
+  double x[3];
+  for (vtkIdType ptId = 0; ptId < numQueries; ++ptId)
+  {
+    points->GetTuple(ptId, x);
+    closestIds->SetValue(ptId, this->FindClosestPoint(x));
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestNPointsBatch(
+  int N, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  if (!this->CheckQueryPoints(points))
+  {
+    return;
+  }
+  const vtkIdType numQueries = points->GetNumberOfTuples();
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfValues(numQueries + 1);
+  offsets->SetValue(0, 0);
+  ids->SetNumberOfComponents(1);
+  ids->Reset();
+  vtkNew<vtkIdList> result;
+  double x[3];
+  for (vtkIdType ptId = 0; ptId < numQueries; ++ptId)
+  {
+    points->GetTuple(ptId, x);
+    this->FindClosestNPoints(N, x, result);
+    for (vtkIdType i = 0; i < result->GetNumberOfIds(); ++i)
+    {
+      ids->InsertNextValue(result->GetId(i));
+    }
+    offsets->SetValue(ptId + 1, ids->GetNumberOfValues());
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindPointsWithinRadiusBatch(
+  double R, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  if (!this->CheckQueryPoints(points))
+  {
+    return;
+  }
+  const vtkIdType numQueries = points->GetNumberOfTuples();
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfValues(numQueries + 1);
+  offsets->SetValue(0, 0);
+  ids->SetNumberOfComponents(1);
+  ids->Reset();
+  vtkNew<vtkIdList> result;
+  double x[3];
+  for (vtkIdType ptId = 0; ptId < numQueries; ++ptId)
+  {
+    points->GetTuple(ptId, x);
+    this->FindPointsWithinRadius(R, x, result);
+    for (vtkIdType i = 0; i < result->GetNumberOfIds(); ++i)
+    {
+      ids->InsertNextValue(result->GetId(i));
+    }
+    offsets->SetValue(ptId + 1, ids->GetNumberOfValues());
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
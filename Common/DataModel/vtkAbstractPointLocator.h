@@ -23,6 +23,11 @@
  * and finding the closest point.  The points are provided from the specified
  * dataset input.
  *
+ * Batched versions of the queries take an array of query points and return
+ * the results of all of them at once. Subclasses whose queries are thread
+ * safe, like vtkStaticPointLocator, vtkKdTreePointLocator and
+ * vtkOctreePointLocator, run them in parallel using vtkSMPTools.
+ *
  * @sa
  * vtkPointLocator vtkStaticPointLocator vtkMergePoints
  */
@@ -33,7 +38,9 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 #include "vtkLocator.h"
 
+class vtkDataArray;
 class vtkIdList;
+class vtkIdTypeArray;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -89,6 +96,26 @@ public:
   void FindPointsWithinRadius(double R, double x, double y, double z, vtkIdList* result);
   //@}
 
+  //@{
+  /**
+   * Batched versions of FindClosestPoint(), FindClosestNPoints() and
+   * FindPointsWithinRadius(), for each point of an array of query points
+   * with 3 components. FindClosestPointBatch() gives in closestIds the id of
+   * the point closest to each query point. The other methods give the ids
+   * found for query point i in ids, from offsets->GetValue(i) up to
+   * offsets->GetValue(i + 1) excluded, as in vtkCellArray: offsets has one
+   * more value than there are query points. The ids of a query point are in
+   * the same order as with the single point query. By default the queries
+   * are run one after the other; subclasses with thread safe queries run
+   * them in parallel using vtkSMPTools.
+   */
+  virtual void FindClosestPointBatch(vtkDataArray* points, vtkIdTypeArray* closestIds);
+  virtual void FindClosestNPointsBatch(
+    int N, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids);
+  virtual void FindPointsWithinRadiusBatch(
+    double R, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids);
+  //@}
+
   //@{
   /**
    * Provide an accessor to the bounds. Valid after the locator is built.
@@ -112,6 +139,10 @@ protected:
   double Bounds[6];          // bounds of points
   vtkIdType NumberOfBuckets; // total size of locator
 
+  // Returns false, with an error, if the query points of a batched query
+  // are not valid.
+  bool CheckQueryPoints(vtkDataArray* points);
+
 private:
   vtkAbstractPointLocator(const vtkAbstractPointLocator&) = delete;
   void operator=(const vtkAbstractPointLocator&) = delete;
@@ -0,0 +1,214 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAbstractPointLocatorInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAbstractPointLocatorInternal
+ * @brief   threaded batches of point locator queries
+ *
+ * vtkAbstractPointLocatorInternal runs a point locator query on each point
+ * of an array of query points, in parallel using vtkSMPTools, and gathers
+ * the results in the layout of the batched queries of
+ * vtkAbstractPointLocator. The query is a functor, so that the locators can
+ * call their search structure directly rather than through virtual methods.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkAbstractPointLocator vtkStaticPointLocator vtkKdTreePointLocator
+ * vtkOctreePointLocator
+ */
+
+#ifndef vtkAbstractPointLocatorInternal_h
+#define vtkAbstractPointLocatorInternal_h
+
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Reads the query points, directly from float and double arrays.
+struct QueryPoints
+{
+  vtkDataArray* Points;
+  const float* FloatPoints;
+  const double* DoublePoints;
+
+  QueryPoints(vtkDataArray* points)
+    : Points(points)
+    , FloatPoints(nullptr)
+    , DoublePoints(nullptr)
+  {
+    if (points->HasStandardMemoryLayout() && points->GetDataType() == VTK_FLOAT)
+    {
+      this->FloatPoints = static_cast<const float*>(points->GetVoidPointer(0));
+    }
+    else if (points->HasStandardMemoryLayout() && points->GetDataType() == VTK_DOUBLE)
+    {
+      this->DoublePoints = static_cast<const double*>(points->GetVoidPointer(0));
+    }
+  }
+
+  void GetPoint(vtkIdType ptId, double x[3]) const
+  {
+    if (this->DoublePoints)
+    {
+      const double* p = this->DoublePoints + 3 * ptId;
+      x[0] = p[0];
+      x[1] = p[1];
+      x[2] = p[2];
+    }
+    else if (this->FloatPoints)
+    {
+      const float* p = this->FloatPoints + 3 * ptId;
+      x[0] = p[0];
+      x[1] = p[1];
+      x[2] = p[2];
+    }
+    else
+    {
+      this->Points->GetTuple(ptId, x);
+    }
+  }
+};
+
+// Finds the closest point of each query point. TQuery provides
+// vtkIdType operator()(const double x[3]).
+template <typename TQuery>
+void FindClosestPointsInParallel(vtkDataArray* points, TQuery& query, vtkIdTypeArray* closestIds)
+{
+  const vtkIdType numQueries = points->GetNumberOfTuples();
+  closestIds->SetNumberOfComponents(1);
+  closestIds->SetNumberOfValues(numQueries);
+  vtkIdType* closest = closestIds->GetPointer(0);
+  const QueryPoints queryPoints(points);
+
+  vtkSMPTools::For(0, numQueries, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      queryPoints.GetPoint(ptId, x);
+      closest[ptId] = query(x);
+    }
+  });
+}
+
+// Runs a query giving a list of ids on each query point. The ids found for
+// each batch of query points are kept per thread, along with their counts,
+// and copied into place once the offsets are known.
+template <typename TQuery>
+struct FindPointLists
+{
+  struct Batch
+  {
+    vtkIdType BeginQuery;
+    std::vector<vtkIdType> Ids;
+  };
+
+  TQuery& Query;
+  QueryPoints Points;
+  vtkIdType* Counts;
+  vtkSMPThreadLocalObject<vtkIdList> Result;
+  vtkSMPThreadLocal<std::vector<Batch>> Batches;
+
+  FindPointLists(vtkDataArray* points, TQuery& query, vtkIdType* counts)
+    : Query(query)
+    , Points(points)
+    , Counts(counts)
+  {
+  }
+
+  void Initialize() { this->Result.Local()->Allocate(128); }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkIdList* result = this->Result.Local();
+    std::vector<Batch>& batches = this->Batches.Local();
+    batches.emplace_back();
+    Batch& batch = batches.back();
+    batch.BeginQuery = ptId;
+
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      this->Points.GetPoint(ptId, x);
+      result->Reset();
+      this->Query(x, result);
+      const vtkIdType numIds = result->GetNumberOfIds();
+      this->Counts[ptId] = numIds;
+      batch.Ids.insert(batch.Ids.end(), result->GetPointer(0), result->GetPointer(0) + numIds);
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Finds a list of points for each query point. The ids found for query
+// point i are ids[offsets[i]] to ids[offsets[i + 1] - 1]. TQuery provides
+// void operator()(const double x[3], vtkIdList* result).
+template <typename TQuery>
+void FindPointListsInParallel(
+  vtkDataArray* points, TQuery& query, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  const vtkIdType numQueries = points->GetNumberOfTuples();
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfValues(numQueries + 1);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  offsetsPtr[numQueries] = 0;
+
+  FindPointLists<TQuery> finder(points, query, offsetsPtr);
+  vtkSMPTools::For(0, numQueries, finder);
+
+  // The counts become the offsets.
+  vtkSMPTools::ExclusiveScan(offsetsPtr, offsetsPtr + numQueries + 1, offsetsPtr, vtkIdType(0));
+
+  typedef typename FindPointLists<TQuery>::Batch Batch;
+  std::vector<const Batch*> batches;
+  for (auto threadBatches = finder.Batches.begin(); threadBatches != finder.Batches.end();
+       ++threadBatches)
+  {
+    for (const Batch& batch : *threadBatches)
+    {
+      batches.push_back(&batch);
+    }
+  }
+
+  ids->SetNumberOfComponents(1);
+  ids->SetNumberOfValues(offsetsPtr[numQueries]);
+  vtkIdType* idsPtr = ids->GetPointer(0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(batches.size()),
+    [&](vtkIdType batchId, vtkIdType endBatchId) {
+      for (; batchId < endBatchId; ++batchId)
+      {
+        const Batch* batch = batches[batchId];
+        std::copy(batch->Ids.begin(), batch->Ids.end(), idsPtr + offsetsPtr[batch->BeginQuery]);
+      }
+    });
+}
+
+} // anonymous namespace
+
+#endif // vtkAbstractPointLocatorInternal_h
+// VTK-HeaderTest-Exclude: vtkAbstractPointLocatorInternal.h
@@ -0,0 +1,1124 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBVHCellLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkBVHCellLocator);
+
+//------------------------------------------------------------------------------
+// A node of the hierarchy. The first child of an inner node follows it, and
+// its Offset is the index of its second child. A leaf refers to the cells
+// Offset to Offset + Count - 1 of vtkBVHTree::CellIds.
+struct vtkBVHNode
+{
+  float Min[3];
+  float Max[3];
+  vtkTypeUInt32 Offset;
+  vtkTypeUInt32 Count; // 0 for inner nodes
+
+  bool IsLeaf() const { return this->Count > 0; }
+};
+
+struct vtkBVHTree
+{
+  std::vector<vtkBVHNode> Nodes;
+  std::vector<vtkIdType> CellIds;
+  // The bounds of the cells in the order of CellIds: min x, y, z then max
+  // x, y, z, rounded outwards.
+  std::vector<float> CellBounds;
+};
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+// Reads the end points of the segments, directly from float and double
+// arrays.
+struct SegmentPoints
+{
+  vtkDataArray* Points;
+  const float* FloatPoints;
+  const double* DoublePoints;
+
+  SegmentPoints(vtkDataArray* points)
+    : Points(points)
+    , FloatPoints(nullptr)
+    , DoublePoints(nullptr)
+  {
+    if (points->HasStandardMemoryLayout() && points->GetDataType() == VTK_FLOAT)
+    {
+      this->FloatPoints = static_cast<const float*>(points->GetVoidPointer(0));
+    }
+    else if (points->HasStandardMemoryLayout() && points->GetDataType() == VTK_DOUBLE)
+    {
+      this->DoublePoints = static_cast<const double*>(points->GetVoidPointer(0));
+    }
+  }
+
+  void GetPoint(vtkIdType ptId, double x[3]) const
+  {
+    if (this->DoublePoints)
+    {
+      std::copy(this->DoublePoints + 3 * ptId, this->DoublePoints + 3 * ptId + 3, x);
+    }
+    else if (this->FloatPoints)
+    {
+      std::copy(this->FloatPoints + 3 * ptId, this->FloatPoints + 3 * ptId + 3, x);
+    }
+    else
+    {
+      this->Points->GetTuple(ptId, x);
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Single precision bounds enclosing double precision ones.
+float RoundDown(double value)
+{
+  float rounded = static_cast<float>(value);
+  if (rounded > value)
+  {
+    rounded = std::nextafter(rounded, -std::numeric_limits<float>::infinity());
+  }
+  return rounded;
+}
+
+float RoundUp(double value)
+{
+  float rounded = static_cast<float>(value);
+  if (rounded < value)
+  {
+    rounded = std::nextafter(rounded, std::numeric_limits<float>::infinity());
+  }
+  return rounded;
+}
+
+//------------------------------------------------------------------------------
+// Builds the hierarchy top down, splitting the nodes with the surface area
+// heuristic evaluated on NumberOfBins bins of the cell centers.
+class vtkBVHBuilder
+{
+public:
+  struct BuildCell
+  {
+    float Min[3];
+    float Max[3];
+    vtkIdType Id;
+
+    // Twice the center, which orders the cells as well.
+    float Center(int axis) const { return this->Min[axis] + this->Max[axis]; }
+  };
+
+  // A range of cells whose node is built later.
+  struct Subtree
+  {
+    vtkIdType Begin;
+    vtkIdType End;
+  };
+
+  static const int NumberOfBins = 16;
+  // Count of the placeholder nodes of the subtrees built later.
+  static const vtkTypeUInt32 SubtreeCount = VTK_UNSIGNED_INT_MAX;
+
+  std::vector<BuildCell> Cells;
+  vtkIdType LeafSize;
+
+  void ComputeCellBounds(vtkDataSet* dataSet)
+  {
+    const vtkIdType numCells = dataSet->GetNumberOfCells();
+    this->Cells.resize(numCells);
+
+    // Call GetCellBounds() once on this thread so that its side effects (for
+    // example building the cells of a vtkPolyData) do not happen in parallel.
+    double bounds[6];
+    dataSet->GetCellBounds(0, bounds);
+    vtkSMPTools::For(0, numCells, [this, dataSet](vtkIdType cellId, vtkIdType endCellId) {
+      double cellBounds[6];
+      for (; cellId < endCellId; ++cellId)
+      {
+        dataSet->GetCellBounds(cellId, cellBounds);
+        BuildCell& cell = this->Cells[cellId];
+        for (int i = 0; i < 3; ++i)
+        {
+          cell.Min[i] = RoundDown(cellBounds[2 * i]);
+          cell.Max[i] = RoundUp(cellBounds[2 * i + 1]);
+        }
+        cell.Id = cellId;
+      }
+    });
+  }
+
+  // Builds the nodes of the cells begin to end - 1 into nodes, depth first.
+  // When subtrees is given, the nodes at depth splitDepth are only
+  // placeholders, whose ranges of cells are appended to subtrees.
+  void BuildNode(std::vector<vtkBVHNode>& nodes, vtkIdType begin, vtkIdType end, int depth,
+    std::vector<Subtree>* subtrees, int splitDepth)
+  {
+    const std::size_t index = nodes.size();
+    nodes.emplace_back();
+    if (subtrees && depth == splitDepth)
+    {
+      nodes[index].Offset = static_cast<vtkTypeUInt32>(subtrees->size());
+      nodes[index].Count = SubtreeCount;
+      Subtree subtree = { begin, end };
+      subtrees->push_back(subtree);
+      return;
+    }
+
+    float centerMin[3], centerMax[3];
+    {
+      vtkBVHNode& node = nodes[index];
+      for (int i = 0; i < 3; ++i)
+      {
+        node.Min[i] = centerMin[i] = std::numeric_limits<float>::max();
+        node.Max[i] = centerMax[i] = -std::numeric_limits<float>::max();
+      }
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        const BuildCell& cell = this->Cells[cellId];
+        for (int i = 0; i < 3; ++i)
+        {
+          node.Min[i] = std::min(node.Min[i], cell.Min[i]);
+          node.Max[i] = std::max(node.Max[i], cell.Max[i]);
+          centerMin[i] = std::min(centerMin[i], cell.Center(i));
+          centerMax[i] = std::max(centerMax[i], cell.Center(i));
+        }
+      }
+    }
+
+    const vtkIdType numCells = end - begin;
+    if (numCells <= this->LeafSize)
+    {
+      nodes[index].Offset = static_cast<vtkTypeUInt32>(begin);
+      nodes[index].Count = static_cast<vtkTypeUInt32>(numCells);
+      return;
+    }
+
+    const vtkIdType mid = this->Partition(begin, end, centerMin, centerMax);
+    nodes[index].Count = 0;
+    this->BuildNode(nodes, begin, mid, depth + 1, subtrees, splitDepth);
+    nodes[index].Offset = static_cast<vtkTypeUInt32>(nodes.size());
+    this->BuildNode(nodes, mid, end, depth + 1, subtrees, splitDepth);
+  }
+
+  // Splits the cells begin to end - 1 where the surface area heuristic is
+  // the lowest, and returns the first cell of the second half.
+  vtkIdType Partition(
+    vtkIdType begin, vtkIdType end, const float centerMin[3], const float centerMax[3])
+  {
+    // Bin the cells along the three axes at once.
+    vtkIdType counts[3][NumberOfBins] = { { 0 } };
+    float binMin[3][NumberOfBins][3], binMax[3][NumberOfBins][3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      for (int bin = 0; bin < NumberOfBins; ++bin)
+      {
+        ResetBox(binMin[axis][bin], binMax[axis][bin]);
+      }
+    }
+    float scales[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      scales[axis] = centerMax[axis] > centerMin[axis]
+        ? NumberOfBins / (centerMax[axis] - centerMin[axis])
+        : 0.0f;
+    }
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      const BuildCell& cell = this->Cells[cellId];
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        const int bin = GetBin(cell, axis, centerMin, scales);
+        ++counts[axis][bin];
+        GrowBox(binMin[axis][bin], binMax[axis][bin], cell.Min, cell.Max);
+      }
+    }
+
+    double bestCost = std::numeric_limits<double>::max();
+    int bestAxis = -1;
+    int bestBin = 0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (scales[axis] == 0.0f)
+      {
+        continue;
+      }
+
+      // Sweep from the right to get the cost of the right halves, then from
+      // the left.
+      double rightCosts[NumberOfBins];
+      float boxMin[3], boxMax[3];
+      vtkIdType count = 0;
+      ResetBox(boxMin, boxMax);
+      for (int bin = NumberOfBins - 1; bin > 0; --bin)
+      {
+        count += counts[axis][bin];
+        GrowBox(boxMin, boxMax, binMin[axis][bin], binMax[axis][bin]);
+        rightCosts[bin] = count * HalfArea(boxMin, boxMax);
+      }
+      count = 0;
+      ResetBox(boxMin, boxMax);
+      for (int bin = 0; bin < NumberOfBins - 1; ++bin)
+      {
+        count += counts[axis][bin];
+        GrowBox(boxMin, boxMax, binMin[axis][bin], binMax[axis][bin]);
+        if (count == 0 || count == end - begin)
+        {
+          continue;
+        }
+        const double cost = count * HalfArea(boxMin, boxMax) + rightCosts[bin + 1];
+        if (cost < bestCost)
+        {
+          bestCost = cost;
+          bestAxis = axis;
+          bestBin = bin;
+        }
+      }
+    }
+
+    if (bestAxis < 0)
+    {
+      // All the centers are the same: split the range in two.
+      return begin + (end - begin) / 2;
+    }
+    BuildCell* first = this->Cells.data() + begin;
+    BuildCell* last = this->Cells.data() + end;
+    return std::partition(first, last,
+             [&](const BuildCell& cell) {
+               return GetBin(cell, bestAxis, centerMin, scales) <= bestBin;
+             }) -
+      this->Cells.data();
+  }
+
+  static int GetBin(
+    const BuildCell& cell, int axis, const float centerMin[3], const float scales[3])
+  {
+    const int bin = static_cast<int>((cell.Center(axis) - centerMin[axis]) * scales[axis]);
+    return std::max(0, std::min(NumberOfBins - 1, bin));
+  }
+
+  static void ResetBox(float boxMin[3], float boxMax[3])
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      boxMin[i] = std::numeric_limits<float>::max();
+      boxMax[i] = -std::numeric_limits<float>::max();
+    }
+  }
+
+  static void GrowBox(float boxMin[3], float boxMax[3], const float min[3], const float max[3])
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      boxMin[i] = std::min(boxMin[i], min[i]);
+      boxMax[i] = std::max(boxMax[i], max[i]);
+    }
+  }
+
+  static double HalfArea(const float boxMin[3], const float boxMax[3])
+  {
+    if (boxMin[0] > boxMax[0])
+    {
+      return 0.0;
+    }
+    const double dx = static_cast<double>(boxMax[0]) - boxMin[0];
+    const double dy = static_cast<double>(boxMax[1]) - boxMin[1];
+    const double dz = static_cast<double>(boxMax[2]) - boxMin[2];
+    return dx * dy + dy * dz + dz * dx;
+  }
+
+  // Builds the first levels of the hierarchy, then the subtrees below them
+  // in parallel. Each subtree works on its own range of cells, so that the
+  // hierarchy is the same as the one built serially.
+  void Build(vtkBVHTree* tree)
+  {
+    const vtkIdType numCells = static_cast<vtkIdType>(this->Cells.size());
+    int splitDepth = 0;
+    while ((1 << splitDepth) < 8 * vtkSMPTools::GetEstimatedNumberOfThreads() && splitDepth < 12)
+    {
+      ++splitDepth;
+    }
+
+    std::vector<vtkBVHNode> topNodes;
+    std::vector<Subtree> subtrees;
+    this->BuildNode(topNodes, 0, numCells, 0, &subtrees, splitDepth);
+
+    std::vector<std::vector<vtkBVHNode>> subtreeNodes(subtrees.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()),
+      [&](vtkIdType subtreeId, vtkIdType endSubtreeId) {
+        for (; subtreeId < endSubtreeId; ++subtreeId)
+        {
+          this->BuildNode(subtreeNodes[subtreeId], subtrees[subtreeId].Begin,
+            subtrees[subtreeId].End, 0, nullptr, 0);
+        }
+      });
+
+    tree->Nodes.reserve(topNodes.size() +
+      std::accumulate(subtreeNodes.begin(), subtreeNodes.end(), std::size_t(0),
+        [](std::size_t size, const std::vector<vtkBVHNode>& nodes) { return size + nodes.size(); }));
+    this->Assemble(topNodes, 0, subtreeNodes, tree->Nodes);
+
+    tree->CellIds.resize(numCells);
+    tree->CellBounds.resize(6 * numCells);
+    vtkSMPTools::For(0, numCells, [this, tree](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        const BuildCell& cell = this->Cells[cellId];
+        tree->CellIds[cellId] = cell.Id;
+        std::copy(cell.Min, cell.Min + 3, &tree->CellBounds[6 * cellId]);
+        std::copy(cell.Max, cell.Max + 3, &tree->CellBounds[6 * cellId + 3]);
+      }
+    });
+  }
+
+  // Appends the node topNodes[index] to nodes, depth first, replacing the
+  // placeholders by their subtrees.
+  static void Assemble(const std::vector<vtkBVHNode>& topNodes, std::size_t index,
+    const std::vector<std::vector<vtkBVHNode>>& subtreeNodes, std::vector<vtkBVHNode>& nodes)
+  {
+    const vtkBVHNode& topNode = topNodes[index];
+    if (topNode.Count == SubtreeCount)
+    {
+      const vtkTypeUInt32 shift = static_cast<vtkTypeUInt32>(nodes.size());
+      for (vtkBVHNode node : subtreeNodes[topNode.Offset])
+      {
+        if (!node.IsLeaf())
+        {
+          node.Offset += shift;
+        }
+        nodes.push_back(node);
+      }
+    }
+    else if (topNode.IsLeaf())
+    {
+      nodes.push_back(topNode);
+    }
+    else
+    {
+      const std::size_t nodeId = nodes.size();
+      nodes.push_back(topNode);
+      Assemble(topNodes, index + 1, subtreeNodes, nodes);
+      nodes[nodeId].Offset = static_cast<vtkTypeUInt32>(nodes.size());
+      Assemble(topNodes, topNode.Offset, subtreeNodes, nodes);
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+bool PointInBox(const double x[3], const float* min, const float* max, double tol)
+{
+  return x[0] >= min[0] - tol && x[0] <= max[0] + tol && x[1] >= min[1] - tol &&
+    x[1] <= max[1] + tol && x[2] >= min[2] - tol && x[2] <= max[2] + tol;
+}
+
+double Distance2ToBox(const double x[3], const float* min, const float* max)
+{
+  double dist2 = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    const double d = x[i] < min[i] ? min[i] - x[i] : (x[i] > max[i] ? x[i] - max[i] : 0.0);
+    dist2 += d * d;
+  }
+  return dist2;
+}
+
+//------------------------------------------------------------------------------
+// A packet of segments, stored component by component so that the box tests
+// loop over the segments of the packet. Each segment keeps its closest
+// intersection: the smallest t, then the smallest cell id.
+struct RayPacket
+{
+  static const int Size = 8;
+
+  int NumberOfRays;
+  double Tolerance;
+  double Origin[3][Size];
+  double InverseDirection[3][Size];
+  double P1[Size][3];
+  double P2[Size][3];
+  double T[Size];
+  vtkIdType CellId[Size];
+  double X[Size][3];
+  double PCoords[Size][3];
+  int SubId[Size];
+
+  RayPacket(double tol)
+    : NumberOfRays(0)
+    , Tolerance(tol)
+  {
+  }
+
+  void AddRay(const double p1[3], const double p2[3])
+  {
+    const int ray = this->NumberOfRays++;
+    for (int i = 0; i < 3; ++i)
+    {
+      this->P1[ray][i] = p1[i];
+      this->P2[ray][i] = p2[i];
+      this->Origin[i][ray] = p1[i];
+      const double direction = p2[i] - p1[i];
+      // 0 marks the segments parallel to the slabs of the axis.
+      this->InverseDirection[i][ray] = direction != 0.0 ? 1.0 / direction : 0.0;
+    }
+    this->T[ray] = 1.0;
+    this->CellId[ray] = -1;
+  }
+
+  // Returns the first segment of a non empty set of segments.
+  static int FirstRay(unsigned int rays)
+  {
+    int ray = 0;
+    while (!((rays >> ray) & 1u))
+    {
+      ++ray;
+    }
+    return ray;
+  }
+
+  // Tests the slabs of a box against a segment, up to its current closest
+  // intersection.
+  bool IntersectSlabs(const double lo[3], const double hi[3], int ray) const
+  {
+    double tNear = 0.0;
+    double tFar = this->T[ray];
+    for (int i = 0; i < 3; ++i)
+    {
+      const double inverse = this->InverseDirection[i][ray];
+      const double d1 = lo[i] - this->Origin[i][ray];
+      const double d2 = hi[i] - this->Origin[i][ray];
+      double tEnter = std::min(d1 * inverse, d2 * inverse);
+      double tExit = std::max(d1 * inverse, d2 * inverse);
+      if (inverse == 0.0)
+      {
+        // Parallel segments are within the slab everywhere, or nowhere.
+        const bool inside = d1 <= 0.0 && d2 >= 0.0;
+        tEnter = inside ? -VTK_DOUBLE_MAX : VTK_DOUBLE_MAX;
+        tExit = -tEnter;
+      }
+      tNear = std::max(tNear, tEnter);
+      tFar = std::min(tFar, tExit);
+    }
+    return tNear <= tFar;
+  }
+
+  // Tests a box, inflated by the tolerance, against the non empty set of
+  // segments rays (bit i for segment i). Returns the segments hitting it.
+  unsigned int IntersectBox(const float* min, const float* max, unsigned int rays) const
+  {
+    double lo[3], hi[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      lo[i] = min[i] - this->Tolerance;
+      hi[i] = max[i] + this->Tolerance;
+    }
+    if ((rays & (rays - 1)) == 0)
+    {
+      return this->IntersectSlabs(lo, hi, FirstRay(rays)) ? rays : 0;
+    }
+    unsigned int hits = 0;
+    for (int ray = 0; ray < this->NumberOfRays; ++ray)
+    {
+      hits |= static_cast<unsigned int>(this->IntersectSlabs(lo, hi, ray)) << ray;
+    }
+    return hits & rays;
+  }
+
+  // Intersects the cells of a leaf with the segments rays.
+  void IntersectLeaf(const vtkBVHTree* tree, const vtkBVHNode& leaf, unsigned int rays,
+    vtkDataSet* dataSet, vtkGenericCell* cell)
+  {
+    for (vtkTypeUInt32 i = leaf.Offset; i < leaf.Offset + leaf.Count; ++i)
+    {
+      const float* bounds = &tree->CellBounds[6 * i];
+      const unsigned int hits = this->IntersectBox(bounds, bounds + 3, rays);
+      if (!hits)
+      {
+        continue;
+      }
+      const vtkIdType cellId = tree->CellIds[i];
+      dataSet->GetCell(cellId, cell);
+      for (int ray = 0; ray < this->NumberOfRays; ++ray)
+      {
+        double t, x[3], pcoords[3];
+        int subId;
+        if (((hits >> ray) & 1u) &&
+          cell->IntersectWithLine(this->P1[ray], this->P2[ray], this->Tolerance, t, x, pcoords,
+            subId) &&
+          (t < this->T[ray] ||
+            (t == this->T[ray] && (this->CellId[ray] < 0 || cellId < this->CellId[ray]))))
+        {
+          this->T[ray] = t;
+          this->CellId[ray] = cellId;
+          this->SubId[ray] = subId;
+          std::copy(x, x + 3, this->X[ray]);
+          std::copy(pcoords, pcoords + 3, this->PCoords[ray]);
+        }
+      }
+    }
+  }
+
+  // A node to visit, and the segments which reached it.
+  struct Entry
+  {
+    vtkTypeUInt32 NodeId;
+    unsigned int Rays;
+  };
+
+  // Traverses the hierarchy once for all the segments of the packet. Each
+  // node is only tested against the segments which hit its parent, and its
+  // child nearer to the origin of the first of them is visited first.
+  void Intersect(
+    const vtkBVHTree* tree, vtkDataSet* dataSet, vtkGenericCell* cell, std::vector<Entry>& stack)
+  {
+    stack.clear();
+    Entry root = { 0, (1u << this->NumberOfRays) - 1 };
+    stack.push_back(root);
+    while (!stack.empty())
+    {
+      const Entry entry = stack.back();
+      stack.pop_back();
+      const vtkBVHNode& node = tree->Nodes[entry.NodeId];
+      const unsigned int rays = this->IntersectBox(node.Min, node.Max, entry.Rays);
+      if (!rays)
+      {
+        continue;
+      }
+      if (node.IsLeaf())
+      {
+        this->IntersectLeaf(tree, node, rays, dataSet, cell);
+        continue;
+      }
+      const vtkBVHNode& first = tree->Nodes[entry.NodeId + 1];
+      const vtkBVHNode& second = tree->Nodes[node.Offset];
+      const int ray = FirstRay(rays);
+      double order = 0.0;
+      for (int i = 0; i < 3; ++i)
+      {
+        order += (static_cast<double>(first.Min[i]) + first.Max[i] - second.Min[i] -
+                   second.Max[i]) *
+          (this->P2[ray][i] - this->P1[ray][i]);
+      }
+      Entry firstEntry = { entry.NodeId + 1, rays };
+      Entry secondEntry = { node.Offset, rays };
+      if (order > 0.0)
+      {
+        std::swap(firstEntry, secondEntry);
+      }
+      stack.push_back(secondEntry);
+      stack.push_back(firstEntry);
+    }
+  }
+};
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::vtkBVHCellLocator()
+{
+  this->NumberOfCellsPerNode = 8;
+  this->Tree = nullptr;
+}
+
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::~vtkBVHCellLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FreeSearchStructure()
+{
+  delete this->Tree;
+  this->Tree = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocator()
+{
+  if (this->LazyEvaluation)
+  {
+    return;
+  }
+  this->ForceBuildLocator();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocatorIfNeeded()
+{
+  // A hierarchy which was built is kept until BuildLocator() is called,
+  // unless LazyEvaluation is on.
+  if (!this->Tree || this->LazyEvaluation)
+  {
+    this->ForceBuildLocator();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::ForceBuildLocator()
+{
+  // Do we need to build?
+  if (this->Tree && (this->BuildTime > this->MTime) &&
+    (this->BuildTime > this->DataSet->GetMTime()))
+  {
+    return;
+  }
+  if (this->Tree && this->UseExistingSearchStructure)
+  {
+    this->BuildTime.Modified();
+    vtkDebugMacro(<< "BuildLocator exited - UseExistingSearchStructure");
+    return;
+  }
+  this->BuildLocatorInternal();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocatorInternal()
+{
+  vtkIdType numCells;
+  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1)
+  {
+    vtkErrorMacro(<< "No cells to build");
+    return;
+  }
+  if (numCells >= static_cast<vtkIdType>(VTK_UNSIGNED_INT_MAX))
+  {
+    vtkErrorMacro(<< "Too many cells to build: " << numCells);
+    return;
+  }
+  vtkDebugMacro(<< "Building BVH cell locator for " << numCells << " cells");
+
+  this->FreeSearchStructure();
+  vtkBVHBuilder builder;
+  builder.LeafSize = this->NumberOfCellsPerNode;
+  builder.ComputeCellBounds(this->DataSet);
+  this->Tree = new vtkBVHTree;
+  builder.Build(this->Tree);
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::GetNumberOfNodes()
+{
+  return this->Tree ? static_cast<vtkIdType>(this->Tree->Nodes.size()) : 0;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindCell(
+  double pos[3], double, vtkGenericCell* cell, double pcoords[3], double* weights)
+{
+  this->BuildLocatorIfNeeded();
+  if (!this->Tree)
+  {
+    return -1;
+  }
+
+  const vtkBVHTree* tree = this->Tree;
+  const double tol = this->Tolerance;
+  double dist2;
+  int subId;
+  std::vector<vtkTypeUInt32> stack(1, 0);
+  while (!stack.empty())
+  {
+    const vtkTypeUInt32 nodeId = stack.back();
+    stack.pop_back();
+    const vtkBVHNode& node = tree->Nodes[nodeId];
+    if (!PointInBox(pos, node.Min, node.Max, tol))
+    {
+      continue;
+    }
+    if (!node.IsLeaf())
+    {
+      stack.push_back(node.Offset);
+      stack.push_back(nodeId + 1);
+      continue;
+    }
+    for (vtkTypeUInt32 i = node.Offset; i < node.Offset + node.Count; ++i)
+    {
+      const float* bounds = &tree->CellBounds[6 * i];
+      if (PointInBox(pos, bounds, bounds + 3, tol))
+      {
+        this->DataSet->GetCell(tree->CellIds[i], cell);
+        if (cell->EvaluatePosition(pos, nullptr, subId, pcoords, dist2, weights) == 1)
+        {
+          return tree->CellIds[i];
+        }
+      }
+    }
+  }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsWithinBounds(double* bbox, vtkIdList* cells)
+{
+  cells->Reset();
+  this->BuildLocatorIfNeeded();
+  if (!this->Tree)
+  {
+    return;
+  }
+
+  const vtkBVHTree* tree = this->Tree;
+  auto overlaps = [bbox](const float* min, const float* max) {
+    return min[0] <= bbox[1] && max[0] >= bbox[0] && min[1] <= bbox[3] && max[1] >= bbox[2] &&
+      min[2] <= bbox[5] && max[2] >= bbox[4];
+  };
+  std::vector<vtkTypeUInt32> stack(1, 0);
+  while (!stack.empty())
+  {
+    const vtkTypeUInt32 nodeId = stack.back();
+    stack.pop_back();
+    const vtkBVHNode& node = tree->Nodes[nodeId];
+    if (!overlaps(node.Min, node.Max))
+    {
+      continue;
+    }
+    if (!node.IsLeaf())
+    {
+      stack.push_back(node.Offset);
+      stack.push_back(nodeId + 1);
+      continue;
+    }
+    for (vtkTypeUInt32 i = node.Offset; i < node.Offset + node.Count; ++i)
+    {
+      const float* bounds = &tree->CellBounds[6 * i];
+      if (overlaps(bounds, bounds + 3))
+      {
+        cells->InsertNextId(tree->CellIds[i]);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsAlongLine(
+  const double p1[3], const double p2[3], double tolerance, vtkIdList* cells)
+{
+  cells->Reset();
+  this->BuildLocatorIfNeeded();
+  if (!this->Tree)
+  {
+    return;
+  }
+
+  const vtkBVHTree* tree = this->Tree;
+  RayPacket ray(tolerance);
+  ray.AddRay(p1, p2);
+  std::vector<vtkTypeUInt32> stack(1, 0);
+  while (!stack.empty())
+  {
+    const vtkTypeUInt32 nodeId = stack.back();
+    stack.pop_back();
+    const vtkBVHNode& node = tree->Nodes[nodeId];
+    if (!ray.IntersectBox(node.Min, node.Max, 1u))
+    {
+      continue;
+    }
+    if (!node.IsLeaf())
+    {
+      stack.push_back(node.Offset);
+      stack.push_back(nodeId + 1);
+      continue;
+    }
+    for (vtkTypeUInt32 i = node.Offset; i < node.Offset + node.Count; ++i)
+    {
+      const float* bounds = &tree->CellBounds[6 * i];
+      if (ray.IntersectBox(bounds, bounds + 3, 1u))
+      {
+        cells->InsertNextId(tree->CellIds[i]);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
+  vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2)
+{
+  int inside;
+  double point[3] = { x[0], x[1], x[2] };
+  this->FindClosestPointWithinRadius(
+    point, VTK_DOUBLE_MAX, closestPoint, cell, cellId, subId, dist2, inside);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindClosestPointWithinRadius(double x[3], double radius,
+  double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2,
+  int& inside)
+{
+  this->BuildLocatorIfNeeded();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+
+  const vtkBVHTree* tree = this->Tree;
+  std::vector<double> weights(8);
+  double pcoords[3], point[3], cellDist2;
+  int cellSubId;
+  double minDist2 = radius < std::sqrt(VTK_DOUBLE_MAX) ? radius * radius : VTK_DOUBLE_MAX;
+  vtkIdType closestCellId = -1;
+
+  // The nodes are visited depth first, the nearer child first, and skipped
+  // when they are further than the closest point found so far.
+  std::vector<std::pair<vtkTypeUInt32, double>> stack(1, std::make_pair(vtkTypeUInt32(0), 0.0));
+  while (!stack.empty())
+  {
+    const vtkTypeUInt32 nodeId = stack.back().first;
+    const double nodeDist2 = stack.back().second;
+    stack.pop_back();
+    if (nodeDist2 >= minDist2)
+    {
+      continue;
+    }
+    const vtkBVHNode& node = tree->Nodes[nodeId];
+    if (!node.IsLeaf())
+    {
+      const vtkBVHNode& first = tree->Nodes[nodeId + 1];
+      const vtkBVHNode& second = tree->Nodes[node.Offset];
+      const double firstDist2 = Distance2ToBox(x, first.Min, first.Max);
+      const double secondDist2 = Distance2ToBox(x, second.Min, second.Max);
+      if (firstDist2 <= secondDist2)
+      {
+        stack.push_back(std::make_pair(node.Offset, secondDist2));
+        stack.push_back(std::make_pair(nodeId + 1, firstDist2));
+      }
+      else
+      {
+        stack.push_back(std::make_pair(nodeId + 1, firstDist2));
+        stack.push_back(std::make_pair(node.Offset, secondDist2));
+      }
+      continue;
+    }
+    for (vtkTypeUInt32 i = node.Offset; i < node.Offset + node.Count; ++i)
+    {
+      const float* bounds = &tree->CellBounds[6 * i];
+      if (Distance2ToBox(x, bounds, bounds + 3) >= minDist2)
+      {
+        continue;
+      }
+      this->DataSet->GetCell(tree->CellIds[i], cell);
+
+      // make sure we have enough storage space for the weights
+      const std::size_t numPoints = static_cast<std::size_t>(cell->GetNumberOfPoints());
+      if (numPoints > weights.size())
+      {
+        weights.resize(2 * numPoints);
+      }
+      // stat==(-1) is numerical error; stat==0 means outside; stat=1 means inside
+      const int stat =
+        cell->EvaluatePosition(x, point, cellSubId, pcoords, cellDist2, weights.data());
+      if (stat != -1 && cellDist2 < minDist2)
+      {
+        minDist2 = cellDist2;
+        closestCellId = tree->CellIds[i];
+        inside = stat;
+        subId = cellSubId;
+        closestPoint[0] = point[0];
+        closestPoint[1] = point[1];
+        closestPoint[2] = point[2];
+      }
+    }
+  }
+
+  if (closestCellId < 0)
+  {
+    return 0;
+  }
+  cellId = closestCellId;
+  dist2 = minDist2;
+  this->DataSet->GetCell(closestCellId, cell);
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(const double a0[3], const double a1[3], double tol,
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+{
+  cellId = -1;
+  this->BuildLocatorIfNeeded();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+
+  RayPacket ray(tol);
+  ray.AddRay(a0, a1);
+  std::vector<RayPacket::Entry> stack;
+  ray.Intersect(this->Tree, this->DataSet, cell, stack);
+  if (ray.CellId[0] < 0)
+  {
+    return 0;
+  }
+  cellId = ray.CellId[0];
+  t = ray.T[0];
+  subId = ray.SubId[0];
+  std::copy(ray.X[0], ray.X[0] + 3, x);
+  std::copy(ray.PCoords[0], ray.PCoords[0] + 3, pcoords);
+  this->DataSet->GetCell(cellId, cell);
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::IntersectWithLineBatch(vtkDataArray* p1, vtkDataArray* p2, double tol,
+  vtkIdTypeArray* cellIds, vtkDoubleArray* t, vtkDoubleArray* x)
+{
+  if (!p1 || !p2 || p1->GetNumberOfComponents() != 3 || p2->GetNumberOfComponents() != 3 ||
+    p1->GetNumberOfTuples() != p2->GetNumberOfTuples())
+  {
+    vtkErrorMacro(<< "The end points of the segments must be two arrays of 3 components and "
+                     "of the same number of tuples");
+    return;
+  }
+  const vtkIdType numRays = p1->GetNumberOfTuples();
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfValues(numRays);
+  if (t)
+  {
+    t->SetNumberOfComponents(1);
+    t->SetNumberOfValues(numRays);
+  }
+  if (x)
+  {
+    x->SetNumberOfComponents(3);
+    x->SetNumberOfTuples(numRays);
+  }
+
+  this->BuildLocatorIfNeeded();
+  if (!this->Tree)
+  {
+    cellIds->FillValue(-1);
+    return;
+  }
+
+  const vtkBVHTree* tree = this->Tree;
+  vtkDataSet* dataSet = this->DataSet;
+  const SegmentPoints points1(p1);
+  const SegmentPoints points2(p2);
+  vtkIdType* cellIdsPtr = cellIds->GetPointer(0);
+  double* tPtr = t ? t->GetPointer(0) : nullptr;
+  double* xPtr = x ? x->GetPointer(0) : nullptr;
+  vtkSMPThreadLocalObject<vtkGenericCell> threadCell;
+  vtkSMPThreadLocal<std::vector<RayPacket::Entry>> threadStack;
+
+  const vtkIdType numPackets = (numRays + RayPacket::Size - 1) / RayPacket::Size;
+  vtkSMPTools::For(0, numPackets, [&](vtkIdType packetId, vtkIdType endPacketId) {
+    vtkGenericCell* cell = threadCell.Local();
+    std::vector<RayPacket::Entry>& stack = threadStack.Local();
+    for (; packetId < endPacketId; ++packetId)
+    {
+      const vtkIdType firstRay = packetId * RayPacket::Size;
+      const vtkIdType endRay = std::min(firstRay + RayPacket::Size, numRays);
+      RayPacket packet(tol);
+      for (vtkIdType rayId = firstRay; rayId < endRay; ++rayId)
+      {
+        double a0[3], a1[3];
+        points1.GetPoint(rayId, a0);
+        points2.GetPoint(rayId, a1);
+        packet.AddRay(a0, a1);
+      }
+      packet.Intersect(tree, dataSet, cell, stack);
+      for (vtkIdType rayId = firstRay; rayId < endRay; ++rayId)
+      {
+        const int ray = static_cast<int>(rayId - firstRay);
+        cellIdsPtr[rayId] = packet.CellId[ray];
+        if (tPtr)
+        {
+          tPtr[rayId] = packet.T[ray];
+        }
+        if (xPtr && packet.CellId[ray] >= 0)
+        {
+          std::copy(packet.X[ray], packet.X[ray] + 3, xPtr + 3 * rayId);
+        }
+      }
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::GenerateRepresentation(int level, vtkPolyData* pd)
+{
+  this->BuildLocatorIfNeeded();
+  if (!this->Tree)
+  {
+    return;
+  }
+
+  vtkNew<vtkPoints> pts;
+  pts->SetDataTypeToFloat();
+  vtkNew<vtkCellArray> polys;
+  const vtkIdType faces[6][4] = { { 0, 2, 3, 1 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 },
+    { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+
+  std::vector<std::pair<vtkTypeUInt32, int>> stack(1, std::make_pair(vtkTypeUInt32(0), 0));
+  while (!stack.empty())
+  {
+    const vtkTypeUInt32 nodeId = stack.back().first;
+    const int depth = stack.back().second;
+    stack.pop_back();
+    const vtkBVHNode& node = this->Tree->Nodes[nodeId];
+    if (depth < level && !node.IsLeaf())
+    {
+      stack.push_back(std::make_pair(node.Offset, depth + 1));
+      stack.push_back(std::make_pair(nodeId + 1, depth + 1));
+      continue;
+    }
+    const vtkIdType firstPoint = pts->GetNumberOfPoints();
+    for (int corner = 0; corner < 8; ++corner)
+    {
+      pts->InsertNextPoint((corner & 1) ? node.Max[0] : node.Min[0],
+        (corner & 2) ? node.Max[1] : node.Min[1], (corner & 4) ? node.Max[2] : node.Min[2]);
+    }
+    for (int face = 0; face < 6; ++face)
+    {
+      vtkIdType ids[4];
+      for (int i = 0; i < 4; ++i)
+      {
+        ids[i] = firstPoint + faces[face][i];
+      }
+      polys->InsertNextCell(4, ids);
+    }
+  }
+  pd->SetPoints(pts);
+  pd->SetPolys(polys);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number Of Nodes: " << this->GetNumberOfNodes() << "\n";
+}
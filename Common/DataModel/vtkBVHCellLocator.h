@@ -0,0 +1,207 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkBVHCellLocator
+ * @brief   cell locator based on a bounding volume hierarchy
+ *
+ * vtkBVHCellLocator is a type of vtkAbstractCellLocator which organizes the
+ * bounding boxes of the cells in a binary bounding volume hierarchy (BVH).
+ * The hierarchy is built top down using the surface area heuristic (SAH) on
+ * binned cell centers, and is stored as a flat array of 32 byte nodes in
+ * depth first order, the first child of a node following it. The leaves
+ * refer to a contiguous range of cell ids, stored along with the bounding
+ * boxes of their cells. The cell bounds are computed, and the subtrees below
+ * the first levels of the hierarchy are built, in parallel using vtkSMPTools.
+ *
+ * The hierarchy suits ray casting against large surfaces (picking, inside /
+ * outside tests), and supports IntersectWithLine(), FindCell(),
+ * FindClosestPoint() and FindClosestPointWithinRadius(). Rays are traversed
+ * in packets: IntersectWithLineBatch() intersects many segments at once,
+ * traversing the hierarchy once for every packet of consecutive segments and
+ * testing each node against the segments of the packet which reached it, in
+ * parallel over the packets. Packets work best when consecutive segments are coherent, as
+ * the rays of a camera or a regular sampling are.
+ *
+ * The closest intersection along a segment is returned; among intersections
+ * with the same parametric coordinate, the one with the smallest cell id is
+ * returned, so that results do not depend on the traversal order.
+ *
+ * As with vtkCellLocator, BuildLocator() does nothing when LazyEvaluation is
+ * on, the hierarchy then being built by the first query, and rebuilt by the
+ * queries once the locator or the dataset is modified. A hierarchy that is
+ * already built is kept when UseExistingSearchStructure is on. The queries
+ * build the hierarchy if it was never built, but do not rebuild it unless
+ * LazyEvaluation is on: call BuildLocator() after modifying the dataset.
+ *
+ * @warning
+ * This class *always* caches cell bounds, in single precision rounded
+ * outwards. The number of cells is limited to VTK_UNSIGNED_INT_MAX.
+ *
+ * @sa
+ * vtkAbstractCellLocator vtkStaticCellLocator vtkCellTreeLocator
+ * vtkModifiedBSPTree vtkOBBTree
+ */
+
+#ifndef vtkBVHCellLocator_h
+#define vtkBVHCellLocator_h
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkCommonDataModelModule.h" // For export macro
+
+class vtkDataArray;
+class vtkDoubleArray;
+class vtkIdTypeArray;
+struct vtkBVHTree;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkBVHCellLocator : public vtkAbstractCellLocator
+{
+public:
+  //@{
+  /**
+   * Standard methods to instantiate, print and obtain type-related information.
+   */
+  static vtkBVHCellLocator* New();
+  vtkTypeMacro(vtkBVHCellLocator, vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  using vtkAbstractCellLocator::FindClosestPoint;
+  using vtkAbstractCellLocator::FindClosestPointWithinRadius;
+
+  /**
+   * Test a point to find if it is inside a cell. Returns the cellId if inside
+   * or -1 if not.
+   */
+  vtkIdType FindCell(double pos[3], double vtkNotUsed, vtkGenericCell* cell, double pcoords[3],
+    double* weights) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  vtkIdType FindCell(double x[3]) override { return this->Superclass::FindCell(x); }
+
+  /**
+   * Return a list of unique cell ids whose bounding boxes intersect a given
+   * bounding box. The user must provide the vtkIdList to populate.
+   */
+  void FindCellsWithinBounds(double* bbox, vtkIdList* cells) override;
+
+  /**
+   * Given a finite line defined by the two points (p1,p2), return the list
+   * of unique cell ids whose bounding boxes, inflated by the tolerance, are
+   * intersected by the line. The user must provide the vtkIdList to populate.
+   */
+  void FindCellsAlongLine(
+    const double p1[3], const double p2[3], double tolerance, vtkIdList* cells) override;
+
+  /**
+   * Return the closest point and the cell which is closest to the point x.
+   * The closest point is somewhere on a cell, it need not be one of the
+   * vertices of the cell. If a cell is found, "cell" contains the points and
+   * ptIds for the cell "cellId" upon exit.
+   */
+  void FindClosestPoint(const double x[3], double closestPoint[3], vtkGenericCell* cell,
+    vtkIdType& cellId, int& subId, double& dist2) override;
+
+  /**
+   * Return the closest point within a specified radius and the cell which is
+   * closest to the point x. The closest point is somewhere on a cell, it
+   * need not be one of the vertices of the cell. This method returns 1 if a
+   * point is found within the specified radius. If there are no cells within
+   * the specified radius, the method returns 0 and the values of
+   * closestPoint, cellId, subId, and dist2 are undefined. If a closest point
+   * is found, "cell" contains the points and ptIds for the cell "cellId" upon
+   * exit, and inside returns the return value of the EvaluatePosition call
+   * to the closest cell; inside(=1) or outside(=0).
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius, double closestPoint[3],
+    vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2, int& inside) override;
+
+  /**
+   * Return intersection point (if any) AND the cell which was intersected by
+   * the finite line. The cell is returned as a cell id and as a generic cell.
+   */
+  int IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords, subId);
+  }
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId, vtkIdType& cellId) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
+  }
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(
+    const double p1[3], const double p2[3], vtkPoints* points, vtkIdList* cellIds) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, points, cellIds);
+  }
+
+  /**
+   * Intersect the segments (p1[i],p2[i]) with the cells, as IntersectWithLine()
+   * does for one segment. p1 and p2 have 3 components and the same number of
+   * tuples. For each segment, cellIds receives the intersected cell, or -1
+   * when the segment does not intersect any cell. If given, t receives the
+   * parametric coordinate of the intersection along the segment and x the
+   * intersection point (undefined when there is no intersection). The
+   * segments are processed in packets and in parallel.
+   */
+  void IntersectWithLineBatch(vtkDataArray* p1, vtkDataArray* p2, double tol,
+    vtkIdTypeArray* cellIds, vtkDoubleArray* t = nullptr, vtkDoubleArray* x = nullptr);
+
+  //@{
+  /**
+   * Satisfy vtkLocator abstract interface. GenerateRepresentation() produces
+   * the boxes of the nodes at the given depth, and of the leaves above it.
+   */
+  void GenerateRepresentation(int level, vtkPolyData* pd) override;
+  void FreeSearchStructure() override;
+  void BuildLocator() override;
+  virtual void BuildLocatorIfNeeded();
+  virtual void ForceBuildLocator();
+  virtual void BuildLocatorInternal();
+  //@}
+
+  /**
+   * Return the number of nodes of the hierarchy, or 0 if it is not built.
+   */
+  vtkIdType GetNumberOfNodes();
+
+protected:
+  vtkBVHCellLocator();
+  ~vtkBVHCellLocator() override;
+
+  vtkBVHTree* Tree;
+
+private:
+  vtkBVHCellLocator(const vtkBVHCellLocator&) = delete;
+  void operator=(const vtkBVHCellLocator&) = delete;
+};
+
+#endif
@@ -20,8 +20,10 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellLocator);
 
@@ -30,6 +32,22 @@ vtkStandardNewMacro(vtkCellLocator);
 
 typedef vtkIdList* vtkIdListPtr;
 
+namespace
+{
+// A cell overlapping a leaf octant, ordered by octant and then by cell.
+struct vtkCellFragment
+{
+  vtkIdType Octant;
+  vtkIdType CellId;
+
+  bool operator<(const vtkCellFragment& other) const
+  {
+    return this->Octant < other.Octant ||
+      (this->Octant == other.Octant && this->CellId < other.CellId);
+  }
+};
+}
+
 //------------------------------------------------------------------------------
 class vtkNeighborCells
 {
@@ -1189,13 +1207,11 @@ void vtkCellLocator::ForceBuildLocator()
 //
 void vtkCellLocator::BuildLocatorInternal()
 {
-  double length, cellBounds[6], *boundsPtr;
+  double length, cellBounds[6];
   vtkIdType numCells;
   int ndivs, product;
-  int i, j, k, ijkMin[3], ijkMax[3];
-  vtkIdType cellId, idx;
+  int i, j, k;
   int parentOffset;
-  vtkIdList* octant;
   int numCellsPerBucket = this->NumberOfCellsPerNode;
   int prod, numOctants;
   double hTol[3];
@@ -1273,61 +1289,122 @@ void vtkCellLocator::BuildLocatorInternal()
   }
 
   //  Insert each cell into the appropriate octant.  Make sure cell
-  //  falls within octant.
+  //  falls within octant. The octants overlapped by each cell are found in
+  //  parallel, as (octant, cell) fragments which are then sorted so that
+  //  every octant lists its cells in increasing order.
   //
   parentOffset = numOctants - (ndivs * ndivs * ndivs);
   product = ndivs * ndivs;
-  boundsPtr = cellBounds;
-  for (cellId = 0; cellId < numCells; cellId++)
+  if (!this->CellBounds)
   {
-    if (this->CellBounds)
+    // Call GetCellBounds() once on this thread so that its side effects do
+    // not happen in parallel.
+    this->DataSet->GetCellBounds(0, cellBounds);
+  }
+  std::vector<int> cellExtents(6 * numCells);
+  std::vector<vtkIdType> offsets(numCells + 1, 0);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    double threadCellBounds[6];
+    for (; cellId < endCellId; ++cellId)
     {
-      boundsPtr = this->CellBounds[cellId];
+      double* boundsPtr = threadCellBounds;
+      if (this->CellBounds)
+      {
+        boundsPtr = this->CellBounds[cellId];
+      }
+      else
+      {
+        this->DataSet->GetCellBounds(cellId, threadCellBounds);
+      }
+
+      // find min/max locations of bounding box
+      int* ijkMin = &cellExtents[6 * cellId];
+      int* ijkMax = ijkMin + 3;
+      for (int ii = 0; ii < 3; ii++)
+      {
+        ijkMin[ii] =
+          static_cast<int>((boundsPtr[2 * ii] - this->Bounds[2 * ii] - hTol[ii]) / this->H[ii]);
+        ijkMax[ii] =
+          static_cast<int>((boundsPtr[2 * ii + 1] - this->Bounds[2 * ii] + hTol[ii]) / this->H[ii]);
+
+        if (ijkMin[ii] < 0)
+        {
+          ijkMin[ii] = 0;
+        }
+        if (ijkMax[ii] >= ndivs)
+        {
+          ijkMax[ii] = ndivs - 1;
+        }
+      }
+      offsets[cellId] = static_cast<vtkIdType>(ijkMax[0] - ijkMin[0] + 1) *
+        (ijkMax[1] - ijkMin[1] + 1) * (ijkMax[2] - ijkMin[2] + 1);
     }
-    else
+  });
+  vtkSMPTools::ExclusiveScan(offsets.begin(), offsets.end(), offsets.begin(), vtkIdType(0));
+
+  // each octant between min/max point may have cell in it
+  std::vector<vtkCellFragment> fragments(offsets[numCells]);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
     {
-      this->DataSet->GetCellBounds(cellId, cellBounds);
+      const int* ijkMin = &cellExtents[6 * cellId];
+      const int* ijkMax = ijkMin + 3;
+      vtkCellFragment* fragment = fragments.data() + offsets[cellId];
+      for (int kk = ijkMin[2]; kk <= ijkMax[2]; kk++)
+      {
+        for (int jj = ijkMin[1]; jj <= ijkMax[1]; jj++)
+        {
+          for (int ii = ijkMin[0]; ii <= ijkMax[0]; ii++)
+          {
+            fragment->Octant = parentOffset + ii + jj * ndivs + kk * product;
+            fragment->CellId = cellId;
+            ++fragment;
+          }
+        }
+      }
     }
+  });
+  vtkSMPTools::Sort(fragments.data(), fragments.data() + fragments.size());
 
-    // find min/max locations of bounding box
-    for (i = 0; i < 3; i++)
+  // Each fragment starting the run of an octant fills the list of the octant.
+  const vtkIdType numFragments = static_cast<vtkIdType>(fragments.size());
+  vtkSMPTools::For(0, numFragments, [&](vtkIdType fragId, vtkIdType endFragId) {
+    for (; fragId < endFragId; ++fragId)
     {
-      ijkMin[i] = static_cast<int>((boundsPtr[2 * i] - this->Bounds[2 * i] - hTol[i]) / this->H[i]);
-      ijkMax[i] =
-        static_cast<int>((boundsPtr[2 * i + 1] - this->Bounds[2 * i] + hTol[i]) / this->H[i]);
-
-      if (ijkMin[i] < 0)
+      const vtkIdType octantId = fragments[fragId].Octant;
+      if (fragId > 0 && fragments[fragId - 1].Octant == octantId)
+      {
+        continue;
+      }
+      vtkIdType endRun = fragId + 1;
+      while (endRun < numFragments && fragments[endRun].Octant == octantId)
       {
-        ijkMin[i] = 0;
+        ++endRun;
       }
-      if (ijkMax[i] >= ndivs)
+      vtkIdList* octant = vtkIdList::New();
+      octant->SetNumberOfIds(endRun - fragId);
+      for (vtkIdType runId = fragId; runId < endRun; ++runId)
       {
-        ijkMax[i] = ndivs - 1;
+        octant->SetId(runId - fragId, fragments[runId].CellId);
       }
+      this->Tree[octantId] = octant;
     }
+  });
 
-    // each octant between min/max point may have cell in it
-    for (k = ijkMin[2]; k <= ijkMax[2]; k++)
+  // Mark the parents of the non-empty octants.
+  for (k = 0; k < ndivs; k++)
+  {
+    for (j = 0; j < ndivs; j++)
     {
-      for (j = ijkMin[1]; j <= ijkMax[1]; j++)
+      for (i = 0; i < ndivs; i++)
       {
-        for (i = ijkMin[0]; i <= ijkMax[0]; i++)
+        if (this->Tree[parentOffset + i + j * ndivs + k * product])
         {
-          idx = parentOffset + i + j * ndivs + k * product;
           this->MarkParents(reinterpret_cast<void*>(VTK_CELL_INSIDE), i, j, k, ndivs, this->Level);
-          octant = this->Tree[idx];
-          if (!octant)
-          {
-            octant = vtkIdList::New();
-            octant->Allocate(numCellsPerBucket, numCellsPerBucket / 2);
-            this->Tree[idx] = octant;
-          }
-          octant->InsertNextId(cellId);
         }
       }
     }
-
-  } // for all cells
+  }
 
   this->BuildTime.Modified();
 }
@@ -35,6 +35,7 @@
 #include "vtkLagrangeWedge.h"
 #include "vtkMath.h"
 #include "vtkPointData.h"
+#include "vtkScratchPool.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredData.h"
 
@@ -294,8 +295,7 @@ vtkCell* vtkDataSet::FindAndGetCell(double x[3], vtkCell* cell, vtkIdType cellId
 void vtkDataSet::GetCellNeighbors(vtkIdType cellId, vtkIdList* ptIds, vtkIdList* cellIds)
 {
   vtkIdType i, numPts;
-  vtkIdList* otherCells = vtkIdList::New();
-  otherCells->Allocate(VTK_CELL_SIZE);
+  auto otherCells = vtkScratchPool<vtkIdList>::Acquire();
 
   // load list with candidate cells, remove current cell
   this->GetPointCells(ptIds->GetId(0), cellIds);
@@ -310,8 +310,6 @@ void vtkDataSet::GetCellNeighbors(vtkIdType cellId, vtkIdList* ptIds, vtkIdList*
       cellIds->IntersectWith(*otherCells);
     }
   }
-
-  otherCells->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -500,11 +498,10 @@ void vtkDataSet::SetCellOrderAndRationalWeights(vtkIdType cellId, vtkGenericCell
 // Subclasses should override this method for efficiency.
 void vtkDataSet::GetCellBounds(vtkIdType cellId, double bounds[6])
 {
-  vtkGenericCell* cell = vtkGenericCell::New();
+  auto cell = vtkScratchPool<vtkGenericCell>::Acquire();
 
   this->GetCell(cellId, cell);
   cell->GetBounds(bounds);
-  cell->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -14,10 +14,15 @@
 =========================================================================*/
 #include "vtkKdTreePointLocator.h"
 
+#include "vtkAbstractPointLocatorInternal.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkKdTree.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkKdTreePointLocator);
 
 vtkKdTreePointLocator::vtkKdTreePointLocator()
@@ -60,6 +65,68 @@ void vtkKdTreePointLocator::FindPointsWithinRadius(double R, const double x[3],
   this->KdTree->FindPointsWithinRadius(R, x, result);
 }
 
+void vtkKdTreePointLocator::FindClosestPointBatch(vtkDataArray* points, vtkIdTypeArray* closestIds)
+{
+  if (!this->CheckQueryPoints(points))
+  {
+    return;
+  }
+  this->BuildLocator();
+  if (!this->KdTree)
+  {
+    return;
+  }
+  vtkKdTree* kdTree = this->KdTree;
+  auto query = [kdTree](const double* x) {
+    double dist2;
+    return kdTree->FindClosestPoint(x[0], x[1], x[2], dist2);
+  };
+  FindClosestPointsInParallel(points, query, closestIds);
+}
+
+void vtkKdTreePointLocator::FindClosestNPointsBatch(
+  int N, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  if (!this->CheckQueryPoints(points))
+  {
+    return;
+  }
+  this->BuildLocator();
+  if (!this->KdTree)
+  {
+    return;
+  }
+  // Warn once here rather than from every thread.
+  const vtkIdType numPts = this->DataSet->GetNumberOfPoints();
+  if (numPts < N)
+  {
+    vtkWarningMacro("Number of requested points is greater than total number of points in KdTree");
+    N = static_cast<int>(numPts);
+  }
+  vtkKdTree* kdTree = this->KdTree;
+  auto query = [kdTree, N](
+                 const double* x, vtkIdList* result) { kdTree->FindClosestNPoints(N, x, result); };
+  FindPointListsInParallel(points, query, offsets, ids);
+}
+
+void vtkKdTreePointLocator::FindPointsWithinRadiusBatch(
+  double R, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  if (!this->CheckQueryPoints(points))
+  {
+    return;
+  }
+  this->BuildLocator();
+  if (!this->KdTree)
+  {
+    return;
+  }
+  vtkKdTree* kdTree = this->KdTree;
+  auto query = [kdTree, R](
+                 const double* x, vtkIdList* result) { kdTree->FindPointsWithinRadius(R, x, result); };
+  FindPointListsInParallel(points, query, offsets, ids);
+}
+
 void vtkKdTreePointLocator::FreeSearchStructure()
 {
   if (this->KdTree)
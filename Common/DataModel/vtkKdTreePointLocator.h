@@ -29,7 +29,9 @@
 #include "vtkAbstractPointLocator.h"
 #include "vtkCommonDataModelModule.h" // For export macro
 
+class vtkDataArray;
 class vtkIdList;
+class vtkIdTypeArray;
 class vtkKdTree;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkKdTreePointLocator : public vtkAbstractPointLocator
@@ -72,6 +74,18 @@ public:
    */
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList* result) override;
 
+  //@{
+  /**
+   * Batched versions of the queries above (see vtkAbstractPointLocator).
+   * The query points are processed in parallel using vtkSMPTools.
+   */
+  void FindClosestPointBatch(vtkDataArray* points, vtkIdTypeArray* closestIds) override;
+  void FindClosestNPointsBatch(
+    int N, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  void FindPointsWithinRadiusBatch(
+    double R, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  //@}
+
   //@{
   /**
    * See vtkLocator interface documentation.
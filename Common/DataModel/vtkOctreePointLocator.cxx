@@ -19,6 +19,7 @@
 
 #include "vtkOctreePointLocator.h"
 
+#include "vtkAbstractPointLocatorInternal.h"
 #include "vtkCellArray.h"
 #include "vtkCommand.h"
 #include "vtkDataSet.h"
@@ -983,6 +984,72 @@ vtkIdTypeArray* vtkOctreePointLocator::GetPointsInRegion(int leafNodeId)
   return ptIds;
 }
 
+//------------------------------------------------------------------------------
+void vtkOctreePointLocator::FindClosestPointBatch(vtkDataArray* points, vtkIdTypeArray* closestIds)
+{
+  if (!this->CheckQueryPoints(points))
+  {
+    return;
+  }
+  this->BuildLocator();
+  if (!this->Top)
+  {
+    return;
+  }
+  auto query = [this](const double* x) {
+    double dist2;
+    return this->FindClosestPoint(x[0], x[1], x[2], dist2);
+  };
+  FindClosestPointsInParallel(points, query, closestIds);
+}
+
+//------------------------------------------------------------------------------
+void vtkOctreePointLocator::FindClosestNPointsBatch(
+  int N, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  if (!this->CheckQueryPoints(points))
+  {
+    return;
+  }
+  this->BuildLocator();
+  if (!this->Top)
+  {
+    return;
+  }
+  // Warn once here rather than from every thread.
+  if (this->Top->GetNumberOfPoints() < N)
+  {
+    vtkWarningMacro(
+      "Number of requested points is greater than total number of points in OctreePointLocator");
+    N = this->Top->GetNumberOfPoints();
+  }
+  auto query = [this, N](const double* x, vtkIdList* result) {
+    this->FindClosestNPoints(N, x, result);
+  };
+  FindPointListsInParallel(points, query, offsets, ids);
+}
+
+//------------------------------------------------------------------------------
+void vtkOctreePointLocator::FindPointsWithinRadiusBatch(
+  double R, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  if (!this->CheckQueryPoints(points))
+  {
+    return;
+  }
+  this->BuildLocator();
+  if (!this->Top)
+  {
+    return;
+  }
+  // Search the tree directly, with the squared radius.
+  const double radiusSquared = R * R;
+  auto query = [this, radiusSquared](const double* x, vtkIdList* result) {
+    this->FindPointsWithinRadius(this->Top, radiusSquared, x, result);
+  };
+  FindPointListsInParallel(points, query, offsets, ids);
+}
+
 //------------------------------------------------------------------------------
 void vtkOctreePointLocator::FreeSearchStructure()
 {
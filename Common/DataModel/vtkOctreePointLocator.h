@@ -41,6 +41,7 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 
 class vtkCellArray;
+class vtkDataArray;
 class vtkIdTypeArray;
 class vtkOctreePointLocatorNode;
 class vtkPoints;
@@ -161,6 +162,18 @@ public:
    */
   void FindClosestNPoints(int N, const double x[3], vtkIdList* result) override;
 
+  //@{
+  /**
+   * Batched versions of the queries above (see vtkAbstractPointLocator).
+   * The query points are processed in parallel using vtkSMPTools.
+   */
+  void FindClosestPointBatch(vtkDataArray* points, vtkIdTypeArray* closestIds) override;
+  void FindClosestNPointsBatch(
+    int N, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  void FindPointsWithinRadiusBatch(
+    double R, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  //@}
+
   /**
    * Get a list of the original IDs of all points in a leaf node.
    */
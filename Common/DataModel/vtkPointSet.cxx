@@ -20,16 +20,21 @@
 #include "vtkEmptyCell.h"
 #include "vtkGarbageCollector.h"
 #include "vtkGenericCell.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointLocator.h"
 #include "vtkPointSetCellIterator.h"
+#include "vtkSMPTools.h"
 #include "vtkStaticCellLocator.h"
 #include "vtkStaticPointLocator.h"
 
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
+#include <vector>
+
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 vtkStandardNewMacro(vtkPointSet);
@@ -338,6 +343,134 @@ void vtkPointSet::DeepCopy(vtkDataObject* dataObject)
   this->vtkDataSet::DeepCopy(dataObject);
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Number of bits of the quantized coordinates, so that a curve key fits in
+// 63 bits.
+const int CurveBits = 21;
+
+// Spreads the 21 low bits of x so that two zero bits separate them.
+vtkTypeUInt64 SpreadBits(vtkTypeUInt64 x)
+{
+  x &= 0x1fffff;
+  x = (x | (x << 32)) & 0x1f00000000ffffULL;
+  x = (x | (x << 16)) & 0x1f0000ff0000ffULL;
+  x = (x | (x << 8)) & 0x100f00f00f00f00fULL;
+  x = (x | (x << 4)) & 0x10c30c30c30c30c3ULL;
+  x = (x | (x << 2)) & 0x1249249249249249ULL;
+  return x;
+}
+
+vtkTypeUInt64 MortonKey(vtkTypeUInt32 x[3])
+{
+  return SpreadBits(x[0]) | (SpreadBits(x[1]) << 1) | (SpreadBits(x[2]) << 2);
+}
+
+// Computes the Hilbert key of a grid cell, using the transposition of the
+// coordinates described in J. Skilling, "Programming the Hilbert curve",
+// AIP Conference Proceedings 707, 2004.
+vtkTypeUInt64 HilbertKey(vtkTypeUInt32 x[3])
+{
+  // Inverse undo excess work.
+  for (vtkTypeUInt32 q = 1u << (CurveBits - 1); q > 1; q >>= 1)
+  {
+    const vtkTypeUInt32 p = q - 1;
+    for (int i = 0; i < 3; ++i)
+    {
+      if (x[i] & q)
+      {
+        x[0] ^= p; // invert
+      }
+      else
+      {
+        const vtkTypeUInt32 t = (x[0] ^ x[i]) & p; // exchange
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+  // Gray encode.
+  x[1] ^= x[0];
+  x[2] ^= x[1];
+  vtkTypeUInt32 t = 0;
+  for (vtkTypeUInt32 q = 1u << (CurveBits - 1); q > 1; q >>= 1)
+  {
+    if (x[2] & q)
+    {
+      t ^= q - 1;
+    }
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    x[i] ^= t;
+  }
+  // The transposed key interleaves the bits, the first axis highest.
+  return SpreadBits(x[2]) | (SpreadBits(x[1]) << 1) | (SpreadBits(x[0]) << 2);
+}
+
+struct CurvePoint
+{
+  vtkTypeUInt64 Key;
+  vtkIdType Id;
+
+  bool operator<(const CurvePoint& other) const
+  {
+    return this->Key < other.Key || (this->Key == other.Key && this->Id < other.Id);
+  }
+};
+}
+
+//------------------------------------------------------------------------------
+void vtkPointSet::ComputeSpaceFillingCurveOrder(
+  vtkPoints* points, int curve, vtkIdTypeArray* order)
+{
+  const vtkIdType numPts = points ? points->GetNumberOfPoints() : 0;
+  order->SetNumberOfComponents(1);
+  order->SetNumberOfValues(numPts);
+  if (numPts < 1)
+  {
+    return;
+  }
+
+  // The curve spans the bounding cube of the points, so that it has the
+  // same resolution along all the axes.
+  const double* bounds = points->GetBounds();
+  const double origin[3] = { bounds[0], bounds[2], bounds[4] };
+  const double size =
+    std::max(bounds[1] - bounds[0], std::max(bounds[3] - bounds[2], bounds[5] - bounds[4]));
+  const double maxCoordinate = static_cast<double>((1u << CurveBits) - 1);
+  const double scale = size > 0.0 ? maxCoordinate / size : 0.0;
+
+  std::vector<CurvePoint> curvePoints(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3];
+    vtkTypeUInt32 ijk[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      points->GetPoint(ptId, x);
+      for (int i = 0; i < 3; ++i)
+      {
+        const double coordinate = (x[i] - origin[i]) * scale;
+        ijk[i] = static_cast<vtkTypeUInt32>(
+          coordinate > 0.0 ? std::min(coordinate, maxCoordinate) : 0.0);
+      }
+      curvePoints[ptId].Key = curve == HILBERT_CURVE ? HilbertKey(ijk) : MortonKey(ijk);
+      curvePoints[ptId].Id = ptId;
+    }
+  });
+
+  vtkSMPTools::Sort(curvePoints.begin(), curvePoints.end());
+
+  vtkIdType* orderPtr = order->GetPointer(0);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      orderPtr[i] = curvePoints[i].Id;
+    }
+  });
+}
+
 //------------------------------------------------------------------------------
 vtkPointSet* vtkPointSet::GetData(vtkInformation* info)
 {
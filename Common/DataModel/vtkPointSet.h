@@ -62,6 +62,7 @@
 
 class vtkAbstractPointLocator;
 class vtkAbstractCellLocator;
+class vtkIdTypeArray;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkPointSet : public vtkDataSet
 {
@@ -250,6 +251,27 @@ public:
   void UnRegister(vtkObjectBase* o) override;
   //@}
 
+  /**
+   * Space filling curves along which points can be ordered.
+   */
+  enum SpaceFillingCurves
+  {
+    MORTON_CURVE = 0,
+    HILBERT_CURVE = 1
+  };
+
+  /**
+   * Compute the order of points along a Morton (Z-order) or Hilbert space
+   * filling curve spanning the bounding cube of the points. Upon return,
+   * order holds the ids of the points in curve order, so that order[i] is
+   * the id of the i-th point along the curve. The points are quantized on a
+   * grid of 2^21 cells per axis; points falling in the same grid cell are
+   * ordered by id. The curve keys are computed and sorted in parallel using
+   * vtkSMPTools. Reordering the points of a dataset this way (see
+   * vtkSpatialReorderFilter) keeps the points close in space close in memory.
+   */
+  static void ComputeSpaceFillingCurveOrder(vtkPoints* points, int curve, vtkIdTypeArray* order);
+
   //@{
   /**
    * Retrieve an instance of this class from an information object.
@@ -22,6 +22,7 @@
 #include "vtkPoints.h"
 #include "vtkPolygon.h"
 #include "vtkQuadraticEdge.h"
+#include "vtkScratchPool.h"
 
 vtkStandardNewMacro(vtkQuadraticPolygon);
 
@@ -294,7 +295,7 @@ void vtkQuadraticPolygon::GetPermutationFromPolygon(vtkIdType nb, vtkIdList* per
 //------------------------------------------------------------------------------
 void vtkQuadraticPolygon::PermuteToPolygon(vtkIdType nbPoints, double* inPoints, double* outPoints)
 {
-  vtkIdList* permutation = vtkIdList::New();
+  auto permutation = vtkScratchPool<vtkIdList>::Acquire();
   vtkQuadraticPolygon::GetPermutationFromPolygon(nbPoints, permutation);
 
   for (vtkIdType i = 0; i < nbPoints; i++)
@@ -304,8 +305,6 @@ void vtkQuadraticPolygon::PermuteToPolygon(vtkIdType nbPoints, double* inPoints,
       outPoints[3 * i + j] = inPoints[3 * permutation->GetId(i) + j];
     }
   }
-
-  permutation->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -313,7 +312,7 @@ void vtkQuadraticPolygon::PermuteToPolygon(vtkPoints* inPoints, vtkPoints* outPo
 {
   vtkIdType nbPoints = inPoints->GetNumberOfPoints();
 
-  vtkIdList* permutation = vtkIdList::New();
+  auto permutation = vtkScratchPool<vtkIdList>::Acquire();
   vtkQuadraticPolygon::GetPermutationFromPolygon(nbPoints, permutation);
 
   outPoints->SetNumberOfPoints(nbPoints);
@@ -321,8 +320,6 @@ void vtkQuadraticPolygon::PermuteToPolygon(vtkPoints* inPoints, vtkPoints* outPo
   {
     outPoints->SetPoint(i, inPoints->GetPoint(permutation->GetId(i)));
   }
-
-  permutation->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -330,7 +327,7 @@ void vtkQuadraticPolygon::PermuteToPolygon(vtkIdTypeArray* inIds, vtkIdTypeArray
 {
   vtkIdType nbIds = inIds->GetNumberOfTuples();
 
-  vtkIdList* permutation = vtkIdList::New();
+  auto permutation = vtkScratchPool<vtkIdList>::Acquire();
   vtkQuadraticPolygon::GetPermutationFromPolygon(nbIds, permutation);
 
   outIds->SetNumberOfTuples(nbIds);
@@ -338,8 +335,6 @@ void vtkQuadraticPolygon::PermuteToPolygon(vtkIdTypeArray* inIds, vtkIdTypeArray
   {
     outIds->SetValue(i, inIds->GetValue(permutation->GetId(i)));
   }
-
-  permutation->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -347,14 +342,12 @@ void vtkQuadraticPolygon::PermuteToPolygon(vtkDataArray* inDataArray, vtkDataArr
 {
   vtkIdType nb = inDataArray->GetNumberOfTuples();
 
-  vtkIdList* permutation = vtkIdList::New();
+  auto permutation = vtkScratchPool<vtkIdList>::Acquire();
   vtkQuadraticPolygon::GetPermutationFromPolygon(nb, permutation);
 
   outDataArray->SetNumberOfComponents(inDataArray->GetNumberOfComponents());
   outDataArray->SetNumberOfTuples(nb);
   inDataArray->GetTuples(permutation, outDataArray);
-
-  permutation->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -362,7 +355,7 @@ void vtkQuadraticPolygon::PermuteToPolygon(vtkCell* inCell, vtkCell* outCell)
 {
   vtkIdType nbPoints = inCell->GetNumberOfPoints();
 
-  vtkIdList* permutation = vtkIdList::New();
+  auto permutation = vtkScratchPool<vtkIdList>::Acquire();
   vtkQuadraticPolygon::GetPermutationFromPolygon(nbPoints, permutation);
 
   outCell->Points->SetNumberOfPoints(nbPoints);
@@ -373,8 +366,6 @@ void vtkQuadraticPolygon::PermuteToPolygon(vtkCell* inCell, vtkCell* outCell)
     outCell->PointIds->SetId(i, inCell->PointIds->GetId(permutation->GetId(i)));
     outCell->Points->SetPoint(i, inCell->Points->GetPoint(permutation->GetId(i)));
   }
-
-  permutation->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -396,7 +387,7 @@ void vtkQuadraticPolygon::GetPermutationToPolygon(vtkIdType nb, vtkIdList* permu
 //------------------------------------------------------------------------------
 void vtkQuadraticPolygon::PermuteFromPolygon(vtkIdType nb, double* values)
 {
-  vtkIdList* permutation = vtkIdList::New();
+  auto permutation = vtkScratchPool<vtkIdList>::Acquire();
   vtkQuadraticPolygon::GetPermutationToPolygon(nb, permutation);
 
   double* save = new double[nb];
@@ -409,7 +400,6 @@ void vtkQuadraticPolygon::PermuteFromPolygon(vtkIdType nb, double* values)
     values[i] = save[permutation->GetId(i)];
   }
 
-  permutation->Delete();
   delete[] save;
 }
 
@@ -418,10 +408,10 @@ void vtkQuadraticPolygon::ConvertFromPolygon(vtkIdList* ids)
 {
   vtkIdType nbIds = ids->GetNumberOfIds();
 
-  vtkIdList* permutation = vtkIdList::New();
+  auto permutation = vtkScratchPool<vtkIdList>::Acquire();
   vtkQuadraticPolygon::GetPermutationFromPolygon(nbIds, permutation);
 
-  vtkIdList* saveList = vtkIdList::New();
+  auto saveList = vtkScratchPool<vtkIdList>::Acquire();
   saveList->SetNumberOfIds(nbIds);
   ids->SetNumberOfIds(nbIds);
 
@@ -433,9 +423,6 @@ void vtkQuadraticPolygon::ConvertFromPolygon(vtkIdList* ids)
   {
     ids->SetId(i, permutation->GetId(saveList->GetId(i)));
   }
-
-  permutation->Delete();
-  saveList->Delete();
 }
 
 //------------------------------------------------------------------------------
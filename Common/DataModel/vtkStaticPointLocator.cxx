@@ -14,10 +14,12 @@
 =========================================================================*/
 #include "vtkStaticPointLocator.h"
 
+#include "vtkAbstractPointLocatorInternal.h"
 #include "vtkBoundingBox.h"
 #include "vtkBox.h"
 #include "vtkCellArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIntArray.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
@@ -1958,6 +1960,95 @@ void vtkStaticPointLocator::FindPointsWithinRadius(double R, const double x[3],
   }
 }
 
+//------------------------------------------------------------------------------
+// The batched queries dispatch on the id type once, then search the buckets
+// of each query point in parallel.
+void vtkStaticPointLocator::FindClosestPointBatch(vtkDataArray* points, vtkIdTypeArray* closestIds)
+{
+  if (!this->CheckQueryPoints(points))
+  {
+    return;
+  }
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if (!this->Buckets)
+  {
+    auto query = [](const double*) -> vtkIdType { return -1; };
+    FindClosestPointsInParallel(points, query, closestIds);
+  }
+  else if (this->LargeIds)
+  {
+    BucketList<vtkIdType>* bList = static_cast<BucketList<vtkIdType>*>(this->Buckets);
+    auto query = [bList](const double* x) { return bList->FindClosestPoint(x); };
+    FindClosestPointsInParallel(points, query, closestIds);
+  }
+  else
+  {
+    BucketList<int>* bList = static_cast<BucketList<int>*>(this->Buckets);
+    auto query = [bList](const double* x) { return bList->FindClosestPoint(x); };
+    FindClosestPointsInParallel(points, query, closestIds);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestNPointsBatch(
+  int N, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  if (!this->CheckQueryPoints(points))
+  {
+    return;
+  }
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if (!this->Buckets)
+  {
+    auto query = [](const double*, vtkIdList*) {};
+    FindPointListsInParallel(points, query, offsets, ids);
+  }
+  else if (this->LargeIds)
+  {
+    BucketList<vtkIdType>* bList = static_cast<BucketList<vtkIdType>*>(this->Buckets);
+    auto query = [bList, N](
+                   const double* x, vtkIdList* result) { bList->FindClosestNPoints(N, x, result); };
+    FindPointListsInParallel(points, query, offsets, ids);
+  }
+  else
+  {
+    BucketList<int>* bList = static_cast<BucketList<int>*>(this->Buckets);
+    auto query = [bList, N](
+                   const double* x, vtkIdList* result) { bList->FindClosestNPoints(N, x, result); };
+    FindPointListsInParallel(points, query, offsets, ids);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::FindPointsWithinRadiusBatch(
+  double R, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  if (!this->CheckQueryPoints(points))
+  {
+    return;
+  }
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if (!this->Buckets)
+  {
+    auto query = [](const double*, vtkIdList*) {};
+    FindPointListsInParallel(points, query, offsets, ids);
+  }
+  else if (this->LargeIds)
+  {
+    BucketList<vtkIdType>* bList = static_cast<BucketList<vtkIdType>*>(this->Buckets);
+    auto query = [bList, R](
+                   const double* x, vtkIdList* result) { bList->FindPointsWithinRadius(R, x, result); };
+    FindPointListsInParallel(points, query, offsets, ids);
+  }
+  else
+  {
+    BucketList<int>* bList = static_cast<BucketList<int>*>(this->Buckets);
+    auto query = [bList, R](
+                   const double* x, vtkIdList* result) { bList->FindPointsWithinRadius(R, x, result); };
+    FindPointListsInParallel(points, query, offsets, ids);
+  }
+}
+
 //------------------------------------------------------------------------------
 // This method traverses the locator along the defined ray, finding the
 // closest point to a0 when projected onto the line (a0,a1) (i.e., min
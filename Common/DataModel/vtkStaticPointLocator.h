@@ -140,6 +140,19 @@ public:
    */
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList* result) override;
 
+  //@{
+  /**
+   * Batched versions of the queries above (see vtkAbstractPointLocator).
+   * The query points are processed in parallel using vtkSMPTools, searching
+   * the buckets directly.
+   */
+  void FindClosestPointBatch(vtkDataArray* points, vtkIdTypeArray* closestIds) override;
+  void FindClosestNPointsBatch(
+    int N, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  void FindPointsWithinRadiusBatch(
+    double R, vtkDataArray* points, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  //@}
+
   /**
    * Intersect the points contained in the locator with the line defined by
    * (a0,a1). Return the point within the tolerance tol that is closest to a0
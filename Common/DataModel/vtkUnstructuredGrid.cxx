@@ -88,6 +88,7 @@
 #include "vtkTimerLog.h"
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <set>
 #include <unordered_map>
@@ -179,6 +180,7 @@ vtkUnstructuredGrid::vtkUnstructuredGrid()
   this->Information->Set(vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS(), 0);
 
   this->DistinctCellTypesUpdateMTime = 0;
+  this->FaceNeighborsManifold = false;
 
   this->AllocateExact(1024, 1024);
 }
@@ -424,6 +426,8 @@ void vtkUnstructuredGrid::Cleanup()
   this->DistinctCellTypesUpdateMTime = 0;
   this->Faces = nullptr;
   this->FaceLocations = nullptr;
+  this->FaceNeighbors = nullptr;
+  this->FaceNeighborsManifold = false;
 }
 
 //------------------------------------------------------------------------------
@@ -1807,6 +1811,11 @@ unsigned long vtkUnstructuredGrid::GetActualMemorySize()
     size += this->FaceLocations->GetActualMemorySize();
   }
 
+  if (this->FaceNeighbors)
+  {
+    size += this->FaceNeighbors->GetActualMemorySize();
+  }
+
   return size;
 }
 
@@ -2137,6 +2146,107 @@ inline void GetCellNeighborsImp(TLinks* links, bool vtkNotUsed(shareable), vtkId
   }   // for all potential cell neighbors
 }
 
+// Whether two lists of point ids hold the same points.
+inline bool SameFacePoints(
+  vtkIdType npts, const vtkIdType* pts, vtkIdType nfacePts, const vtkIdType* facePts)
+{
+  if (npts != nfacePts)
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    if (std::find(facePts, facePts + npts, pts[i]) == facePts + npts ||
+      std::find(pts, pts + npts, facePts[i]) == pts + npts)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class CellT>
+vtkIdType FindFaceInArrays(
+  const vtkIdType* cellPts, vtkIdType npts, const vtkIdType* pts)
+{
+  vtkIdType facePts[CellT::MaximumFaceSize];
+  for (vtkIdType faceId = 0; faceId < CellT::NumberOfFaces; ++faceId)
+  {
+    // The faces of fewer points than the maximum end with -1.
+    const vtkIdType* face = CellT::GetFaceArray(faceId);
+    vtkIdType nfacePts = 0;
+    for (; nfacePts < CellT::MaximumFaceSize && face[nfacePts] >= 0; ++nfacePts)
+    {
+      facePts[nfacePts] = cellPts[face[nfacePts]];
+    }
+    if (SameFacePoints(npts, pts, nfacePts, facePts))
+    {
+      return faceId;
+    }
+  }
+  return -1;
+}
+
+// Return the index of the face of the cell, in the order of
+// BuildFaceNeighbors(), made of the points pts, or -1. Only the cells whose
+// faces are read from their connectivity or face stream are handled. The
+// cell points are read without copy, which is thread safe when the
+// connectivity is shareable.
+vtkIdType FindCellFace(
+  vtkUnstructuredGrid* grid, vtkIdType cellId, vtkIdType npts, const vtkIdType* pts)
+{
+  vtkIdType ncellPts;
+  const vtkIdType* cellPts;
+  switch (grid->GetCellType(cellId))
+  {
+    case VTK_TETRA:
+      grid->GetCellPoints(cellId, ncellPts, cellPts);
+      return FindFaceInArrays<vtkTetra>(cellPts, npts, pts);
+    case VTK_HEXAHEDRON:
+      grid->GetCellPoints(cellId, ncellPts, cellPts);
+      return FindFaceInArrays<vtkHexahedron>(cellPts, npts, pts);
+    case VTK_VOXEL:
+      grid->GetCellPoints(cellId, ncellPts, cellPts);
+      return FindFaceInArrays<vtkVoxel>(cellPts, npts, pts);
+    case VTK_WEDGE:
+      grid->GetCellPoints(cellId, ncellPts, cellPts);
+      return FindFaceInArrays<vtkWedge>(cellPts, npts, pts);
+    case VTK_PYRAMID:
+      grid->GetCellPoints(cellId, ncellPts, cellPts);
+      return FindFaceInArrays<vtkPyramid>(cellPts, npts, pts);
+    case VTK_TRIANGLE:
+    case VTK_QUAD:
+    case VTK_POLYGON:
+      grid->GetCellPoints(cellId, ncellPts, cellPts);
+      for (vtkIdType i = 0; npts == 2 && i < ncellPts; ++i)
+      {
+        const vtkIdType edge[2] = { cellPts[i], cellPts[(i + 1) % ncellPts] };
+        if (SameFacePoints(npts, pts, 2, edge))
+        {
+          return i;
+        }
+      }
+      return -1;
+    case VTK_POLYHEDRON:
+    {
+      const vtkIdType* faceStream = grid->GetFaces(cellId);
+      const vtkIdType nfaces = *faceStream++;
+      for (vtkIdType faceId = 0; faceId < nfaces; ++faceId)
+      {
+        const vtkIdType nfacePts = *faceStream++;
+        if (SameFacePoints(npts, pts, nfacePts, faceStream))
+        {
+          return faceId;
+        }
+        faceStream += nfacePts;
+      }
+      return -1;
+    }
+    default:
+      return -1;
+  }
+}
+
 } // end anonymous namespace
 
 //----------------------------------------------------------------------------
@@ -2148,6 +2258,13 @@ bool vtkUnstructuredGrid::IsCellBoundary(vtkIdType cellId, vtkIdType npts, const
     return false;
   }
 
+  // Look the face up in the face adjacency if it is current.
+  vtkIdType neighbor;
+  if (this->LookupFaceNeighbor(cellId, npts, pts, neighbor))
+  {
+    return neighbor < 0;
+  }
+
   // Ensure that cell links are available.
   if (!this->Links)
   {
@@ -2188,6 +2305,18 @@ void vtkUnstructuredGrid::GetCellNeighbors(
     return;
   }
 
+  // Look the face up in the face adjacency if it is current, and if no face
+  // has several neighbors.
+  vtkIdType neighbor;
+  if (this->FaceNeighborsManifold && this->LookupFaceNeighbor(cellId, npts, pts, neighbor))
+  {
+    if (neighbor >= 0)
+    {
+      cellIds->InsertNextId(neighbor);
+    }
+    return;
+  }
+
   // Ensure that links are built.
   if (!this->Links)
   {
@@ -2211,6 +2340,288 @@ void vtkUnstructuredGrid::GetCellNeighbors(
   }
 }
 
+//------------------------------------------------------------------------------
+// Support BuildFaceNeighbors()
+namespace
+{
+// Visits the faces of the cells, the edges of the 2D cells, with their point
+// ids. The common linear cells and the polyhedra are visited from their
+// connectivity and face stream, without instantiating them.
+struct CellFaces
+{
+  vtkUnstructuredGrid* Grid;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  CellFaces(vtkUnstructuredGrid* grid)
+    : Grid(grid)
+  {
+  }
+
+  vtkIdType GetNumberOfFaces(vtkIdType cellId)
+  {
+    switch (this->Grid->GetCellType(cellId))
+    {
+      case VTK_TETRA:
+        return vtkTetra::NumberOfFaces;
+      case VTK_HEXAHEDRON:
+        return vtkHexahedron::NumberOfFaces;
+      case VTK_VOXEL:
+        return vtkVoxel::NumberOfFaces;
+      case VTK_WEDGE:
+        return vtkWedge::NumberOfFaces;
+      case VTK_PYRAMID:
+        return vtkPyramid::NumberOfFaces;
+      case VTK_TRIANGLE:
+      case VTK_QUAD:
+      case VTK_POLYGON:
+        return this->Grid->GetCells()->GetCellSize(cellId);
+      case VTK_POLYHEDRON:
+        return this->Grid->GetFaces(cellId)[0];
+      default:
+      {
+        vtkGenericCell* cell = this->Cell.Local();
+        this->Grid->GetCell(cellId, cell);
+        const int dimension = cell->GetCellDimension();
+        return dimension == 3 ? cell->GetNumberOfFaces()
+                              : (dimension == 2 ? cell->GetNumberOfEdges() : 0);
+      }
+    }
+  }
+
+  // Calls functor(npts, pts) for each face of the cell.
+  template <typename FaceFunctor>
+  void VisitFaces(vtkIdType cellId, FaceFunctor& functor)
+  {
+    switch (this->Grid->GetCellType(cellId))
+    {
+      case VTK_TETRA:
+        this->VisitFaceArrays<vtkTetra>(cellId, functor);
+        break;
+      case VTK_HEXAHEDRON:
+        this->VisitFaceArrays<vtkHexahedron>(cellId, functor);
+        break;
+      case VTK_VOXEL:
+        this->VisitFaceArrays<vtkVoxel>(cellId, functor);
+        break;
+      case VTK_WEDGE:
+        this->VisitFaceArrays<vtkWedge>(cellId, functor);
+        break;
+      case VTK_PYRAMID:
+        this->VisitFaceArrays<vtkPyramid>(cellId, functor);
+        break;
+      case VTK_TRIANGLE:
+      case VTK_QUAD:
+      case VTK_POLYGON:
+      {
+        vtkIdList* cellPts = this->CellPoints.Local();
+        this->Grid->GetCells()->GetCellAtId(cellId, cellPts);
+        const vtkIdType npts = cellPts->GetNumberOfIds();
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          const vtkIdType edge[2] = { cellPts->GetId(i), cellPts->GetId((i + 1) % npts) };
+          functor(2, edge);
+        }
+        break;
+      }
+      case VTK_POLYHEDRON:
+      {
+        const vtkIdType* faceStream = this->Grid->GetFaces(cellId);
+        const vtkIdType nfaces = *faceStream++;
+        for (vtkIdType faceId = 0; faceId < nfaces; ++faceId)
+        {
+          const vtkIdType npts = *faceStream++;
+          functor(npts, faceStream);
+          faceStream += npts;
+        }
+        break;
+      }
+      default:
+      {
+        vtkGenericCell* cell = this->Cell.Local();
+        this->Grid->GetCell(cellId, cell);
+        const int dimension = cell->GetCellDimension();
+        if (dimension == 3)
+        {
+          for (int faceId = 0; faceId < cell->GetNumberOfFaces(); ++faceId)
+          {
+            vtkIdList* facePts = cell->GetFace(faceId)->GetPointIds();
+            functor(facePts->GetNumberOfIds(), facePts->GetPointer(0));
+          }
+        }
+        else if (dimension == 2)
+        {
+          for (int edgeId = 0; edgeId < cell->GetNumberOfEdges(); ++edgeId)
+          {
+            vtkIdList* edgePts = cell->GetEdge(edgeId)->GetPointIds();
+            functor(edgePts->GetNumberOfIds(), edgePts->GetPointer(0));
+          }
+        }
+      }
+    }
+  }
+
+  template <typename CellT, typename FaceFunctor>
+  void VisitFaceArrays(vtkIdType cellId, FaceFunctor& functor)
+  {
+    vtkIdList* cellPts = this->CellPoints.Local();
+    this->Grid->GetCells()->GetCellAtId(cellId, cellPts);
+    vtkIdType facePts[CellT::MaximumFaceSize];
+    for (vtkIdType faceId = 0; faceId < CellT::NumberOfFaces; ++faceId)
+    {
+      // The faces of fewer points than the maximum end with -1.
+      const vtkIdType* face = CellT::GetFaceArray(faceId);
+      vtkIdType npts = 0;
+      for (; npts < CellT::MaximumFaceSize && face[npts] >= 0; ++npts)
+      {
+        facePts[npts] = cellPts->GetId(face[npts]);
+      }
+      functor(npts, facePts);
+    }
+  }
+};
+
+// Counts the faces of each cell in the offsets of the face adjacency.
+struct CountFacesWorker : public CellFaces
+{
+  vtkIdType* Offsets;
+
+  CountFacesWorker(vtkUnstructuredGrid* grid, vtkIdType* offsets)
+    : CellFaces(grid)
+    , Offsets(offsets)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      this->Offsets[cellId + 1] = this->GetNumberOfFaces(cellId);
+    }
+  }
+};
+
+// Finds the neighbor of each face of the cells with the cell links.
+struct FindFaceNeighborsWorker : public CellFaces
+{
+  const vtkIdType* Offsets;
+  vtkIdType* Neighbors;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  std::atomic<bool> NonManifold;
+
+  FindFaceNeighborsWorker(vtkUnstructuredGrid* grid, const vtkIdType* offsets, vtkIdType* neighbors)
+    : CellFaces(grid)
+    , Offsets(offsets)
+    , Neighbors(neighbors)
+    , NonManifold(false)
+  {
+  }
+
+  struct FaceNeighbor
+  {
+    vtkUnstructuredGrid* Grid;
+    vtkIdType CellId;
+    vtkIdList* CellIds;
+    vtkIdType* Neighbor;
+    std::atomic<bool>* NonManifold;
+
+    void operator()(vtkIdType npts, const vtkIdType* pts)
+    {
+      this->Grid->GetCellNeighbors(this->CellId, npts, pts, this->CellIds);
+      const vtkIdType* cellIds = this->CellIds->GetPointer(0);
+      const vtkIdType ncells = this->CellIds->GetNumberOfIds();
+      *this->Neighbor++ = ncells > 0 ? *std::min_element(cellIds, cellIds + ncells) : -1;
+      if (ncells > 1)
+      {
+        *this->NonManifold = true;
+      }
+    }
+  };
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* cellIds = this->CellIds.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      FaceNeighbor faceNeighbor = { this->Grid, cellId, cellIds,
+        this->Neighbors + this->Offsets[cellId], &this->NonManifold };
+      this->VisitFaces(cellId, faceNeighbor);
+    }
+  }
+};
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+bool vtkUnstructuredGrid::AreFaceNeighborsCurrent()
+{
+  // InsertNextCell() does not modify the mesh, hence the count of the cells.
+  return this->FaceNeighbors &&
+    this->FaceNeighbors->GetNumberOfCells() == this->GetNumberOfCells() &&
+    this->FaceNeighborsBuildTime >
+    std::max(this->GetMeshMTime(), this->Types ? this->Types->GetMTime() : 0);
+}
+
+//------------------------------------------------------------------------------
+bool vtkUnstructuredGrid::LookupFaceNeighbor(
+  vtkIdType cellId, vtkIdType npts, const vtkIdType* pts, vtkIdType& neighbor)
+{
+  if (cellId < 0 || cellId >= this->GetNumberOfCells() || !this->AreFaceNeighborsCurrent() ||
+    !this->Connectivity->IsStorageShareable())
+  {
+    return false;
+  }
+  const vtkIdType faceId = FindCellFace(this, cellId, npts, pts);
+  if (faceId < 0)
+  {
+    return false;
+  }
+  neighbor = this->GetFaceNeighbor(cellId, faceId);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkUnstructuredGrid::BuildFaceNeighbors()
+{
+  if (this->AreFaceNeighborsCurrent())
+  {
+    return;
+  }
+  const vtkMTimeType meshMTime =
+    std::max(this->GetMeshMTime(), this->Types ? this->Types->GetMTime() : 0);
+  const vtkIdType numCells = this->GetNumberOfCells();
+  const bool cellsInserted =
+    this->FaceNeighbors && this->FaceNeighbors->GetNumberOfCells() != numCells;
+
+  // The links are used concurrently, and are rebuilt if they are older than
+  // the mesh: each BuildLinks() creates new links.
+  if (numCells > 0 && (!this->Links || cellsInserted || this->Links->GetMTime() < meshMTime))
+  {
+    this->BuildLinks();
+  }
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numCells + 1);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  offsetsPtr[0] = 0;
+  CountFacesWorker countFaces(this, offsetsPtr);
+  vtkSMPTools::For(0, numCells, countFaces);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    offsetsPtr[cellId + 1] += offsetsPtr[cellId];
+  }
+
+  vtkNew<vtkIdTypeArray> neighbors;
+  neighbors->SetNumberOfValues(offsetsPtr[numCells]);
+  FindFaceNeighborsWorker findNeighbors(this, offsetsPtr, neighbors->GetPointer(0));
+  vtkSMPTools::For(0, numCells, findNeighbors);
+
+  // The ids are shared as vtkIdType, for the thread safety of GetCellAtId().
+  this->FaceNeighbors = vtkSmartPointer<vtkCellArray>::New();
+  this->FaceNeighbors->SetData(offsets, neighbors);
+  this->FaceNeighborsManifold = !findNeighbors.NonManifold;
+  this->FaceNeighborsBuildTime.Modified();
+}
+
 //------------------------------------------------------------------------------
 int vtkUnstructuredGrid::IsHomogeneous()
 {
@@ -321,6 +321,62 @@ public:
   bool IsCellBoundary(vtkIdType cellId, vtkIdType npts, const vtkIdType* ptIds);
   //@}
 
+  /**
+   * Build the face adjacency of the cells, i.e. the neighbor of each cell
+   * across each of its faces, in parallel with vtkSMPTools. The faces of the
+   * 3D cells are in the order of vtkCell::GetFace(), the ones of polyhedra in
+   * the order of their face stream, and the faces of the 2D cells are their
+   * edges. 0D and 1D cells have no faces. The adjacency is only rebuilt when
+   * the mesh was modified or cells were inserted since the last call, and it
+   * is released by Initialize(). The cell links are rebuilt if they are older
+   * than the mesh.
+   */
+  void BuildFaceNeighbors();
+
+  /**
+   * Return whether the face adjacency was built since the mesh was last
+   * modified and cells were last inserted, i.e. whether GetFaceNeighbors()
+   * returns the neighbors of the current mesh. When it does,
+   * IsCellBoundary(), and GetCellNeighbors() if no face has more than one
+   * neighbor, look up the faces of a cell in the adjacency instead of
+   * intersecting the cell links.
+   */
+  bool AreFaceNeighborsCurrent();
+
+  //@{
+  /**
+   * Return the neighbors of the faces of a cell: for each face, the id of
+   * the other cell using all of its points, or -1 when the face is on the
+   * boundary. A face shared by more than two cells returns the smallest id of
+   * the other cells. THESE METHODS ARE THREAD SAFE.
+   *
+   * These methods return the adjacency as last built: call
+   * BuildFaceNeighbors() after the mesh is modified, or check
+   * AreFaceNeighborsCurrent(), otherwise the neighbors of the previous mesh
+   * are returned. Before the first BuildFaceNeighbors(), after Initialize()
+   * and for the cells inserted since, a cell has no faces and
+   * GetFaceNeighbor() returns -1.
+   */
+  void GetFaceNeighbors(vtkIdType cellId, vtkIdType& nfaces, vtkIdType const*& neighbors)
+    VTK_SIZEHINT(neighbors, nfaces)
+  {
+    if (!this->FaceNeighbors || cellId < 0 || cellId >= this->FaceNeighbors->GetNumberOfCells())
+    {
+      nfaces = 0;
+      neighbors = nullptr;
+      return;
+    }
+    this->FaceNeighbors->GetCellAtId(cellId, nfaces, neighbors);
+  }
+  vtkIdType GetFaceNeighbor(vtkIdType cellId, vtkIdType faceId)
+  {
+    vtkIdType nfaces;
+    const vtkIdType* neighbors;
+    this->GetFaceNeighbors(cellId, nfaces, neighbors);
+    return faceId >= 0 && faceId < nfaces ? neighbors[faceId] : -1;
+  }
+  //@}
+
   //@{
   /**
    * Use these methods only if the dataset has been specified as
@@ -588,6 +644,20 @@ protected:
   vtkSmartPointer<vtkIdTypeArray> Faces;
   vtkSmartPointer<vtkIdTypeArray> FaceLocations;
 
+  // The face adjacency built by BuildFaceNeighbors(): the neighbors of the
+  // faces of each cell are stored as the point ids of a cell.
+  vtkSmartPointer<vtkCellArray> FaceNeighbors;
+  vtkTimeStamp FaceNeighborsBuildTime;
+  // Whether each face has at most one neighbor, in which case the adjacency
+  // answers GetCellNeighbors() for the faces.
+  bool FaceNeighborsManifold;
+
+  // Look up the neighbor of the face of a cell made of the points pts in the
+  // current face adjacency. Return false if the adjacency is not current or
+  // the points are not those of a face of the cell.
+  bool LookupFaceNeighbor(
+    vtkIdType cellId, vtkIdType npts, const vtkIdType* pts, vtkIdType& neighbor);
+
   // Legacy support -- stores the old-style cell array locations.
   vtkSmartPointer<vtkIdTypeArray> CellLocations;
 
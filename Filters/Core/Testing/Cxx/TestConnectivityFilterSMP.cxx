@@ -0,0 +1,301 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConnectivityFilterSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the threaded labeling of vtkConnectivityFilter and
+// vtkPolyDataConnectivityFilter gives, with every vtkSMPTools backend, the
+// same regions as the sequential one in every extraction mode, with and
+// without scalar connectivity, including the numbering of the output points.
+
+#include <vtkAppendFilter.h>
+#include <vtkAppendPolyData.h>
+#include <vtkCellData.h>
+#include <vtkConnectivityFilter.h>
+#include <vtkDoubleArray.h>
+#include <vtkIdList.h>
+#include <vtkIdTypeArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataConnectivityFilter.h>
+#include <vtkSMPTestUtilities.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Adds an oscillating point scalar and the input ids to a dataset.
+void AddArrays(vtkDataSet* dataSet)
+{
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(dataSet->GetNumberOfPoints());
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfTuples(dataSet->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < dataSet->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    dataSet->GetPoint(ptId, x);
+    scalars->SetValue(ptId, std::sin(6.0 * x[0]) * std::cos(4.0 * x[1]) + 0.3 * x[2]);
+    pointIds->SetValue(ptId, ptId);
+  }
+  dataSet->GetPointData()->SetScalars(scalars);
+  dataSet->GetPointData()->AddArray(pointIds);
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfTuples(dataSet->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < dataSet->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->SetValue(cellId, cellId);
+  }
+  dataSet->GetCellData()->AddArray(cellIds);
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  const int numComp = a->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetComponent(i / numComp, i % numComp) != b->GetComponent(i / numComp, i % numComp))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compares the first numTuples tuples of the arrays: the RegionId arrays may
+// be allocated for the whole input.
+bool SameAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b, vtkIdType numTuples)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* arrayA = a->GetArray(i);
+    vtkDataArray* arrayB = b->GetArray(a->GetArrayName(i));
+    if (!arrayB || arrayA->GetNumberOfComponents() != arrayB->GetNumberOfComponents() ||
+      arrayA->GetNumberOfTuples() < numTuples || arrayB->GetNumberOfTuples() < numTuples)
+    {
+      return false;
+    }
+    for (vtkIdType tupleId = 0; tupleId < numTuples; ++tupleId)
+    {
+      for (int comp = 0; comp < arrayA->GetNumberOfComponents(); ++comp)
+      {
+        if (arrayA->GetComponent(tupleId, comp) != arrayB->GetComponent(tupleId, comp))
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool SameOutputs(vtkDataSet* a, vtkDataSet* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells() ||
+    !SameAttributes(a->GetPointData(), b->GetPointData(), a->GetNumberOfPoints()) ||
+    !SameArrays(a->GetCellData()->GetArray("CellIds"), b->GetCellData()->GetArray("CellIds")))
+  {
+    return false;
+  }
+  // vtkConnectivityFilter passes the cell RegionIds indexed by input cell.
+  vtkDataArray* cellIds = a->GetCellData()->GetArray("CellIds");
+  vtkDataArray* cellRegionIdsA = a->GetCellData()->GetArray("RegionId");
+  vtkDataArray* cellRegionIdsB = b->GetCellData()->GetArray("RegionId");
+  if (!cellRegionIdsA != !cellRegionIdsB)
+  {
+    return false;
+  }
+  for (vtkIdType cellId = 0; cellRegionIdsA && cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    const vtkIdType inputCellId = static_cast<vtkIdType>(cellIds->GetComponent(cellId, 0));
+    if (cellRegionIdsA->GetComponent(inputCellId, 0) !=
+      cellRegionIdsB->GetComponent(inputCellId, 0))
+    {
+      return false;
+    }
+  }
+  for (vtkIdType ptId = 0; ptId < a->GetNumberOfPoints(); ++ptId)
+  {
+    double xA[3];
+    double xB[3];
+    a->GetPoint(ptId, xA);
+    b->GetPoint(ptId, xB);
+    if (xA[0] != xB[0] || xA[1] != xB[1] || xA[2] != xB[2])
+    {
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> ptIdsA;
+  vtkNew<vtkIdList> ptIdsB;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCellPoints(cellId, ptIdsA);
+    b->GetCellPoints(cellId, ptIdsB);
+    if (a->GetCellType(cellId) != b->GetCellType(cellId) ||
+      ptIdsA->GetNumberOfIds() != ptIdsB->GetNumberOfIds() ||
+      !std::equal(ptIdsA->begin(), ptIdsA->end(), ptIdsB->begin()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Sets up a connectivity filter for the given extraction mode.
+template <typename Filter>
+void Configure(Filter* filter, vtkDataSet* input, int extractionMode, bool scalarConnectivity)
+{
+  filter->SetInputData(input);
+  filter->SetExtractionMode(extractionMode);
+  filter->AddSeed(extractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ? 0 : 1);
+  filter->AddSeed(extractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS
+      ? input->GetNumberOfPoints() / 3
+      : input->GetNumberOfCells() / 2);
+  filter->AddSpecifiedRegion(0);
+  filter->AddSpecifiedRegion(2);
+  filter->SetClosestPoint(0.4, 0.2, 0.1);
+  filter->SetScalarConnectivity(scalarConnectivity);
+  filter->SetScalarRange(0.1, 0.6);
+  filter->ColorRegionsOn();
+}
+}
+
+int TestConnectivityFilterSMP(int, char*[])
+{
+  // Disjoint spheres, and two images whose points are not merged.
+  vtkNew<vtkAppendPolyData> spheres;
+  for (int i = 0; i < 4; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(0.8 * i, 0.3 * i, 0.0);
+    sphere->SetRadius(0.35);
+    sphere->SetThetaResolution(16 + 4 * i);
+    sphere->SetPhiResolution(12 + 2 * i);
+    spheres->AddInputConnection(sphere->GetOutputPort());
+  }
+  spheres->Update();
+  vtkPolyData* mesh = spheres->GetOutput();
+  AddArrays(mesh);
+
+  vtkNew<vtkAppendFilter> images;
+  for (int i = 0; i < 2; ++i)
+  {
+    vtkNew<vtkImageData> image;
+    image->SetExtent(0, 14, 0, 10, 0, 6);
+    image->SetSpacing(0.1, 0.1, 0.1);
+    image->SetOrigin(1.6 * i, 0.0, 0.0);
+    images->AddInputData(image);
+  }
+  images->Update();
+  vtkUnstructuredGrid* grid = images->GetOutput();
+  AddArrays(grid);
+
+  std::vector<vtkDataSet*> inputs = { mesh, grid };
+
+  int status = EXIT_SUCCESS;
+  for (int extractionMode = VTK_EXTRACT_POINT_SEEDED_REGIONS;
+       extractionMode <= VTK_EXTRACT_CLOSEST_POINT_REGION; ++extractionMode)
+  {
+    for (int scalarMode = 0; scalarMode < 3; ++scalarMode)
+    {
+      const bool scalarConnectivity = scalarMode != 0;
+      const bool fullScalarConnectivity = scalarMode == 2;
+
+      for (std::size_t inputId = 0; inputId < inputs.size(); ++inputId)
+      {
+        if (fullScalarConnectivity)
+        {
+          // Only vtkPolyDataConnectivityFilter has this option.
+          break;
+        }
+        vtkNew<vtkConnectivityFilter> sequentialConnectivity;
+        Configure(sequentialConnectivity.GetPointer(), inputs[inputId], extractionMode,
+          scalarConnectivity);
+        sequentialConnectivity->Update();
+        vtkDataSet* reference = vtkDataSet::SafeDownCast(sequentialConnectivity->GetOutput());
+
+        if (reference->GetNumberOfCells() == 0)
+        {
+          std::cerr << "Empty vtkConnectivityFilter output for input " << inputId
+                    << " in mode " << extractionMode << std::endl;
+          status = EXIT_FAILURE;
+        }
+
+        vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+          vtkNew<vtkConnectivityFilter> connectivity;
+          Configure(connectivity.GetPointer(), inputs[inputId], extractionMode, scalarConnectivity);
+          connectivity->ParallelLabelingOn();
+          connectivity->Update();
+          if (connectivity->GetNumberOfExtractedRegions() !=
+              sequentialConnectivity->GetNumberOfExtractedRegions() ||
+            !SameOutputs(reference, vtkDataSet::SafeDownCast(connectivity->GetOutput())))
+          {
+            std::cerr << "Threaded vtkConnectivityFilter with the " << backend
+                      << " backend differs from the sequential one for input " << inputId
+                      << " in mode " << extractionMode << " with scalar mode " << scalarMode
+                      << std::endl;
+            status = EXIT_FAILURE;
+          }
+        });
+      }
+
+      vtkNew<vtkPolyDataConnectivityFilter> sequentialConnectivity;
+      Configure(sequentialConnectivity.GetPointer(), mesh, extractionMode, scalarConnectivity);
+      sequentialConnectivity->SetFullScalarConnectivity(fullScalarConnectivity);
+      sequentialConnectivity->Update();
+
+      vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+        vtkNew<vtkPolyDataConnectivityFilter> connectivity;
+        Configure(connectivity.GetPointer(), mesh, extractionMode, scalarConnectivity);
+        connectivity->SetFullScalarConnectivity(fullScalarConnectivity);
+        connectivity->ParallelLabelingOn();
+        connectivity->Update();
+        if (!SameArrays(sequentialConnectivity->GetRegionSizes(), connectivity->GetRegionSizes()) ||
+          !SameOutputs(sequentialConnectivity->GetOutput(), connectivity->GetOutput()))
+        {
+          std::cerr << "Threaded vtkPolyDataConnectivityFilter with the " << backend
+                    << " backend differs from the sequential one in mode " << extractionMode
+                    << " with scalar mode " << scalarMode << std::endl;
+          status = EXIT_FAILURE;
+        }
+      });
+    }
+  }
+  return status;
+}
@@ -0,0 +1,294 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestParallelCleanPolyData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the threaded clean of vtkCleanPolyData gives the same output,
+// array types included, as the sequential one, and that vtkCleanPolyData and
+// vtkStaticCleanPolyData give the same output with every vtkSMPTools
+// backend.
+
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkCleanPolyData.h>
+#include <vtkIdTypeArray.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkSMPTestUtilities.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+#include <vtkStaticCleanPolyData.h>
+#include <vtkUnsignedCharArray.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Adds the ids, and integer and unsigned char values derived from them, to
+// the point or cell data.
+void AddIds(vtkDataSetAttributes* attributes, const std::string& prefix, vtkIdType numIds)
+{
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName((prefix + "Ids").c_str());
+  ids->SetNumberOfTuples(numIds);
+  vtkNew<vtkIntArray> labels;
+  labels->SetName((prefix + "Labels").c_str());
+  labels->SetNumberOfTuples(numIds);
+  vtkNew<vtkUnsignedCharArray> flags;
+  flags->SetName((prefix + "Flags").c_str());
+  flags->SetNumberOfTuples(numIds);
+  for (vtkIdType id = 0; id < numIds; ++id)
+  {
+    ids->SetValue(id, id);
+    labels->SetValue(id, static_cast<int>(id % 7) - 3);
+    flags->SetValue(id, static_cast<unsigned char>(id % 3));
+  }
+  attributes->AddArray(ids);
+  attributes->AddArray(labels);
+  attributes->AddArray(flags);
+}
+
+// A sphere whose polygons do not share their points, with a few verts,
+// lines and strips. Points and cells carry their input id.
+vtkSmartPointer<vtkPolyData> CreateMesh()
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(24);
+  sphere->Update();
+  vtkPolyData* input = sphere->GetOutput();
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> strips;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  std::vector<vtkIdType> newPts;
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfPolys(); ++cellId)
+  {
+    input->GetPolys()->GetCellAtId(cellId, npts, pts);
+    newPts.clear();
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      newPts.push_back(points->InsertNextPoint(input->GetPoint(pts[i])));
+    }
+    // Close some polygons, and degenerate others.
+    if (cellId % 7 == 0)
+    {
+      newPts.push_back(points->InsertNextPoint(input->GetPoint(pts[0])));
+    }
+    if (cellId % 11 == 0)
+    {
+      newPts[1] = newPts[0];
+    }
+    polys->InsertNextCell(static_cast<vtkIdType>(newPts.size()), newPts.data());
+
+    switch (cellId % 13)
+    {
+      case 0:
+        verts->InsertNextCell(1, newPts.data());
+        break;
+      case 1:
+        lines->InsertNextCell(2, newPts.data());
+        break;
+      case 2:
+        lines->InsertNextCell({ newPts[0], newPts[0] });
+        break;
+      case 3:
+        strips->InsertNextCell({ newPts[0], newPts[1], newPts[2], newPts[0] });
+        break;
+      case 4:
+        strips->InsertNextCell({ newPts[0], newPts[0], newPts[1], newPts[1] });
+        break;
+      default:
+        break;
+    }
+  }
+
+  vtkSmartPointer<vtkPolyData> mesh = vtkSmartPointer<vtkPolyData>::New();
+  mesh->SetPoints(points);
+  mesh->SetVerts(verts);
+  mesh->SetLines(lines);
+  mesh->SetPolys(polys);
+  mesh->SetStrips(strips);
+
+  AddIds(mesh->GetPointData(), "Point", mesh->GetNumberOfPoints());
+  AddIds(mesh->GetCellData(), "Cell", mesh->GetNumberOfCells());
+  return mesh;
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  if (a->GetDataType() != b->GetDataType() || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  const int numComp = a->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetComponent(i / numComp, i % numComp) != b->GetComponent(i / numComp, i % numComp))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameCells(vtkCellArray* a, vtkCellArray* b)
+{
+  if (a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  vtkIdType nptsA, nptsB;
+  const vtkIdType *ptsA, *ptsB;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCellAtId(cellId, nptsA, ptsA);
+    b->GetCellAtId(cellId, nptsB, ptsB);
+    if (nptsA != nptsB || !std::equal(ptsA, ptsA + nptsA, ptsB))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compares the arrays of a with the arrays of the same name in b.
+bool SameAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = a->GetArray(i);
+    if (!SameArrays(array, b->GetArray(array->GetName())))
+    {
+      return false;
+    }
+  }
+  return a->GetNumberOfArrays() == b->GetNumberOfArrays();
+}
+
+// Checks that the arrays of b have the type of the arrays of the same name
+// in a.
+bool SameTypes(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = b->GetArray(a->GetArray(i)->GetName());
+    if (!array || array->GetDataType() != a->GetArray(i)->GetDataType())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutputs(vtkPolyData* a, vtkPolyData* b)
+{
+  return a->GetNumberOfPoints() == b->GetNumberOfPoints() &&
+    SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()) &&
+    SameCells(a->GetVerts(), b->GetVerts()) && SameCells(a->GetLines(), b->GetLines()) &&
+    SameCells(a->GetPolys(), b->GetPolys()) && SameCells(a->GetStrips(), b->GetStrips()) &&
+    SameAttributes(a->GetPointData(), b->GetPointData()) &&
+    SameAttributes(a->GetCellData(), b->GetCellData());
+}
+}
+
+int TestParallelCleanPolyData(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> mesh = CreateMesh();
+
+  int status = EXIT_SUCCESS;
+  for (int mode = 0; mode < 16; ++mode)
+  {
+    const bool merging = (mode & 1) != 0;
+    const bool convertLines = (mode & 2) != 0;
+    const bool convertPolys = (mode & 4) != 0;
+    const bool convertStrips = (mode & 8) != 0;
+
+    vtkNew<vtkCleanPolyData> sequentialClean;
+    sequentialClean->SetInputData(mesh);
+    sequentialClean->SetPointMerging(merging);
+    sequentialClean->SetConvertLinesToPoints(convertLines);
+    sequentialClean->SetConvertPolysToLines(convertPolys);
+    sequentialClean->SetConvertStripsToPolys(convertStrips);
+    sequentialClean->Update();
+    if (!SameTypes(mesh->GetPointData(), sequentialClean->GetOutput()->GetPointData()) ||
+      !SameTypes(mesh->GetCellData(), sequentialClean->GetOutput()->GetCellData()))
+    {
+      std::cerr << "Sequential clean changes the array types in mode " << mode << std::endl;
+      status = EXIT_FAILURE;
+    }
+
+    vtkSmartPointer<vtkPolyData> staticReference;
+    vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+      vtkNew<vtkCleanPolyData> clean;
+      clean->SetInputData(mesh);
+      clean->SetPointMerging(merging);
+      clean->SetConvertLinesToPoints(convertLines);
+      clean->SetConvertPolysToLines(convertPolys);
+      clean->SetConvertStripsToPolys(convertStrips);
+      clean->ParallelCleanOn();
+      clean->Update();
+      if (!SameOutputs(sequentialClean->GetOutput(), clean->GetOutput()))
+      {
+        std::cerr << "Threaded clean with the " << backend
+                  << " backend differs from the sequential clean in mode " << mode << std::endl;
+        status = EXIT_FAILURE;
+      }
+
+      vtkNew<vtkStaticCleanPolyData> staticClean;
+      staticClean->SetInputData(mesh);
+      staticClean->SetConvertLinesToPoints(convertLines);
+      staticClean->SetConvertPolysToLines(convertPolys);
+      staticClean->SetConvertStripsToPolys(convertStrips);
+      staticClean->Update();
+      if (!SameTypes(mesh->GetCellData(), staticClean->GetOutput()->GetCellData()))
+      {
+        std::cerr << "vtkStaticCleanPolyData changes the cell array types with the " << backend
+                  << " backend in mode " << mode << std::endl;
+        status = EXIT_FAILURE;
+      }
+      if (!staticReference)
+      {
+        staticReference = vtkSmartPointer<vtkPolyData>::New();
+        staticReference->DeepCopy(staticClean->GetOutput());
+      }
+      else if (!SameOutputs(staticReference, staticClean->GetOutput()))
+      {
+        std::cerr << "vtkStaticCleanPolyData output with the " << backend
+                  << " backend differs from the Sequential one in mode " << mode << std::endl;
+        status = EXIT_FAILURE;
+      }
+      if (merging &&
+        staticClean->GetOutput()->GetNumberOfPoints() != clean->GetOutput()->GetNumberOfPoints())
+      {
+        std::cerr << "vtkStaticCleanPolyData and vtkCleanPolyData do not merge the same points"
+                  << " in mode " << mode << std::endl;
+        status = EXIT_FAILURE;
+      }
+    });
+  }
+  return status;
+}
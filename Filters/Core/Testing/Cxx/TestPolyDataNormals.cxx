@@ -0,0 +1,298 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataNormals.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the normals of vtkPolyDataNormals against known ones, that it gives
+// the same output with every vtkSMPTools backend, and that the regions of a
+// mesh are consistently ordered and oriented.
+
+#include <vtkAppendPolyData.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkFloatArray.h>
+#include <vtkMath.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataNormals.h>
+#include <vtkSMPTestUtilities.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace
+{
+// Several spheres, with some of their polygons reversed.
+vtkSmartPointer<vtkPolyData> CreateMesh()
+{
+  vtkNew<vtkAppendPolyData> append;
+  for (int i = 0; i < 12; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(3.0 * (i % 4), 3.0 * (i / 4), 0.0);
+    sphere->SetThetaResolution(16 + i);
+    sphere->SetPhiResolution(12 + i);
+    sphere->Update();
+    append->AddInputData(sphere->GetOutput());
+  }
+  append->Update();
+
+  vtkSmartPointer<vtkPolyData> mesh = vtkSmartPointer<vtkPolyData>::New();
+  mesh->DeepCopy(append->GetOutput());
+  vtkCellArray* polys = mesh->GetPolys();
+  for (vtkIdType cellId = 0; cellId < polys->GetNumberOfCells(); cellId += 3)
+  {
+    polys->ReverseCellAtId(cellId);
+  }
+  return mesh;
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetComponent(i / a->GetNumberOfComponents(), i % a->GetNumberOfComponents()) !=
+      b->GetComponent(i / b->GetNumberOfComponents(), i % b->GetNumberOfComponents()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutputs(vtkPolyData* a, vtkPolyData* b)
+{
+  vtkIdType nptsA, nptsB;
+  const vtkIdType *ptsA, *ptsB;
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfPolys() != b->GetNumberOfPolys())
+  {
+    return false;
+  }
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfPolys(); ++cellId)
+  {
+    a->GetPolys()->GetCellAtId(cellId, nptsA, ptsA);
+    b->GetPolys()->GetCellAtId(cellId, nptsB, ptsB);
+    if (nptsA != nptsB || !std::equal(ptsA, ptsA + nptsA, ptsB))
+    {
+      return false;
+    }
+  }
+  return SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()) &&
+    SameArrays(a->GetPointData()->GetNormals(), b->GetPointData()->GetNormals()) &&
+    SameArrays(a->GetCellData()->GetNormals(), b->GetCellData()->GetNormals());
+}
+
+// A cube of side 2 centered at the origin, with shared points and its second
+// face reversed.
+vtkSmartPointer<vtkPolyData> CreateCube()
+{
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 8; ++i)
+  {
+    points->InsertNextPoint(i & 1 ? 1.0 : -1.0, i & 2 ? 1.0 : -1.0, i & 4 ? 1.0 : -1.0);
+  }
+  const vtkIdType faces[6][4] = { { 0, 2, 3, 1 }, { 4, 6, 7, 5 }, { 0, 1, 5, 4 },
+    { 2, 6, 7, 3 }, { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+  vtkNew<vtkCellArray> polys;
+  for (const auto& face : faces)
+  {
+    polys->InsertNextCell(4, face);
+  }
+  vtkSmartPointer<vtkPolyData> cube = vtkSmartPointer<vtkPolyData>::New();
+  cube->SetPoints(points);
+  cube->SetPolys(polys);
+  return cube;
+}
+
+bool SameDirection(const double a[3], const double b[3])
+{
+  double u[3] = { a[0], a[1], a[2] };
+  double v[3] = { b[0], b[1], b[2] };
+  vtkMath::Normalize(u);
+  vtkMath::Normalize(v);
+  return vtkMath::Dot(u, v) > 1.0 - 1e-6;
+}
+
+// Compares the normals of a cube, with and without splitting, and of a sphere
+// with the exact ones.
+bool HasKnownNormals()
+{
+  bool success = true;
+  for (bool splitting : { false, true })
+  {
+    vtkNew<vtkPolyDataNormals> normals;
+    normals->SetInputData(CreateCube());
+    normals->SetSplitting(splitting);
+    normals->SetFeatureAngle(30.0);
+    normals->ComputeCellNormalsOn();
+    normals->Update();
+    vtkPolyData* output = normals->GetOutput();
+    vtkDataArray* pointNormals = output->GetPointData()->GetNormals();
+    vtkDataArray* cellNormals = output->GetCellData()->GetNormals();
+    if (output->GetNumberOfPoints() != (splitting ? 24 : 8) || output->GetNumberOfPolys() != 6)
+    {
+      std::cerr << "Wrong cube size with splitting " << splitting << std::endl;
+      success = false;
+      continue;
+    }
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = 0; cellId < 6; ++cellId)
+    {
+      // The face normal points from the origin to the center of the face.
+      output->GetPolys()->GetCellAtId(cellId, npts, pts);
+      double center[3] = { 0.0, 0.0, 0.0 }, x[3], normal[3];
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        output->GetPoint(pts[i], x);
+        vtkMath::Add(center, x, center);
+      }
+      cellNormals->GetTuple(cellId, normal);
+      success &= SameDirection(normal, center);
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        output->GetPoint(pts[i], x);
+        pointNormals->GetTuple(pts[i], normal);
+        success &= SameDirection(normal, splitting ? center : x);
+      }
+    }
+  }
+  if (!success)
+  {
+    std::cerr << "Wrong cube normals" << std::endl;
+  }
+
+  // The normals of a fine sphere are close to the radial directions given by
+  // the source.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+  vtkNew<vtkPolyData> mesh;
+  mesh->DeepCopy(sphere->GetOutput());
+  vtkSmartPointer<vtkDataArray> exact = mesh->GetPointData()->GetNormals();
+  mesh->GetPointData()->Initialize();
+  for (vtkIdType cellId = 1; cellId < mesh->GetNumberOfPolys(); cellId += 5)
+  {
+    mesh->GetPolys()->ReverseCellAtId(cellId);
+  }
+  vtkNew<vtkPolyDataNormals> normals;
+  normals->SetInputData(mesh);
+  normals->SplittingOff();
+  normals->Update();
+  vtkDataArray* pointNormals = normals->GetOutput()->GetPointData()->GetNormals();
+  for (vtkIdType ptId = 0; ptId < mesh->GetNumberOfPoints(); ++ptId)
+  {
+    double a[3], b[3];
+    pointNormals->GetTuple(ptId, a);
+    exact->GetTuple(ptId, b);
+    if (vtkMath::Dot(a, b) < 0.999)
+    {
+      std::cerr << "Wrong sphere normal at point " << ptId << std::endl;
+      return false;
+    }
+  }
+  return success;
+}
+
+// With auto orientation, every normal of a sphere points away from its center.
+bool IsOutward(vtkPolyData* output, bool flip)
+{
+  vtkDataArray* normals = output->GetCellData()->GetNormals();
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfPolys(); ++cellId)
+  {
+    output->GetPolys()->GetCellAtId(cellId, npts, pts);
+    double x[3], center[3] = { 0.0, 0.0, 0.0 };
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      output->GetPoint(pts[i], x);
+      vtkMath::Add(center, x, center);
+    }
+    vtkMath::MultiplyScalar(center, 1.0 / npts);
+    // The centers of the spheres are on a grid of spacing 3.
+    double direction[3] = { center[0] - 3.0 * vtkMath::Round(center[0] / 3.0),
+      center[1] - 3.0 * vtkMath::Round(center[1] / 3.0), center[2] };
+    double normal[3];
+    normals->GetTuple(cellId, normal);
+    if ((vtkMath::Dot(normal, direction) > 0.0) == flip)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestPolyDataNormals(int, char*[])
+{
+  int status = HasKnownNormals() ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  vtkSmartPointer<vtkPolyData> mesh = CreateMesh();
+  for (int mode = 0; mode < 32; ++mode)
+  {
+    const bool consistency = (mode & 1) != 0;
+    const bool autoOrient = (mode & 2) != 0;
+    const bool splitting = (mode & 4) != 0;
+    const bool flip = (mode & 8) != 0;
+    const bool nonManifold = (mode & 16) != 0;
+
+    vtkSmartPointer<vtkPolyData> reference;
+    vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+      vtkNew<vtkPolyDataNormals> normals;
+      normals->SetInputData(mesh);
+      normals->SetConsistency(consistency);
+      normals->SetAutoOrientNormals(autoOrient);
+      normals->SetSplitting(splitting);
+      normals->SetFlipNormals(flip);
+      normals->SetNonManifoldTraversal(nonManifold);
+      normals->ComputeCellNormalsOn();
+      normals->Update();
+      vtkPolyData* output = normals->GetOutput();
+
+      if (!reference)
+      {
+        reference = vtkSmartPointer<vtkPolyData>::New();
+        reference->DeepCopy(output);
+
+        if (autoOrient && !IsOutward(output, flip))
+        {
+          std::cerr << "Normals are not oriented outward in mode " << mode << std::endl;
+          status = EXIT_FAILURE;
+        }
+      }
+      else if (!SameOutputs(reference, output))
+      {
+        std::cerr << "Output of the " << backend
+                  << " backend differs from the Sequential one in mode " << mode << std::endl;
+        status = EXIT_FAILURE;
+      }
+    });
+  }
+  return status;
+}
@@ -0,0 +1,235 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThresholdSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the threaded vtkThreshold gives, with every vtkSMPTools
+// backend, the same output, array types included, as the sequential path,
+// which is used when the input carries a string array.
+
+#include <vtkAppendFilter.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkDoubleArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkImageData.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkSMPTestUtilities.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+#include <vtkStringArray.h>
+#include <vtkThreshold.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Adds the ids, and integer and unsigned char values derived from them, to
+// the point or cell data.
+void AddIds(vtkDataSetAttributes* attributes, const std::string& prefix, vtkIdType numIds)
+{
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName((prefix + "Ids").c_str());
+  ids->SetNumberOfTuples(numIds);
+  vtkNew<vtkIntArray> labels;
+  labels->SetName((prefix + "Labels").c_str());
+  labels->SetNumberOfTuples(numIds);
+  vtkNew<vtkUnsignedCharArray> flags;
+  flags->SetName((prefix + "Flags").c_str());
+  flags->SetNumberOfTuples(numIds);
+  for (vtkIdType id = 0; id < numIds; ++id)
+  {
+    ids->SetValue(id, id);
+    labels->SetValue(id, static_cast<int>(id % 7) - 3);
+    flags->SetValue(id, static_cast<unsigned char>(id % 3));
+  }
+  attributes->AddArray(ids);
+  attributes->AddArray(labels);
+  attributes->AddArray(flags);
+}
+
+// Adds a point scalar, a cell scalar and the arrays of AddIds() to a dataset.
+void AddArrays(vtkDataSet* dataSet)
+{
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  pointScalars->SetNumberOfTuples(dataSet->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < dataSet->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    dataSet->GetPoint(ptId, x);
+    pointScalars->SetValue(ptId, x[0] * x[0] + x[1] - x[2]);
+  }
+  dataSet->GetPointData()->SetScalars(pointScalars);
+  AddIds(dataSet->GetPointData(), "Point", dataSet->GetNumberOfPoints());
+
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  cellScalars->SetNumberOfTuples(dataSet->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < dataSet->GetNumberOfCells(); ++cellId)
+  {
+    cellScalars->SetValue(cellId, (cellId * 37) % 101 / 100.0);
+  }
+  dataSet->GetCellData()->SetScalars(cellScalars);
+  AddIds(dataSet->GetCellData(), "Cell", dataSet->GetNumberOfCells());
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  if (a->GetDataType() != b->GetDataType() || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  const int numComp = a->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetComponent(i / numComp, i % numComp) != b->GetComponent(i / numComp, i % numComp))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutputs(vtkUnstructuredGrid* a, vtkUnstructuredGrid* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells() ||
+    !SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()) ||
+    !SameArrays(a->GetCellTypesArray(), b->GetCellTypesArray()))
+  {
+    return false;
+  }
+  vtkIdType nptsA, nptsB;
+  const vtkIdType *ptsA, *ptsB;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    a->GetCells()->GetCellAtId(cellId, nptsA, ptsA);
+    b->GetCells()->GetCellAtId(cellId, nptsB, ptsB);
+    if (nptsA != nptsB || !std::equal(ptsA, ptsA + nptsA, ptsB))
+    {
+      return false;
+    }
+  }
+  for (const char* name : { "PointScalars", "PointIds", "PointLabels", "PointFlags" })
+  {
+    if (!SameArrays(a->GetPointData()->GetArray(name), b->GetPointData()->GetArray(name)))
+    {
+      return false;
+    }
+  }
+  for (const char* name : { "CellScalars", "CellIds", "CellLabels", "CellFlags" })
+  {
+    if (!SameArrays(a->GetCellData()->GetArray(name), b->GetCellData()->GetArray(name)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestThresholdSMP(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(-10, 10, -8, 8, -6, 6);
+  image->SetSpacing(0.1, 0.1, 0.1);
+  AddArrays(image);
+
+  vtkNew<vtkAppendFilter> toGrid;
+  toGrid->AddInputData(image);
+  toGrid->Update();
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(40);
+  sphere->SetPhiResolution(30);
+  sphere->Update();
+  AddArrays(sphere->GetOutput());
+
+  std::vector<vtkDataSet*> inputs = { image, toGrid->GetOutput(), sphere->GetOutput() };
+
+  int status = EXIT_SUCCESS;
+  for (std::size_t inputId = 0; inputId < inputs.size(); ++inputId)
+  {
+    // A string array is not handled by the threaded path.
+    vtkSmartPointer<vtkDataSet> sequentialInput;
+    sequentialInput.TakeReference(inputs[inputId]->NewInstance());
+    sequentialInput->ShallowCopy(inputs[inputId]);
+    vtkNew<vtkStringArray> names;
+    names->SetName("Names");
+    names->SetNumberOfValues(sequentialInput->GetNumberOfCells());
+    sequentialInput->GetCellData()->AddArray(names);
+
+    for (int mode = 0; mode < 16; ++mode)
+    {
+      const bool cellScalars = (mode & 1) != 0;
+      const bool allScalars = (mode & 2) != 0;
+      const bool continuousRange = (mode & 4) != 0;
+      const bool invert = (mode & 8) != 0;
+
+      vtkNew<vtkThreshold> sequentialThreshold;
+      sequentialThreshold->SetInputData(sequentialInput);
+      sequentialThreshold->SetInputArrayToProcess(0, 0, 0,
+        cellScalars ? vtkDataObject::FIELD_ASSOCIATION_CELLS
+                    : vtkDataObject::FIELD_ASSOCIATION_POINTS,
+        cellScalars ? "CellScalars" : "PointScalars");
+      sequentialThreshold->ThresholdBetween(0.2, 0.6);
+      sequentialThreshold->SetAllScalars(allScalars);
+      sequentialThreshold->SetUseContinuousCellRange(continuousRange);
+      sequentialThreshold->SetInvert(invert);
+      sequentialThreshold->Update();
+      vtkUnstructuredGrid* reference = sequentialThreshold->GetOutput();
+
+      if (reference->GetNumberOfCells() == 0 ||
+        reference->GetNumberOfCells() == inputs[inputId]->GetNumberOfCells())
+      {
+        std::cerr << "Trivial threshold for input " << inputId << " in mode " << mode
+                  << std::endl;
+        status = EXIT_FAILURE;
+      }
+
+      vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+        vtkNew<vtkThreshold> threshold;
+        threshold->SetInputData(inputs[inputId]);
+        threshold->SetInputArrayToProcess(0, 0, 0,
+          cellScalars ? vtkDataObject::FIELD_ASSOCIATION_CELLS
+                      : vtkDataObject::FIELD_ASSOCIATION_POINTS,
+          cellScalars ? "CellScalars" : "PointScalars");
+        threshold->ThresholdBetween(0.2, 0.6);
+        threshold->SetAllScalars(allScalars);
+        threshold->SetUseContinuousCellRange(continuousRange);
+        threshold->SetInvert(invert);
+        threshold->Update();
+        if (!SameOutputs(reference, threshold->GetOutput()))
+        {
+          std::cerr << "Threaded threshold with the " << backend
+                    << " backend differs from the sequential one for input " << inputId
+                    << " in mode " << mode << std::endl;
+          status = EXIT_FAILURE;
+        }
+      });
+    }
+  }
+  return status;
+}
@@ -16,18 +16,25 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCleanPolyDataInternal.h"
 #include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <atomic>
 #include <unordered_map>
+#include <vector>
 
 vtkStandardNewMacro(vtkCleanPolyData);
 
@@ -47,6 +54,176 @@ bool InsertPointUsingGlobalId(vtkIdType globalId, vtkPoints* newPts,
   ptId = it->second;
   return false;
 }
+
+// Degenerate cells are reduced like in the sequential clean: consecutive
+// duplicate points are removed, then the closing point of polygons and
+// strips. A cell left with too few points is converted to the type matching
+// its number of points, if it was not modified or if the conversion is on.
+struct CleanCellRule
+{
+  bool ConvertLinesToPoints;
+  bool ConvertPolysToLines;
+  bool ConvertStripsToPolys;
+
+  int operator()(int inType, vtkIdType& npts, vtkIdType* pts) const
+  {
+    if (inType == CLEAN_VERTS)
+    {
+      return npts > 0 ? CLEAN_VERTS : CLEAN_DISCARD;
+    }
+
+    vtkIdType numNewPts = 0;
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      if (i == 0 || pts[i] != pts[numNewPts - 1])
+      {
+        pts[numNewPts++] = pts[i];
+      }
+    }
+    if (((inType == CLEAN_POLYS && numNewPts > 2) || (inType == CLEAN_STRIPS && numNewPts > 1)) &&
+      pts[0] == pts[numNewPts - 1])
+    {
+      numNewPts--;
+    }
+    const bool unchanged = (numNewPts == npts);
+    npts = numNewPts;
+
+    switch (numNewPts)
+    {
+      case 0:
+        return CLEAN_DISCARD;
+      case 1:
+        return (unchanged || this->ConvertLinesToPoints) ? CLEAN_VERTS : CLEAN_DISCARD;
+      case 2:
+        if (inType == CLEAN_LINES)
+        {
+          return CLEAN_LINES;
+        }
+        return (unchanged || this->ConvertPolysToLines) ? CLEAN_LINES : CLEAN_DISCARD;
+      case 3:
+        if (inType != CLEAN_STRIPS)
+        {
+          return inType;
+        }
+        return (unchanged || this->ConvertStripsToPolys) ? CLEAN_POLYS : CLEAN_DISCARD;
+      default:
+        return inType;
+    }
+  }
+};
+
+// Finds the first position at which the cells use each group of merged
+// points. Positions follow the sequential traversal of the cells (verts,
+// lines, polys then strips) and are encoded as
+// cellId * maxCellSize + index of the point in the cell.
+struct FindFirstUses
+{
+  vtkCellArray* Cells;
+  vtkIdType CellIdOffset;
+  const vtkIdType* MergeMap;
+  vtkIdType MaxCellSize;
+  std::atomic<vtkTypeInt64>* FirstUses;
+
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> CellIterator;
+
+  FindFirstUses(vtkCellArray* cells, vtkIdType offset, const vtkIdType* mergeMap,
+    vtkIdType maxCellSize, std::atomic<vtkTypeInt64>* firstUses)
+    : Cells(cells)
+    , CellIdOffset(offset)
+    , MergeMap(mergeMap)
+    , MaxCellSize(maxCellSize)
+    , FirstUses(firstUses)
+  {
+  }
+
+  void Initialize() { this->CellIterator.Local().TakeReference(this->Cells->NewIterator()); }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* cellIter = this->CellIterator.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      cellIter->GetCellAtId(cellId, npts, pts);
+      const vtkTypeInt64 position =
+        static_cast<vtkTypeInt64>(this->CellIdOffset + cellId) * this->MaxCellSize;
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        std::atomic<vtkTypeInt64>& firstUse =
+          this->FirstUses[GetMergedPoint(this->MergeMap, pts[i])];
+        vtkTypeInt64 current = firstUse.load(std::memory_order_relaxed);
+        while (position + i < current && !firstUse.compare_exchange_weak(current, position + i))
+        {
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Numbers the output points in the order of their first use, and records
+// the input point each of them is copied from.
+struct MapFirstUses
+{
+  vtkCellArray* Cells[CLEAN_DISCARD];
+  const vtkIdType* CellIdOffsets;
+  const vtkTypeInt64* Positions;
+  vtkIdType MaxCellSize;
+  const vtkIdType* MergeMap;
+  vtkIdType* FirstPoints;
+  vtkIdType* GroupMap;
+
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> CellIterators[CLEAN_DISCARD];
+
+  MapFirstUses(vtkPolyData* input, const vtkIdType* offsets, const vtkTypeInt64* positions,
+    vtkIdType maxCellSize, const vtkIdType* mergeMap, vtkIdType* firstPoints, vtkIdType* groupMap)
+    : CellIdOffsets(offsets)
+    , Positions(positions)
+    , MaxCellSize(maxCellSize)
+    , MergeMap(mergeMap)
+    , FirstPoints(firstPoints)
+    , GroupMap(groupMap)
+  {
+    this->Cells[CLEAN_VERTS] = input->GetVerts();
+    this->Cells[CLEAN_LINES] = input->GetLines();
+    this->Cells[CLEAN_POLYS] = input->GetPolys();
+    this->Cells[CLEAN_STRIPS] = input->GetStrips();
+  }
+
+  void Initialize()
+  {
+    for (int type = 0; type < CLEAN_DISCARD; ++type)
+    {
+      this->CellIterators[type].Local().TakeReference(this->Cells[type]->NewIterator());
+    }
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      const vtkIdType cellId = static_cast<vtkIdType>(this->Positions[ptId] / this->MaxCellSize);
+      const vtkIdType i = static_cast<vtkIdType>(this->Positions[ptId] % this->MaxCellSize);
+      int type = CLEAN_VERTS;
+      while (cellId >= this->CellIdOffsets[type + 1])
+      {
+        ++type;
+      }
+      this->CellIterators[type].Local()->GetCellAtId(
+        cellId - this->CellIdOffsets[type], npts, pts);
+      this->FirstPoints[ptId] = pts[i];
+      this->GroupMap[GetMergedPoint(this->MergeMap, pts[i])] = ptId;
+    }
+  }
+
+  void Reduce() {}
+};
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -67,6 +244,7 @@ vtkCleanPolyData::vtkCleanPolyData()
   this->ConvertStripsToPolys = 1;
   this->Locator = nullptr;
   this->PieceInvariant = 1;
+  this->ParallelClean = 0;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 }
 
@@ -151,6 +329,12 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
+  if (this->ParallelClean &&
+    !(this->PointMerging && vtkIdTypeArray::SafeDownCast(input->GetPointData()->GetGlobalIds())))
+  {
+    this->CleanInParallel(input, output);
+    return 1;
+  }
   vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   vtkIdType numNewPts;
@@ -649,6 +833,168 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Threaded version of RequestData(). Output points are numbered in the order
+// in which the cells first use them, as when they are inserted one at a time
+// in the locator, so that both versions give the same output.
+void vtkCleanPolyData::CleanInParallel(vtkPolyData* input, vtkPolyData* output)
+{
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* inputPD = input->GetPointData();
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+
+  vtkPoints* newPts = inPts->NewInstance();
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+
+  // Operate on all the points at once. They are stored with the output
+  // precision so that they compare as they would in the locator.
+  vtkNew<vtkPoints> mappedPts;
+  mappedPts->SetDataType(newPts->GetDataType());
+  mappedPts->SetNumberOfPoints(numPts);
+  vtkSMPTools::For(0, numPts, [this, inPts, &mappedPts](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3], newx[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      inPts->GetPoint(ptId, x);
+      this->OperateOnPoint(x, newx);
+      mappedPts->SetPoint(ptId, newx);
+    }
+  });
+
+  // Group the points. Without merging, each point is its own group.
+  std::vector<vtkIdType> mergeMap(numPts);
+  if (this->PointMerging)
+  {
+    vtkNew<vtkPolyData> cloud;
+    cloud->SetPoints(mappedPts);
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(cloud);
+    locator->BuildLocator();
+    double tol = (this->ToleranceIsAbsolute ? this->AbsoluteTolerance
+                                            : this->Tolerance * input->GetLength());
+    locator->MergePoints(tol, mergeMap.data());
+  }
+  else
+  {
+    vtkIdType* mergePtr = mergeMap.data();
+    vtkSMPTools::For(0, numPts, [mergePtr](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        mergePtr[ptId] = ptId;
+      }
+    });
+  }
+  this->UpdateProgress(0.25);
+
+  // Find where each group is first used. Unused groups are removed.
+  vtkCellArray* inCells[CLEAN_DISCARD] = { input->GetVerts(), input->GetLines(),
+    input->GetPolys(), input->GetStrips() };
+  vtkIdType cellIdOffsets[CLEAN_DISCARD + 1];
+  cellIdOffsets[0] = 0;
+  for (int type = 0; type < CLEAN_DISCARD; ++type)
+  {
+    cellIdOffsets[type + 1] = cellIdOffsets[type] + inCells[type]->GetNumberOfCells();
+  }
+  const vtkIdType maxCellSize = input->GetMaxCellSize();
+  const vtkTypeInt64 unused = VTK_TYPE_INT64_MAX;
+
+  std::vector<std::atomic<vtkTypeInt64>> firstUses(numPts);
+  std::atomic<vtkTypeInt64>* firstUsesPtr = firstUses.data();
+  vtkSMPTools::For(0, numPts, [firstUsesPtr, unused](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstUsesPtr[ptId].store(unused, std::memory_order_relaxed);
+    }
+  });
+  for (int type = 0; type < CLEAN_DISCARD; ++type)
+  {
+    FindFirstUses find(
+      inCells[type], cellIdOffsets[type], mergeMap.data(), maxCellSize, firstUsesPtr);
+    vtkSMPTools::For(0, inCells[type]->GetNumberOfCells(), find);
+  }
+
+  std::vector<vtkTypeInt64> positions(numPts);
+  auto positionsEnd = vtkSMPTools::CopyIf(firstUses.begin(), firstUses.end(), positions.begin(),
+    [unused](const std::atomic<vtkTypeInt64>& firstUse) { return firstUse.load() != unused; });
+  positions.erase(positionsEnd, positions.end());
+  std::vector<std::atomic<vtkTypeInt64>>().swap(firstUses);
+  vtkSMPTools::Sort(positions.begin(), positions.end());
+  const vtkIdType numNewPts = static_cast<vtkIdType>(positions.size());
+
+  std::vector<vtkIdType> firstPoints(numNewPts);
+  std::vector<vtkIdType> groupMap(numPts);
+  vtkSMPTools::Fill(groupMap.begin(), groupMap.end(), -1);
+  MapFirstUses mapFirstUses(input, cellIdOffsets, positions.data(), maxCellSize, mergeMap.data(),
+    firstPoints.data(), groupMap.data());
+  vtkSMPTools::For(0, numNewPts, mapFirstUses);
+  std::vector<vtkTypeInt64>().swap(positions);
+
+  std::vector<vtkIdType> pointMap(numPts);
+  const vtkIdType* mergePtr = mergeMap.data();
+  const vtkIdType* groupPtr = groupMap.data();
+  vtkIdType* pointMapPtr = pointMap.data();
+  vtkSMPTools::For(
+    0, numPts, [mergePtr, groupPtr, pointMapPtr](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        pointMapPtr[ptId] = groupPtr[GetMergedPoint(mergePtr, ptId)];
+      }
+    });
+  std::vector<vtkIdType>().swap(groupMap);
+  std::vector<vtkIdType>().swap(mergeMap);
+  this->UpdateProgress(0.5);
+
+  // Copy the points and their data from their first use.
+  if (!this->PointMerging)
+  {
+    outputPD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  }
+  outputPD->CopyAllocate(inputPD);
+  newPts->SetNumberOfPoints(numNewPts);
+  ArrayList arrays;
+  arrays.AddArrays(numNewPts, inputPD, outputPD, 0.0, false);
+  const vtkIdType* firstPtr = firstPoints.data();
+  vtkSMPTools::For(0, numNewPts,
+    [firstPtr, newPts, &mappedPts, &arrays](vtkIdType ptId, vtkIdType endPtId) {
+      double x[3];
+      for (; ptId < endPtId; ++ptId)
+      {
+        mappedPts->GetPoint(firstPtr[ptId], x);
+        newPts->SetPoint(ptId, x);
+        arrays.Copy(firstPtr[ptId], ptId);
+      }
+    });
+  this->UpdateProgress(0.75);
+
+  // Finally, remap and compact the cells.
+  if (!this->GetAbortExecute())
+  {
+    outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+    outputCD->CopyAllocate(input->GetCellData());
+    CleanCellRule rule{ this->ConvertLinesToPoints != 0, this->ConvertPolysToLines != 0,
+      this->ConvertStripsToPolys != 0 };
+    CompactCells(input, pointMap.data(), rule, output);
+  }
+
+  vtkDebugMacro(<< "Removed " << numPts - numNewPts << " points");
+
+  output->SetPoints(newPts);
+  newPts->Delete();
+}
+
 //------------------------------------------------------------------------------
 // Method manages creation of locators. It takes into account the potential
 // change of tolerance (zero to non-zero).
@@ -720,6 +1066,7 @@ void vtkCleanPolyData::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "Locator: (none)\n";
   }
   os << indent << "PieceInvariant: " << (this->PieceInvariant ? "On\n" : "Off\n");
+  os << indent << "ParallelClean: " << (this->ParallelClean ? "On\n" : "Off\n");
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
 }
 
@@ -46,6 +46,10 @@
  * subclasses) to further refine the cleaning process. See
  * vtkQuantizePolyDataPoints.
  *
+ * When ParallelClean is on, the locator is replaced by a vtkStaticPointLocator
+ * and the whole clean is threaded with vtkSMPTools. This is much faster on
+ * large meshes (see SetParallelClean()).
+ *
  * In addition, if a point global id array is available, then two points are merged
  * if and only if they share the same global id.
  *
@@ -185,6 +189,23 @@ public:
    */
   virtual void OperateOnBounds(double in[6], double out[6]);
 
+  //@{
+  /**
+   * Turn on/off the threaded clean. When on, the points are transformed with
+   * OperateOnPoint() and merged with a vtkStaticPointLocator, and the cells
+   * are remapped and compacted, all in parallel using vtkSMPTools. The
+   * Locator is not used, and OperateOnPoint() must be thread safe. With a
+   * zero tolerance the output is the same as with the threaded clean off.
+   * With a non-zero tolerance the points are merged as in
+   * vtkStaticCleanPolyData, which may give a different result that can vary
+   * between runs. Merging based on point global ids is always sequential.
+   * By default, the threaded clean is off.
+   */
+  vtkSetMacro(ParallelClean, vtkTypeBool);
+  vtkGetMacro(ParallelClean, vtkTypeBool);
+  vtkBooleanMacro(ParallelClean, vtkTypeBool);
+  //@}
+
   // This filter is difficult to stream.
   // To get invariant results, the whole input must be processed at once.
   // This flag allows the user to select whether strict piece invariance
@@ -212,6 +233,9 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  // Implementation of RequestData() when ParallelClean is on.
+  void CleanInParallel(vtkPolyData* input, vtkPolyData* output);
+
   vtkTypeBool PointMerging;
   double Tolerance;
   double AbsoluteTolerance;
@@ -222,6 +246,7 @@ protected:
   vtkIncrementalPointLocator* Locator;
 
   vtkTypeBool PieceInvariant;
+  vtkTypeBool ParallelClean;
   int OutputPointsPrecision;
 
 private:
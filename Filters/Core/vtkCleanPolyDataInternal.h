@@ -0,0 +1,354 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCleanPolyDataInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCleanPolyDataInternal
+ * @brief   threaded remapping and compaction of polydata cells
+ *
+ * vtkCleanPolyDataInternal rebuilds the verts, lines, polys and strips of a
+ * vtkPolyData once its points have been renumbered (typically merged). Each
+ * input cell is remapped through a point map and classified by a cell rule
+ * supplied by the filter; the rule removes the ids it does not want and
+ * decides to which output cell array the cell goes, if any (e.g., a polygon
+ * reduced to two points becomes a line). The output cell arrays and cell
+ * data are then filled in parallel using prefix sums, so the output is
+ * identical to the one produced by inserting the cells one at a time.
+ *
+ * A cell rule provides the method
+ *   int operator()(int inType, vtkIdType& npts, vtkIdType* pts) const
+ * where inType is the cell array the cell comes from (CLEAN_VERTS, ...,
+ * CLEAN_STRIPS) and pts holds its npts remapped point ids. The rule may
+ * remove ids in place (updating npts) and returns the output cell array
+ * type, or CLEAN_DISCARD. The rule is invoked concurrently and twice for
+ * each cell, so it must be thread safe and deterministic.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkCleanPolyData vtkStaticCleanPolyData
+ */
+
+#ifndef vtkCleanPolyDataInternal_h
+#define vtkCleanPolyDataInternal_h
+
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// The cell arrays of a vtkPolyData, in the order of the cell ids.
+enum CleanCellType
+{
+  CLEAN_VERTS = 0,
+  CLEAN_LINES = 1,
+  CLEAN_POLYS = 2,
+  CLEAN_STRIPS = 3,
+  CLEAN_DISCARD = 4
+};
+
+// Returns the point a point was merged with. Merge maps produced with a
+// tolerance may chain (a -> b -> c) but always point to smaller ids.
+inline vtkIdType GetMergedPoint(const vtkIdType* mergeMap, vtkIdType ptId)
+{
+  while (mergeMap[ptId] != ptId)
+  {
+    ptId = mergeMap[ptId];
+  }
+  return ptId;
+}
+
+// Remaps and classifies the cells of one input cell array. The number of
+// output cells of each type is accumulated.
+template <typename CellRule>
+struct ClassifyCells
+{
+  vtkCellArray* Cells;
+  int InType;
+  vtkIdType CellIdOffset;
+  const vtkIdType* PointMap;
+  const CellRule& Rule;
+  unsigned char* Types;
+  vtkIdType* Sizes;
+  vtkIdType MaxCellSize;
+  vtkIdType NumCells[CLEAN_DISCARD];
+
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> CellIterator;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> CellPoints;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> LocalNumCells;
+
+  ClassifyCells(vtkCellArray* cells, int inType, vtkIdType offset, const vtkIdType* pointMap,
+    const CellRule& rule, unsigned char* types, vtkIdType* sizes, vtkIdType maxCellSize)
+    : Cells(cells)
+    , InType(inType)
+    , CellIdOffset(offset)
+    , PointMap(pointMap)
+    , Rule(rule)
+    , Types(types)
+    , Sizes(sizes)
+    , MaxCellSize(maxCellSize)
+  {
+    std::fill_n(this->NumCells, static_cast<int>(CLEAN_DISCARD), 0);
+  }
+
+  void Initialize()
+  {
+    this->CellIterator.Local().TakeReference(this->Cells->NewIterator());
+    this->CellPoints.Local().resize(this->MaxCellSize);
+    this->LocalNumCells.Local().assign(CLEAN_DISCARD, 0);
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* cellIter = this->CellIterator.Local();
+    vtkIdType* cellPts = this->CellPoints.Local().data();
+    std::vector<vtkIdType>& numCells = this->LocalNumCells.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      cellIter->GetCellAtId(cellId, npts, pts);
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        cellPts[i] = this->PointMap[pts[i]];
+      }
+      const int type = this->Rule(this->InType, npts, cellPts);
+      this->Types[this->CellIdOffset + cellId] = static_cast<unsigned char>(type);
+      this->Sizes[this->CellIdOffset + cellId] = npts;
+      if (type != CLEAN_DISCARD)
+      {
+        ++numCells[type];
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    for (auto it = this->LocalNumCells.begin(); it != this->LocalNumCells.end(); ++it)
+    {
+      for (int type = 0; type < CLEAN_DISCARD; ++type)
+      {
+        this->NumCells[type] += (*it)[type];
+      }
+    }
+  }
+};
+
+// Writes the cells of one input cell array that go to the output cell array
+// being built, and copies their cell data.
+template <typename CellRule>
+struct BuildCells
+{
+  vtkCellArray* Cells;
+  int InType;
+  vtkIdType CellIdOffset;
+  const vtkIdType* PointMap;
+  const CellRule& Rule;
+  const unsigned char* Types;
+  int OutType;
+  const vtkIdType* CellIndices;
+  const vtkIdType* ConnOffsets;
+  vtkIdType OutCellIdOffset;
+  vtkIdType* Offsets;
+  vtkIdType* Conn;
+  ArrayList* Arrays;
+  vtkIdType MaxCellSize;
+
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> CellIterator;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> CellPoints;
+
+  BuildCells(vtkCellArray* cells, int inType, vtkIdType offset, const vtkIdType* pointMap,
+    const CellRule& rule, const unsigned char* types, int outType, const vtkIdType* cellIndices,
+    const vtkIdType* connOffsets, vtkIdType outOffset, vtkIdType* offsets, vtkIdType* conn,
+    ArrayList* arrays, vtkIdType maxCellSize)
+    : Cells(cells)
+    , InType(inType)
+    , CellIdOffset(offset)
+    , PointMap(pointMap)
+    , Rule(rule)
+    , Types(types)
+    , OutType(outType)
+    , CellIndices(cellIndices)
+    , ConnOffsets(connOffsets)
+    , OutCellIdOffset(outOffset)
+    , Offsets(offsets)
+    , Conn(conn)
+    , Arrays(arrays)
+    , MaxCellSize(maxCellSize)
+  {
+  }
+
+  void Initialize()
+  {
+    this->CellIterator.Local().TakeReference(this->Cells->NewIterator());
+    this->CellPoints.Local().resize(this->MaxCellSize);
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* cellIter = this->CellIterator.Local();
+    vtkIdType* cellPts = this->CellPoints.Local().data();
+    vtkIdType npts;
+    const vtkIdType* pts;
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      const vtkIdType inCellId = this->CellIdOffset + cellId;
+      if (this->Types[inCellId] != this->OutType)
+      {
+        continue;
+      }
+      cellIter->GetCellAtId(cellId, npts, pts);
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        cellPts[i] = this->PointMap[pts[i]];
+      }
+      this->Rule(this->InType, npts, cellPts);
+
+      const vtkIdType outCellId = this->CellIndices[inCellId];
+      vtkIdType* connPtr = this->Conn + this->ConnOffsets[inCellId];
+      this->Offsets[outCellId] = this->ConnOffsets[inCellId];
+      std::copy(cellPts, cellPts + npts, connPtr);
+      this->Arrays->Copy(inCellId, this->OutCellIdOffset + outCellId);
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Remaps the cells of input through pointMap and builds the cell arrays and
+// cell data of output. outCD must have been allocated from the input cell
+// data (e.g., with CopyAllocate()).
+template <typename CellRule>
+void CompactCells(
+  vtkPolyData* input, const vtkIdType* pointMap, const CellRule& rule, vtkPolyData* output)
+{
+  vtkCellArray* inCells[CLEAN_DISCARD] = { input->GetVerts(), input->GetLines(),
+    input->GetPolys(), input->GetStrips() };
+  vtkIdType inOffsets[CLEAN_DISCARD + 1];
+  inOffsets[0] = 0;
+  for (int type = 0; type < CLEAN_DISCARD; ++type)
+  {
+    inOffsets[type + 1] = inOffsets[type] + inCells[type]->GetNumberOfCells();
+  }
+  const vtkIdType numInCells = inOffsets[CLEAN_DISCARD];
+  const vtkIdType maxCellSize = input->GetMaxCellSize();
+
+  // Classify the cells and count them per output cell array.
+  std::vector<unsigned char> types(numInCells);
+  std::vector<vtkIdType> sizes(numInCells);
+  vtkIdType outOffsets[CLEAN_DISCARD + 1];
+  std::fill_n(outOffsets, CLEAN_DISCARD + 1, 0);
+  for (int type = 0; type < CLEAN_DISCARD; ++type)
+  {
+    ClassifyCells<CellRule> classify(inCells[type], type, inOffsets[type], pointMap, rule,
+      types.data(), sizes.data(), maxCellSize);
+    vtkSMPTools::For(0, inCells[type]->GetNumberOfCells(), classify);
+    for (int outType = 0; outType < CLEAN_DISCARD; ++outType)
+    {
+      outOffsets[outType + 1] += classify.NumCells[outType];
+    }
+  }
+  for (int type = 0; type < CLEAN_DISCARD; ++type)
+  {
+    outOffsets[type + 1] += outOffsets[type];
+  }
+
+  vtkCellData* inCD = input->GetCellData();
+  vtkCellData* outCD = output->GetCellData();
+  ArrayList arrays;
+  arrays.AddArrays(outOffsets[CLEAN_DISCARD], inCD, outCD, 0.0, false);
+
+  // Build the output cell arrays one at a time. Cells only degenerate to
+  // lower types, so the cells of an output array come from the input
+  // arrays of the same or a higher type. The prefix sums give each output
+  // cell its index and the position of its connectivity.
+  std::vector<vtkIdType> cellIndices(numInCells + 1);
+  std::vector<vtkIdType> connOffsets(numInCells + 1);
+  for (int outType = 0; outType < CLEAN_DISCARD; ++outType)
+  {
+    const vtkIdType numOutCells = outOffsets[outType + 1] - outOffsets[outType];
+    if (numOutCells == 0)
+    {
+      continue;
+    }
+    const vtkIdType begin = inOffsets[outType];
+    const unsigned char selected = static_cast<unsigned char>(outType);
+    vtkSMPTools::Transform(types.begin() + begin, types.end(), cellIndices.begin() + begin,
+      [selected](unsigned char type) -> vtkIdType { return type == selected ? 1 : 0; });
+    vtkSMPTools::Transform(types.begin() + begin, types.end(), sizes.begin() + begin,
+      connOffsets.begin() + begin, [selected](unsigned char type, vtkIdType size) -> vtkIdType {
+        return type == selected ? size : 0;
+      });
+    cellIndices[numInCells] = 0;
+    connOffsets[numInCells] = 0;
+    vtkSMPTools::ExclusiveScan(cellIndices.begin() + begin, cellIndices.end(),
+      cellIndices.begin() + begin, static_cast<vtkIdType>(0));
+    vtkSMPTools::ExclusiveScan(connOffsets.begin() + begin, connOffsets.end(),
+      connOffsets.begin() + begin, static_cast<vtkIdType>(0));
+    const vtkIdType connSize = connOffsets[numInCells];
+
+    vtkNew<vtkIdTypeArray> offsets;
+    vtkNew<vtkIdTypeArray> conn;
+    vtkIdType* offsetsPtr = offsets->WritePointer(0, numOutCells + 1);
+    vtkIdType* connPtr = conn->WritePointer(0, connSize);
+    offsetsPtr[numOutCells] = connSize;
+    for (int inType = outType; inType < CLEAN_DISCARD; ++inType)
+    {
+      BuildCells<CellRule> build(inCells[inType], inType, inOffsets[inType], pointMap, rule,
+        types.data(), outType, cellIndices.data(), connOffsets.data(), outOffsets[outType],
+        offsetsPtr, connPtr, &arrays, maxCellSize);
+      vtkSMPTools::For(0, inCells[inType]->GetNumberOfCells(), build);
+    }
+
+    vtkNew<vtkCellArray> outCells;
+    outCells->SetData(offsets, conn);
+    switch (outType)
+    {
+      case CLEAN_VERTS:
+        output->SetVerts(outCells);
+        break;
+      case CLEAN_LINES:
+        output->SetLines(outCells);
+        break;
+      case CLEAN_POLYS:
+        output->SetPolys(outCells);
+        break;
+      default:
+        output->SetStrips(outCells);
+        break;
+    }
+  }
+}
+
+} // anonymous namespace
+
+#endif // vtkCleanPolyDataInternal_h
+// VTK-HeaderTest-Exclude: vtkCleanPolyDataInternal.h
@@ -16,6 +16,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityFilterInternal.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
@@ -24,13 +25,19 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <atomic>
 #include <map>
+#include <vector>
 
 vtkObjectFactoryNewMacro(vtkConnectivityFilter);
 
@@ -61,6 +68,7 @@ vtkConnectivityFilter::vtkConnectivityFilter()
   this->NewCellScalars = nullptr;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->ParallelLabeling = 0;
 }
 
 vtkConnectivityFilter::~vtkConnectivityFilter()
@@ -241,28 +249,35 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
+    if (this->ParallelLabeling)
     {
-      if (cellId && !(cellId % 5000))
-      {
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
-      }
-
-      if (this->Visited[cellId] < 0)
+      largestRegionId = this->LabelRegionsInParallel(input, nullptr);
+    }
+    else
+    {
+      for (cellId = 0; cellId < numCells; cellId++)
       {
-        this->NumCellsInRegion = 0;
-        this->Wave->InsertNextId(cellId);
-        this->TraverseAndMark(input);
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
+        if (cellId && !(cellId % 5000))
         {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
+          this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
         }
 
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave->Reset();
-        this->Wave2->Reset();
+        if (this->Visited[cellId] < 0)
+        {
+          this->NumCellsInRegion = 0;
+          this->Wave->InsertNextId(cellId);
+          this->TraverseAndMark(input);
+
+          if (this->NumCellsInRegion > maxCellsInRegion)
+          {
+            maxCellsInRegion = this->NumCellsInRegion;
+            largestRegionId = this->RegionNumber;
+          }
+
+          this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
+          this->Wave->Reset();
+          this->Wave2->Reset();
+        }
       }
     }
   }
@@ -319,8 +334,15 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     this->UpdateProgress(0.5);
 
     // mark all seeded regions
-    this->TraverseAndMark(input);
-    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+    if (this->ParallelLabeling)
+    {
+      this->LabelRegionsInParallel(input, this->Wave);
+    }
+    else
+    {
+      this->TraverseAndMark(input);
+      this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+    }
     this->UpdateProgress(0.9);
   }
 
@@ -597,6 +619,78 @@ void vtkConnectivityFilter::TraverseAndMark(vtkDataSet* input)
   } // while wave is not empty
 }
 
+// Label the regions with a concurrent union-find.
+//
+vtkIdType vtkConnectivityFilter::LabelRegionsInParallel(vtkDataSet* input, vtkIdList* seeds)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+
+  // Calling GetCellPoints() and GetPointCells() once on this thread makes
+  // them thread safe.
+  input->GetCellPoints(0, this->PointIds);
+  input->GetPointCells(0, this->CellIds);
+  vtkNew<vtkStaticCellLinks> links;
+  links->BuildLinks(input);
+
+  std::vector<unsigned char> connected;
+  if (this->InScalars)
+  {
+    connected.resize(numCells);
+    MarkScalarConnectedCells(input, this->InScalars, this->ScalarRange, false, connected.data());
+  }
+  const unsigned char* connectedPtr = this->InScalars ? connected.data() : nullptr;
+
+  vtkIdType numRegions = 1;
+  std::vector<vtkIdType> regionSeeds;
+  if (seeds)
+  {
+    this->RegionSizes->InsertValue(0,
+      LabelSeededRegion(input, links, connectedPtr, seeds->GetPointer(0),
+        seeds->GetNumberOfIds(), this->Visited));
+    regionSeeds.assign(seeds->begin(), seeds->end());
+  }
+  else
+  {
+    numRegions = LabelAllRegions(input, links, connectedPtr, this->Visited, regionSeeds);
+    this->RegionNumber = numRegions;
+
+    std::vector<std::atomic<vtkIdType>> sizes(numRegions);
+    std::atomic<vtkIdType>* sizesPtr = sizes.data();
+    const vtkIdType* regions = this->Visited;
+    vtkSMPTools::For(0, numRegions, [sizesPtr](vtkIdType regionId, vtkIdType endRegionId) {
+      for (; regionId < endRegionId; ++regionId)
+      {
+        sizesPtr[regionId].store(0, std::memory_order_relaxed);
+      }
+    });
+    vtkSMPTools::For(0, numCells, [sizesPtr, regions](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        sizesPtr[regions[cellId]].fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+    this->RegionSizes->SetNumberOfValues(numRegions);
+    for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+    {
+      this->RegionSizes->SetValue(regionId, sizes[regionId].load(std::memory_order_relaxed));
+    }
+  }
+  std::copy(this->Visited, this->Visited + numCells, this->NewCellScalars->GetPointer(0));
+
+  this->PointNumber = MapRegionPoints(input, connectedPtr, this->Visited, regionSeeds.data(),
+    static_cast<vtkIdType>(regionSeeds.size()), this->PointMap, this->NewScalars->GetPointer(0));
+
+  vtkIdType largestRegionId = 0;
+  for (vtkIdType regionId = 1; regionId < numRegions; ++regionId)
+  {
+    if (this->RegionSizes->GetValue(regionId) > this->RegionSizes->GetValue(largestRegionId))
+    {
+      largestRegionId = regionId;
+    }
+  }
+  return largestRegionId;
+}
+
 void vtkConnectivityFilter::OrderRegionIds(
   vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds)
 {
@@ -755,4 +849,5 @@ void vtkConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   double* range = this->GetScalarRange();
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Parallel Labeling: " << (this->ParallelLabeling ? "On\n" : "Off\n");
 }
@@ -50,6 +50,11 @@
  * was processed and has no other significance with respect to the size of
  * or number of cells.
  *
+ * When ParallelLabeling is on, the regions are labeled with a concurrent
+ * union-find using vtkSMPTools instead of the sequential wave propagation.
+ * The output is the same: the regions, their RegionIds and sizes, and the
+ * numbering of the output points.
+ *
  * @sa
  * vtkPolyDataConnectivityFilter
  */
@@ -215,6 +220,21 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the threaded labeling of the regions. When on, the cells are
+   * grouped in regions with a concurrent union-find, in parallel using
+   * vtkSMPTools, rather than by a sequential wave propagation. Every cell gets
+   * the same region, and the region sizes and the cell RegionIds are the same
+   * as with the threaded labeling off. The output points are then numbered
+   * in parallel too, in the order the wave propagation would visit them. By
+   * default, the threaded labeling is off.
+   */
+  vtkSetMacro(ParallelLabeling, vtkTypeBool);
+  vtkGetMacro(ParallelLabeling, vtkTypeBool);
+  vtkBooleanMacro(ParallelLabeling, vtkTypeBool);
+  //@}
+
 protected:
   vtkConnectivityFilter();
   ~vtkConnectivityFilter() override;
@@ -242,9 +262,16 @@ protected:
   double ScalarRange[2];
 
   int RegionIdAssignmentMode;
+  vtkTypeBool ParallelLabeling;
 
   void TraverseAndMark(vtkDataSet* input);
 
+  // Labels the regions in parallel when ParallelLabeling is on, filling the
+  // same structures as TraverseAndMark(). Every region is labeled if seeds
+  // is nullptr, otherwise the single region grown from the seed cells.
+  // Returns the id of the largest region.
+  vtkIdType LabelRegionsInParallel(vtkDataSet* input, vtkIdList* seeds);
+
   void OrderRegionIds(vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds);
 
 private:
@@ -0,0 +1,559 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectivityFilterInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConnectivityFilterInternal
+ * @brief   threaded labeling of connected regions
+ *
+ * vtkConnectivityFilterInternal labels the connected regions of a dataset
+ * with a concurrent union-find, in parallel using vtkSMPTools. Cells are
+ * connected when they share a point. With scalar connectivity, only the
+ * cells satisfying the scalar criterion can be reached from a neighbor;
+ * other cells only start a region of their own. The labels are those of
+ * the sequential wave propagation of vtkConnectivityFilter and
+ * vtkPolyDataConnectivityFilter, which visits the cells in increasing id
+ * order: a region is numbered by the rank of its smallest cell, the cell
+ * that starts the propagation.
+ *
+ * With scalar connectivity, the cells satisfying the criterion are first
+ * grouped in components. A cell that does not satisfy the criterion starts
+ * a region that takes in every adjacent component not reached before,
+ * i.e. the components whose smallest cell is larger than it and that are
+ * not adjacent to another such cell with a smaller id.
+ *
+ * The output points are numbered in the order the wave propagation visits
+ * them. Once the regions are known, the waves of all the regions are
+ * advanced together, one wave per pass: each wave is made of the cells
+ * first reached from the previous one, in the order it reaches them.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ */
+
+#ifndef vtkConnectivityFilterInternal_h
+#define vtkConnectivityFilterInternal_h
+
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLinks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// The representative of a component is its smallest cell id: the parent of
+// a cell is never larger than the cell itself.
+inline vtkIdType FindComponent(std::atomic<vtkIdType>* parents, vtkIdType cellId)
+{
+  for (;;)
+  {
+    vtkIdType parent = parents[cellId].load();
+    if (parent == cellId)
+    {
+      return cellId;
+    }
+    // Path halving: link the cell to its grand parent.
+    const vtkIdType grandParent = parents[parent].load();
+    if (grandParent != parent)
+    {
+      parents[cellId].compare_exchange_weak(parent, grandParent);
+    }
+    cellId = grandParent;
+  }
+}
+
+inline void MergeComponents(std::atomic<vtkIdType>* parents, vtkIdType cellId0, vtkIdType cellId1)
+{
+  for (;;)
+  {
+    vtkIdType root0 = FindComponent(parents, cellId0);
+    vtkIdType root1 = FindComponent(parents, cellId1);
+    if (root0 == root1)
+    {
+      return;
+    }
+    if (root0 < root1)
+    {
+      std::swap(root0, root1);
+    }
+    // Fails if another thread attached root0 in the meantime; retry then.
+    vtkIdType expected = root0;
+    if (parents[root0].compare_exchange_strong(expected, root1))
+    {
+      return;
+    }
+  }
+}
+
+inline void AtomicMin(std::atomic<vtkIdType>& value, vtkIdType candidate)
+{
+  vtkIdType current = value.load(std::memory_order_relaxed);
+  while (candidate < current && !value.compare_exchange_weak(current, candidate))
+  {
+  }
+}
+
+// Reads the points of the cells, and the cells of the points, with id lists
+// per thread.
+struct CellPointsReader
+{
+  vtkDataSet* Input;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> PointIds;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> CellIds;
+
+  CellPointsReader(vtkDataSet* input)
+    : Input(input)
+  {
+  }
+
+  vtkIdList* GetCellPoints(vtkIdType cellId)
+  {
+    vtkSmartPointer<vtkIdList>& ptIds = this->PointIds.Local();
+    if (!ptIds)
+    {
+      ptIds = vtkSmartPointer<vtkIdList>::New();
+    }
+    this->Input->GetCellPoints(cellId, ptIds);
+    return ptIds;
+  }
+
+  vtkIdList* GetPointCells(vtkIdType ptId)
+  {
+    vtkSmartPointer<vtkIdList>& cellIds = this->CellIds.Local();
+    if (!cellIds)
+    {
+      cellIds = vtkSmartPointer<vtkIdList>::New();
+    }
+    this->Input->GetPointCells(ptId, cellIds);
+    return cellIds;
+  }
+};
+
+// Flags the cells whose point scalars (first component, compared in single
+// precision as the sequential filters do) satisfy the scalar criterion:
+// any point, or all the points if allPointsInRange, is in the range.
+inline void MarkScalarConnectedCells(vtkDataSet* input, vtkDataArray* scalars,
+  const double range[2], bool allPointsInRange, unsigned char* connected)
+{
+  CellPointsReader reader(input);
+  vtkSMPTools::For(0, input->GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      vtkIdList* ptIds = reader.GetCellPoints(cellId);
+      double cellRange[2] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+        const double s = static_cast<float>(scalars->GetComponent(ptIds->GetId(i), 0));
+        cellRange[0] = std::min(cellRange[0], s);
+        cellRange[1] = std::max(cellRange[1], s);
+      }
+      connected[cellId] = allPointsInRange
+        ? (cellRange[0] >= range[0] && cellRange[1] <= range[1])
+        : (cellRange[1] >= range[0] && cellRange[0] <= range[1]);
+    }
+  });
+}
+
+// Groups the connected cells sharing a point in components, and gives for
+// each connected cell the smallest cell of its component. Cells that are
+// not connected are their own component. connected flags the cells
+// satisfying the scalar criterion (nullptr if all of them do).
+inline void FindComponents(vtkDataSet* input, vtkStaticCellLinks* links,
+  const unsigned char* connected, vtkIdType* components)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+
+  std::vector<std::atomic<vtkIdType>> parents(numCells);
+  std::atomic<vtkIdType>* parentsPtr = parents.data();
+  vtkSMPTools::For(0, numCells, [parentsPtr](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      parentsPtr[cellId].store(cellId, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      const vtkIdType ncells = links->GetNcells(ptId);
+      const vtkIdType* cells = links->GetCells(ptId);
+      vtkIdType first = -1;
+      for (vtkIdType i = 0; i < ncells; ++i)
+      {
+        if (!connected || connected[cells[i]])
+        {
+          if (first < 0)
+          {
+            first = cells[i];
+          }
+          else
+          {
+            MergeComponents(parentsPtr, first, cells[i]);
+          }
+        }
+      }
+    }
+  });
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      components[cellId] = FindComponent(parentsPtr, cellId);
+    }
+  });
+}
+
+// Calls functor(neighborId) for each connected cell sharing a point with
+// the given cell.
+template <typename Functor>
+void ForEachConnectedNeighbor(vtkIdList* ptIds, vtkStaticCellLinks* links,
+  const unsigned char* connected, Functor& functor)
+{
+  for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+  {
+    const vtkIdType ncells = links->GetNcells(ptIds->GetId(i));
+    const vtkIdType* cells = links->GetCells(ptIds->GetId(i));
+    for (vtkIdType j = 0; j < ncells; ++j)
+    {
+      if (connected[cells[j]])
+      {
+        functor(cells[j]);
+      }
+    }
+  }
+}
+
+// Labels every region. Returns the number of regions, the region of each
+// cell in cellRegions and the smallest cell of each region, which starts its
+// propagation, in seeds. GetCellPoints() must be thread safe.
+inline vtkIdType LabelAllRegions(vtkDataSet* input, vtkStaticCellLinks* links,
+  const unsigned char* connected, vtkIdType* cellRegions, std::vector<vtkIdType>& seeds)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  std::vector<vtkIdType> regionSeeds(numCells);
+  vtkIdType* regionSeedsPtr = regionSeeds.data();
+  FindComponents(input, links, connected, regionSeedsPtr);
+
+  if (connected)
+  {
+    // A component is taken in by the smallest adjacent cell that is not
+    // connected, if that cell comes before the component.
+    std::vector<std::atomic<vtkIdType>> claims(numCells);
+    std::atomic<vtkIdType>* claimsPtr = claims.data();
+    vtkSMPTools::For(0, numCells, [claimsPtr, numCells](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        claimsPtr[cellId].store(numCells, std::memory_order_relaxed);
+      }
+    });
+    CellPointsReader reader(input);
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        if (connected[cellId])
+        {
+          continue;
+        }
+        auto claim = [&](vtkIdType neighborId) {
+          const vtkIdType component = regionSeedsPtr[neighborId];
+          if (cellId < component)
+          {
+            AtomicMin(claimsPtr[component], cellId);
+          }
+        };
+        ForEachConnectedNeighbor(reader.GetCellPoints(cellId), links, connected, claim);
+      }
+    });
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        if (connected[cellId])
+        {
+          const vtkIdType component = regionSeedsPtr[cellId];
+          const vtkIdType claim = claimsPtr[component].load(std::memory_order_relaxed);
+          regionSeedsPtr[cellId] = claim < component ? claim : component;
+        }
+      }
+    });
+  }
+
+  // Regions are numbered in the order of their seeds.
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      cellRegions[cellId] = regionSeedsPtr[cellId] == cellId ? 1 : 0;
+    }
+  });
+  const vtkIdType lastSeed = cellRegions[numCells - 1];
+  vtkSMPTools::ExclusiveScan(cellRegions, cellRegions + numCells, cellRegions, vtkIdType(0));
+  const vtkIdType numRegions = cellRegions[numCells - 1] + lastSeed;
+  seeds.resize(numRegions);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      // A seed precedes the other cells of its region and already holds
+      // the region number.
+      if (regionSeedsPtr[cellId] != cellId)
+      {
+        cellRegions[cellId] = cellRegions[regionSeedsPtr[cellId]];
+      }
+      else
+      {
+        seeds[cellRegions[cellId]] = cellId;
+      }
+    }
+  });
+  return numRegions;
+}
+
+// Labels with region 0 the cells reached from the given seed cells, and
+// with -1 the other ones. Returns the number of cells reached.
+inline vtkIdType LabelSeededRegion(vtkDataSet* input, vtkStaticCellLinks* links,
+  const unsigned char* connected, const vtkIdType* seeds, vtkIdType numSeeds,
+  vtkIdType* cellRegions)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  std::vector<vtkIdType> components(numCells);
+  FindComponents(input, links, connected, components.data());
+
+  // A seed reaches its component, or, if it is not connected, itself and
+  // the adjacent components.
+  std::vector<unsigned char> reached(numCells, 0);
+  vtkNew<vtkIdList> ptIds;
+  auto reach = [&](vtkIdType neighborId) { reached[components[neighborId]] = 1; };
+  for (vtkIdType i = 0; i < numSeeds; ++i)
+  {
+    reached[components[seeds[i]]] = 1;
+    if (connected && !connected[seeds[i]])
+    {
+      input->GetCellPoints(seeds[i], ptIds);
+      ForEachConnectedNeighbor(ptIds, links, connected, reach);
+    }
+  }
+
+  vtkSMPTools::Transform(components.begin(), components.end(), cellRegions,
+    [&](vtkIdType component) -> vtkIdType { return reached[component] ? 0 : -1; });
+  return vtkSMPTools::TransformReduce(cellRegions, cellRegions + numCells, vtkIdType(0),
+    std::plus<vtkIdType>(), [](vtkIdType region) -> vtkIdType { return region == 0 ? 1 : 0; });
+}
+
+// Calls functor on each cell of the region of cellId that is not visited yet
+// and that is reached from it through one of its points, in order.
+template <typename Functor>
+void ForEachReachedCell(CellPointsReader& reader, vtkIdType cellId, const unsigned char* visited,
+  const vtkIdType* cellRegions, const unsigned char* connected, Functor&& functor)
+{
+  vtkIdList* ptIds = reader.GetCellPoints(cellId);
+  for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+  {
+    vtkIdList* cellIds = reader.GetPointCells(ptIds->GetId(i));
+    for (vtkIdType j = 0; j < cellIds->GetNumberOfIds(); ++j)
+    {
+      const vtkIdType neighborId = cellIds->GetId(j);
+      if (!visited[neighborId] && cellRegions[neighborId] == cellRegions[cellId] &&
+        (!connected || connected[neighborId]))
+      {
+        functor(neighborId);
+      }
+    }
+  }
+}
+
+// Numbers the points used by the labeled cells in the order the sequential
+// wave propagation visits them, and gives each of them the region of the
+// cells visiting it first. The propagation of each region starts from its
+// seeds, in order, and goes from a cell to the connected cells of the same
+// region through input->GetPointCells(). GetCellPoints() and GetPointCells()
+// must be thread safe. Returns the number of points.
+inline vtkIdType MapRegionPoints(vtkDataSet* input, const unsigned char* connected,
+  const vtkIdType* cellRegions, const vtkIdType* seeds, vtkIdType numSeeds, vtkIdType* pointMap,
+  vtkIdType* pointRegions)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  CellPointsReader reader(input);
+
+  // Order the cells as the propagation visits them: wave after wave, the
+  // cells of a wave in the order the previous wave reaches them first.
+  std::vector<unsigned char> visited(numCells, 0);
+  std::vector<vtkIdType> order;
+  order.reserve(numCells);
+  for (vtkIdType i = 0; i < numSeeds; ++i)
+  {
+    if (!visited[seeds[i]])
+    {
+      visited[seeds[i]] = 1;
+      order.push_back(seeds[i]);
+    }
+  }
+  std::vector<std::atomic<vtkIdType>> firstReaches(numCells);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      firstReaches[cellId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  std::vector<vtkIdType> counts;
+  std::vector<vtkIdType> reached;
+  for (std::size_t waveBegin = 0; waveBegin < order.size();)
+  {
+    const std::size_t waveEnd = order.size();
+    const vtkIdType waveSize = static_cast<vtkIdType>(waveEnd - waveBegin);
+    const vtkIdType* wave = order.data() + waveBegin;
+
+    // Number the cells reached by each cell of the wave, in order.
+    counts.resize(waveSize);
+    vtkSMPTools::For(0, waveSize, [&](vtkIdType i, vtkIdType end) {
+      for (; i < end; ++i)
+      {
+        vtkIdType count = 0;
+        ForEachReachedCell(reader, wave[i], visited.data(), cellRegions, connected,
+          [&count](vtkIdType) { ++count; });
+        counts[i] = count;
+      }
+    });
+    const vtkIdType lastCount = counts[waveSize - 1];
+    vtkSMPTools::ExclusiveScan(counts.begin(), counts.end(), counts.begin(), vtkIdType(0));
+    reached.resize(counts[waveSize - 1] + lastCount);
+    vtkSMPTools::For(0, waveSize, [&](vtkIdType i, vtkIdType end) {
+      for (; i < end; ++i)
+      {
+        vtkIdType index = counts[i];
+        ForEachReachedCell(
+          reader, wave[i], visited.data(), cellRegions, connected, [&](vtkIdType neighborId) {
+            reached[index] = neighborId;
+            AtomicMin(firstReaches[neighborId], index++);
+          });
+      }
+    });
+
+    // The next wave keeps the first time each cell is reached.
+    vtkSMPTools::For(0, static_cast<vtkIdType>(reached.size()),
+      [&](vtkIdType index, vtkIdType end) {
+        for (; index < end; ++index)
+        {
+          if (firstReaches[reached[index]].load(std::memory_order_relaxed) != index)
+          {
+            reached[index] = -1;
+          }
+        }
+      });
+    order.resize(waveEnd + reached.size());
+    order.resize(vtkSMPTools::CopyIf(reached.begin(), reached.end(), order.begin() + waveEnd,
+                   [](vtkIdType cellId) { return cellId >= 0; }) -
+      order.begin());
+    vtkSMPTools::For(static_cast<vtkIdType>(waveEnd), static_cast<vtkIdType>(order.size()),
+      [&](vtkIdType index, vtkIdType end) {
+        for (; index < end; ++index)
+        {
+          visited[order[index]] = 1;
+        }
+      });
+    waveBegin = waveEnd;
+  }
+
+  // The regions are propagated one after the other.
+  std::vector<vtkIdType> ranks(numCells);
+  const vtkIdType numVisited = static_cast<vtkIdType>(order.size());
+  vtkSMPTools::For(0, numVisited, [&](vtkIdType index, vtkIdType end) {
+    for (; index < end; ++index)
+    {
+      ranks[order[index]] = index;
+    }
+  });
+  vtkSMPTools::Sort(order.begin(), order.end(), [&](vtkIdType cellId0, vtkIdType cellId1) {
+    return cellRegions[cellId0] < cellRegions[cellId1] ||
+      (cellRegions[cellId0] == cellRegions[cellId1] && ranks[cellId0] < ranks[cellId1]);
+  });
+
+  // A point is numbered by the first cell visiting it.
+  std::vector<vtkIdType> offsets(numVisited);
+  vtkSMPTools::For(0, numVisited, [&](vtkIdType index, vtkIdType end) {
+    for (; index < end; ++index)
+    {
+      offsets[index] = reader.GetCellPoints(order[index])->GetNumberOfIds();
+    }
+  });
+  vtkSMPTools::ExclusiveScan(offsets.begin(), offsets.end(), offsets.begin(), vtkIdType(0));
+  std::vector<std::atomic<vtkIdType>> firstUses(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstUses[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numVisited, [&](vtkIdType index, vtkIdType end) {
+    for (; index < end; ++index)
+    {
+      vtkIdList* ptIds = reader.GetCellPoints(order[index]);
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+        AtomicMin(firstUses[ptIds->GetId(i)], offsets[index] + i);
+      }
+    }
+  });
+  std::vector<vtkIdType> numbers(numVisited);
+  vtkSMPTools::For(0, numVisited, [&](vtkIdType index, vtkIdType end) {
+    for (; index < end; ++index)
+    {
+      vtkIdList* ptIds = reader.GetCellPoints(order[index]);
+      vtkIdType count = 0;
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+        count += firstUses[ptIds->GetId(i)].load(std::memory_order_relaxed) == offsets[index] + i;
+      }
+      numbers[index] = count;
+    }
+  });
+  const vtkIdType lastNumber = numVisited > 0 ? numbers[numVisited - 1] : 0;
+  vtkSMPTools::ExclusiveScan(numbers.begin(), numbers.end(), numbers.begin(), vtkIdType(0));
+  const vtkIdType numNewPts = numVisited > 0 ? numbers[numVisited - 1] + lastNumber : 0;
+  vtkSMPTools::Fill(pointMap, pointMap + numPts, vtkIdType(-1));
+  vtkSMPTools::For(0, numVisited, [&](vtkIdType index, vtkIdType end) {
+    for (; index < end; ++index)
+    {
+      vtkIdList* ptIds = reader.GetCellPoints(order[index]);
+      vtkIdType number = numbers[index];
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+        const vtkIdType ptId = ptIds->GetId(i);
+        if (firstUses[ptId].load(std::memory_order_relaxed) == offsets[index] + i)
+        {
+          pointMap[ptId] = number;
+          pointRegions[number++] = cellRegions[order[index]];
+        }
+      }
+    }
+  });
+  return numNewPts;
+}
+
+} // anonymous namespace
+
+#endif // vtkConnectivityFilterInternal_h
+// VTK-HeaderTest-Exclude: vtkConnectivityFilterInternal.h
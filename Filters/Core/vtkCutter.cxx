@@ -41,6 +41,7 @@
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearSynchronizedTemplates.h"
+#include "vtkScratchPool.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
@@ -478,7 +479,6 @@ void vtkCutter::DataSetCutter(vtkDataSet* input, vtkPolyData* output)
   int iter;
   vtkPoints* cellPts;
   vtkDoubleArray* cellScalars;
-  vtkGenericCell* cell;
   vtkCellArray *newVerts, *newLines, *newPolys;
   vtkPoints* newPoints;
   vtkDoubleArray* cutScalars;
@@ -568,7 +568,7 @@ void vtkCutter::DataSetCutter(vtkDataSet* input, vtkPolyData* output)
 
   // Compute some information for progress methods
   //
-  cell = vtkGenericCell::New();
+  auto cell = vtkScratchPool<vtkGenericCell>::Acquire();
   vtkContourHelper helper(this->Locator, newVerts, newLines, newPolys, inPD, inCD, outPD, outCD,
     estimatedSize, this->GenerateTriangles != 0);
   if (this->SortBy == VTK_SORT_BY_CELL)
@@ -689,7 +689,6 @@ void vtkCutter::DataSetCutter(vtkDataSet* input, vtkPolyData* output)
   // Update ourselves.  Because we don't know upfront how many verts, lines,
   // polys we've created, take care to reclaim memory.
   //
-  cell->Delete();
   cellScalars->Delete();
   cutScalars->Delete();
 
@@ -820,7 +819,7 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
   }
   vtkSmartPointer<vtkCellIterator> cellIter =
     vtkSmartPointer<vtkCellIterator>::Take(input->NewCellIterator());
-  vtkNew<vtkGenericCell> cell;
+  auto cell = vtkScratchPool<vtkGenericCell>::Acquire();
   vtkIdList* pointIdList;
   double* scalarArrayPtr = cutScalars->GetPointer(0);
   double tempScalar;
@@ -23,11 +23,18 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
+
+#include "vtkConnectivityFilterInternal.h"
 
 #include <algorithm> // for fill_n
+#include <atomic>
+#include <vector>
 
 vtkStandardNewMacro(vtkPolyDataConnectivityFilter);
 
@@ -58,6 +65,7 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
   this->VisitedPointIds = vtkIdList::New();
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->ParallelLabeling = 0;
 }
 
 vtkPolyDataConnectivityFilter::~vtkPolyDataConnectivityFilter()
@@ -134,6 +142,11 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   this->Mesh = vtkPolyData::New();
   this->Mesh->CopyStructure(input);
   this->Mesh->BuildLinks();
+  vtkNew<vtkStaticCellLinks> links;
+  if (this->ParallelLabeling)
+  {
+    links->BuildLinks(this->Mesh);
+  }
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
@@ -188,28 +201,35 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
+    if (this->ParallelLabeling)
     {
-      if (cellId && !(cellId % 5000))
-      {
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
-      }
-
-      if (this->Visited[cellId] < 0)
+      largestRegionId = this->LabelRegionsInParallel(links, false);
+    }
+    else
+    {
+      for (cellId = 0; cellId < numCells; cellId++)
       {
-        this->NumCellsInRegion = 0;
-        this->Wave.push_back(cellId);
-        this->TraverseAndMark();
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
+        if (cellId && !(cellId % 5000))
         {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
+          this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
         }
 
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave.clear();
-        this->Wave2.clear();
+        if (this->Visited[cellId] < 0)
+        {
+          this->NumCellsInRegion = 0;
+          this->Wave.push_back(cellId);
+          this->TraverseAndMark();
+
+          if (this->NumCellsInRegion > maxCellsInRegion)
+          {
+            maxCellsInRegion = this->NumCellsInRegion;
+            largestRegionId = this->RegionNumber;
+          }
+
+          this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
+          this->Wave.clear();
+          this->Wave2.clear();
+        }
       }
     }
   }
@@ -266,8 +286,15 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     this->UpdateProgress(0.5);
 
     // mark all seeded regions
-    this->TraverseAndMark();
-    this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+    if (this->ParallelLabeling)
+    {
+      this->LabelRegionsInParallel(links, true);
+    }
+    else
+    {
+      this->TraverseAndMark();
+      this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
+    }
     this->UpdateProgress(0.9);
   } // else extracted seeded cells
 
@@ -502,6 +529,77 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark()
   } // while wave is not empty
 }
 
+// Label the regions with a concurrent union-find.
+//
+vtkIdType vtkPolyDataConnectivityFilter::LabelRegionsInParallel(
+  vtkStaticCellLinks* links, bool seeded)
+{
+  const vtkIdType numCells = this->Mesh->GetNumberOfCells();
+
+  // Calling GetCellPoints() and GetPointCells() once on this thread makes
+  // them thread safe.
+  this->Mesh->GetCellPoints(0, this->PointIds);
+  this->Mesh->GetPointCells(0, this->CellIds);
+
+  std::vector<unsigned char> connected;
+  if (this->InScalars)
+  {
+    connected.resize(numCells);
+    MarkScalarConnectedCells(this->Mesh, this->InScalars, this->ScalarRange,
+      this->FullScalarConnectivity != 0, connected.data());
+  }
+  const unsigned char* connectedPtr = this->InScalars ? connected.data() : nullptr;
+
+  vtkIdType numRegions = 1;
+  if (seeded)
+  {
+    this->RegionSizes->InsertValue(0,
+      LabelSeededRegion(this->Mesh, links, connectedPtr, this->Wave.data(),
+        static_cast<vtkIdType>(this->Wave.size()), this->Visited));
+  }
+  else
+  {
+    numRegions = LabelAllRegions(this->Mesh, links, connectedPtr, this->Visited, this->Wave);
+    this->RegionNumber = numRegions;
+
+    std::vector<std::atomic<vtkIdType>> sizes(numRegions);
+    std::atomic<vtkIdType>* sizesPtr = sizes.data();
+    const vtkIdType* regions = this->Visited;
+    vtkSMPTools::For(0, numRegions, [sizesPtr](vtkIdType regionId, vtkIdType endRegionId) {
+      for (; regionId < endRegionId; ++regionId)
+      {
+        sizesPtr[regionId].store(0, std::memory_order_relaxed);
+      }
+    });
+    vtkSMPTools::For(0, numCells, [sizesPtr, regions](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        sizesPtr[regions[cellId]].fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+    this->RegionSizes->SetNumberOfValues(numRegions);
+    for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+    {
+      this->RegionSizes->SetValue(regionId, sizes[regionId].load(std::memory_order_relaxed));
+    }
+  }
+
+  this->PointNumber = MapRegionPoints(this->Mesh, connectedPtr, this->Visited, this->Wave.data(),
+    static_cast<vtkIdType>(this->Wave.size()), this->PointMap,
+    vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars)->GetPointer(0));
+  this->Wave.clear();
+
+  vtkIdType largestRegionId = 0;
+  for (vtkIdType regionId = 1; regionId < numRegions; ++regionId)
+  {
+    if (this->RegionSizes->GetValue(regionId) > this->RegionSizes->GetValue(largestRegionId))
+    {
+      largestRegionId = regionId;
+    }
+  }
+  return largestRegionId;
+}
+
 //------------------------------------------------------------------------------
 int vtkPolyDataConnectivityFilter::IsScalarConnected(vtkIdType cellId)
 {
@@ -645,4 +743,5 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Parallel Labeling: " << (this->ParallelLabeling ? "On\n" : "Off\n");
 }
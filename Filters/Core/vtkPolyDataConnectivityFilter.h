@@ -43,6 +43,11 @@
  * This use of ScalarConnectivity is particularly useful for selecting cells
  * for later processing.
  *
+ * When ParallelLabeling is on, the regions are labeled with a concurrent
+ * union-find using vtkSMPTools instead of the sequential wave propagation.
+ * The output is the same: the regions, their sizes and the numbering of the
+ * output points.
+ *
  * @sa
  * vtkConnectivityFilter
  */
@@ -63,6 +68,7 @@
 class vtkDataArray;
 class vtkIdList;
 class vtkIdTypeArray;
+class vtkStaticCellLinks;
 
 class VTKFILTERSCORE_EXPORT vtkPolyDataConnectivityFilter : public vtkPolyDataAlgorithm
 {
@@ -227,6 +233,21 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the threaded labeling of the regions. When on, the cells are
+   * grouped in regions with a concurrent union-find, in parallel using
+   * vtkSMPTools, rather than by a sequential wave propagation. Every cell gets
+   * the same region, and the region sizes are the same as with the threaded
+   * labeling off. The output points are then numbered in parallel too, in
+   * the order the wave propagation would visit them. By default, the threaded
+   * labeling is off.
+   */
+  vtkSetMacro(ParallelLabeling, vtkTypeBool);
+  vtkGetMacro(ParallelLabeling, vtkTypeBool);
+  vtkBooleanMacro(ParallelLabeling, vtkTypeBool);
+  //@}
+
 protected:
   vtkPolyDataConnectivityFilter();
   ~vtkPolyDataConnectivityFilter() override;
@@ -252,6 +273,12 @@ protected:
 
   void TraverseAndMark();
 
+  // Labels the regions in parallel when ParallelLabeling is on, filling the
+  // same structures as TraverseAndMark(). Every region is labeled unless
+  // seeded, in which case the single region grown from the cells in Wave.
+  // Returns the id of the largest region.
+  vtkIdType LabelRegionsInParallel(vtkStaticCellLinks* links, bool seeded);
+
   // used to support algorithm execution
   vtkDataArray* CellScalars;
   vtkIdList* NeighborCellPointIds;
@@ -271,6 +298,7 @@ protected:
 
   vtkTypeBool MarkVisitedPointIds;
   int OutputPointsPrecision;
+  vtkTypeBool ParallelLabeling;
 
 private:
   vtkPolyDataConnectivityFilter(const vtkPolyDataConnectivityFilter&) = delete;
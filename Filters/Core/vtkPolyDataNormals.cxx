@@ -27,12 +27,540 @@
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTriangleStrip.h"
 
 #include "vtkNew.h"
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 vtkStandardNewMacro(vtkPolyDataNormals);
 
+#define VTK_CELL_NOT_VISITED 0
+#define VTK_CELL_VISITED 1
+
+//------------------------------------------------------------------------------
+// Internal classes and methods for the threaded normal computation.
+namespace
+{
+
+// Connected regions of polygons are tracked with a concurrent union-find.
+// A region is represented by its smallest cell id: the parent of a cell is
+// never larger than the cell itself, so that the representative of a region
+// is the seed that a traversal in cell order would pick first.
+vtkIdType FindRegion(std::atomic<vtkIdType>* parents, vtkIdType cellId)
+{
+  for (;;)
+  {
+    vtkIdType parent = parents[cellId].load();
+    if (parent == cellId)
+    {
+      return cellId;
+    }
+    // Path halving: link the cell to its grand parent.
+    const vtkIdType grandParent = parents[parent].load();
+    if (grandParent != parent)
+    {
+      parents[cellId].compare_exchange_weak(parent, grandParent);
+    }
+    cellId = grandParent;
+  }
+}
+
+void MergeRegions(std::atomic<vtkIdType>* parents, vtkIdType cellId0, vtkIdType cellId1)
+{
+  for (;;)
+  {
+    vtkIdType root0 = FindRegion(parents, cellId0);
+    vtkIdType root1 = FindRegion(parents, cellId1);
+    if (root0 == root1)
+    {
+      return;
+    }
+    if (root0 < root1)
+    {
+      std::swap(root0, root1);
+    }
+    // Fails if another thread attached root0 in the meantime; retry then.
+    vtkIdType expected = root0;
+    if (parents[root0].compare_exchange_strong(expected, root1))
+    {
+      return;
+    }
+  }
+}
+
+// Merge the regions of the polygons connected through an edge that the
+// traversal is allowed to cross. Parents must have been initialized with
+// the cell ids.
+struct LinkRegions
+{
+  vtkPolyData* Mesh;
+  bool NonManifoldTraversal;
+  std::atomic<vtkIdType>* Parents;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> CellPoints;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> CellIds;
+
+  LinkRegions(vtkPolyData* mesh, bool nonManifoldTraversal, std::atomic<vtkIdType>* parents)
+    : Mesh(mesh)
+    , NonManifoldTraversal(nonManifoldTraversal)
+    , Parents(parents)
+  {
+  }
+
+  void Initialize()
+  {
+    this->CellPoints.Local().TakeReference(vtkIdList::New());
+    this->CellIds.Local().TakeReference(vtkIdList::New());
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkIdList* cellPoints = this->CellPoints.Local();
+    vtkIdList* cellIds = this->CellIds.Local();
+
+    for (; cellId < endCellId; ++cellId)
+    {
+      this->Mesh->GetCellPoints(cellId, cellPoints);
+      const vtkIdType npts = cellPoints->GetNumberOfIds();
+      const vtkIdType* pts = cellPoints->GetPointer(0);
+      for (vtkIdType j = 0; j < npts; ++j)
+      {
+        this->Mesh->GetCellEdgeNeighbors(cellId, pts[j], pts[(j + 1) % npts], cellIds);
+        if (cellIds->GetNumberOfIds() == 1 || this->NonManifoldTraversal)
+        {
+          for (vtkIdType k = 0; k < cellIds->GetNumberOfIds(); ++k)
+          {
+            MergeRegions(this->Parents, cellId, cellIds->GetId(k));
+          }
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// First polygon of a traversal, and whether it has to be reversed.
+struct TraversalSeed
+{
+  vtkIdType CellId;
+  bool Reverse;
+};
+
+// Propagates a wave of consistently ordered polygons from a seed polygon.
+// Polygons are read from and reordered in NewMesh while the topological
+// queries use OldMesh. Two traversals may run concurrently as long as
+// their seeds belong to different regions.
+class PolygonTraversal
+{
+public:
+  PolygonTraversal()
+    : OldMesh(nullptr)
+    , NewMesh(nullptr)
+    , Visited(nullptr)
+    , NonManifoldTraversal(false)
+    , NumFlips(0)
+    , NumVisited(0)
+  {
+  }
+
+  void Initialize(vtkPolyData* oldMesh, vtkPolyData* newMesh, int* visited,
+    bool nonManifoldTraversal, vtkIdType numPolys)
+  {
+    this->OldMesh = oldMesh;
+    this->NewMesh = newMesh;
+    this->Visited = visited;
+    this->NonManifoldTraversal = nonManifoldTraversal;
+    this->Wave.TakeReference(vtkIdList::New());
+    this->Wave->Allocate(numPolys / 4 + 1, numPolys);
+    this->Wave2.TakeReference(vtkIdList::New());
+    this->Wave2->Allocate(numPolys / 4 + 1, numPolys);
+    this->CellIds.TakeReference(vtkIdList::New());
+    this->CellIds->Allocate(VTK_CELL_SIZE);
+    this->CellPoints.TakeReference(vtkIdList::New());
+    this->CellPoints->Allocate(VTK_CELL_SIZE);
+    this->NeighborPoints.TakeReference(vtkIdList::New());
+    this->NeighborPoints->Allocate(VTK_CELL_SIZE);
+  }
+
+  void Traverse(const TraversalSeed& seed)
+  {
+    if (seed.Reverse)
+    {
+      this->NumFlips++;
+      this->NewMesh->ReverseCell(seed.CellId);
+    }
+    this->Visited[seed.CellId] = VTK_CELL_VISITED;
+    this->NumVisited++;
+    this->Wave->Reset();
+    this->Wave2->Reset();
+    this->Wave->InsertNextId(seed.CellId);
+
+    vtkIdType numIds;
+    // propagate wave until nothing left in wave
+    while ((numIds = this->Wave->GetNumberOfIds()) > 0)
+    {
+      for (vtkIdType i = 0; i < numIds; i++)
+      {
+        const vtkIdType cellId = this->Wave->GetId(i);
+
+        // Store the results here in a vtkIdList, since passing npts/pts directly
+        // would result in the data getting invalidated by the later call to
+        // NewMesh->GetCellPoints.
+        this->NewMesh->GetCellPoints(cellId, this->CellPoints);
+        const vtkIdType npts = this->CellPoints->GetNumberOfIds();
+        const vtkIdType* pts = this->CellPoints->GetPointer(0);
+
+        for (vtkIdType j = 0; j < npts; ++j) // for each edge neighbor
+        {
+          const vtkIdType j1 = (j + 1) % npts;
+          this->OldMesh->GetCellEdgeNeighbors(cellId, pts[j], pts[j1], this->CellIds);
+
+          //  Check the direction of the neighbor ordering.  Should be
+          //  consistent with us (i.e., if we are n1->n2,
+          // neighbor should be n2->n1).
+          if (this->CellIds->GetNumberOfIds() == 1 || this->NonManifoldTraversal)
+          {
+            for (vtkIdType k = 0; k < this->CellIds->GetNumberOfIds(); k++)
+            {
+              const vtkIdType neighbor = this->CellIds->GetId(k);
+              if (this->Visited[neighbor] == VTK_CELL_NOT_VISITED)
+              {
+                this->NewMesh->GetCellPoints(neighbor, this->NeighborPoints);
+                const vtkIdType numNeiPts = this->NeighborPoints->GetNumberOfIds();
+                const vtkIdType* neiPts = this->NeighborPoints->GetPointer(0);
+
+                vtkIdType l;
+                for (l = 0; l < numNeiPts; l++)
+                {
+                  if (neiPts[l] == pts[j1])
+                  {
+                    break;
+                  }
+                }
+
+                //  Have to reverse ordering if neighbor not consistent
+                //
+                if (neiPts[(l + 1) % numNeiPts] != pts[j])
+                {
+                  this->NumFlips++;
+                  this->NewMesh->ReverseCell(neighbor);
+                }
+                this->Visited[neighbor] = VTK_CELL_VISITED;
+                this->NumVisited++;
+                this->Wave2->InsertNextId(neighbor);
+              } // if cell not visited
+            }   // for each edge neighbor
+          }     // for manifold or non-manifold traversal allowed
+        }       // for all edges of this polygon
+      }         // for all cells in wave
+
+      // swap wave and proceed with propagation
+      std::swap(this->Wave, this->Wave2);
+      this->Wave2->Reset();
+    } // while wave still propagating
+  }
+
+  int GetNumberOfFlips() const { return this->NumFlips; }
+  vtkIdType GetNumberOfVisitedCells() const { return this->NumVisited; }
+
+private:
+  vtkPolyData* OldMesh;
+  vtkPolyData* NewMesh;
+  int* Visited;
+  bool NonManifoldTraversal;
+  int NumFlips;
+  vtkIdType NumVisited;
+  vtkSmartPointer<vtkIdList> Wave;
+  vtkSmartPointer<vtkIdList> Wave2;
+  vtkSmartPointer<vtkIdList> CellIds;
+  vtkSmartPointer<vtkIdList> CellPoints;
+  vtkSmartPointer<vtkIdList> NeighborPoints;
+};
+
+// Traverses the regions of a list of seeds in parallel.
+struct TraverseRegions
+{
+  vtkPolyData* OldMesh;
+  vtkPolyData* NewMesh;
+  int* Visited;
+  bool NonManifoldTraversal;
+  vtkIdType NumPolys;
+  const std::vector<TraversalSeed>& Seeds;
+  vtkSMPThreadLocal<PolygonTraversal> Traversals;
+  int NumFlips;
+  vtkIdType NumVisited;
+
+  TraverseRegions(vtkPolyData* oldMesh, vtkPolyData* newMesh, int* visited,
+    bool nonManifoldTraversal, vtkIdType numPolys, const std::vector<TraversalSeed>& seeds)
+    : OldMesh(oldMesh)
+    , NewMesh(newMesh)
+    , Visited(visited)
+    , NonManifoldTraversal(nonManifoldTraversal)
+    , NumPolys(numPolys)
+    , Seeds(seeds)
+    , NumFlips(0)
+    , NumVisited(0)
+  {
+  }
+
+  void Initialize()
+  {
+    this->Traversals.Local().Initialize(
+      this->OldMesh, this->NewMesh, this->Visited, this->NonManifoldTraversal, this->NumPolys);
+  }
+
+  void operator()(vtkIdType seedId, vtkIdType endSeedId)
+  {
+    PolygonTraversal& traversal = this->Traversals.Local();
+    for (; seedId < endSeedId; ++seedId)
+    {
+      traversal.Traverse(this->Seeds[seedId]);
+    }
+  }
+
+  void Reduce()
+  {
+    for (const PolygonTraversal& traversal : this->Traversals)
+    {
+      this->NumFlips += traversal.GetNumberOfFlips();
+      this->NumVisited += traversal.GetNumberOfVisitedCells();
+    }
+  }
+};
+
+// The seed of a connected region, for AutoOrientNormals, is the polygon
+// using the leftmost point whose normal is the most aligned with the x
+// axis. Its outward pointing normal should face left. Regions are seeded
+// one after the other, from the leftmost point to the rightmost one.
+// Regions::IsSeeded(cellId) tells whether the region of a polygon already
+// has a seed and Regions::AddSeed(seed) records a new one.
+template <typename Regions>
+void FindLeftmostSeeds(vtkPolyData* mesh, bool flipNormals, Regions& regions)
+{
+  vtkPoints* inPts = mesh->GetPoints();
+  const vtkIdType numPts = inPts->GetNumberOfPoints();
+  vtkNew<vtkPriorityQueue> leftmostPoints;
+
+  // Put all the points in the priority queue, based on x coord
+  // So that we can find leftmost point
+  leftmostPoints->Allocate(numPts);
+  double x[3];
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+  {
+    inPts->GetPoint(ptId, x);
+    leftmostPoints->Insert(x[0], ptId);
+  }
+
+  // Repeat this while loop as long as the queue is not empty,
+  // because there may be multiple connected components, each of
+  // which needs to be seeded independently with a correctly
+  // oriented polygon.
+  vtkIdType leftmostCellID = -1;
+  double n[3];
+  while (leftmostPoints->GetNumberOfItems())
+  {
+    bool foundLeftmostCell = false;
+    bool bestReverseFlag = false;
+    // Keep iterating through leftmost points and cells located at
+    // those points until I've got a leftmost point with
+    // unvisited cells attached and I've found the best cell
+    // at that point
+    do
+    {
+      const vtkIdType currentPointID = leftmostPoints->Pop();
+      vtkIdType nleftmostCells;
+      vtkIdType* leftmostCells;
+      mesh->GetPointCells(currentPointID, nleftmostCells, leftmostCells);
+      double bestNormalAbsXComponent = 0.0;
+      bestReverseFlag = false;
+      for (vtkIdType cIdx = 0; cIdx < nleftmostCells; cIdx++)
+      {
+        const vtkIdType currentCellID = leftmostCells[cIdx];
+        if (regions.IsSeeded(currentCellID))
+        {
+          continue;
+        }
+        vtkIdType nCellPts;
+        const vtkIdType* cellPts;
+        mesh->GetCellPoints(currentCellID, nCellPts, cellPts);
+        vtkPolygon::ComputeNormal(inPts, nCellPts, cellPts, n);
+        // Ok, see if this leftmost cell candidate is the best
+        // so far
+        if (fabs(n[0]) > bestNormalAbsXComponent)
+        {
+          bestNormalAbsXComponent = fabs(n[0]);
+          leftmostCellID = currentCellID;
+          // If the current leftmost cell's normal is pointing to the
+          // right, then the vertex ordering is wrong
+          bestReverseFlag = (n[0] > 0);
+          foundLeftmostCell = true;
+        } // if this normal is most x-aligned so far
+      }   // for each cell at current leftmost point
+    } while (leftmostPoints->GetNumberOfItems() && !foundLeftmostCell);
+    if (foundLeftmostCell)
+    {
+      // We've got the seed for a connected component! But do
+      // we need to flip it first? We do, if it was pointed the wrong
+      // way to begin with, or if the user requested flipping all
+      // normals, but if both are true, then we leave it as it is.
+      TraversalSeed seed = { leftmostCellID, bestReverseFlag != flipNormals };
+      regions.AddSeed(seed);
+    } // if found leftmost cell
+  }   // Still some points in the queue
+}
+
+// Seeds collected before traversing the regions in parallel.
+struct LabeledRegions
+{
+  std::atomic<vtkIdType>* Parents;
+  std::vector<bool> Seeded;
+  std::vector<TraversalSeed> Seeds;
+
+  bool IsSeeded(vtkIdType cellId) { return this->Seeded[FindRegion(this->Parents, cellId)]; }
+
+  void AddSeed(const TraversalSeed& seed)
+  {
+    this->Seeded[FindRegion(this->Parents, seed.CellId)] = true;
+    this->Seeds.push_back(seed);
+  }
+};
+
+// Regions seeded and traversed one at a time.
+struct VisitedRegions
+{
+  int* Visited;
+  PolygonTraversal& Traversal;
+
+  bool IsSeeded(vtkIdType cellId) { return this->Visited[cellId] == VTK_CELL_VISITED; }
+
+  void AddSeed(const TraversalSeed& seed) { this->Traversal.Traverse(seed); }
+};
+
+// Computes the normal of each polygon.
+struct ComputePolygonNormals
+{
+  vtkPoints* Points;
+  vtkCellArray* Polys;
+  float* Normals;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> CellPoints;
+
+  ComputePolygonNormals(vtkPoints* points, vtkCellArray* polys, float* normals)
+    : Points(points)
+    , Polys(polys)
+    , Normals(normals)
+  {
+  }
+
+  void Initialize() { this->CellPoints.Local().TakeReference(vtkIdList::New()); }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkIdList* cellPoints = this->CellPoints.Local();
+    double n[3];
+    for (; cellId < endCellId; ++cellId)
+    {
+      this->Polys->GetCellAtId(cellId, cellPoints);
+      vtkPolygon::ComputeNormal(this->Points, static_cast<int>(cellPoints->GetNumberOfIds()),
+        cellPoints->GetPointer(0), n);
+      float* normal = this->Normals + 3 * cellId;
+      normal[0] = static_cast<float>(n[0]);
+      normal[1] = static_cast<float>(n[1]);
+      normal[2] = static_cast<float>(n[2]);
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Computes the normal of each output point as the normalized sum of the
+// normals of the polygons using it. The point gathers the polygon normals
+// in increasing cell order (the order of the links of OldMesh), which
+// gives the same sums as scattering them polygon by polygon. Map gives the
+// input point of each output point when points have been split.
+struct AccumulatePointNormals
+{
+  vtkPolyData* OldMesh;
+  vtkCellArray* Polys;
+  vtkIdList* Map;
+  const float* PolyNormals;
+  float* Normals;
+  double FlipDirection;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> CellPoints;
+
+  AccumulatePointNormals(vtkPolyData* oldMesh, vtkCellArray* polys, vtkIdList* map,
+    const float* polyNormals, float* normals, double flipDirection)
+    : OldMesh(oldMesh)
+    , Polys(polys)
+    , Map(map)
+    , PolyNormals(polyNormals)
+    , Normals(normals)
+    , FlipDirection(flipDirection)
+  {
+  }
+
+  void Initialize() { this->CellPoints.Local().TakeReference(vtkIdList::New()); }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkIdList* cellPoints = this->CellPoints.Local();
+    for (; ptId < endPtId; ++ptId)
+    {
+      const vtkIdType oldId = this->Map ? this->Map->GetId(ptId) : ptId;
+      vtkIdType ncells;
+      vtkIdType* cells;
+      this->OldMesh->GetPointCells(oldId, ncells, cells);
+
+      float normal[3] = { 0.0f, 0.0f, 0.0f };
+      for (vtkIdType i = 0; i < ncells; ++i)
+      {
+        // A polygon using a point several times is linked several times.
+        if (i > 0 && cells[i] == cells[i - 1])
+        {
+          continue;
+        }
+        this->Polys->GetCellAtId(cells[i], cellPoints);
+        const vtkIdType npts = cellPoints->GetNumberOfIds();
+        const vtkIdType* pts = cellPoints->GetPointer(0);
+        const float* polyNormal = this->PolyNormals + 3 * cells[i];
+        for (vtkIdType j = 0; j < npts; ++j)
+        {
+          if (pts[j] == ptId)
+          {
+            normal[0] += polyNormal[0];
+            normal[1] += polyNormal[1];
+            normal[2] += polyNormal[2];
+          }
+        }
+      }
+
+      const double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] +
+                              normal[2] * normal[2]) *
+        this->FlipDirection;
+      if (length != 0.0)
+      {
+        normal[0] /= length;
+        normal[1] /= length;
+        normal[2] /= length;
+      }
+      float* outNormal = this->Normals + 3 * ptId;
+      outNormal[0] = normal[0];
+      outNormal[1] = normal[1];
+      outNormal[2] = normal[2];
+    }
+  }
+
+  void Reduce() {}
+};
+
+} // anonymous namespace
+
 // Construct with feature angle=30, splitting and consistency turned on,
 // flipNormals turned off, and non-manifold traversal turned on.
 vtkPolyDataNormals::vtkPolyDataNormals()
@@ -48,11 +576,7 @@ vtkPolyDataNormals::vtkPolyDataNormals()
   // some internal data
   this->NumFlips = 0;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
-  this->Wave = nullptr;
-  this->Wave2 = nullptr;
   this->CellIds = nullptr;
-  this->CellPoints = nullptr;
-  this->NeighborPoints = nullptr;
   this->Map = nullptr;
   this->OldMesh = nullptr;
   this->NewMesh = nullptr;
@@ -61,9 +585,6 @@ vtkPolyDataNormals::vtkPolyDataNormals()
   this->CosAngle = 0.0;
 }
 
-#define VTK_CELL_NOT_VISITED 0
-#define VTK_CELL_VISITED 1
-
 // Generate normals for polygon meshes
 int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -197,10 +718,6 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     memset(this->Visited, VTK_CELL_NOT_VISITED, numPolys * sizeof(int));
     this->CellIds = vtkIdList::New();
     this->CellIds->Allocate(VTK_CELL_SIZE);
-    this->CellPoints = vtkIdList::New();
-    this->CellPoints->Allocate(VTK_CELL_SIZE);
-    this->NeighborPoints = vtkIdList::New();
-    this->NeighborPoints->Allocate(VTK_CELL_SIZE);
   }
   else
   {
@@ -213,134 +730,12 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   //  with its (already checked) neighbors.
   //
   this->NumFlips = 0;
-  if (this->AutoOrientNormals)
+  if (this->AutoOrientNormals || this->Consistency)
   {
-    // No need to check this->Consistency. It's implied.
-
-    // Ok, here's the basic idea: the "left-most" polygon should
-    // have its outward pointing normal facing left. If it doesn't,
-    // reverse the vertex order. Then use it as the seed for other
-    // connected polys. To find left-most polygon, first find left-most
-    // point, and examine neighboring polys and see which one
-    // has a normal that's "most aligned" with the X-axis. This process
-    // will need to be repeated to handle all connected components in
-    // the mesh. Report bugs/issues to cvolpe@ara.com.
-    int foundLeftmostCell;
-    vtkIdType leftmostCellID = -1, currentPointID, currentCellID;
-    vtkIdType* leftmostCells;
-    vtkIdType nleftmostCells;
-    const vtkIdType* cellPts;
-    vtkIdType nCellPts;
-    int cIdx;
-    double bestNormalAbsXComponent;
-    int bestReverseFlag;
-    vtkPriorityQueue* leftmostPoints = vtkPriorityQueue::New();
-    this->Wave = vtkIdList::New();
-    this->Wave->Allocate(numPolys / 4 + 1, numPolys);
-    this->Wave2 = vtkIdList::New();
-    this->Wave2->Allocate(numPolys / 4 + 1, numPolys);
-
-    // Put all the points in the priority queue, based on x coord
-    // So that we can find leftmost point
-    leftmostPoints->Allocate(numPts);
-    for (ptId = 0; ptId < numPts; ptId++)
-    {
-      leftmostPoints->Insert(inPts->GetPoint(ptId)[0], ptId);
-    }
-
-    // Repeat this while loop as long as the queue is not empty,
-    // because there may be multiple connected components, each of
-    // which needs to be seeded independently with a correctly
-    // oriented polygon.
-    while (leftmostPoints->GetNumberOfItems())
-    {
-      foundLeftmostCell = 0;
-      // Keep iterating through leftmost points and cells located at
-      // those points until I've got a leftmost point with
-      // unvisited cells attached and I've found the best cell
-      // at that point
-      do
-      {
-        currentPointID = leftmostPoints->Pop();
-        this->OldMesh->GetPointCells(currentPointID, nleftmostCells, leftmostCells);
-        bestNormalAbsXComponent = 0.0;
-        bestReverseFlag = 0;
-        for (cIdx = 0; cIdx < nleftmostCells; cIdx++)
-        {
-          currentCellID = leftmostCells[cIdx];
-          if (this->Visited[currentCellID] == VTK_CELL_VISITED)
-          {
-            continue;
-          }
-          this->OldMesh->GetCellPoints(currentCellID, nCellPts, cellPts);
-          vtkPolygon::ComputeNormal(inPts, nCellPts, cellPts, n);
-          // Ok, see if this leftmost cell candidate is the best
-          // so far
-          if (fabs(n[0]) > bestNormalAbsXComponent)
-          {
-            bestNormalAbsXComponent = fabs(n[0]);
-            leftmostCellID = currentCellID;
-            // If the current leftmost cell's normal is pointing to the
-            // right, then the vertex ordering is wrong
-            bestReverseFlag = (n[0] > 0);
-            foundLeftmostCell = 1;
-          } // if this normal is most x-aligned so far
-        }   // for each cell at current leftmost point
-      } while (leftmostPoints->GetNumberOfItems() && !foundLeftmostCell);
-      if (foundLeftmostCell)
-      {
-        // We've got the seed for a connected component! But do
-        // we need to flip it first? We do, if it was pointed the wrong
-        // way to begin with, or if the user requested flipping all
-        // normals, but if both are true, then we leave it as it is.
-        if (bestReverseFlag ^ this->FlipNormals)
-        {
-          this->NewMesh->ReverseCell(leftmostCellID);
-          this->NumFlips++;
-        }
-        this->Wave->InsertNextId(leftmostCellID);
-        this->Visited[leftmostCellID] = VTK_CELL_VISITED;
-        this->TraverseAndOrder();
-        this->Wave->Reset();
-        this->Wave2->Reset();
-      } // if found leftmost cell
-    }   // Still some points in the queue
-    this->Wave->Delete();
-    this->Wave2->Delete();
-    leftmostPoints->Delete();
+    // No need to check this->Consistency with AutoOrientNormals. It's implied.
+    this->OrderPolygons(numPolys);
     vtkDebugMacro(<< "Reversed ordering of " << this->NumFlips << " polygons");
-  } // automatically orient normals
-  else
-  {
-    if (this->Consistency)
-    {
-      this->Wave = vtkIdList::New();
-      this->Wave->Allocate(numPolys / 4 + 1, numPolys);
-      this->Wave2 = vtkIdList::New();
-      this->Wave2->Allocate(numPolys / 4 + 1, numPolys);
-      for (cellId = 0; cellId < numPolys; cellId++)
-      {
-        if (this->Visited[cellId] == VTK_CELL_NOT_VISITED)
-        {
-          if (this->FlipNormals)
-          {
-            this->NumFlips++;
-            this->NewMesh->ReverseCell(cellId);
-          }
-          this->Wave->InsertNextId(cellId);
-          this->Visited[cellId] = VTK_CELL_VISITED;
-          this->TraverseAndOrder();
-        }
-
-        this->Wave->Reset();
-        this->Wave2->Reset();
-      }
-
-      this->Wave->Delete();
-      this->Wave2->Delete();
-      vtkDebugMacro(<< "Reversed ordering of " << this->NumFlips << " polygons");
-    } // Consistent ordering
-  }   // don't automatically orient normals
+  }
 
   this->UpdateProgress(0.333);
 
@@ -362,19 +757,10 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     this->PolyNormals->SetTuple(cellId, n);
   }
 
-  for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
-  {
-    if ((cellId % 1000) == 0)
-    {
-      this->UpdateProgress(0.333 + 0.333 * (double)cellId / (double)numPolys);
-      if (this->GetAbortExecute())
-      {
-        break;
-      }
-    }
-    vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-    this->PolyNormals->SetTuple(offsetCells + cellId, n);
-  }
+  float* fPolyNormals = this->PolyNormals->WritePointer(3 * offsetCells, 3 * numPolys);
+  ComputePolygonNormals polyNormals(inPts, newPolys, fPolyNormals);
+  vtkSMPTools::For(0, numPolys, polyNormals);
+  this->UpdateProgress(0.666);
 
   // Split mesh if sharp features
   if (this->Splitting)
@@ -439,7 +825,6 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
       newPts->SetPoint(ptId, inPts->GetPoint(oldId));
       outPD->CopyData(pd, oldId, ptId);
     }
-    this->Map->Delete();
   } // splitting
 
   else // no splitting, so no new points
@@ -454,10 +839,6 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     delete[] this->Visited;
     this->CellIds->Delete();
     this->CellIds = nullptr;
-    this->CellPoints->Delete();
-    this->CellPoints = nullptr;
-    this->NeighborPoints->Delete();
-    this->NeighborPoints = nullptr;
   }
 
   this->UpdateProgress(0.80);
@@ -475,35 +856,18 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   newNormals->SetNumberOfTuples(numNewPts);
   newNormals->SetName("Normals");
   float* fNormals = newNormals->WritePointer(0, 3 * numNewPts);
-  std::fill_n(fNormals, 3 * numNewPts, 0);
-
-  float* fPolyNormals = this->PolyNormals->WritePointer(3 * offsetCells, 3 * numPolys);
 
   if (this->ComputePointNormals)
   {
-    for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); ++cellId)
-    {
-      for (vtkIdType i = 0; i < npts; ++i)
-      {
-        fNormals[3 * pts[i]] += fPolyNormals[3 * cellId];
-        fNormals[3 * pts[i] + 1] += fPolyNormals[3 * cellId + 1];
-        fNormals[3 * pts[i] + 2] += fPolyNormals[3 * cellId + 2];
-      }
-    }
+    AccumulatePointNormals pointNormals(
+      this->OldMesh, newPolys, this->Map, fPolyNormals, fNormals, flipDirection);
+    vtkSMPTools::For(0, numNewPts, pointNormals);
+  }
 
-    for (vtkIdType i = 0; i < numNewPts; ++i)
-    {
-      const double length =
-        sqrt(fNormals[3 * i] * fNormals[3 * i] + fNormals[3 * i + 1] * fNormals[3 * i + 1] +
-          fNormals[3 * i + 2] * fNormals[3 * i + 2]) *
-        flipDirection;
-      if (length != 0.0)
-      {
-        fNormals[3 * i] /= length;
-        fNormals[3 * i + 1] /= length;
-        fNormals[3 * i + 2] /= length;
-      }
-    }
+  if (this->Map)
+  {
+    this->Map->Delete();
+    this->Map = nullptr;
   }
 
   //  Update ourselves.  If no new nodes have been created (i.e., no
@@ -547,81 +911,78 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
-//  Propagate wave of consistently ordered polygons.
-//
-void vtkPolyDataNormals::TraverseAndOrder()
+//------------------------------------------------------------------------------
+// Reorder the polygons of each connected region consistently with a seed
+// polygon. The regions are labeled first so that they can be seeded up front
+// and traversed concurrently. The seeds are the ones a sequential traversal
+// would pick, so the result does not depend on the number of threads.
+void vtkPolyDataNormals::OrderPolygons(vtkIdType numPolys)
 {
-  vtkIdType i, k;
-  int j, l, j1;
-  vtkIdType numIds, cellId;
-  const vtkIdType* pts;
-  const vtkIdType* neiPts;
-  vtkIdType npts;
-  vtkIdType numNeiPts;
-  vtkIdType neighbor;
-  vtkIdList* tmpWave;
+  const bool nonManifoldTraversal = this->NonManifoldTraversal != 0;
+  std::vector<std::atomic<vtkIdType>> parents(numPolys);
+  vtkSMPTools::For(0, numPolys, [&parents](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      parents[cellId].store(cellId);
+    }
+  });
+  LinkRegions linkRegions(this->OldMesh, nonManifoldTraversal, parents.data());
+  vtkSMPTools::For(0, numPolys, linkRegions);
 
-  // propagate wave until nothing left in wave
-  while ((numIds = this->Wave->GetNumberOfIds()) > 0)
+  LabeledRegions regions;
+  regions.Parents = parents.data();
+  if (this->AutoOrientNormals)
   {
-    for (i = 0; i < numIds; i++)
+    regions.Seeded.resize(numPolys, false);
+    FindLeftmostSeeds(this->OldMesh, this->FlipNormals != 0, regions);
+  }
+  else
+  {
+    // The smallest cell id of each region is its representative.
+    for (vtkIdType cellId = 0; cellId < numPolys; cellId++)
     {
-      cellId = this->Wave->GetId(i);
-
-      // Store the results here in a vtkIdList, since passing npts/pts directly
-      // would result in the data getting invalidated by the later call to
-      // NewMesh->GetCellPoints.
-      this->NewMesh->GetCellPoints(cellId, this->CellPoints);
-      npts = this->CellPoints->GetNumberOfIds();
-      pts = this->CellPoints->GetPointer(0);
-
-      for (j = 0, j1 = 1; j < npts; ++j, (j1 = (++j1 < npts) ? j1 : 0)) // for each edge neighbor
+      if (parents[cellId].load() == cellId)
       {
-        this->OldMesh->GetCellEdgeNeighbors(cellId, pts[j], pts[j1], this->CellIds);
+        TraversalSeed seed = { cellId, this->FlipNormals != 0 };
+        regions.Seeds.push_back(seed);
+      }
+    }
+  }
 
-        //  Check the direction of the neighbor ordering.  Should be
-        //  consistent with us (i.e., if we are n1->n2,
-        // neighbor should be n2->n1).
-        if (this->CellIds->GetNumberOfIds() == 1 || this->NonManifoldTraversal)
-        {
-          for (k = 0; k < this->CellIds->GetNumberOfIds(); k++)
-          {
-            if (this->Visited[this->CellIds->GetId(k)] == VTK_CELL_NOT_VISITED)
-            {
-              neighbor = this->CellIds->GetId(k);
-              this->NewMesh->GetCellPoints(neighbor, this->NeighborPoints);
-              numNeiPts = this->NeighborPoints->GetNumberOfIds();
-              neiPts = this->NeighborPoints->GetPointer(0);
+  TraverseRegions traverseRegions(this->OldMesh, this->NewMesh, this->Visited,
+    nonManifoldTraversal, numPolys, regions.Seeds);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(regions.Seeds.size()), traverseRegions);
+  this->NumFlips = traverseRegions.NumFlips;
 
-              for (l = 0; l < numNeiPts; l++)
-              {
-                if (neiPts[l] == pts[j1])
-                {
-                  break;
-                }
-              }
+  if (traverseRegions.NumVisited == numPolys)
+  {
+    return;
+  }
 
-              //  Have to reverse ordering if neighbor not consistent
-              //
-              if (neiPts[(l + 1) % numNeiPts] != pts[j])
-              {
-                this->NumFlips++;
-                this->NewMesh->ReverseCell(neighbor);
-              }
-              this->Visited[neighbor] = VTK_CELL_VISITED;
-              this->Wave2->InsertNextId(neighbor);
-            } // if cell not visited
-          }   // for each edge neighbor
-        }     // for manifold or non-manifold traversal allowed
-      }       // for all edges of this polygon
-    }         // for all cells in wave
-
-    // swap wave and proceed with propagation
-    tmpWave = this->Wave;
-    this->Wave = this->Wave2;
-    this->Wave2 = tmpWave;
-    this->Wave2->Reset();
-  } // while wave still propagating
+  // A polygon with a repeated point has a degenerate edge whose neighbors
+  // may not see the polygon as a neighbor in return. Such a polygon joins
+  // their region but the traversal from the region seed may not reach it.
+  // Seed and traverse what is left one region at a time.
+  PolygonTraversal traversal;
+  traversal.Initialize(
+    this->OldMesh, this->NewMesh, this->Visited, nonManifoldTraversal, numPolys);
+  if (this->AutoOrientNormals)
+  {
+    VisitedRegions visitedRegions = { this->Visited, traversal };
+    FindLeftmostSeeds(this->OldMesh, this->FlipNormals != 0, visitedRegions);
+  }
+  else
+  {
+    for (vtkIdType cellId = 0; cellId < numPolys; cellId++)
+    {
+      if (this->Visited[cellId] == VTK_CELL_NOT_VISITED)
+      {
+        TraversalSeed seed = { cellId, this->FlipNormals != 0 };
+        traversal.Traverse(seed);
+      }
+    }
+  }
+  this->NumFlips += traversal.GetNumberOfFlips();
 }
 
 //
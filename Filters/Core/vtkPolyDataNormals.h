@@ -39,6 +39,12 @@
  * are split and new points generated to prevent blurry edges (due to
  * Gouraud shading).
  *
+ * The polygon normals and the point normals are computed with vtkSMPTools.
+ * When consistency (or auto orientation) is on, the connected regions of
+ * the mesh are identified first and then reordered in parallel, one region
+ * per task. Splitting remains sequential. The output does not depend on
+ * the number of threads.
+ *
  * @warning
  * Normals are computed only for polygons and triangle strips. Normals are
  * not computed for lines or vertices.
@@ -192,11 +198,7 @@ protected:
   int OutputPointsPrecision;
 
 private:
-  vtkIdList* Wave;
-  vtkIdList* Wave2;
   vtkIdList* CellIds;
-  vtkIdList* CellPoints;
-  vtkIdList* NeighborPoints;
   vtkIdList* Map;
   vtkPolyData* OldMesh;
   vtkPolyData* NewMesh;
@@ -204,9 +206,9 @@ private:
   vtkFloatArray* PolyNormals;
   double CosAngle;
 
-  // Uses the list of cell ids (this->Wave) to propagate a wave of
-  // checked and properly ordered polygons.
-  void TraverseAndOrder(void);
+  // Reorders the polygons of this->NewMesh so that each connected region
+  // is consistently ordered. The regions are traversed in parallel.
+  void OrderPolygons(vtkIdType numPolys);
 
   // Check the point id give to see whether it lies on a feature
   // edge. If so, split the point (i.e., duplicate it) to topologically
@@ -18,6 +18,7 @@
 #include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCleanPolyDataInternal.h"
 #include "vtkDataArrayRange.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -37,18 +38,22 @@ namespace
 { // anonymous
 
 //------------------------------------------------------------------------------
-// Fast, threaded way to copy new points and attribute data to output.
+// Fast, threaded way to copy new points and attribute data to output. Only
+// the point each group of merged points was merged with is copied, so every
+// output point is written once.
 template <typename InArrayT, typename OutArrayT>
 struct CopyPointsAlgorithm
 {
   vtkIdType* PtMap;
+  const vtkIdType* MergeMap;
   InArrayT* InPts;
   OutArrayT* OutPts;
   ArrayList Arrays;
 
-  CopyPointsAlgorithm(vtkIdType* ptMap, InArrayT* inPts, vtkPointData* inPD, vtkIdType numNewPts,
-    OutArrayT* outPts, vtkPointData* outPD)
+  CopyPointsAlgorithm(vtkIdType* ptMap, const vtkIdType* mergeMap, InArrayT* inPts,
+    vtkPointData* inPD, vtkIdType numNewPts, OutArrayT* outPts, vtkPointData* outPD)
     : PtMap(ptMap)
+    , MergeMap(mergeMap)
     , InPts(inPts)
     , OutPts(outPts)
   {
@@ -66,9 +71,9 @@ struct CopyPointsAlgorithm
 
     for (; ptId < endPtId; ++ptId)
     {
-      const vtkIdType outPtId = ptMap[ptId];
-      if (outPtId != -1)
+      if (this->MergeMap[ptId] == ptId)
       {
+        const vtkIdType outPtId = ptMap[ptId];
         const auto inP = inPoints[ptId];
         auto outP = outPoints[outPtId];
         outP[0] = static_cast<OutValueT>(inP[0]);
@@ -83,17 +88,74 @@ struct CopyPointsAlgorithm
 struct CopyPointsLauncher
 {
   template <typename InArrayT, typename OutArrayT>
-  void operator()(InArrayT* inPts, OutArrayT* outPts, vtkIdType* ptMap, vtkPointData* inPD,
-    vtkIdType numNewPts, vtkPointData* outPD)
+  void operator()(InArrayT* inPts, OutArrayT* outPts, vtkIdType* ptMap, const vtkIdType* mergeMap,
+    vtkPointData* inPD, vtkIdType numNewPts, vtkPointData* outPD)
   {
     const vtkIdType numPts = inPts->GetNumberOfTuples();
 
-    CopyPointsAlgorithm<InArrayT, OutArrayT> algo{ ptMap, inPts, inPD, numNewPts, outPts, outPD };
+    CopyPointsAlgorithm<InArrayT, OutArrayT> algo{ ptMap, mergeMap, inPts, inPD, numNewPts, outPts,
+      outPD };
 
     vtkSMPTools::For(0, numPts, algo);
   }
 };
 
+//------------------------------------------------------------------------------
+// Degenerate cells are demoted according to the Convert* flags. Only the
+// closing point of a polygon repeating its first point is removed.
+struct StaticCleanCellRule
+{
+  bool ConvertLinesToPoints;
+  bool ConvertPolysToLines;
+  bool ConvertStripsToPolys;
+
+  int operator()(int inType, vtkIdType& npts, vtkIdType* pts) const
+  {
+    switch (inType)
+    {
+      case CLEAN_VERTS:
+        return npts > 0 ? CLEAN_VERTS : CLEAN_DISCARD;
+
+      case CLEAN_LINES:
+        if (npts > 1 || !this->ConvertLinesToPoints)
+        {
+          return CLEAN_LINES;
+        }
+        return npts == 1 ? CLEAN_VERTS : CLEAN_DISCARD;
+
+      case CLEAN_POLYS:
+        if (npts > 2 && pts[0] == pts[npts - 1])
+        {
+          npts--;
+        }
+        if (npts > 2 || !this->ConvertPolysToLines)
+        {
+          return CLEAN_POLYS;
+        }
+        if (npts == 2 || !this->ConvertLinesToPoints)
+        {
+          return CLEAN_LINES;
+        }
+        return npts == 1 ? CLEAN_VERTS : CLEAN_DISCARD;
+
+      default:
+        if (npts > 3 || !this->ConvertStripsToPolys)
+        {
+          return CLEAN_STRIPS;
+        }
+        if (npts == 3 || !this->ConvertPolysToLines)
+        {
+          return CLEAN_POLYS;
+        }
+        if (npts == 2 || !this->ConvertLinesToPoints)
+        {
+          return CLEAN_LINES;
+        }
+        return npts == 1 ? CLEAN_VERTS : CLEAN_DISCARD;
+    }
+  }
+};
+
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -174,22 +236,7 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
-  vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
-
-  // we'll be needing these
-  vtkIdType inCellID, newId;
-  vtkIdType i;
-  vtkIdType ptId;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
-
-  vtkCellArray *inVerts = input->GetVerts(), *newVerts = nullptr;
-  vtkCellArray *inLines = input->GetLines(), *newLines = nullptr;
-  vtkCellArray *inPolys = input->GetPolys(), *newPolys = nullptr;
-  vtkCellArray *inStrips = input->GetStrips(), *newStrips = nullptr;
-
   vtkPointData* inPD = input->GetPointData();
-  vtkCellData* inCD = input->GetCellData();
 
   // The merge map indicates which points are merged with what points
   vtkIdType* mergeMap = new vtkIdType[numPts];
@@ -198,33 +245,34 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   double tol =
     (this->ToleranceIsAbsolute ? this->AbsoluteTolerance : this->Tolerance * input->GetLength());
   this->Locator->MergePoints(tol, mergeMap);
+  this->UpdateProgress(0.25);
 
   vtkPointData* outPD = output->GetPointData();
   vtkCellData* outCD = output->GetCellData();
   outPD->CopyAllocate(inPD);
-  outCD->CopyAllocate(inCD);
-
-  // Prefix sum: count the number of new points; allocate memory. Populate the
-  // point map (old points to new).
-  vtkIdType* pointMap = new vtkIdType[numPts];
-  vtkIdType id, numNewPts = 0;
-  // Count and map points to new points
-  for (id = 0; id < numPts; ++id)
-  {
-    if (mergeMap[id] == id)
+  outCD->CopyAllocate(input->GetCellData());
+
+  // Prefix sum: number the points that are kept, then map the merged points
+  // to the point they were merged with.
+  vtkIdType* pointMap = new vtkIdType[numPts + 1];
+  pointMap[numPts] = 0;
+  vtkSMPTools::For(0, numPts, [mergeMap, pointMap](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
     {
-      pointMap[id] = numNewPts++;
+      pointMap[id] = (mergeMap[id] == id ? 1 : 0);
     }
-  }
-  // Now map old merged points to new points
-  for (id = 0; id < numPts; ++id)
-  {
-    if (mergeMap[id] != id)
+  });
+  vtkSMPTools::ExclusiveScan(pointMap, pointMap + numPts + 1, pointMap, static_cast<vtkIdType>(0));
+  vtkIdType numNewPts = pointMap[numPts];
+  vtkSMPTools::For(0, numPts, [mergeMap, pointMap](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
     {
-      pointMap[id] = pointMap[mergeMap[id]];
+      if (mergeMap[id] != id)
+      {
+        pointMap[id] = pointMap[GetMergedPoint(mergeMap, id)];
+      }
     }
-  }
-  delete[] mergeMap;
+  });
 
   vtkPoints* newPts = inPts->NewInstance();
   if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
@@ -249,312 +297,33 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   using Dispatcher = vtkArrayDispatch::Dispatch2ByValueType<FastValueTypes, FastValueTypes>;
 
   CopyPointsLauncher launcher;
-  if (!Dispatcher::Execute(inArray, outArray, launcher, pointMap, inPD, numNewPts, outPD))
+  if (!Dispatcher::Execute(
+        inArray, outArray, launcher, pointMap, mergeMap, inPD, numNewPts, outPD))
   { // Fallback to slow path for unusual types:
-    launcher(inArray, outArray, pointMap, inPD, numNewPts, outPD);
-  }
-
-  // Finally, remap the topology to use new point ids. Celldata needs to be
-  // copied correctly. If a poly is converted to a line, or a line to a
-  // point, then using a CellCounter will not do, as the cells should be
-  // ordered verts, lines, polys, strips. We need to maintain separate cell
-  // data lists so we can copy them all correctly. Tedious but easy to
-  // implement. We can use outCD for vertex cell data, then add the rest
-  // at the end.
-  vtkCellData* outLineData = nullptr;
-  vtkCellData* outPolyData = nullptr;
-  vtkCellData* outStrpData = nullptr;
-  vtkIdType vertIDcounter = 0, lineIDcounter = 0;
-  vtkIdType polyIDcounter = 0, strpIDcounter = 0;
-
-  // Begin to adjust topology.
-  //
-  // Vertices are renumbered and we remove duplicates
-  vtkIdType numCellPts;
-  inCellID = 0;
-  if (!this->GetAbortExecute() && inVerts->GetNumberOfCells() > 0)
-  {
-    newVerts = vtkCellArray::New();
-    newVerts->AllocateEstimate(inVerts->GetNumberOfCells(), 1);
-
-    vtkDebugMacro(<< "Starting Verts " << inCellID);
-    for (inVerts->InitTraversal(); inVerts->GetNextCell(npts, pts); inCellID++)
-    {
-      for (numCellPts = 0, i = 0; i < npts; i++)
-      {
-        ptId = pointMap[pts[i]];
-        updatedPts[numCellPts++] = ptId;
-      } // for all points of vertex cell
-
-      if (numCellPts > 0)
-      {
-        newId = newVerts->InsertNextCell(numCellPts, updatedPts);
-        outCD->CopyData(inCD, inCellID, newId);
-        if (vertIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Vertex ID fault in vertex test");
-        }
-        vertIDcounter++;
-      }
-    }
-  }
-  this->UpdateProgress(0.25);
-
-  // lines reduced to one point are eliminated or made into verts
-  if (!this->GetAbortExecute() && inLines->GetNumberOfCells() > 0)
-  {
-    newLines = vtkCellArray::New();
-    newLines->AllocateEstimate(inLines->GetNumberOfCells(), 2);
-    outLineData = vtkCellData::New();
-    outLineData->CopyAllocate(inCD);
-    //
-    vtkDebugMacro(<< "Starting Lines " << inCellID);
-    for (inLines->InitTraversal(); inLines->GetNextCell(npts, pts); inCellID++)
-    {
-      for (numCellPts = 0, i = 0; i < npts; i++)
-      {
-        ptId = pointMap[pts[i]];
-        updatedPts[numCellPts++] = ptId;
-      } // for all cell points
-
-      if ((numCellPts > 1) || !this->ConvertLinesToPoints)
-      {
-        newId = newLines->InsertNextCell(numCellPts, updatedPts);
-        outLineData->CopyData(inCD, inCellID, newId);
-        if (lineIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Line ID fault in line test");
-        }
-        lineIDcounter++;
-      }
-      else if (numCellPts == 1)
-      {
-        if (!newVerts)
-        {
-          newVerts = vtkCellArray::New();
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(numCellPts, updatedPts);
-        outCD->CopyData(inCD, inCellID, newId);
-        if (vertIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Vertex ID fault in line test");
-        }
-        vertIDcounter++;
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inLines->GetNumberOfCells() - newLines->GetNumberOfCells()
-                  << " lines");
+    launcher(inArray, outArray, pointMap, mergeMap, inPD, numNewPts, outPD);
   }
-  this->UpdateProgress(0.50);
-
-  // polygons reduced to two points or less are either eliminated
-  // or converted to lines or points if enabled
-  if (!this->GetAbortExecute() && inPolys->GetNumberOfCells() > 0)
-  {
-    newPolys = vtkCellArray::New();
-    newPolys->AllocateCopy(inPolys);
-    outPolyData = vtkCellData::New();
-    outPolyData->CopyAllocate(inCD);
-
-    vtkDebugMacro(<< "Starting Polys " << inCellID);
-    for (inPolys->InitTraversal(); inPolys->GetNextCell(npts, pts); inCellID++)
-    {
-      for (numCellPts = 0, i = 0; i < npts; i++)
-      {
-        ptId = pointMap[pts[i]];
-        updatedPts[numCellPts++] = ptId;
-      } // for points in cell
-
-      if (numCellPts > 2 && updatedPts[0] == updatedPts[numCellPts - 1])
-      {
-        numCellPts--;
-      }
-      if ((numCellPts > 2) || !this->ConvertPolysToLines)
-      {
-        newId = newPolys->InsertNextCell(numCellPts, updatedPts);
-        outPolyData->CopyData(inCD, inCellID, newId);
-        if (polyIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Poly ID fault in poly test");
-        }
-        polyIDcounter++;
-      }
-      else if ((numCellPts == 2) || !this->ConvertLinesToPoints)
-      {
-        if (!newLines)
-        {
-          newLines = vtkCellArray::New();
-          newLines->AllocateEstimate(5, 2);
-          outLineData = vtkCellData::New();
-          outLineData->CopyAllocate(inCD);
-        }
-        newId = newLines->InsertNextCell(numCellPts, updatedPts);
-        outLineData->CopyData(inCD, inCellID, newId);
-        if (lineIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Line ID fault in poly test");
-        }
-        lineIDcounter++;
-      }
-      else if (numCellPts == 1)
-      {
-        if (!newVerts)
-        {
-          newVerts = vtkCellArray::New();
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(numCellPts, updatedPts);
-        outCD->CopyData(inCD, inCellID, newId);
-        if (vertIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Vertex ID fault in poly test");
-        }
-        vertIDcounter++;
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inPolys->GetNumberOfCells() - newPolys->GetNumberOfCells()
-                  << " polys");
-  }
-  this->UpdateProgress(0.75);
+  delete[] mergeMap;
+  this->UpdateProgress(0.5);
 
-  // triangle strips can reduced to polys/lines/points etc
-  if (!this->GetAbortExecute() && inStrips->GetNumberOfCells() > 0)
+  // Finally, remap the topology to use new point ids. Degenerate cells are
+  // converted or removed, and the output cells (and their cell data) are
+  // ordered verts, lines, polys, strips.
+  if (!this->GetAbortExecute())
   {
-    newStrips = vtkCellArray::New();
-    newStrips->AllocateCopy(inStrips);
-    outStrpData = vtkCellData::New();
-    outStrpData->CopyAllocate(inCD);
-
-    for (inStrips->InitTraversal(); inStrips->GetNextCell(npts, pts); inCellID++)
-    {
-      for (numCellPts = 0, i = 0; i < npts; i++)
-      {
-        ptId = pointMap[pts[i]];
-        updatedPts[numCellPts++] = ptId;
-      }
-      if ((numCellPts > 3) || !this->ConvertStripsToPolys)
-      {
-        newId = newStrips->InsertNextCell(numCellPts, updatedPts);
-        outStrpData->CopyData(inCD, inCellID, newId);
-        if (strpIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Strip ID fault in strip test");
-        }
-        strpIDcounter++;
-      }
-      else if ((numCellPts == 3) || !this->ConvertPolysToLines)
-      {
-        if (!newPolys)
-        {
-          newPolys = vtkCellArray::New();
-          newPolys->AllocateEstimate(5, 3);
-          outPolyData = vtkCellData::New();
-          outPolyData->CopyAllocate(inCD);
-        }
-        newId = newPolys->InsertNextCell(numCellPts, updatedPts);
-        outPolyData->CopyData(inCD, inCellID, newId);
-        if (polyIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Poly ID fault in strip test");
-        }
-        polyIDcounter++;
-      }
-      else if ((numCellPts == 2) || !this->ConvertLinesToPoints)
-      {
-        if (!newLines)
-        {
-          newLines = vtkCellArray::New();
-          newLines->AllocateEstimate(5, 2);
-          outLineData = vtkCellData::New();
-          outLineData->CopyAllocate(inCD);
-        }
-        newId = newLines->InsertNextCell(numCellPts, updatedPts);
-        outLineData->CopyData(inCD, inCellID, newId);
-        if (lineIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Line ID fault in strip test");
-        }
-        lineIDcounter++;
-      }
-      else if (numCellPts == 1)
-      {
-        if (!newVerts)
-        {
-          newVerts = vtkCellArray::New();
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(numCellPts, updatedPts);
-        outCD->CopyData(inCD, inCellID, newId);
-        if (vertIDcounter != newId)
-        {
-          vtkErrorMacro(<< "Vertex ID fault in strip test");
-        }
-        vertIDcounter++;
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inStrips->GetNumberOfCells() - newStrips->GetNumberOfCells()
-                  << " strips");
+    StaticCleanCellRule rule{ this->ConvertLinesToPoints != 0, this->ConvertPolysToLines != 0,
+      this->ConvertStripsToPolys != 0 };
+    CompactCells(input, pointMap, rule, output);
   }
 
-  vtkDebugMacro(<< "Removed " << numNewPts - newPts->GetNumberOfPoints() << " points");
+  vtkDebugMacro(<< "Removed " << numPts - numNewPts << " points");
 
   // Update ourselves and release memory
   //
   this->Locator->Initialize(); // release memory.
-  delete[] updatedPts;
   delete[] pointMap;
 
-  // Now transfer all CellData from Lines/Polys/Strips into final
-  // Cell data output
-  vtkIdType combinedCellID = vertIDcounter;
-  if (newLines)
-  {
-    for (i = 0; i < lineIDcounter; ++i, ++combinedCellID)
-    {
-      outCD->CopyData(outLineData, i, combinedCellID);
-    }
-    outLineData->Delete();
-  }
-  if (newPolys)
-  {
-    for (i = 0; i < polyIDcounter; ++i, ++combinedCellID)
-    {
-      outCD->CopyData(outPolyData, i, combinedCellID);
-    }
-    outPolyData->Delete();
-  }
-  if (newStrips)
-  {
-    for (i = 0; i < strpIDcounter; ++i, ++combinedCellID)
-    {
-      outCD->CopyData(outStrpData, i, combinedCellID);
-    }
-    outStrpData->Delete();
-  }
-
   output->SetPoints(newPts);
   newPts->Delete();
-  if (newVerts)
-  {
-    output->SetVerts(newVerts);
-    newVerts->Delete();
-  }
-  if (newLines)
-  {
-    output->SetLines(newLines);
-    newLines->Delete();
-  }
-  if (newPolys)
-  {
-    output->SetPolys(newPolys);
-    newPolys->Delete();
-  }
-  if (newStrips)
-  {
-    output->SetStrips(newStrips);
-    newStrips->Delete();
-  }
 
   return 1;
 }
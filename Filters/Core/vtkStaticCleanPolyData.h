@@ -37,7 +37,9 @@
  * Internally this class uses vtkStaticPointLocator, which is a threaded, and
  * much faster locator than the incremental locators that vtkCleanPolyData
  * uses. Note because of these and other differences, the output of this
- * filter may be different than vtkCleanPolyData.
+ * filter may be different than vtkCleanPolyData. The points are merged and
+ * the cells are remapped and compacted in parallel; with a zero tolerance
+ * the output does not depend on the number of threads.
  *
  * Note that if you want to remove points that aren't used by any cells
  * (i.e., disable point merging), then use vtkCleanPolyData.
@@ -14,21 +14,87 @@
 =========================================================================*/
 #include "vtkThreshold.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
+#include <atomic>
+#include <vector>
 
 vtkStandardNewMacro(vtkThreshold);
 
+namespace
+{
+// ArrayList, used to copy the point and cell data from several threads,
+// only handles vtkDataArrays.
+bool HasOnlyDataArrays(vtkDataSetAttributes* attributes)
+{
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    if (!attributes->GetArray(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Gets the type and the point ids of the cells of a dataset. Each thread
+// uses its own reader. Unstructured grids are read directly, other datasets
+// through a vtkGenericCell.
+struct CellReader
+{
+  vtkDataSet* Input;
+  vtkUnstructuredGrid* Grid;
+  vtkSmartPointer<vtkGenericCell> Cell;
+  vtkSmartPointer<vtkIdList> PointIds;
+
+  CellReader(vtkDataSet* input = nullptr)
+    : Input(input)
+    , Grid(vtkUnstructuredGrid::SafeDownCast(input))
+  {
+  }
+
+  vtkIdList* Read(vtkIdType cellId, int& cellType)
+  {
+    if (this->Grid)
+    {
+      if (!this->PointIds)
+      {
+        this->PointIds = vtkSmartPointer<vtkIdList>::New();
+      }
+      cellType = this->Grid->GetCellType(cellId);
+      this->Grid->GetCellPoints(cellId, this->PointIds);
+      return this->PointIds;
+    }
+    if (!this->Cell)
+    {
+      this->Cell = vtkSmartPointer<vtkGenericCell>::New();
+    }
+    this->Input->GetCell(cellId, this->Cell);
+    cellType = this->Cell->GetCellType();
+    return this->Cell->GetPointIds();
+  }
+};
+}
+
 // Construct with lower threshold=0, upper threshold=1, and threshold
 // function=upper AllScalars=1.
 vtkThreshold::vtkThreshold()
@@ -152,7 +218,6 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
   outCD->CopyAllocate(cd);
 
   numPts = input->GetNumberOfPoints();
-  output->Allocate(input->GetNumberOfCells());
 
   newPoints = vtkPoints::New();
 
@@ -178,7 +243,22 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
     newPoints->SetDataType(VTK_DOUBLE);
   }
 
+  // are we using pointScalars?
+  int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
+  bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
+
+  vtkUnstructuredGrid* inputGrid = vtkUnstructuredGrid::SafeDownCast(input);
+  if ((!inputGrid || !inputGrid->GetFaces()) && HasOnlyDataArrays(pd) && HasOnlyDataArrays(cd))
+  {
+    this->ThresholdInParallel(input, inScalars, usePointScalars, newPoints, output);
+    vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells() << " number of cells.");
+    output->SetPoints(newPoints);
+    newPoints->Delete();
+    return 1;
+  }
+
   newPoints->Allocate(numPts);
+  output->Allocate(input->GetNumberOfCells());
 
   pointMap = vtkIdList::New(); // maps old point ids into new
   pointMap->SetNumberOfIds(numPts);
@@ -189,52 +269,13 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
 
   newCellPts = vtkIdList::New();
 
-  // are we using pointScalars?
-  int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
-  bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
-
   // Check that the scalars of each cell satisfy the threshold criterion
   for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
   {
     cell = input->GetCell(cellId);
     cellPts = cell->GetPointIds();
     numCellPts = cell->GetNumberOfPoints();
-
-    if (usePointScalars)
-    {
-      if (this->AllScalars)
-      {
-        keepCell = 1;
-        for (i = 0; keepCell && (i < numCellPts); i++)
-        {
-          ptId = cellPts->GetId(i);
-          keepCell = this->EvaluateComponents(inScalars, ptId);
-        }
-      }
-      else
-      {
-        if (!this->UseContinuousCellRange)
-        {
-          keepCell = 0;
-          for (i = 0; (!keepCell) && (i < numCellPts); i++)
-          {
-            ptId = cellPts->GetId(i);
-            keepCell = this->EvaluateComponents(inScalars, ptId);
-          }
-        }
-        else
-        {
-          keepCell = this->EvaluateCell(inScalars, cellPts, numCellPts);
-        }
-      }
-    }
-    else // use cell scalars
-    {
-      keepCell = this->EvaluateComponents(inScalars, cellId);
-    }
-
-    // Invert the keep flag if the Invert option is enabled.
-    keepCell = this->Invert ? (1 - keepCell) : keepCell;
+    keepCell = this->KeepCell(inScalars, usePointScalars, cellId, cellPts, numCellPts);
 
     if (numCellPts > 0 && keepCell)
     {
@@ -252,10 +293,10 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
         newCellPts->InsertId(i, newId);
       }
       // special handling for polyhedron cells
-      if (vtkUnstructuredGrid::SafeDownCast(input) && input->GetCellType(cellId) == VTK_POLYHEDRON)
+      if (inputGrid && input->GetCellType(cellId) == VTK_POLYHEDRON)
       {
         newCellPts->Reset();
-        vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(cellId, newCellPts);
+        inputGrid->GetFaceStream(cellId, newCellPts);
         vtkUnstructuredGrid::ConvertFaceStreamPointIds(newCellPts, pointMap->GetPointer(0));
       }
       newCellId = output->InsertNextCell(cell->GetCellType(), newCellPts);
@@ -278,6 +319,224 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+void vtkThreshold::ThresholdInParallel(vtkDataSet* input, vtkDataArray* inScalars,
+  bool usePointScalars, vtkPoints* newPoints, vtkUnstructuredGrid* output)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+
+  // Call GetCell() once on this thread, so that it is then thread safe.
+  if (numCells > 0)
+  {
+    vtkNew<vtkGenericCell> cell;
+    input->GetCell(0, cell);
+  }
+  vtkSMPThreadLocal<CellReader> readers(CellReader{ input });
+
+  // First pass: evaluate the criterion of each cell, and find the first
+  // kept cell using each point. The points are numbered in the order of
+  // their first use, as when the cells are traversed sequentially.
+  std::vector<vtkIdType> cellSizes(numCells);
+  std::vector<std::atomic<vtkIdType>> firstCells(numPts);
+  std::atomic<vtkIdType>* firstCellsPtr = firstCells.data();
+  vtkSMPTools::For(0, numPts, [firstCellsPtr, numCells](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstCellsPtr[ptId].store(numCells, std::memory_order_relaxed);
+    }
+  });
+  vtkIdType* cellSizesPtr = cellSizes.data();
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    CellReader& reader = readers.Local();
+    int cellType;
+    for (; cellId < endCellId; ++cellId)
+    {
+      vtkIdList* cellPts = reader.Read(cellId, cellType);
+      const vtkIdType numCellPts = cellPts->GetNumberOfIds();
+      const bool keepCell = numCellPts > 0 &&
+        this->KeepCell(inScalars, usePointScalars, cellId, cellPts, numCellPts) != 0;
+      cellSizesPtr[cellId] = keepCell ? numCellPts : 0;
+      if (!keepCell)
+      {
+        continue;
+      }
+      for (vtkIdType i = 0; i < numCellPts; ++i)
+      {
+        std::atomic<vtkIdType>& firstCell = firstCellsPtr[cellPts->GetId(i)];
+        vtkIdType current = firstCell.load(std::memory_order_relaxed);
+        while (cellId < current && !firstCell.compare_exchange_weak(current, cellId))
+        {
+        }
+      }
+    }
+  });
+  this->UpdateProgress(0.25);
+
+  // Count the points each cell uses first, and number them.
+  std::vector<vtkIdType> newPointOffsets(numCells);
+  vtkIdType* newPointOffsetsPtr = newPointOffsets.data();
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    CellReader& reader = readers.Local();
+    int cellType;
+    for (; cellId < endCellId; ++cellId)
+    {
+      vtkIdType numNewPts = 0;
+      if (cellSizesPtr[cellId] > 0)
+      {
+        vtkIdList* cellPts = reader.Read(cellId, cellType);
+        const vtkIdType* pts = cellPts->GetPointer(0);
+        for (vtkIdType i = 0; i < cellSizesPtr[cellId]; ++i)
+        {
+          if (firstCellsPtr[pts[i]].load(std::memory_order_relaxed) == cellId &&
+            std::find(pts, pts + i, pts[i]) == pts + i)
+          {
+            ++numNewPts;
+          }
+        }
+      }
+      newPointOffsetsPtr[cellId] = numNewPts;
+    }
+  });
+  const vtkIdType lastNewPts = numCells > 0 ? newPointOffsets.back() : 0;
+  vtkSMPTools::ExclusiveScan(
+    newPointOffsets.begin(), newPointOffsets.end(), newPointOffsets.begin(), vtkIdType(0));
+  const vtkIdType numNewPts = numCells > 0 ? newPointOffsets.back() + lastNewPts : 0;
+
+  // Offsets of the kept cells in the output, and of their connectivity.
+  std::vector<vtkIdType> outCellIds(numCells);
+  vtkSMPTools::Transform(cellSizes.begin(), cellSizes.end(), outCellIds.begin(),
+    [](vtkIdType size) -> vtkIdType { return size > 0 ? 1 : 0; });
+  const vtkIdType lastKept = numCells > 0 ? outCellIds.back() : 0;
+  vtkSMPTools::ExclusiveScan(outCellIds.begin(), outCellIds.end(), outCellIds.begin(), vtkIdType(0));
+  const vtkIdType numOutCells = numCells > 0 ? outCellIds.back() + lastKept : 0;
+
+  std::vector<vtkIdType> connOffsets(numCells);
+  const vtkIdType lastSize = numCells > 0 ? cellSizes.back() : 0;
+  vtkSMPTools::ExclusiveScan(cellSizes.begin(), cellSizes.end(), connOffsets.begin(), vtkIdType(0));
+  const vtkIdType connSize = numCells > 0 ? connOffsets.back() + lastSize : 0;
+  this->UpdateProgress(0.5);
+
+  // Second pass: copy the new points and their data.
+  vtkPointData* pd = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  newPoints->SetNumberOfPoints(numNewPts);
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, pd, outPD, 0.0, false);
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  vtkIdType* pointMapPtr = pointMap.data();
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    CellReader& reader = readers.Local();
+    int cellType;
+    double x[3];
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (cellSizesPtr[cellId] == 0)
+      {
+        continue;
+      }
+      vtkIdList* cellPts = reader.Read(cellId, cellType);
+      const vtkIdType* pts = cellPts->GetPointer(0);
+      vtkIdType newId = newPointOffsetsPtr[cellId];
+      for (vtkIdType i = 0; i < cellSizesPtr[cellId]; ++i)
+      {
+        const vtkIdType ptId = pts[i];
+        if (firstCellsPtr[ptId].load(std::memory_order_relaxed) == cellId &&
+          pointMapPtr[ptId] < 0)
+        {
+          pointMapPtr[ptId] = newId;
+          input->GetPoint(ptId, x);
+          newPoints->SetPoint(newId, x);
+          pointArrays.Copy(ptId, newId);
+          ++newId;
+        }
+      }
+    }
+  });
+  std::vector<std::atomic<vtkIdType>>().swap(firstCells);
+  this->UpdateProgress(0.75);
+
+  // Third pass: copy the cells, with their points renumbered, and their data.
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfTuples(numOutCells);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfTuples(numOutCells + 1);
+  offsets->SetValue(numOutCells, connSize);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfTuples(connSize);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numOutCells, input->GetCellData(), output->GetCellData(), 0.0, false);
+  unsigned char* typesPtr = types->GetPointer(0);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkIdType* connPtr = connectivity->GetPointer(0);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    CellReader& reader = readers.Local();
+    int cellType;
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (cellSizesPtr[cellId] == 0)
+      {
+        continue;
+      }
+      vtkIdList* cellPts = reader.Read(cellId, cellType);
+      const vtkIdType* pts = cellPts->GetPointer(0);
+      const vtkIdType outCellId = outCellIds[cellId];
+      vtkIdType* outPts = connPtr + connOffsets[cellId];
+      for (vtkIdType i = 0; i < cellSizesPtr[cellId]; ++i)
+      {
+        outPts[i] = pointMapPtr[pts[i]];
+      }
+      typesPtr[outCellId] = static_cast<unsigned char>(cellType);
+      offsetsPtr[outCellId] = connOffsets[cellId];
+      cellArrays.Copy(cellId, outCellId);
+    }
+  });
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+  output->SetCells(types, cells);
+}
+
+//------------------------------------------------------------------------------
+int vtkThreshold::KeepCell(vtkDataArray* scalars, bool usePointScalars, vtkIdType cellId,
+  vtkIdList* cellPts, int numCellPts)
+{
+  int keepCell;
+  if (usePointScalars)
+  {
+    if (this->AllScalars)
+    {
+      keepCell = 1;
+      for (int i = 0; keepCell && (i < numCellPts); i++)
+      {
+        keepCell = this->EvaluateComponents(scalars, cellPts->GetId(i));
+      }
+    }
+    else
+    {
+      if (!this->UseContinuousCellRange)
+      {
+        keepCell = 0;
+        for (int i = 0; (!keepCell) && (i < numCellPts); i++)
+        {
+          keepCell = this->EvaluateComponents(scalars, cellPts->GetId(i));
+        }
+      }
+      else
+      {
+        keepCell = this->EvaluateCell(scalars, cellPts, numCellPts);
+      }
+    }
+  }
+  else // use cell scalars
+  {
+    keepCell = this->EvaluateComponents(scalars, cellId);
+  }
+
+  // Invert the keep flag if the Invert option is enabled.
+  return this->Invert ? (1 - keepCell) : keepCell;
+}
+
 int vtkThreshold::EvaluateCell(vtkDataArray* scalars, vtkIdList* cellPts, int numCellPts)
 {
   int c(0);
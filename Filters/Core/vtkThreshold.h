@@ -30,6 +30,12 @@
  * By default only the first scalar value is used in the decision. Use the ComponentMode
  * and SelectedComponent ivars to control this behavior.
  *
+ * The cells are evaluated, and the output built, in parallel with
+ * vtkSMPTools. The output is the same as when the cells are traversed in
+ * order, whatever the number of threads. Inputs with polyhedral cells, or
+ * with attribute arrays that are not vtkDataArrays, are processed
+ * sequentially.
+ *
  * @sa
  * vtkThresholdPoints vtkThresholdTextureCoords
  */
@@ -51,6 +57,7 @@
 
 class vtkDataArray;
 class vtkIdList;
+class vtkPoints;
 
 class VTKFILTERSCORE_EXPORT vtkThreshold : public vtkUnstructuredGridAlgorithm
 {
@@ -233,6 +240,17 @@ protected:
   int EvaluateCell(vtkDataArray* scalars, vtkIdList* cellPts, int numCellPts);
   int EvaluateCell(vtkDataArray* scalars, int c, vtkIdList* cellPts, int numCellPts);
 
+  // Returns 1 if the cell with the given points satisfies the threshold
+  // criterion, taking the Invert option into account.
+  int KeepCell(vtkDataArray* scalars, bool usePointScalars, vtkIdType cellId, vtkIdList* cellPts,
+    int numCellPts);
+
+  // Extracts the cells satisfying the criterion with vtkSMPTools. The point
+  // and cell data of the output must have been allocated with
+  // CopyAllocate().
+  void ThresholdInParallel(vtkDataSet* input, vtkDataArray* inScalars, bool usePointScalars,
+    vtkPoints* newPoints, vtkUnstructuredGrid* output);
+
 private:
   vtkThreshold(const vtkThreshold&) = delete;
   void operator=(const vtkThreshold&) = delete;
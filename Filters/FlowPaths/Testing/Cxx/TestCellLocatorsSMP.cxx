@@ -0,0 +1,186 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellLocatorsSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkCellLocator, vtkCellTreeLocator and vtkModifiedBSPTree,
+// which build in parallel, give the same query results with every
+// vtkSMPTools backend.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdListCollection.h"
+#include "vtkImageData.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Runs the queries on a locator and records their results.
+std::vector<double> RunQueries(vtkAbstractCellLocator* locator, const std::vector<double>& points)
+{
+  std::vector<double> results;
+  for (std::size_t i = 0; i + 6 <= points.size(); i += 6)
+  {
+    double x[3] = { points[i], points[i + 1], points[i + 2] };
+    double p2[3] = { points[i + 3], points[i + 4], points[i + 5] };
+    double pcoords[3], weights[8];
+    vtkNew<vtkGenericCell> cell;
+    results.push_back(static_cast<double>(locator->FindCell(x, 0.0, cell, pcoords, weights)));
+
+    double t, hit[3];
+    int subId;
+    vtkIdType cellId = -1;
+    if (locator->IntersectWithLine(x, p2, 0.0, t, hit, pcoords, subId, cellId, cell))
+    {
+      results.push_back(t);
+      results.push_back(static_cast<double>(cellId));
+    }
+    else
+    {
+      results.push_back(-1.0);
+    }
+  }
+  return results;
+}
+
+// Records the cells of the leaves or buckets of a locator.
+std::vector<vtkIdType> GetLeafCells(vtkAbstractCellLocator* locator)
+{
+  std::vector<vtkIdType> leafCells;
+  if (vtkCellLocator* cellLocator = vtkCellLocator::SafeDownCast(locator))
+  {
+    // The leaf octants come after their parents.
+    int numLeaves = 1;
+    for (int level = 0; level < cellLocator->GetLevel(); ++level)
+    {
+      numLeaves *= 8;
+    }
+    for (int bucket = cellLocator->GetNumberOfBuckets() - numLeaves;
+         bucket < cellLocator->GetNumberOfBuckets(); ++bucket)
+    {
+      vtkIdList* cells = cellLocator->GetCells(bucket);
+      leafCells.push_back(cells ? cells->GetNumberOfIds() : -1);
+      for (vtkIdType i = 0; cells && i < cells->GetNumberOfIds(); ++i)
+      {
+        leafCells.push_back(cells->GetId(i));
+      }
+    }
+  }
+  else if (vtkModifiedBSPTree* tree = vtkModifiedBSPTree::SafeDownCast(locator))
+  {
+    vtkSmartPointer<vtkIdListCollection> leaves;
+    leaves.TakeReference(tree->GetLeafNodeCellInformation());
+    for (int leaf = 0; leaf < leaves->GetNumberOfItems(); ++leaf)
+    {
+      vtkIdList* cells = leaves->GetItem(leaf);
+      leafCells.push_back(cells->GetNumberOfIds());
+      for (vtkIdType i = 0; i < cells->GetNumberOfIds(); ++i)
+      {
+        leafCells.push_back(cells->GetId(i));
+      }
+    }
+  }
+  return leafCells;
+}
+
+vtkSmartPointer<vtkAbstractCellLocator> NewLocator(int type)
+{
+  switch (type)
+  {
+    case 0:
+      return vtkSmartPointer<vtkCellLocator>::New();
+    case 1:
+      return vtkSmartPointer<vtkCellTreeLocator>::New();
+    default:
+      return vtkSmartPointer<vtkModifiedBSPTree>::New();
+  }
+}
+}
+
+int TestCellLocatorsSMP(int, char*[])
+{
+  // Voxels, whose bounds are often equal, and triangles.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 30, 0, 24, 0, 20);
+  image->SetSpacing(0.1, 0.125, 0.15);
+  image->SetOrigin(-1.5, -1.5, -1.5);
+  vtkNew<vtkAppendFilter> toGrid;
+  toGrid->AddInputData(image);
+  toGrid->Update();
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(96);
+  sphere->SetPhiResolution(64);
+  sphere->SetRadius(1.2);
+  sphere->Update();
+
+  std::vector<vtkDataSet*> inputs = { toGrid->GetOutput(), sphere->GetOutput() };
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(6481);
+  std::vector<double> points(6 * 2000);
+  for (double& x : points)
+  {
+    x = random->GetRangeValue(-1.8, 1.8);
+    random->Next();
+  }
+
+  int status = EXIT_SUCCESS;
+  for (std::size_t inputId = 0; inputId < inputs.size(); ++inputId)
+  {
+    for (int type = 0; type < 3; ++type)
+    {
+      for (int cacheCellBounds = 0; cacheCellBounds < 2; ++cacheCellBounds)
+      {
+        std::vector<double> referenceResults;
+        std::vector<vtkIdType> referenceLeafCells;
+        vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+          vtkSmartPointer<vtkAbstractCellLocator> locator = NewLocator(type);
+          locator->SetDataSet(inputs[inputId]);
+          locator->SetCacheCellBounds(cacheCellBounds);
+          locator->SetNumberOfCellsPerNode(type == 2 ? 16 : 8);
+          locator->LazyEvaluationOff();
+          locator->BuildLocator();
+
+          std::vector<double> results = RunQueries(locator, points);
+          std::vector<vtkIdType> leafCells = GetLeafCells(locator);
+          if (referenceResults.empty())
+          {
+            referenceResults = results;
+            referenceLeafCells = leafCells;
+          }
+          else if (results != referenceResults || leafCells != referenceLeafCells)
+          {
+            std::cerr << locator->GetClassName() << " with the " << backend
+                      << " backend differs from the Sequential one for input " << inputId
+                      << " with CacheCellBounds " << cacheCellBounds << std::endl;
+            status = EXIT_FAILURE;
+          }
+        });
+      }
+    }
+  }
+  return status;
+}
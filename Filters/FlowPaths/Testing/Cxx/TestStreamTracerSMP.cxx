@@ -0,0 +1,207 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStreamTracerSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkStreamTracer gives the same streamlines, in the same order,
+// with every vtkSMPTools backend, on image data, unstructured grids and
+// multiblock inputs, including overlapping blocks with different flows.
+
+#include <vtkAppendFilter.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkDoubleArray.h>
+#include <vtkImageData.h>
+#include <vtkMultiBlockDataSet.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPointSource.h>
+#include <vtkPolyData.h>
+#include <vtkRungeKutta45.h>
+#include <vtkSMPTestUtilities.h>
+#include <vtkSmartPointer.h>
+#include <vtkStreamTracer.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// An image of a helical flow around the z axis, turning in the direction of
+// swirl, with a scalar to interpolate.
+vtkSmartPointer<vtkImageData> CreateImage(int xMin, int xMax, double swirl = 1.0)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(xMin, xMax, -10, 10, -10, 10);
+  image->SetSpacing(0.1, 0.1, 0.1);
+
+  vtkNew<vtkDoubleArray> velocity;
+  velocity->SetName("Velocity");
+  velocity->SetNumberOfComponents(3);
+  velocity->SetNumberOfTuples(image->GetNumberOfPoints());
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < image->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    image->GetPoint(ptId, x);
+    velocity->SetTuple3(ptId, -swirl * x[1], swirl * x[0], 0.2 + 0.1 * x[2]);
+    scalars->SetValue(ptId, x[0] * x[0] + x[1] - x[2]);
+  }
+  image->GetPointData()->SetVectors(velocity);
+  image->GetPointData()->SetScalars(scalars);
+  return image;
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  const int numComp = a->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetComponent(i / numComp, i % numComp) != b->GetComponent(i / numComp, i % numComp))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutputs(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfLines() != b->GetNumberOfLines() ||
+    !SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()))
+  {
+    return false;
+  }
+  vtkIdType nptsA, nptsB;
+  const vtkIdType *ptsA, *ptsB;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfLines(); ++cellId)
+  {
+    a->GetLines()->GetCellAtId(cellId, nptsA, ptsA);
+    b->GetLines()->GetCellAtId(cellId, nptsB, ptsB);
+    if (nptsA != nptsB || !std::equal(ptsA, ptsA + nptsA, ptsB))
+    {
+      return false;
+    }
+  }
+  if (a->GetPointData()->GetNumberOfArrays() != b->GetPointData()->GetNumberOfArrays() ||
+    a->GetCellData()->GetNumberOfArrays() != b->GetCellData()->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < a->GetPointData()->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = a->GetPointData()->GetArray(i);
+    if (!SameArrays(array, b->GetPointData()->GetArray(array->GetName())))
+    {
+      return false;
+    }
+  }
+  for (int i = 0; i < a->GetCellData()->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = a->GetCellData()->GetArray(i);
+    if (!SameArrays(array, b->GetCellData()->GetArray(array->GetName())))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestStreamTracerSMP(int, char*[])
+{
+  vtkSmartPointer<vtkImageData> image = CreateImage(-10, 10);
+
+  vtkNew<vtkAppendFilter> toGrid;
+  toGrid->AddInputData(image);
+  toGrid->Update();
+
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  blocks->SetNumberOfBlocks(2);
+  blocks->SetBlock(0, CreateImage(-10, 0));
+  blocks->SetBlock(1, CreateImage(0, 10));
+
+  // Overlapping blocks whose flows differ: the streamlines depend on the
+  // block where the search for the cell of each seed starts.
+  vtkNew<vtkMultiBlockDataSet> overlapping;
+  overlapping->SetNumberOfBlocks(2);
+  overlapping->SetBlock(0, CreateImage(-10, 5));
+  overlapping->SetBlock(1, CreateImage(-5, 10, -1.0));
+
+  std::vector<vtkDataObject*> inputs = { image, toGrid->GetOutput(), blocks, overlapping };
+
+  vtkNew<vtkPointSource> seeds;
+  seeds->SetCenter(0.2, 0.0, -0.5);
+  seeds->SetRadius(0.6);
+  seeds->SetNumberOfPoints(200);
+  seeds->Update();
+
+  int status = EXIT_SUCCESS;
+  for (std::size_t inputId = 0; inputId < inputs.size(); ++inputId)
+  {
+    for (int mode = 0; mode < 2; ++mode)
+    {
+      vtkSmartPointer<vtkPolyData> reference;
+      vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+        vtkNew<vtkStreamTracer> tracer;
+        tracer->SetInputData(inputs[inputId]);
+        tracer->SetSourceData(seeds->GetOutput());
+        tracer->SetIntegrationDirectionToBoth();
+        tracer->SetMaximumPropagation(5.0);
+        tracer->SetInitialIntegrationStep(0.2);
+        if (mode == 1)
+        {
+          vtkNew<vtkRungeKutta45> integrator;
+          tracer->SetIntegrator(integrator);
+          tracer->SetMinimumIntegrationStep(0.05);
+          tracer->SetMaximumIntegrationStep(0.5);
+        }
+        tracer->Update();
+        vtkPolyData* output = tracer->GetOutput();
+
+        if (output->GetNumberOfLines() == 0)
+        {
+          std::cerr << "No streamlines for input " << inputId << " in mode " << mode << std::endl;
+          status = EXIT_FAILURE;
+        }
+        if (!reference)
+        {
+          reference = vtkSmartPointer<vtkPolyData>::New();
+          reference->DeepCopy(output);
+        }
+        else if (!SameOutputs(reference, output))
+        {
+          std::cerr << "Streamlines of the " << backend
+                    << " backend differ from the Sequential ones for input " << inputId
+                    << " in mode " << mode << std::endl;
+          status = EXIT_FAILURE;
+        }
+      });
+    }
+  }
+  return status;
+}
@@ -35,6 +35,22 @@ vtkCompositeInterpolatedVelocityField::~vtkCompositeInterpolatedVelocityField()
   this->DataSets = nullptr;
 }
 
+//------------------------------------------------------------------------------
+int vtkCompositeInterpolatedVelocityField::GetNumberOfDataSets()
+{
+  return static_cast<int>(this->DataSets->size());
+}
+
+//------------------------------------------------------------------------------
+vtkDataSet* vtkCompositeInterpolatedVelocityField::GetDataSet(int index)
+{
+  if (index < 0 || index >= static_cast<int>(this->DataSets->size()))
+  {
+    return nullptr;
+  }
+  return (*this->DataSets)[index];
+}
+
 //------------------------------------------------------------------------------
 void vtkCompositeInterpolatedVelocityField::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -59,6 +59,16 @@ public:
    */
   virtual void AddDataSet(vtkDataSet* dataset) = 0;
 
+  //@{
+  /**
+   * Get the number of datasets added with AddDataSet(), and the dataset at
+   * the given index. This allows to set up a new instance of the velocity
+   * field, for instance one per thread, over the same datasets.
+   */
+  int GetNumberOfDataSets();
+  vtkDataSet* GetDataSet(int index);
+  //@}
+
   //@{
   /**
    * Get the most recently visited dataset and its id. The dataset is used
@@ -18,6 +18,7 @@
 #include "vtkIdListCollection.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <functional>
@@ -84,8 +85,6 @@ public:
 
 typedef cell_extents* cell_extents_List;
 
-static int global_list_count = 0;
-
 class Sorted_cell_extents_Lists
 {
 public:
@@ -99,7 +98,6 @@ public:
       Mins[i] = new cell_extents[nCells]; // max num <= nCells/2 ?
       Maxs[i] = new cell_extents[nCells];
     }
-    global_list_count += 1;
   };
   ~Sorted_cell_extents_Lists()
   {
@@ -108,38 +106,47 @@ public:
       delete[](Mins[i]);
       delete[](Maxs[i]);
     }
-    global_list_count -= 1;
   }
 };
 
-extern "C" int _compareMin(const void* pA, const void* B)
+// A node left to subdivide, along with its lists, once the first levels of
+// the tree are built.
+struct BSPSubtree
 {
-  const cell_extents* tA = static_cast<const cell_extents*>(pA);
-  const cell_extents* tB = static_cast<const cell_extents*>(B);
-  if (tA->min == tB->min)
-  {
-    return 0;
-  }
-  else
+  BSPNode* Node;
+  Sorted_cell_extents_Lists* Lists;
+  vtkIdType NumberOfCells;
+  int Depth;
+};
+
+class BSPSubtreeList : public std::vector<BSPSubtree>
+{
+};
+
+// Sort orders of the extents lists. Equal extents are ordered by cell id so
+// that the lists do not depend on the sort algorithm.
+static bool _compareMin(const cell_extents& tA, const cell_extents& tB)
+{
+  if (tA.min == tB.min)
   {
-    return tA->min < tB->min ? -1 : 1;
+    return tA.cell_ID < tB.cell_ID;
   }
+  return tA.min < tB.min;
 }
 
-extern "C" int _compareMax(const void* pA, const void* B)
+static bool _compareMax(const cell_extents& tA, const cell_extents& tB)
 {
-  const cell_extents* tA = static_cast<const cell_extents*>(pA);
-  const cell_extents* tB = static_cast<const cell_extents*>(B);
-  if (tA->max == tB->max)
-  {
-    return 0;
-  }
-  else
+  if (tA.max == tB.max)
   {
-    return tA->max > tB->max ? -1 : 1;
+    return tA.cell_ID < tB.cell_ID;
   }
+  return tA.max > tB.max;
 }
 
+// The number of levels of the tree which are built before the remaining
+// nodes are subdivided in parallel, up to 3^4 = 81 subtrees.
+static const int BSPParallelDepth = 4;
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -202,7 +209,7 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
 
   // create the root node
   this->mRoot = new BSPNode();
-  this->mRoot->mAxis = rand() % 3;
+  this->mRoot->mAxis = 0;
   this->mRoot->depth = 0;
   //
   if (numCells == 0)
@@ -214,35 +221,53 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
   //
   // sort the cells into 6 lists using structure for subdividing tests
   Sorted_cell_extents_Lists* lists = new Sorted_cell_extents_Lists(numCells);
-  for (int i = 0; i < 3; i++)
-  { // loop over each axis
-    for (vtkIdType j = 0; j < numCells; j++)
-    {                                                   // loop over each cell
-      lists->Mins[i][j].min = CellBounds[j][i * 2];     // i=0 xmin, i=1 ymin, i=2 zmin
-      lists->Mins[i][j].max = CellBounds[j][i * 2 + 1]; // i=0 xmax, i=1 ymax, i=2 zmax
-      lists->Mins[i][j].cell_ID = j;
-      //
-      lists->Maxs[i][j].min = CellBounds[j][i * 2];
-      lists->Maxs[i][j].max = CellBounds[j][i * 2 + 1];
-      lists->Maxs[i][j].cell_ID = j;
+  double(*cellBounds)[6] = this->CellBounds;
+  vtkSMPTools::For(0, numCells, [lists, cellBounds](vtkIdType j, vtkIdType endCell) {
+    for (; j < endCell; j++)
+    { // loop over each cell
+      for (int i = 0; i < 3; i++)
+      { // loop over each axis
+        // i=0 xmin/xmax, i=1 ymin/ymax, i=2 zmin/zmax
+        lists->Mins[i][j].min = cellBounds[j][i * 2];
+        lists->Mins[i][j].max = cellBounds[j][i * 2 + 1];
+        lists->Mins[i][j].cell_ID = j;
+        //
+        lists->Maxs[i][j].min = cellBounds[j][i * 2];
+        lists->Maxs[i][j].max = cellBounds[j][i * 2 + 1];
+        lists->Maxs[i][j].cell_ID = j;
+      }
     }
+  });
+  for (int i = 0; i < 3; i++)
+  {
     // Sort
-    qsort(lists->Mins[i], numCells, sizeof(cell_extents), _compareMin);
-    qsort(lists->Maxs[i], numCells, sizeof(cell_extents), _compareMax);
+    vtkSMPTools::Sort(lists->Mins[i], lists->Mins[i] + numCells, _compareMin);
+    vtkSMPTools::Sort(lists->Maxs[i], lists->Maxs[i] + numCells, _compareMax);
   }
   //
-  // call the recursive subdivision routine
+  // call the recursive subdivision routine : the first levels are built here,
+  // the subtrees below them are subdivided in parallel
   //
   vtkDebugMacro(<< "Beginning Subdivision");
   //
-  if (numCells > 0)
-  {
-    Subdivide(this->mRoot, lists, this->DataSet, numCells, 0, this->MaxLevel,
-      this->NumberOfCellsPerNode, this->Level);
-  }
+  BSPSubtreeList subtrees;
+  Subdivide(this->mRoot, lists, this->DataSet, numCells, 0, this->MaxLevel,
+    this->NumberOfCellsPerNode, &subtrees, BSPParallelDepth);
   delete lists;
+  vtkDataSet* dataSet = this->DataSet;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()),
+    [this, &subtrees, dataSet](vtkIdType subtreeId, vtkIdType endSubtree) {
+      for (; subtreeId < endSubtree; subtreeId++)
+      {
+        BSPSubtree& subtree = subtrees[subtreeId];
+        Subdivide(subtree.Node, subtree.Lists, dataSet, subtree.NumberOfCells, subtree.Depth,
+          this->MaxLevel, this->NumberOfCellsPerNode);
+        delete subtree.Lists;
+      }
+    });
   // Child nodes are responsible for freeing the temporary sorted lists
   //
+  this->GatherStatistics(this->mRoot);
   this->BuildTime.Modified();
   //
   double av_depth = (double)tot_depth / nln;
@@ -252,23 +277,42 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
                 << "Average Depth " << av_depth << " Original : " << numCells);
 }
 
+//------------------------------------------------------------------------------
+void vtkModifiedBSPTree::GatherStatistics(BSPNode* node)
+{
+  if (node->depth > this->Level)
+  {
+    this->Level = node->depth;
+  }
+  if (!node->mChild[0])
+  {
+    nln += 1; // Leaf node
+    tot_depth += node->depth;
+    return;
+  }
+  npn += 1; // Parent node
+  for (int i = 0; i < 3; i++)
+  {
+    if (node->mChild[i])
+    {
+      this->GatherStatistics(node->mChild[i]);
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 //
 // The main BSP subdivision routine : The code which does the division is only
 // a small part of this, the rest is just bookkeeping - it looks worse than it is.
 //
 void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lists,
-  vtkDataSet* dataset, vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells, int& MaxDepth)
+  vtkDataSet* dataset, vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells,
+  BSPSubtreeList* subtrees, int splitDepth)
 {
   //
   // We've got lists sorted on the axes, so we can easily get BBox
   node->setMin(lists->Mins[0][0].min, lists->Mins[1][0].min, lists->Mins[2][0].min);
   node->setMax(lists->Maxs[0][0].max, lists->Maxs[1][0].max, lists->Maxs[2][0].max);
-  // Update depth info
-  if (node->depth > MaxDepth)
-  {
-    MaxDepth = depth;
-  }
   //
   // Make sure child nodes are clear to start with
   node->mChild[2] = node->mChild[1] = node->mChild[0] = nullptr;
@@ -319,7 +363,7 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
       {
         node->mChild[i] = new BSPNode();
         node->mChild[i]->depth = node->depth + 1;
-        node->mChild[i]->mAxis = rand() % 3;
+        node->mChild[i]->mAxis = (node->mAxis + i + 1) % 3;
       }
       Daxis = node->mAxis;
       Sorted_cell_extents_Lists* left = new Sorted_cell_extents_Lists(nCells);
@@ -456,41 +500,38 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
         //
         // And of course, we really ought to subdivide again - Hoorah!
         // NB: it is possible for a node to be empty now, so check and delete if necessary
-        if (Cmin_l[0])
-        {
-          Subdivide(
-            node->mChild[0], left, dataset, Cmin_l[0], depth + 1, maxlevel, maxCells, MaxDepth);
-        }
-        else
-        {
-          vtkWarningMacro(<< "Child 0 Empty ! - this shouldn't happen");
-        }
-        delete left;
-
-        if (Cmin_m[0])
-        {
-          Subdivide(
-            node->mChild[1], mid, dataset, Cmin_m[0], depth + 1, maxlevel, maxCells, MaxDepth);
-        }
-        else
-        {
-          delete node->mChild[1];
-          node->mChild[1] = nullptr;
-        }
-        delete mid;
-
-        if (Cmin_r[0])
-        {
-          Subdivide(
-            node->mChild[2], right, dataset, Cmin_r[0], depth + 1, maxlevel, maxCells, MaxDepth);
-        }
-        else
+        // Past splitDepth, the children are handed over to the caller along
+        // with their lists.
+        const bool defer = subtrees && depth + 1 >= splitDepth;
+        Sorted_cell_extents_Lists* childLists[3] = { left, mid, right };
+        vtkIdType childCells[3] = { Cmin_l[0], Cmin_m[0], Cmin_r[0] };
+        for (int i = 0; i < 3; i++)
         {
-          vtkWarningMacro(<< "Child 2 Empty ! - this shouldn't happen");
+          if (!childCells[i])
+          {
+            if (i == 1)
+            {
+              delete node->mChild[1];
+              node->mChild[1] = nullptr;
+            }
+            else
+            {
+              vtkWarningMacro(<< "Child " << i << " Empty ! - this shouldn't happen");
+            }
+            delete childLists[i];
+          }
+          else if (defer)
+          {
+            BSPSubtree subtree = { node->mChild[i], childLists[i], childCells[i], depth + 1 };
+            subtrees->push_back(subtree);
+          }
+          else
+          {
+            Subdivide(node->mChild[i], childLists[i], dataset, childCells[i], depth + 1, maxlevel,
+              maxCells, subtrees, splitDepth);
+            delete childLists[i];
+          }
         }
-        delete right;
-        //
-        npn += 1; // Parent node
         //
         // we've done all we were asked to do
         //
@@ -503,8 +544,6 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
   //
   // Copy the cell IDs into the actual node structure for proper use
   node->num_cells = nCells;
-  nln += 1; // Leaf node
-  tot_depth += node->depth;
   for (int i = 0; i < 6; i++)
   {
     node->sorted_cell_lists[i] = new vtkIdType[nCells];
@@ -95,6 +95,11 @@
  * segments the lists and passes them down to the new child nodes whilst
  * maintaining sorted order. This makes for an efficient subdivision strategy.
  *
+ * The cell bounds, the sorted lists and the subdivision of the nodes below the
+ * first levels of the tree are computed in parallel using vtkSMPTools. The
+ * axis first tested when dividing a node follows from the axis of its parent,
+ * so that the tree is the same for every backend and every build.
+ *
  * NB. The following reference has been sent to me
  *   @Article{formella-1995-ray,
  *     author =     "Arno Formella and Christian Gill",
@@ -149,6 +154,7 @@
 
 class Sorted_cell_extents_Lists;
 class BSPNode;
+class BSPSubtreeList;
 class vtkGenericCell;
 class vtkIdList;
 class vtkIdListCollection;
@@ -244,9 +250,15 @@ protected:
   int tot_depth;
 
   //
-  // The main subdivision routine
+  // The main subdivision routine. When subtrees is given, the children of a
+  // node at depth splitDepth - 1 are appended to it instead of being
+  // subdivided, so that they can be subdivided in parallel.
   void Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lists, vtkDataSet* dataSet,
-    vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells, int& MaxDepth);
+    vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells,
+    BSPSubtreeList* subtrees = nullptr, int splitDepth = 0);
+
+  // Counts the parent and leaf nodes, and the depth of the tree.
+  void GatherStatistics(BSPNode* node);
 
   // We provide a function which does the cell/ray test so that
   // it can be overridden by subclasses to perform special treatment
@@ -19,6 +19,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellLocatorInterpolatedVelocityField.h"
+#include "vtkCellLocatorStrategy.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositeDataSet.h"
@@ -43,9 +44,13 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkRungeKutta2.h"
 #include "vtkRungeKutta4.h"
 #include "vtkRungeKutta45.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStaticCellLocator.h"
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 vtkObjectFactoryNewMacro(vtkStreamTracer);
@@ -88,6 +93,35 @@ void InterpolatePoint(vtkDataSetAttributes* outPointData, vtkDataSetAttributes*
   }
 }
 
+// Builds the structures that locating cells in a dataset otherwise builds
+// lazily, so that several velocity fields can then probe it concurrently.
+void PrepareForConcurrentProbing(vtkDataSet* dataset, vtkFindCellStrategy* strategy)
+{
+  double bounds[6];
+  dataset->GetBounds(bounds);
+  if (dataset->GetNumberOfCells() > 0)
+  {
+    vtkNew<vtkGenericCell> cell;
+    dataset->GetCell(0, cell);
+  }
+  if (vtkPointSet* pointSet = vtkPointSet::SafeDownCast(dataset))
+  {
+    if (pointSet->GetNumberOfPoints() > 0)
+    {
+      vtkNew<vtkIdList> cellIds;
+      pointSet->GetPointCells(0, cellIds);
+    }
+    if (vtkCellLocatorStrategy::SafeDownCast(strategy))
+    {
+      pointSet->BuildCellLocator();
+    }
+    else
+    {
+      pointSet->BuildPointLocator();
+    }
+  }
+}
+
 }
 
 //------------------------------------------------------------------------------
@@ -652,102 +686,115 @@ int vtkStreamTracer::CheckInputs(vtkAbstractInterpolatedVelocityField*& func, in
 }
 
 //------------------------------------------------------------------------------
-void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
-  vtkDataArray* seedSource, vtkIdList* seedIds, vtkIntArray* integrationDirections,
-  double lastPoint[3], vtkAbstractInterpolatedVelocityField* func, int maxCellSize, int vecType,
-  const char* vecName, double& inPropagation, vtkIdType& inNumSteps, double& inIntegrationTime)
+// The velocity field, integrator and scratch objects used to integrate
+// streamlines, and the buffers the streamline points are appended to.
+struct vtkStreamTracer::IntegrationWorkspace
 {
-  vtkIdType numLines = seedIds->GetNumberOfIds();
-  double propagation = inPropagation;
-  vtkIdType numSteps = inNumSteps;
-  double integrationTime = inIntegrationTime;
+  vtkSmartPointer<vtkAbstractInterpolatedVelocityField> Func;
+  vtkInterpolatedVelocityField* SurfaceFunc = nullptr;
+  vtkSmartPointer<vtkInitialValueProblemSolver> Integrator;
+  vtkSmartPointer<vtkGenericCell> Cell;
+  std::vector<double> Weights;
+  vtkSmartPointer<vtkDoubleArray> CellVectors;
+  int VecType = vtkDataObject::POINT;
+  const char* VecName = nullptr;
+
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkDataSetAttributes> PointData;
+  vtkSmartPointer<vtkDoubleArray> Time;
+  vtkSmartPointer<vtkDoubleArray> VelocityVectors;
+  vtkSmartPointer<vtkDoubleArray> Vorticity;
+  vtkSmartPointer<vtkDoubleArray> Rotation;
+  vtkSmartPointer<vtkDoubleArray> AngularVelocity;
+
+  // Progress is only reported, and the abort flag checked, when the
+  // streamlines are integrated by the thread executing the filter.
+  bool ReportProgress = false;
+  bool Aborted = false;
+
+  // The arrays of PointData matching those of the output point data, used
+  // when the streamlines are appended to the output.
+  std::vector<vtkAbstractArray*> SourceArrays;
+};
 
-  // Useful pointers
-  vtkDataSetAttributes* outputPD = output->GetPointData();
-  vtkDataSetAttributes* outputCD = output->GetCellData();
-  vtkPointData* inputPD;
-  vtkDataSet* input;
-  vtkDataArray* inVectors;
-
-  int direction = 1;
-
-  if (this->GetIntegrator() == nullptr)
-  {
-    vtkErrorMacro("No integrator is specified.");
-    return;
-  }
-
-  double* weights = nullptr;
-  if (maxCellSize > 0)
-  {
-    weights = new double[maxCellSize];
-  }
+//------------------------------------------------------------------------------
+// How a streamline ended.
+struct vtkStreamTracer::Streamline
+{
+  vtkIdType NumberOfPoints = 0;
+  int ReasonForTermination = OUT_OF_LENGTH;
+  // Set when the streamline left the domain, to the point outside of it.
+  bool HasLastPoint = false;
+  double LastPoint[3];
+  // Set to the last step size used, if any step was taken.
+  bool HasStepSize = false;
+  double StepSize = 0.0;
+};
 
-  // Used in GetCell()
-  vtkGenericCell* cell = vtkGenericCell::New();
+//------------------------------------------------------------------------------
+void vtkStreamTracer::InitializeWorkspace(IntegrationWorkspace& ws,
+  vtkAbstractInterpolatedVelocityField* func, vtkDataSetAttributes* outputPD,
+  vtkPointData* input0Data, int maxCellSize, int vecType, const char* vecName)
+{
+  ws.Func = func;
+  ws.VecType = vecType;
+  ws.VecName = vecName;
 
   // Create a new integrator, the type is the same as Integrator
-  vtkInitialValueProblemSolver* integrator = this->GetIntegrator()->NewInstance();
-  integrator->SetFunctionSet(func);
+  ws.Integrator.TakeReference(this->GetIntegrator()->NewInstance());
+  ws.Integrator->SetFunctionSet(func);
 
   // Check Surface option
-  vtkInterpolatedVelocityField* surfaceFunc = nullptr;
   if (this->SurfaceStreamlines == true)
   {
-    surfaceFunc = vtkInterpolatedVelocityField::SafeDownCast(func);
-    if (surfaceFunc)
+    ws.SurfaceFunc = vtkInterpolatedVelocityField::SafeDownCast(func);
+    if (ws.SurfaceFunc)
     {
-      surfaceFunc->SetForceSurfaceTangentVector(true);
-      surfaceFunc->SetSurfaceDataset(true);
+      ws.SurfaceFunc->SetForceSurfaceTangentVector(true);
+      ws.SurfaceFunc->SetSurfaceDataset(true);
     }
   }
 
+  // Used in GetCell()
+  ws.Cell = vtkSmartPointer<vtkGenericCell>::New();
+  if (maxCellSize > 0)
+  {
+    ws.Weights.resize(maxCellSize);
+  }
+
   // Since we do not know what the total number of points
   // will be, we do not allocate any. This is important for
   // cases where a lot of streamers are used at once. If we
   // were to allocate any points here, potentially, we can
   // waste a lot of memory if a lot of streamers are used.
   // Always insert the first point
-  vtkPoints* outputPoints = vtkPoints::New();
-  vtkCellArray* outputLines = vtkCellArray::New();
+  ws.Points = vtkSmartPointer<vtkPoints>::New();
 
   // We will keep track of integration time in this array
-  vtkDoubleArray* time = vtkDoubleArray::New();
-  time->SetName("IntegrationTime");
+  ws.Time = vtkSmartPointer<vtkDoubleArray>::New();
+  ws.Time->SetName("IntegrationTime");
 
-  // This array explains why the integration stopped
-  vtkIntArray* retVals = vtkIntArray::New();
-  retVals->SetName("ReasonForTermination");
-
-  vtkIntArray* sids = vtkIntArray::New();
-  sids->SetName("SeedIds");
-
-  vtkSmartPointer<vtkDoubleArray> velocityVectors;
   if (vecType != vtkDataObject::POINT)
   {
-    velocityVectors = vtkSmartPointer<vtkDoubleArray>::New();
-    velocityVectors->SetName(vecName);
-    velocityVectors->SetNumberOfComponents(3);
+    ws.VelocityVectors = vtkSmartPointer<vtkDoubleArray>::New();
+    ws.VelocityVectors->SetName(vecName);
+    ws.VelocityVectors->SetNumberOfComponents(3);
   }
-  vtkDoubleArray* cellVectors = nullptr;
-  vtkDoubleArray* vorticity = nullptr;
-  vtkDoubleArray* rotation = nullptr;
-  vtkDoubleArray* angularVel = nullptr;
   if (this->ComputeVorticity)
   {
-    cellVectors = vtkDoubleArray::New();
-    cellVectors->SetNumberOfComponents(3);
-    cellVectors->Allocate(3 * VTK_CELL_SIZE);
+    ws.CellVectors = vtkSmartPointer<vtkDoubleArray>::New();
+    ws.CellVectors->SetNumberOfComponents(3);
+    ws.CellVectors->Allocate(3 * VTK_CELL_SIZE);
 
-    vorticity = vtkDoubleArray::New();
-    vorticity->SetName("Vorticity");
-    vorticity->SetNumberOfComponents(3);
+    ws.Vorticity = vtkSmartPointer<vtkDoubleArray>::New();
+    ws.Vorticity->SetName("Vorticity");
+    ws.Vorticity->SetNumberOfComponents(3);
 
-    rotation = vtkDoubleArray::New();
-    rotation->SetName("Rotation");
+    ws.Rotation = vtkSmartPointer<vtkDoubleArray>::New();
+    ws.Rotation->SetName("Rotation");
 
-    angularVel = vtkDoubleArray::New();
-    angularVel->SetName("AngularVelocity");
+    ws.AngularVelocity = vtkSmartPointer<vtkDoubleArray>::New();
+    ws.AngularVelocity->SetName("AngularVelocity");
   }
 
   // We will interpolate all point attributes of the input on each point of
@@ -765,391 +812,669 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
   //       as a consequence a large number of such small vtkPolyData objects
   //       are needed to represent a streamline, consuming up the memory before
   //       the intermediate memory is timely released.
+  ws.PointData = outputPD;
   outputPD->InterpolateAllocate(input0Data, this->MaximumNumberOfSteps);
+}
 
-  vtkIdType numPtsTotal = 0;
-  double velocity[3];
+//------------------------------------------------------------------------------
+bool vtkStreamTracer::IntegrateLine(IntegrationWorkspace& ws, double seed[3], int direction,
+  vtkIdType currentLine, vtkIdType numLines, double& propagation, vtkIdType& numSteps,
+  double& integrationTime, Streamline& line)
+{
+  // Useful pointers
+  vtkAbstractInterpolatedVelocityField* func = ws.Func;
+  vtkInitialValueProblemSolver* integrator = ws.Integrator;
+  vtkInterpolatedVelocityField* surfaceFunc = ws.SurfaceFunc;
+  vtkGenericCell* cell = ws.Cell;
+  double* weights = ws.Weights.empty() ? nullptr : ws.Weights.data();
+  vtkPoints* outputPoints = ws.Points;
+  vtkDataSetAttributes* outputPD = ws.PointData;
+  vtkDoubleArray* time = ws.Time;
+  vtkDoubleArray* velocityVectors = ws.VelocityVectors;
+  vtkDoubleArray* cellVectors = ws.CellVectors;
+  vtkDoubleArray* vorticity = ws.Vorticity;
+  vtkDoubleArray* rotation = ws.Rotation;
+  vtkDoubleArray* angularVel = ws.AngularVelocity;
+  const int vecType = ws.VecType;
+  const char* vecName = ws.VecName;
+  vtkPointData* inputPD;
+  vtkDataSet* input;
+  vtkDataArray* inVectors;
+
+  // temporary variables used in the integration
+  double point1[3], point2[3], pcoords[3], vort[3], omega, velocity[3];
+  vtkIdType index, numPts = 0;
 
-  int shouldAbort = 0;
+  // Clear the last cell to avoid starting a search from
+  // the last point in the streamline
+  func->ClearLastCellId();
 
-  for (int currentLine = 0; currentLine < numLines; currentLine++)
+  // Initial point
+  memcpy(point1, seed, 3 * sizeof(double));
+  memcpy(point2, point1, 3 * sizeof(double));
+  if (!func->FunctionValues(point1, velocity))
   {
-    double progress = static_cast<double>(currentLine) / numLines;
-    this->UpdateProgress(progress);
+    return false;
+  }
 
-    switch (integrationDirections->GetValue(currentLine))
-    {
-      case FORWARD:
-        direction = 1;
-        break;
-      case BACKWARD:
-        direction = -1;
-        break;
-    }
+  if (propagation >= this->MaximumPropagation || numSteps > this->MaximumNumberOfSteps)
+  {
+    return false;
+  }
 
-    // temporary variables used in the integration
-    double point1[3], point2[3], pcoords[3], vort[3], omega;
-    vtkIdType index, numPts = 0;
+  numPts++;
+  vtkIdType nextPoint = outputPoints->InsertNextPoint(point1);
+  double lastInsertedPoint[3];
+  outputPoints->GetPoint(nextPoint, lastInsertedPoint);
+  time->InsertNextValue(integrationTime);
+
+  // We will always pass an arc-length step size to the integrator.
+  // If the user specifies a step size in cell length unit, we will
+  // have to convert it to arc length.
+  IntervalInformation stepSize; // either positive or negative
+  stepSize.Unit = LENGTH_UNIT;
+  stepSize.Interval = 0;
+  IntervalInformation aStep; // always positive
+  aStep.Unit = LENGTH_UNIT;
+  double step, minStep = 0, maxStep = 0;
+  double stepTaken;
+  double speed;
+  double cellLength;
+  int retVal = OUT_OF_LENGTH, tmp;
+
+  // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
+  input = func->GetLastDataSet();
+  inputPD = input->GetPointData();
+  inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
+  // Convert intervals to arc-length unit
+  input->GetCell(func->GetLastCellId(), cell);
+  cellLength = sqrt(static_cast<double>(cell->GetLength2()));
+  speed = vtkMath::Norm(velocity);
+  // Never call conversion methods if speed == 0
+  if (speed != 0.0)
+  {
+    this->ConvertIntervals(stepSize.Interval, minStep, maxStep, direction, cellLength);
+  }
 
-    // Clear the last cell to avoid starting a search from
-    // the last point in the streamline
-    func->ClearLastCellId();
+  // Interpolate all point attributes on first point
+  func->GetLastWeights(weights);
+  InterpolatePoint(
+    outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
+  // handle both point and cell velocity attributes.
+  vtkDataArray* outputVelocityVectors = outputPD->GetArray(vecName);
+  if (vecType != vtkDataObject::POINT)
+  {
+    velocityVectors->InsertNextTuple(velocity);
+    outputVelocityVectors = velocityVectors;
+  }
 
-    // Initial point
-    seedSource->GetTuple(seedIds->GetId(currentLine), point1);
-    memcpy(point2, point1, 3 * sizeof(double));
-    if (!func->FunctionValues(point1, velocity))
+  // Compute vorticity if required
+  // This can be used later for streamribbon generation.
+  if (this->ComputeVorticity)
+  {
+    if (vecType == vtkDataObject::POINT)
     {
-      continue;
+      inVectors->GetTuples(cell->PointIds, cellVectors);
+      func->GetLastLocalCoordinates(pcoords);
+      vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
     }
-
-    if (propagation >= this->MaximumPropagation || numSteps > this->MaximumNumberOfSteps)
+    else
     {
-      continue;
+      vort[0] = 0;
+      vort[1] = 0;
+      vort[2] = 0;
     }
-
-    numPts++;
-    numPtsTotal++;
-    vtkIdType nextPoint = outputPoints->InsertNextPoint(point1);
-    double lastInsertedPoint[3];
-    outputPoints->GetPoint(nextPoint, lastInsertedPoint);
-    time->InsertNextValue(integrationTime);
-
-    // We will always pass an arc-length step size to the integrator.
-    // If the user specifies a step size in cell length unit, we will
-    // have to convert it to arc length.
-    IntervalInformation stepSize; // either positive or negative
-    stepSize.Unit = LENGTH_UNIT;
-    stepSize.Interval = 0;
-    IntervalInformation aStep; // always positive
-    aStep.Unit = LENGTH_UNIT;
-    double step, minStep = 0, maxStep = 0;
-    double stepTaken;
-    double speed;
-    double cellLength;
-    int retVal = OUT_OF_LENGTH, tmp;
-
-    // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
-    input = func->GetLastDataSet();
-    inputPD = input->GetPointData();
-    inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
-    // Convert intervals to arc-length unit
-    input->GetCell(func->GetLastCellId(), cell);
-    cellLength = sqrt(static_cast<double>(cell->GetLength2()));
-    speed = vtkMath::Norm(velocity);
-    // Never call conversion methods if speed == 0
+    vorticity->InsertNextTuple(vort);
+    // rotation
+    // local rotation = vorticity . unit tangent ( i.e. velocity/speed )
     if (speed != 0.0)
     {
-      this->ConvertIntervals(stepSize.Interval, minStep, maxStep, direction, cellLength);
+      omega = vtkMath::Dot(vort, velocity);
+      omega /= speed;
+      omega *= this->RotationScale;
+    }
+    else
+    {
+      omega = 0.0;
     }
+    angularVel->InsertNextValue(omega);
+    rotation->InsertNextValue(0.0);
+  }
 
-    // Interpolate all point attributes on first point
-    func->GetLastWeights(weights);
-    InterpolatePoint(
-      outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
-    // handle both point and cell velocity attributes.
-    vtkDataArray* outputVelocityVectors = outputPD->GetArray(vecName);
-    if (vecType != vtkDataObject::POINT)
+  double error = 0;
+
+  // Integrate until the maximum propagation length is reached,
+  // maximum number of steps is reached or until a boundary is encountered.
+  // Begin Integration
+  while (propagation < this->MaximumPropagation)
+  {
+
+    if (numSteps > this->MaximumNumberOfSteps)
     {
-      velocityVectors->InsertNextTuple(velocity);
-      outputVelocityVectors = velocityVectors;
+      retVal = OUT_OF_STEPS;
+      break;
     }
 
-    // Compute vorticity if required
-    // This can be used later for streamribbon generation.
-    if (this->ComputeVorticity)
+    bool endIntegration = false;
+    for (std::size_t i = 0; i < this->CustomTerminationCallback.size(); ++i)
     {
-      if (vecType == vtkDataObject::POINT)
+      if (this->CustomTerminationCallback[i](
+            this->CustomTerminationClientData[i], outputPoints, outputVelocityVectors, direction))
       {
-        inVectors->GetTuples(cell->PointIds, cellVectors);
-        func->GetLastLocalCoordinates(pcoords);
-        vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
+        retVal = this->CustomReasonForTermination[i];
+        endIntegration = true;
+        break;
       }
-      else
+    }
+    if (endIntegration)
+    {
+      break;
+    }
+
+    if (numSteps++ % 1000 == 1 && ws.ReportProgress)
+    {
+      double progress = (currentLine + propagation / this->MaximumPropagation) / numLines;
+      this->UpdateProgress(progress);
+
+      if (this->GetAbortExecute())
       {
-        vort[0] = 0;
-        vort[1] = 0;
-        vort[2] = 0;
+        ws.Aborted = true;
+        break;
       }
-      vorticity->InsertNextTuple(vort);
-      // rotation
-      // local rotation = vorticity . unit tangent ( i.e. velocity/speed )
-      if (speed != 0.0)
+    }
+
+    // Never call conversion methods if speed == 0
+    if ((speed == 0) || (speed <= this->TerminalSpeed))
+    {
+      retVal = STAGNATION;
+      break;
+    }
+
+    // If, with the next step, propagation will be larger than
+    // max, reduce it so that it is (approximately) equal to max.
+    aStep.Interval = fabs(stepSize.Interval);
+
+    if ((propagation + aStep.Interval) > this->MaximumPropagation)
+    {
+      aStep.Interval = this->MaximumPropagation - propagation;
+      if (stepSize.Interval >= 0)
       {
-        omega = vtkMath::Dot(vort, velocity);
-        omega /= speed;
-        omega *= this->RotationScale;
+        stepSize.Interval = this->ConvertToLength(aStep, cellLength);
       }
       else
       {
-        omega = 0.0;
+        stepSize.Interval = this->ConvertToLength(aStep, cellLength) * (-1.0);
       }
-      angularVel->InsertNextValue(omega);
-      rotation->InsertNextValue(0.0);
+      maxStep = stepSize.Interval;
     }
+    line.StepSize = stepSize.Interval;
+    line.HasStepSize = true;
 
-    double error = 0;
-
-    // Integrate until the maximum propagation length is reached,
-    // maximum number of steps is reached or until a boundary is encountered.
-    // Begin Integration
-    while (propagation < this->MaximumPropagation)
+    // Calculate the next step using the integrator provided
+    // Break if the next point is out of bounds.
+    func->SetNormalizeVector(true);
+    tmp = integrator->ComputeNextStep(
+      point1, point2, 0, stepSize.Interval, stepTaken, minStep, maxStep, this->MaximumError, error);
+    func->SetNormalizeVector(false);
+    if (tmp != 0)
     {
+      retVal = tmp;
+      memcpy(line.LastPoint, point2, 3 * sizeof(double));
+      line.HasLastPoint = true;
+      break;
+    }
 
-      if (numSteps > this->MaximumNumberOfSteps)
+    // This is the next starting point
+    if (this->SurfaceStreamlines && surfaceFunc != nullptr)
+    {
+      if (surfaceFunc->SnapPointOnCell(point2, point1) != 1)
       {
-        retVal = OUT_OF_STEPS;
+        retVal = OUT_OF_DOMAIN;
+        memcpy(line.LastPoint, point2, 3 * sizeof(double));
+        line.HasLastPoint = true;
         break;
       }
-
-      bool endIntegration = false;
-      for (std::size_t i = 0; i < this->CustomTerminationCallback.size(); ++i)
-      {
-        if (this->CustomTerminationCallback[i](
-              this->CustomTerminationClientData[i], outputPoints, outputVelocityVectors, direction))
-        {
-          retVal = this->CustomReasonForTermination[i];
-          endIntegration = true;
-          break;
-        }
-      }
-      if (endIntegration)
+    }
+    else
+    {
+      for (int i = 0; i < 3; i++)
       {
-        break;
+        point1[i] = point2[i];
       }
+    }
 
-      if (numSteps++ % 1000 == 1)
-      {
-        progress = (currentLine + propagation / this->MaximumPropagation) / numLines;
-        this->UpdateProgress(progress);
+    // Interpolate the velocity at the next point
+    if (!func->FunctionValues(point2, velocity))
+    {
+      retVal = OUT_OF_DOMAIN;
+      memcpy(line.LastPoint, point2, 3 * sizeof(double));
+      line.HasLastPoint = true;
+      break;
+    }
 
-        if (this->GetAbortExecute())
-        {
-          shouldAbort = 1;
-          break;
-        }
-      }
+    // It is not enough to use the starting point for stagnation calculation
+    // Use average speed to check if it is below stagnation threshold
+    double speed2 = vtkMath::Norm(velocity);
+    if ((speed + speed2) / 2 <= this->TerminalSpeed)
+    {
+      retVal = STAGNATION;
+      break;
+    }
 
-      // Never call conversion methods if speed == 0
-      if ((speed == 0) || (speed <= this->TerminalSpeed))
-      {
-        retVal = STAGNATION;
-        break;
-      }
+    integrationTime += stepTaken / speed;
+    // Calculate propagation (using the same units as MaximumPropagation
+    propagation += fabs(stepSize.Interval);
 
-      // If, with the next step, propagation will be larger than
-      // max, reduce it so that it is (approximately) equal to max.
-      aStep.Interval = fabs(stepSize.Interval);
+    // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
+    input = func->GetLastDataSet();
+    inputPD = input->GetPointData();
+    inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
 
-      if ((propagation + aStep.Interval) > this->MaximumPropagation)
-      {
-        aStep.Interval = this->MaximumPropagation - propagation;
-        if (stepSize.Interval >= 0)
-        {
-          stepSize.Interval = this->ConvertToLength(aStep, cellLength);
-        }
-        else
-        {
-          stepSize.Interval = this->ConvertToLength(aStep, cellLength) * (-1.0);
-        }
-        maxStep = stepSize.Interval;
-      }
-      this->LastUsedStepSize = stepSize.Interval;
-
-      // Calculate the next step using the integrator provided
-      // Break if the next point is out of bounds.
-      func->SetNormalizeVector(true);
-      tmp = integrator->ComputeNextStep(point1, point2, 0, stepSize.Interval, stepTaken, minStep,
-        maxStep, this->MaximumError, error);
-      func->SetNormalizeVector(false);
-      if (tmp != 0)
+    // Calculate cell length and speed to be used in unit conversions
+    input->GetCell(func->GetLastCellId(), cell);
+    cellLength = sqrt(static_cast<double>(cell->GetLength2()));
+    speed = speed2;
+
+    // Check if conversion to float will produce a point in same place
+    float convertedPoint[3];
+    for (int i = 0; i < 3; i++)
+    {
+      convertedPoint[i] = point1[i];
+    }
+    if (lastInsertedPoint[0] != convertedPoint[0] || lastInsertedPoint[1] != convertedPoint[1] ||
+      lastInsertedPoint[2] != convertedPoint[2])
+    {
+      // Point is valid. Insert it.
+      numPts++;
+      nextPoint = outputPoints->InsertNextPoint(point1);
+      outputPoints->GetPoint(nextPoint, lastInsertedPoint);
+      time->InsertNextValue(integrationTime);
+
+      // Interpolate all point attributes on current point
+      func->GetLastWeights(weights);
+      InterpolatePoint(
+        outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
+
+      if (vecType != vtkDataObject::POINT)
       {
-        retVal = tmp;
-        memcpy(lastPoint, point2, 3 * sizeof(double));
-        break;
+        velocityVectors->InsertNextTuple(velocity);
       }
-
-      // This is the next starting point
-      if (this->SurfaceStreamlines && surfaceFunc != nullptr)
+      // Compute vorticity if required
+      // This can be used later for streamribbon generation.
+      if (this->ComputeVorticity)
       {
-        if (surfaceFunc->SnapPointOnCell(point2, point1) != 1)
+        if (vecType == vtkDataObject::POINT)
         {
-          retVal = OUT_OF_DOMAIN;
-          memcpy(lastPoint, point2, 3 * sizeof(double));
-          break;
+          inVectors->GetTuples(cell->PointIds, cellVectors);
+          func->GetLastLocalCoordinates(pcoords);
+          vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
         }
-      }
-      else
-      {
-        for (int i = 0; i < 3; i++)
+        else
         {
-          point1[i] = point2[i];
+          vort[0] = 0;
+          vort[1] = 0;
+          vort[2] = 0;
         }
+        vorticity->InsertNextTuple(vort);
+        // rotation
+        // angular velocity = vorticity . unit tangent ( i.e. velocity/speed )
+        // rotation = sum ( angular velocity * stepSize )
+        omega = vtkMath::Dot(vort, velocity);
+        omega /= speed;
+        omega *= this->RotationScale;
+        index = angularVel->InsertNextValue(omega);
+        rotation->InsertNextValue(rotation->GetValue(index - 1) +
+          (angularVel->GetValue(index - 1) + omega) / 2 *
+            (integrationTime - time->GetValue(index - 1)));
       }
+    }
+
+    // Never call conversion methods if speed == 0
+    if ((speed == 0) || (speed <= this->TerminalSpeed))
+    {
+      retVal = STAGNATION;
+      break;
+    }
+
+    // Convert all intervals to arc length
+    this->ConvertIntervals(step, minStep, maxStep, direction, cellLength);
 
-      // Interpolate the velocity at the next point
-      if (!func->FunctionValues(point2, velocity))
+    // If the solver is adaptive and the next step size (stepSize.Interval)
+    // that the solver wants to use is smaller than minStep or larger
+    // than maxStep, re-adjust it. This has to be done every step
+    // because minStep and maxStep can change depending on the cell
+    // size (unless it is specified in arc-length unit)
+    if (integrator->IsAdaptive())
+    {
+      if (fabs(stepSize.Interval) < fabs(minStep))
       {
-        retVal = OUT_OF_DOMAIN;
-        memcpy(lastPoint, point2, 3 * sizeof(double));
-        break;
+        stepSize.Interval = fabs(minStep) * stepSize.Interval / fabs(stepSize.Interval);
       }
-
-      // It is not enough to use the starting point for stagnation calculation
-      // Use average speed to check if it is below stagnation threshold
-      double speed2 = vtkMath::Norm(velocity);
-      if ((speed + speed2) / 2 <= this->TerminalSpeed)
+      else if (fabs(stepSize.Interval) > fabs(maxStep))
       {
-        retVal = STAGNATION;
-        break;
+        stepSize.Interval = fabs(maxStep) * stepSize.Interval / fabs(stepSize.Interval);
       }
+    }
+    else
+    {
+      stepSize.Interval = step;
+    }
+  }
 
-      integrationTime += stepTaken / speed;
-      // Calculate propagation (using the same units as MaximumPropagation
-      propagation += fabs(stepSize.Interval);
-
-      // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
-      input = func->GetLastDataSet();
-      inputPD = input->GetPointData();
-      inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
+  line.NumberOfPoints = numPts;
+  line.ReasonForTermination = retVal;
+  return true;
+}
 
-      // Calculate cell length and speed to be used in unit conversions
-      input->GetCell(func->GetLastCellId(), cell);
-      cellLength = sqrt(static_cast<double>(cell->GetLength2()));
-      speed = speed2;
+//------------------------------------------------------------------------------
+void vtkStreamTracer::IntegrateInParallel(IntegrationWorkspace& ws, vtkCellArray* outputLines,
+  vtkIntArray* retVals, vtkIntArray* sids, vtkPointData* input0Data, vtkDataArray* seedSource,
+  vtkIdList* seedIds, vtkIntArray* integrationDirections, double lastPoint[3], int maxCellSize,
+  int vecType, const char* vecName, double& inPropagation, vtkIdType& inNumSteps,
+  double& inIntegrationTime)
+{
+  vtkIdType numLines = seedIds->GetNumberOfIds();
+  vtkCompositeInterpolatedVelocityField* func =
+    vtkCompositeInterpolatedVelocityField::SafeDownCast(ws.Func);
+  for (int i = 0; i < func->GetNumberOfDataSets(); ++i)
+  {
+    PrepareForConcurrentProbing(func->GetDataSet(i), func->GetFindCellStrategy());
+  }
 
-      // Check if conversion to float will produce a point in same place
-      float convertedPoint[3];
-      for (int i = 0; i < 3; i++)
-      {
-        convertedPoint[i] = point1[i];
-      }
-      if (lastInsertedPoint[0] != convertedPoint[0] || lastInsertedPoint[1] != convertedPoint[1] ||
-        lastInsertedPoint[2] != convertedPoint[2])
+  // Where the points of each streamline are in the workspace of the thread
+  // that integrated it, and the state it ended in.
+  struct SeedResult
+  {
+    IntegrationWorkspace* Workspace = nullptr;
+    vtkIdType FirstPoint = 0;
+    Streamline Line;
+    double Propagation = 0.0;
+    vtkIdType NumSteps = 0;
+    double IntegrationTime = 0.0;
+  };
+  std::vector<SeedResult> results(numLines);
+
+  vtkSMPThreadLocal<std::shared_ptr<IntegrationWorkspace>> workspaces;
+  auto integrateSeeds = [&](vtkIdType begin, vtkIdType end) {
+    std::shared_ptr<IntegrationWorkspace>& local = workspaces.Local();
+    if (!local)
+    {
+      vtkSmartPointer<vtkAbstractInterpolatedVelocityField> localFunc;
+      localFunc.TakeReference(func->NewInstance());
+      localFunc->CopyParameters(func);
+      vtkCompositeInterpolatedVelocityField* localComposite =
+        vtkCompositeInterpolatedVelocityField::SafeDownCast(localFunc);
+      for (int i = 0; i < func->GetNumberOfDataSets(); ++i)
       {
-        // Point is valid. Insert it.
-        numPts++;
-        numPtsTotal++;
-        nextPoint = outputPoints->InsertNextPoint(point1);
-        outputPoints->GetPoint(nextPoint, lastInsertedPoint);
-        time->InsertNextValue(integrationTime);
-
-        // Interpolate all point attributes on current point
-        func->GetLastWeights(weights);
-        InterpolatePoint(
-          outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
-
-        if (vecType != vtkDataObject::POINT)
-        {
-          velocityVectors->InsertNextTuple(velocity);
-        }
-        // Compute vorticity if required
-        // This can be used later for streamribbon generation.
-        if (this->ComputeVorticity)
-        {
-          if (vecType == vtkDataObject::POINT)
-          {
-            inVectors->GetTuples(cell->PointIds, cellVectors);
-            func->GetLastLocalCoordinates(pcoords);
-            vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
-          }
-          else
-          {
-            vort[0] = 0;
-            vort[1] = 0;
-            vort[2] = 0;
-          }
-          vorticity->InsertNextTuple(vort);
-          // rotation
-          // angular velocity = vorticity . unit tangent ( i.e. velocity/speed )
-          // rotation = sum ( angular velocity * stepSize )
-          omega = vtkMath::Dot(vort, velocity);
-          omega /= speed;
-          omega *= this->RotationScale;
-          index = angularVel->InsertNextValue(omega);
-          rotation->InsertNextValue(rotation->GetValue(index - 1) +
-            (angularVel->GetValue(index - 1) + omega) / 2 *
-              (integrationTime - time->GetValue(index - 1)));
-        }
+        localComposite->AddDataSet(func->GetDataSet(i));
       }
+      localFunc->SelectVectors(func->GetVectorsType(), func->GetVectorsSelection());
+      localFunc->SetForceSurfaceTangentVector(func->GetForceSurfaceTangentVector());
+      localFunc->SetSurfaceDataset(func->GetSurfaceDataset());
+
+      local = std::make_shared<IntegrationWorkspace>();
+      vtkNew<vtkPointData> localPD;
+      this->InitializeWorkspace(
+        *local, localFunc, localPD, input0Data, maxCellSize, vecType, vecName);
+    }
 
-      // Never call conversion methods if speed == 0
-      if ((speed == 0) || (speed <= this->TerminalSpeed))
+    for (vtkIdType currentLine = begin; currentLine < end; ++currentLine)
+    {
+      int direction = integrationDirections->GetValue(currentLine) == BACKWARD ? -1 : 1;
+      double seed[3];
+      seedSource->GetTuple(seedIds->GetId(currentLine), seed);
+
+      // Start each search from the first dataset, so that the streamline
+      // does not depend on the seeds integrated before by this thread.
+      local->Func->SetLastCellId(-1, 0);
+
+      SeedResult& result = results[currentLine];
+      result.FirstPoint = local->Points->GetNumberOfPoints();
+      if (this->IntegrateLine(*local, seed, direction, currentLine, numLines, result.Propagation,
+            result.NumSteps, result.IntegrationTime, result.Line))
       {
-        retVal = STAGNATION;
-        break;
+        result.Workspace = local.get();
       }
+    }
+  };
 
-      // Convert all intervals to arc length
-      this->ConvertIntervals(step, minStep, maxStep, direction, cellLength);
+  // Integrate the seeds by batches so that progress can be reported.
+  const vtkIdType batchSize = std::max<vtkIdType>(numLines / 10, 1);
+  for (vtkIdType begin = 0; begin < numLines; begin += batchSize)
+  {
+    this->UpdateProgress(static_cast<double>(begin) / numLines);
+    if (this->GetAbortExecute())
+    {
+      ws.Aborted = true;
+      return;
+    }
+    vtkSMPTools::For(begin, std::min(begin + batchSize, numLines), integrateSeeds);
+  }
 
-      // If the solver is adaptive and the next step size (stepSize.Interval)
-      // that the solver wants to use is smaller than minStep or larger
-      // than maxStep, re-adjust it. This has to be done every step
-      // because minStep and maxStep can change depending on the cell
-      // size (unless it is specified in arc-length unit)
-      if (integrator->IsAdaptive())
+  // An array is removed from the point data of a workspace when a point is
+  // interpolated from a dataset that does not have it. Remove it from the
+  // output too, as the sequential integration would have done.
+  vtkDataSetAttributes* outputPD = ws.PointData;
+  if (!this->HasMatchingPointAttributes)
+  {
+    for (auto& local : workspaces)
+    {
+      for (int i = outputPD->GetNumberOfArrays() - 1; i >= 0; i--)
       {
-        if (fabs(stepSize.Interval) < fabs(minStep))
+        const char* name = outputPD->GetAbstractArray(i)->GetName();
+        if (!local->PointData->GetAbstractArray(name))
         {
-          stepSize.Interval = fabs(minStep) * stepSize.Interval / fabs(stepSize.Interval);
-        }
-        else if (fabs(stepSize.Interval) > fabs(maxStep))
-        {
-          stepSize.Interval = fabs(maxStep) * stepSize.Interval / fabs(stepSize.Interval);
+          outputPD->RemoveArray(name);
         }
       }
-      else
-      {
-        stepSize.Interval = step;
-      }
     }
+  }
+  for (auto& local : workspaces)
+  {
+    local->SourceArrays.clear();
+    for (int i = 0; i < outputPD->GetNumberOfArrays(); i++)
+    {
+      local->SourceArrays.push_back(this->HasMatchingPointAttributes
+          ? local->PointData->GetAbstractArray(i)
+          : local->PointData->GetAbstractArray(outputPD->GetAbstractArray(i)->GetName()));
+    }
+  }
 
-    if (shouldAbort)
+  // Append the streamlines to the output in the order of the seeds.
+  for (vtkIdType currentLine = 0; currentLine < numLines; ++currentLine)
+  {
+    const SeedResult& result = results[currentLine];
+    IntegrationWorkspace* local = result.Workspace;
+    if (!local)
     {
-      break;
+      continue;
+    }
+
+    const Streamline& line = result.Line;
+    const vtkIdType firstPoint = ws.Points->GetNumberOfPoints();
+    const vtkIdType numPts = line.NumberOfPoints;
+    ws.Points->InsertPoints(firstPoint, numPts, result.FirstPoint, local->Points);
+    for (int i = 0; i < outputPD->GetNumberOfArrays(); i++)
+    {
+      outputPD->GetAbstractArray(i)->InsertTuples(
+        firstPoint, numPts, result.FirstPoint, local->SourceArrays[i]);
+    }
+    ws.Time->InsertTuples(firstPoint, numPts, result.FirstPoint, local->Time);
+    if (ws.VelocityVectors)
+    {
+      ws.VelocityVectors->InsertTuples(firstPoint, numPts, result.FirstPoint, local->VelocityVectors);
+    }
+    if (ws.Vorticity)
+    {
+      ws.Vorticity->InsertTuples(firstPoint, numPts, result.FirstPoint, local->Vorticity);
+      ws.Rotation->InsertTuples(firstPoint, numPts, result.FirstPoint, local->Rotation);
+      ws.AngularVelocity->InsertTuples(firstPoint, numPts, result.FirstPoint, local->AngularVelocity);
     }
 
     if (numPts > 1)
     {
       outputLines->InsertNextCell(numPts);
-      for (int i = numPtsTotal - numPts; i < numPtsTotal; i++)
+      for (vtkIdType i = firstPoint; i < firstPoint + numPts; i++)
       {
         outputLines->InsertCellPoint(i);
       }
-      retVals->InsertNextValue(retVal);
+      retVals->InsertNextValue(line.ReasonForTermination);
       sids->InsertNextValue(seedIds->GetId(currentLine));
     }
 
-    // Initialize these to 0 before starting the next line.
-    // The values passed in the function call are only used
-    // for the first line.
-    inPropagation = propagation;
-    inNumSteps = numSteps;
-    inIntegrationTime = integrationTime;
+    if (line.HasLastPoint)
+    {
+      memcpy(lastPoint, line.LastPoint, 3 * sizeof(double));
+    }
+    if (line.HasStepSize)
+    {
+      this->LastUsedStepSize = line.StepSize;
+    }
+    inPropagation = result.Propagation;
+    inNumSteps = result.NumSteps;
+    inIntegrationTime = result.IntegrationTime;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
+  vtkDataArray* seedSource, vtkIdList* seedIds, vtkIntArray* integrationDirections,
+  double lastPoint[3], vtkAbstractInterpolatedVelocityField* func, int maxCellSize, int vecType,
+  const char* vecName, double& inPropagation, vtkIdType& inNumSteps, double& inIntegrationTime)
+{
+  vtkIdType numLines = seedIds->GetNumberOfIds();
+  double propagation = inPropagation;
+  vtkIdType numSteps = inNumSteps;
+  double integrationTime = inIntegrationTime;
+
+  // Useful pointers
+  vtkDataSetAttributes* outputPD = output->GetPointData();
+  vtkDataSetAttributes* outputCD = output->GetCellData();
+
+  int direction = 1;
+
+  if (this->GetIntegrator() == nullptr)
+  {
+    vtkErrorMacro("No integrator is specified.");
+    return;
+  }
+
+  IntegrationWorkspace ws;
+  this->InitializeWorkspace(ws, func, outputPD, input0Data, maxCellSize, vecType, vecName);
+  ws.ReportProgress = true;
+
+  vtkNew<vtkCellArray> outputLines;
+
+  // This array explains why the integration stopped
+  vtkNew<vtkIntArray> retVals;
+  retVals->SetName("ReasonForTermination");
+
+  vtkNew<vtkIntArray> sids;
+  sids->SetName("SeedIds");
+
+  // The seeds can be integrated concurrently when each thread can get its
+  // own copy of the velocity field, and when the streamlines do not depend
+  // on each other (i.e. no propagation is carried over to the first one).
+  if (numLines > 1 && vtkSMPTools::GetEstimatedNumberOfThreads() > 1 &&
+    vtkCompositeInterpolatedVelocityField::SafeDownCast(func) &&
+    this->CustomTerminationCallback.empty() && propagation == 0.0 && numSteps == 0 &&
+    integrationTime == 0.0)
+  {
+    this->IntegrateInParallel(ws, outputLines, retVals, sids, input0Data, seedSource, seedIds,
+      integrationDirections, lastPoint, maxCellSize, vecType, vecName, inPropagation, inNumSteps,
+      inIntegrationTime);
+  }
+  else
+  {
+    vtkCompositeInterpolatedVelocityField* compositeFunc =
+      vtkCompositeInterpolatedVelocityField::SafeDownCast(func);
+    for (vtkIdType currentLine = 0; currentLine < numLines; currentLine++)
+    {
+      double progress = static_cast<double>(currentLine) / numLines;
+      this->UpdateProgress(progress);
+
+      switch (integrationDirections->GetValue(currentLine))
+      {
+        case FORWARD:
+          direction = 1;
+          break;
+        case BACKWARD:
+          direction = -1;
+          break;
+      }
+
+      double seed[3];
+      seedSource->GetTuple(seedIds->GetId(currentLine), seed);
+
+      // Start each search from the first dataset, as the parallel path does,
+      // so that the streamlines do not depend on the number of threads.
+      if (compositeFunc)
+      {
+        compositeFunc->SetLastCellId(-1, 0);
+      }
+
+      vtkIdType firstPoint = ws.Points->GetNumberOfPoints();
+      Streamline line;
+      if (!this->IntegrateLine(ws, seed, direction, currentLine, numLines, propagation, numSteps,
+            integrationTime, line))
+      {
+        continue;
+      }
+      if (line.HasLastPoint)
+      {
+        memcpy(lastPoint, line.LastPoint, 3 * sizeof(double));
+      }
+      if (line.HasStepSize)
+      {
+        this->LastUsedStepSize = line.StepSize;
+      }
+
+      if (ws.Aborted)
+      {
+        break;
+      }
 
-    propagation = 0;
-    numSteps = 0;
-    integrationTime = 0;
+      if (line.NumberOfPoints > 1)
+      {
+        outputLines->InsertNextCell(line.NumberOfPoints);
+        for (vtkIdType i = firstPoint; i < firstPoint + line.NumberOfPoints; i++)
+        {
+          outputLines->InsertCellPoint(i);
+        }
+        retVals->InsertNextValue(line.ReasonForTermination);
+        sids->InsertNextValue(seedIds->GetId(currentLine));
+      }
+
+      // Initialize these to 0 before starting the next line.
+      // The values passed in the function call are only used
+      // for the first line.
+      inPropagation = propagation;
+      inNumSteps = numSteps;
+      inIntegrationTime = integrationTime;
+
+      propagation = 0;
+      numSteps = 0;
+      integrationTime = 0;
+    }
   }
 
-  if (!shouldAbort)
+  if (!ws.Aborted)
   {
     // Create the output polyline
-    output->SetPoints(outputPoints);
-    outputPD->AddArray(time);
+    output->SetPoints(ws.Points);
+    outputPD->AddArray(ws.Time);
     if (vecType != vtkDataObject::POINT)
     {
-      outputPD->AddArray(velocityVectors);
+      outputPD->AddArray(ws.VelocityVectors);
     }
-    if (vorticity)
+    if (ws.Vorticity)
     {
-      outputPD->AddArray(vorticity);
-      outputPD->AddArray(rotation);
-      outputPD->AddArray(angularVel);
+      outputPD->AddArray(ws.Vorticity);
+      outputPD->AddArray(ws.Rotation);
+      outputPD->AddArray(ws.AngularVelocity);
     }
 
-    vtkIdType numPts = outputPoints->GetNumberOfPoints();
+    vtkIdType numPts = ws.Points->GetNumberOfPoints();
     if (numPts > 1)
     {
       // Assign geometry and attributes
@@ -1164,30 +1489,6 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
     }
   }
 
-  if (vorticity)
-  {
-    vorticity->Delete();
-    rotation->Delete();
-    angularVel->Delete();
-  }
-
-  if (cellVectors)
-  {
-    cellVectors->Delete();
-  }
-  retVals->Delete();
-  sids->Delete();
-
-  outputPoints->Delete();
-  outputLines->Delete();
-
-  time->Delete();
-
-  integrator->Delete();
-  cell->Delete();
-
-  delete[] weights;
-
   output->Squeeze();
 }
 
@@ -69,6 +69,14 @@
  * a source object, traces will be generated from each point in the source
  * that is inside the dataset.
  *
+ * The seeds are integrated in parallel with vtkSMPTools, each thread using
+ * its own copy of the velocity field and of the integrator. The streamlines
+ * are appended to the output in the order of the seeds, and the search for
+ * the cell of each seed starts from the first dataset, so the output does
+ * not depend on the number of threads, even when the blocks of a composite
+ * input overlap. Seeds are integrated sequentially for AMR inputs, and when
+ * custom termination callbacks are set since these may not be thread safe.
+ *
  * @note Field data is shallow copied to the output. When the input is a
  * composite data set, field data associated with the root block is shallow-
  * copied to the output vtkPolyData.
@@ -92,6 +100,7 @@
 #include "vtkInitialValueProblemSolver.h" // Needed for constants
 
 class vtkAbstractInterpolatedVelocityField;
+class vtkCellArray;
 class vtkCompositeDataSet;
 class vtkDataArray;
 class vtkDataSetAttributes;
@@ -464,6 +473,31 @@ protected:
   friend class PStreamTracerUtils;
 
 private:
+  struct IntegrationWorkspace;
+  struct Streamline;
+
+  // Sets up ws to integrate streamlines with func, interpolating the point
+  // data of input0Data in outputPD.
+  void InitializeWorkspace(IntegrationWorkspace& ws, vtkAbstractInterpolatedVelocityField* func,
+    vtkDataSetAttributes* outputPD, vtkPointData* input0Data, int maxCellSize, int vecType,
+    const char* vecName);
+
+  // Integrates the streamline starting at seed, appending its points to the
+  // buffers of ws. Returns false if the seed is outside of the domain or
+  // the propagation limits are already reached, in which case nothing is
+  // appended.
+  bool IntegrateLine(IntegrationWorkspace& ws, double seed[3], int direction,
+    vtkIdType currentLine, vtkIdType numLines, double& propagation, vtkIdType& numSteps,
+    double& integrationTime, Streamline& line);
+
+  // Integrates the seeds concurrently, one workspace per thread, and appends
+  // the streamlines to ws in the order of the seeds.
+  void IntegrateInParallel(IntegrationWorkspace& ws, vtkCellArray* outputLines,
+    vtkIntArray* retVals, vtkIntArray* sids, vtkPointData* input0Data, vtkDataArray* seedSource,
+    vtkIdList* seedIds, vtkIntArray* integrationDirections, double lastPoint[3], int maxCellSize,
+    int vecType, const char* vecName, double& propagation, vtkIdType& numSteps,
+    double& integrationTime);
+
   vtkStreamTracer(const vtkStreamTracer&) = delete;
   void operator=(const vtkStreamTracer&) = delete;
 };
@@ -0,0 +1,213 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGradientFilterSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkGradientFilter gives the same gradients, vorticity,
+// divergence and Q-criterion on unstructured grids and polydata with every
+// vtkSMPTools backend, and that they are exact for a linear field.
+
+#include <vtkAppendFilter.h>
+#include <vtkCellCenters.h>
+#include <vtkCellData.h>
+#include <vtkDoubleArray.h>
+#include <vtkGradientFilter.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkSMPTestUtilities.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// The gradient of the linear velocity field, component by component.
+const double Gradient[9] = { 0.5, -1.0, 0.25, 2.0, -0.75, 1.5, -0.5, 1.0, 0.25 };
+
+// Adds a linear velocity field to the points and cells of a dataset.
+void AddVelocity(vtkDataSet* dataSet)
+{
+  vtkNew<vtkCellCenters> centers;
+  centers->SetInputData(dataSet);
+  centers->Update();
+
+  for (int association = 0; association < 2; ++association)
+  {
+    vtkDataSet* locations = association == 0 ? dataSet : centers->GetOutput();
+    vtkNew<vtkDoubleArray> velocity;
+    velocity->SetName("Velocity");
+    velocity->SetNumberOfComponents(3);
+    velocity->SetNumberOfTuples(locations->GetNumberOfPoints());
+    for (vtkIdType id = 0; id < locations->GetNumberOfPoints(); ++id)
+    {
+      double x[3];
+      locations->GetPoint(id, x);
+      for (int i = 0; i < 3; ++i)
+      {
+        velocity->SetComponent(id, i,
+          Gradient[3 * i] * x[0] + Gradient[3 * i + 1] * x[1] + Gradient[3 * i + 2] * x[2] + i);
+      }
+    }
+    if (association == 0)
+    {
+      dataSet->GetPointData()->AddArray(velocity);
+    }
+    else
+    {
+      dataSet->GetCellData()->AddArray(velocity);
+    }
+  }
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  const int numComp = a->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetComponent(i / numComp, i % numComp) != b->GetComponent(i / numComp, i % numComp))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Checks the output of a 3D linear field against the exact values.
+bool IsExact(vtkFieldData* fields)
+{
+  vtkDataArray* gradients = fields->GetArray("Gradients");
+  vtkDataArray* vorticity = fields->GetArray("Vorticity");
+  vtkDataArray* divergence = fields->GetArray("Divergence");
+  vtkDataArray* qCriterion = fields->GetArray("Q-criterion");
+  const double* g = Gradient;
+  const double expectedVorticity[3] = { g[7] - g[5], g[2] - g[6], g[3] - g[1] };
+  const double expectedDivergence = g[0] + g[4] + g[8];
+  const double expectedQCriterion = -(g[0] * g[0] + g[4] * g[4] + g[8] * g[8]) / 2. -
+    (g[1] * g[3] + g[2] * g[6] + g[5] * g[7]);
+  for (vtkIdType id = 0; id < gradients->GetNumberOfTuples(); ++id)
+  {
+    for (int i = 0; i < 9; ++i)
+    {
+      if (std::abs(gradients->GetComponent(id, i) - g[i]) > 1e-8)
+      {
+        return false;
+      }
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      if (std::abs(vorticity->GetComponent(id, i) - expectedVorticity[i]) > 1e-8)
+      {
+        return false;
+      }
+    }
+    if (std::abs(divergence->GetComponent(id, 0) - expectedDivergence) > 1e-8 ||
+      std::abs(qCriterion->GetComponent(id, 0) - expectedQCriterion) > 1e-8)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestGradientFilterSMP(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 12, 0, 10, 0, 8);
+  image->SetSpacing(0.1, 0.2, 0.15);
+  vtkNew<vtkAppendFilter> toGrid;
+  toGrid->AddInputData(image);
+  toGrid->Update();
+  vtkUnstructuredGrid* grid = toGrid->GetOutput();
+  AddVelocity(grid);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(24);
+  sphere->SetPhiResolution(16);
+  sphere->Update();
+  AddVelocity(sphere->GetOutput());
+
+  std::vector<vtkDataSet*> inputs = { grid, sphere->GetOutput() };
+
+  int status = EXIT_SUCCESS;
+  for (std::size_t inputId = 0; inputId < inputs.size(); ++inputId)
+  {
+    for (int mode = 0; mode < 12; ++mode)
+    {
+      const bool cellData = (mode & 1) != 0;
+      const bool faster = (mode & 2) != 0;
+      const int contributingCells = mode / 4;
+
+      vtkSmartPointer<vtkDataSet> reference;
+      vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+        vtkNew<vtkGradientFilter> gradient;
+        gradient->SetInputData(inputs[inputId]);
+        gradient->SetInputArrayToProcess(0, 0, 0,
+          cellData ? vtkDataObject::FIELD_ASSOCIATION_CELLS
+                   : vtkDataObject::FIELD_ASSOCIATION_POINTS,
+          "Velocity");
+        gradient->SetFasterApproximation(faster);
+        gradient->SetContributingCellOption(contributingCells);
+        gradient->ComputeVorticityOn();
+        gradient->ComputeDivergenceOn();
+        gradient->ComputeQCriterionOn();
+        gradient->Update();
+        vtkDataSet* output = vtkDataSet::SafeDownCast(gradient->GetOutput());
+        vtkFieldData* fields = cellData ? static_cast<vtkFieldData*>(output->GetCellData())
+                                        : static_cast<vtkFieldData*>(output->GetPointData());
+
+        if (!reference)
+        {
+          reference.TakeReference(output->NewInstance());
+          reference->ShallowCopy(output);
+          if (inputId == 0 && !cellData && !IsExact(fields))
+          {
+            std::cerr << "Wrong gradients of a linear field in mode " << mode << std::endl;
+            status = EXIT_FAILURE;
+          }
+          return;
+        }
+        vtkFieldData* referenceFields = cellData
+          ? static_cast<vtkFieldData*>(reference->GetCellData())
+          : static_cast<vtkFieldData*>(reference->GetPointData());
+        for (const char* name : { "Gradients", "Vorticity", "Divergence", "Q-criterion" })
+        {
+          if (!fields->GetArray(name) ||
+            !SameArrays(referenceFields->GetArray(name), fields->GetArray(name)))
+          {
+            std::cerr << name << " of the " << backend
+                      << " backend differ from the Sequential ones for input " << inputId
+                      << " in mode " << mode << std::endl;
+            status = EXIT_FAILURE;
+          }
+        }
+      });
+    }
+  }
+  return status;
+}
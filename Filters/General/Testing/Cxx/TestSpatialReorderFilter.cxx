@@ -0,0 +1,406 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSpatialReorderFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the space filling curves of vtkPointSet, and that
+// vtkSpatialReorderFilter permutes the points, the cells and their data
+// consistently, and passes the field data.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpatialReorderFilter.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const int Resolution = 16;
+
+// Checks that consecutive points along the Hilbert curve are neighbors on a
+// lattice of 8x8x8 points, and the Z-order of a 2x2x2 lattice.
+bool CheckCurves()
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < 8; ++k)
+  {
+    for (int j = 0; j < 8; ++j)
+    {
+      for (int i = 0; i < 8; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  vtkNew<vtkIdTypeArray> order;
+  vtkPointSet::ComputeSpaceFillingCurveOrder(points, vtkPointSet::HILBERT_CURVE, order);
+  std::vector<vtkIdType> sorted(order->GetPointer(0), order->GetPointer(0) + 512);
+  std::sort(sorted.begin(), sorted.end());
+  for (vtkIdType i = 0; i < 512; ++i)
+  {
+    if (sorted[i] != i)
+    {
+      std::cerr << "The Hilbert order is not a permutation" << std::endl;
+      return false;
+    }
+  }
+  for (vtkIdType i = 1; i < 512; ++i)
+  {
+    double x0[3], x1[3];
+    points->GetPoint(order->GetValue(i - 1), x0);
+    points->GetPoint(order->GetValue(i), x1);
+    if (std::abs(x1[0] - x0[0]) + std::abs(x1[1] - x0[1]) + std::abs(x1[2] - x0[2]) != 1.0)
+    {
+      std::cerr << "Points " << i - 1 << " and " << i << " of the Hilbert curve are not neighbors"
+                << std::endl;
+      return false;
+    }
+  }
+
+  points->SetNumberOfPoints(8);
+  for (int i = 0; i < 8; ++i)
+  {
+    points->SetPoint(7 - i, i & 1, (i >> 1) & 1, (i >> 2) & 1);
+  }
+  vtkPointSet::ComputeSpaceFillingCurveOrder(points, vtkPointSet::MORTON_CURVE, order);
+  for (vtkIdType i = 0; i < 8; ++i)
+  {
+    if (order->GetValue(i) != 7 - i)
+    {
+      std::cerr << "Wrong Morton order" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// A grid of hexahedra, with its points and cells shuffled, and point and
+// cell data.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(vtkMinimalStandardRandomSequence* random)
+{
+  const int n = Resolution + 1;
+  std::vector<vtkIdType> pointIds(n * n * n);
+  for (std::size_t i = 0; i < pointIds.size(); ++i)
+  {
+    pointIds[i] = static_cast<vtkIdType>(i);
+  }
+  for (std::size_t i = pointIds.size() - 1; i > 0; --i)
+  {
+    std::swap(pointIds[i], pointIds[static_cast<std::size_t>(random->GetValue() * (i + 1))]);
+    random->Next();
+  }
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(n * n * n);
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("PointValues");
+  pointValues->SetNumberOfComponents(2);
+  pointValues->SetNumberOfTuples(n * n * n);
+  vtkNew<vtkIntArray> pointLabels;
+  pointLabels->SetName("PointLabels");
+  pointLabels->SetNumberOfTuples(n * n * n);
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const vtkIdType ptId = pointIds[(k * n + j) * n + i];
+        points->SetPoint(ptId, i, j, k);
+        pointValues->SetTuple2(ptId, i + 100 * j, k);
+        pointLabels->SetValue(ptId, (i + j * n + k * n * n) * 1000 + 1);
+      }
+    }
+  }
+
+  std::vector<vtkIdType> cellIds;
+  for (int k = 0; k < Resolution; ++k)
+  {
+    for (int j = 0; j < Resolution; ++j)
+    {
+      for (int i = 0; i < Resolution; ++i)
+      {
+        cellIds.push_back((k * Resolution + j) * Resolution + i);
+      }
+    }
+  }
+  for (std::size_t i = cellIds.size() - 1; i > 0; --i)
+  {
+    std::swap(cellIds[i], cellIds[static_cast<std::size_t>(random->GetValue() * (i + 1))]);
+    random->Next();
+  }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->GetPointData()->AddArray(pointValues);
+  grid->GetPointData()->AddArray(pointLabels);
+  grid->Allocate(static_cast<vtkIdType>(cellIds.size()));
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("CellValues");
+  vtkNew<vtkUnsignedCharArray> cellFlags;
+  cellFlags->SetName("CellFlags");
+  for (vtkIdType cell : cellIds)
+  {
+    const int i = cell % Resolution;
+    const int j = (cell / Resolution) % Resolution;
+    const int k = cell / (Resolution * Resolution);
+    const int corners[8][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+      { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } };
+    vtkIdType pts[8];
+    for (int c = 0; c < 8; ++c)
+    {
+      pts[c] = pointIds[((k + corners[c][2]) * n + j + corners[c][1]) * n + i + corners[c][0]];
+    }
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+    cellValues->InsertNextValue(static_cast<double>(cell));
+    cellFlags->InsertNextValue(static_cast<unsigned char>(cell % 251));
+  }
+  grid->GetCellData()->AddArray(cellValues);
+  grid->GetCellData()->AddArray(cellFlags);
+  return grid;
+}
+
+// Checks that the output arrays have the type of the input arrays and are
+// permuted by order.
+bool CheckArrays(
+  vtkDataSetAttributes* inAttributes, vtkDataSetAttributes* outAttributes, vtkIdTypeArray* order)
+{
+  for (int a = 0; a < inAttributes->GetNumberOfArrays(); ++a)
+  {
+    vtkDataArray* inArray = inAttributes->GetArray(a);
+    vtkDataArray* outArray = outAttributes->GetArray(inArray->GetName());
+    if (!outArray || strcmp(outArray->GetClassName(), inArray->GetClassName()) != 0)
+    {
+      std::cerr << "Array " << inArray->GetName() << " is not a " << inArray->GetClassName()
+                << " anymore" << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < order->GetNumberOfValues(); ++i)
+    {
+      for (int c = 0; c < inArray->GetNumberOfComponents(); ++c)
+      {
+        if (outArray->GetComponent(i, c) != inArray->GetComponent(order->GetValue(i), c))
+        {
+          std::cerr << "Array " << inArray->GetName() << " is not permuted" << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Checks that the output is the input permuted by the permutation maps.
+bool CheckPermutation(vtkPointSet* input, vtkPointSet* output)
+{
+  vtkIdTypeArray* pointOrder =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("vtkOriginalPointIds"));
+  vtkIdTypeArray* cellOrder =
+    vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("vtkOriginalCellIds"));
+  if (!pointOrder || !cellOrder || output->GetNumberOfPoints() != input->GetNumberOfPoints() ||
+    output->GetNumberOfCells() != input->GetNumberOfCells())
+  {
+    std::cerr << "Missing permutation maps" << std::endl;
+    return false;
+  }
+  if (output->GetFieldData()->GetArray("FieldValues") !=
+    input->GetFieldData()->GetArray("FieldValues"))
+  {
+    std::cerr << "Field data not passed" << std::endl;
+    return false;
+  }
+  if (!CheckArrays(input->GetPointData(), output->GetPointData(), pointOrder) ||
+    !CheckArrays(input->GetCellData(), output->GetCellData(), cellOrder))
+  {
+    return false;
+  }
+
+  vtkDataArray* inPointValues = input->GetPointData()->GetArray("PointValues");
+  vtkDataArray* outPointValues = output->GetPointData()->GetArray("PointValues");
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    const vtkIdType inPtId = pointOrder->GetValue(ptId);
+    double x[3], inX[3];
+    output->GetPoint(ptId, x);
+    input->GetPoint(inPtId, inX);
+    if (x[0] != inX[0] || x[1] != inX[1] || x[2] != inX[2] ||
+      outPointValues->GetComponent(ptId, 0) != inPointValues->GetComponent(inPtId, 0) ||
+      outPointValues->GetComponent(ptId, 1) != inPointValues->GetComponent(inPtId, 1))
+    {
+      std::cerr << "Point " << ptId << " does not match input point " << inPtId << std::endl;
+      return false;
+    }
+  }
+
+  vtkDataArray* inCellValues = input->GetCellData()->GetArray("CellValues");
+  vtkDataArray* outCellValues = output->GetCellData()->GetArray("CellValues");
+  vtkNew<vtkIdList> pts;
+  vtkNew<vtkIdList> inPts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    const vtkIdType inCellId = cellOrder->GetValue(cellId);
+    output->GetCellPoints(cellId, pts);
+    input->GetCellPoints(inCellId, inPts);
+    bool match = output->GetCellType(cellId) == input->GetCellType(inCellId) &&
+      pts->GetNumberOfIds() == inPts->GetNumberOfIds() &&
+      outCellValues->GetComponent(cellId, 0) == inCellValues->GetComponent(inCellId, 0);
+    for (vtkIdType i = 0; match && i < pts->GetNumberOfIds(); ++i)
+    {
+      match = pointOrder->GetValue(pts->GetId(i)) == inPts->GetId(i);
+    }
+    if (!match)
+    {
+      std::cerr << "Cell " << cellId << " does not match input cell " << inCellId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// The average distance between consecutive points.
+double GetPointSpread(vtkPointSet* dataSet)
+{
+  double spread = 0.0;
+  for (vtkIdType ptId = 1; ptId < dataSet->GetNumberOfPoints(); ++ptId)
+  {
+    double x0[3], x1[3];
+    dataSet->GetPoint(ptId - 1, x0);
+    dataSet->GetPoint(ptId, x1);
+    spread += std::sqrt(vtkMath::Distance2BetweenPoints(x0, x1));
+  }
+  return spread / dataSet->GetNumberOfPoints();
+}
+}
+
+int TestSpatialReorderFilter(int, char*[])
+{
+  if (!CheckCurves())
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1729);
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid(random);
+
+  // A polydata with vertices and quads, whose ids must stay in two ranges.
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(grid->GetPoints());
+  polyData->GetPointData()->ShallowCopy(grid->GetPointData());
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType ptId = 0; ptId < grid->GetNumberOfPoints(); ptId += 7)
+  {
+    verts->InsertNextCell(1, &ptId);
+  }
+  vtkNew<vtkCellArray> quads;
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    grid->GetCellPoints(cellId, pts);
+    quads->InsertNextCell(4, pts->GetPointer(0));
+  }
+  polyData->SetVerts(verts);
+  polyData->SetPolys(quads);
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("CellValues");
+  cellValues->SetNumberOfTuples(polyData->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < polyData->GetNumberOfCells(); ++cellId)
+  {
+    cellValues->SetValue(cellId, static_cast<double>(cellId));
+  }
+  polyData->GetCellData()->AddArray(cellValues);
+
+  // Field data, passed as is.
+  vtkNew<vtkDoubleArray> fieldValues;
+  fieldValues->SetName("FieldValues");
+  fieldValues->InsertNextValue(42.0);
+  grid->GetFieldData()->AddArray(fieldValues);
+  polyData->GetFieldData()->AddArray(fieldValues);
+
+  std::vector<vtkPointSet*> inputs = { grid, polyData };
+  for (vtkPointSet* input : inputs)
+  {
+    for (int curve = vtkPointSet::MORTON_CURVE; curve <= vtkPointSet::HILBERT_CURVE; ++curve)
+    {
+      vtkNew<vtkSpatialReorderFilter> reorder;
+      reorder->SetInputData(input);
+      reorder->SetCurve(curve);
+      reorder->GeneratePermutationMapsOn();
+      reorder->Update();
+      vtkPointSet* output = vtkPointSet::SafeDownCast(reorder->GetOutputDataObject(0));
+      if (!output || !output->IsA(input->GetClassName()) || !CheckPermutation(input, output))
+      {
+        std::cerr << "Wrong " << input->GetClassName() << " output with the curve " << curve
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      if (GetPointSpread(output) > 0.25 * GetPointSpread(input))
+      {
+        std::cerr << "The points are not reordered: " << GetPointSpread(output) << " vs "
+                  << GetPointSpread(input) << std::endl;
+        return EXIT_FAILURE;
+      }
+      vtkIdTypeArray* cellOrder =
+        vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("vtkOriginalCellIds"));
+      const vtkIdType numVerts = verts->GetNumberOfCells();
+      for (vtkIdType cellId = 0; input == polyData && cellId < output->GetNumberOfCells();
+           ++cellId)
+      {
+        if ((cellId < numVerts) != (cellOrder->GetValue(cellId) < numVerts))
+        {
+          std::cerr << "A vertex and a polygon were exchanged" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  // Without reordering, the dataset is unchanged.
+  vtkNew<vtkSpatialReorderFilter> reorder;
+  reorder->SetInputData(grid);
+  reorder->ReorderPointsOff();
+  reorder->ReorderCellsOff();
+  reorder->GeneratePermutationMapsOn();
+  reorder->Update();
+  vtkIdTypeArray* cellOrder = vtkIdTypeArray::SafeDownCast(
+    reorder->GetOutputDataObject(0)->GetAttributes(vtkDataObject::CELL)->GetArray(
+      "vtkOriginalCellIds"));
+  for (vtkIdType cellId = 0; cellId < cellOrder->GetNumberOfValues(); ++cellId)
+  {
+    if (cellOrder->GetValue(cellId) != cellId)
+    {
+      std::cerr << "The cells were reordered" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -21,6 +21,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include <algorithm>
 #include <cassert>
@@ -268,6 +269,24 @@ private:
     bool operator()(const PerCell& pc) { return (pc.Min[d] + pc.Max[d]) < p; }
   };
 
+  // A leaf of the tree left to split, with the bounds of its cells.
+  struct Subtree
+  {
+    unsigned int Index;
+    float Min[3];
+    float Max[3];
+
+    Subtree(unsigned int index, const float min[3], const float max[3])
+      : Index(index)
+    {
+      for (int d = 0; d < 3; ++d)
+      {
+        this->Min[d] = min[d];
+        this->Max[d] = max[d];
+      }
+    }
+  };
+
   // -------------------------------------------------------------------------
 
   void FindMinMax(const PerCell* begin, const PerCell* end, float* min, float* max)
@@ -297,10 +316,14 @@ private:
 
   // -------------------------------------------------------------------------
 
-  void Split(unsigned int index, float min[3], float max[3])
+  // Splits the leaf nodes[index], and recursively its children unless
+  // subtrees is given. In that case the children are appended to subtrees,
+  // to be split later in parallel.
+  void Split(std::vector<vtkCellTreeLocator::vtkCellTreeNode>& nodes, unsigned int index,
+    float min[3], float max[3], std::vector<Subtree>* subtrees = nullptr)
   {
-    unsigned int start = this->m_nodes[index].Start();
-    unsigned int size = this->m_nodes[index].Size();
+    unsigned int start = nodes[index].Start();
+    unsigned int size = nodes[index].Size();
 
     if (size < this->m_leafsize)
     {
@@ -416,11 +439,67 @@ private:
     child[0].MakeLeaf(begin - &(this->m_pc[0]), mid - begin);
     child[1].MakeLeaf(mid - &(this->m_pc[0]), end - mid);
 
-    this->m_nodes[index].MakeNode((int)m_nodes.size(), dim, clip);
-    this->m_nodes.insert(m_nodes.end(), child, child + 2);
+    nodes[index].MakeNode((int)nodes.size(), dim, clip);
+    nodes.insert(nodes.end(), child, child + 2);
+
+    if (subtrees)
+    {
+      subtrees->push_back(Subtree(nodes[index].GetLeftChildIndex(), lmin, lmax));
+      subtrees->push_back(Subtree(nodes[index].GetRightChildIndex(), rmin, rmax));
+      return;
+    }
+    Split(nodes, nodes[index].GetLeftChildIndex(), lmin, lmax);
+    Split(nodes, nodes[index].GetRightChildIndex(), rmin, rmax);
+  }
+
+  // Splits the root node. The first levels are split breadth first, until
+  // there are enough subtrees to keep the threads busy, and the subtrees
+  // are then split in parallel into their own node vectors. Each subtree
+  // works on its own range of m_pc, so the tree is the same as the serial
+  // one, up to the order of m_nodes which Build() does not depend upon.
+  void SplitRoot(float min[3], float max[3])
+  {
+    std::vector<Subtree> subtrees(1, Subtree(0, min, max));
+    const std::size_t minSubtrees =
+      8 * static_cast<std::size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+    while (!subtrees.empty() && subtrees.size() < minSubtrees)
+    {
+      std::vector<Subtree> children;
+      for (Subtree& subtree : subtrees)
+      {
+        Split(this->m_nodes, subtree.Index, subtree.Min, subtree.Max, &children);
+      }
+      subtrees.swap(children);
+    }
+
+    std::vector<std::vector<vtkCellTreeLocator::vtkCellTreeNode>> subtreeNodes(subtrees.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()),
+      [&](vtkIdType subtreeId, vtkIdType endSubtreeId) {
+        for (; subtreeId < endSubtreeId; ++subtreeId)
+        {
+          Subtree& subtree = subtrees[subtreeId];
+          std::vector<vtkCellTreeLocator::vtkCellTreeNode>& nodes = subtreeNodes[subtreeId];
+          nodes.push_back(this->m_nodes[subtree.Index]);
+          Split(nodes, 0, subtree.Min, subtree.Max);
+        }
+      });
 
-    Split(this->m_nodes[index].GetLeftChildIndex(), lmin, lmax);
-    Split(this->m_nodes[index].GetRightChildIndex(), rmin, rmax);
+    // Move the subtrees into m_nodes. Their roots replace the leaves they were
+    // split from, the other nodes are appended.
+    for (std::size_t subtreeId = 0; subtreeId < subtrees.size(); ++subtreeId)
+    {
+      std::vector<vtkCellTreeLocator::vtkCellTreeNode>& nodes = subtreeNodes[subtreeId];
+      const unsigned int shift = static_cast<unsigned int>(this->m_nodes.size()) - 1;
+      for (vtkCellTreeLocator::vtkCellTreeNode& node : nodes)
+      {
+        if (!node.IsLeaf())
+        {
+          node.SetChildren(node.GetLeftChildIndex() + shift);
+        }
+      }
+      this->m_nodes[subtrees[subtreeId].Index] = nodes[0];
+      this->m_nodes.insert(this->m_nodes.end(), nodes.begin() + 1, nodes.end());
+    }
   }
 
 public:
@@ -433,48 +512,41 @@ public:
   void Build(vtkCellTreeLocator* ctl, vtkCellTreeLocator::vtkCellTree& ct, vtkDataSet* ds)
   {
     const vtkIdType size = ds->GetNumberOfCells();
-    double cellBounds[6];
     this->m_pc.resize(size);
 
-    float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
-      std::numeric_limits<float>::max() };
-
-    float max[3] = {
-      -std::numeric_limits<float>::max(),
-      -std::numeric_limits<float>::max(),
-      -std::numeric_limits<float>::max(),
-    };
-
-    for (vtkIdType i = 0; i < size; ++i)
+    // Call GetCellBounds() once on this thread so that its side effects (for
+    // example building the cells of a vtkPolyData) do not happen in parallel.
+    double cellBounds[6];
+    if (!ctl->CellBounds)
     {
-      this->m_pc[i].Ind = i;
-
-      double* boundsPtr = cellBounds;
-      if (ctl->CellBounds)
-      {
-        boundsPtr = ctl->CellBounds[i];
-      }
-      else
-      {
-        ds->GetCellBounds(i, boundsPtr);
-      }
-
-      for (int d = 0; d < 3; ++d)
+      ds->GetCellBounds(0, cellBounds);
+    }
+    vtkSMPTools::For(0, size, [&](vtkIdType i, vtkIdType end) {
+      double threadCellBounds[6];
+      for (; i < end; ++i)
       {
-        this->m_pc[i].Min[d] = boundsPtr[2 * d + 0];
-        this->m_pc[i].Max[d] = boundsPtr[2 * d + 1];
+        this->m_pc[i].Ind = i;
 
-        if (this->m_pc[i].Min[d] < min[d])
+        double* boundsPtr = threadCellBounds;
+        if (ctl->CellBounds)
+        {
+          boundsPtr = ctl->CellBounds[i];
+        }
+        else
         {
-          min[d] = this->m_pc[i].Min[d];
+          ds->GetCellBounds(i, boundsPtr);
         }
 
-        if (this->m_pc[i].Max[d] > max[d]) /// This can be m_pc[i].max[d] instead of min
+        for (int d = 0; d < 3; ++d)
         {
-          max[d] = this->m_pc[i].Max[d];
+          this->m_pc[i].Min[d] = boundsPtr[2 * d + 0];
+          this->m_pc[i].Max[d] = boundsPtr[2 * d + 1];
         }
       }
-    }
+    });
+
+    float min[3], max[3];
+    FindMinMax(this->m_pc.data(), this->m_pc.data() + size, min, max);
 
     ct.DataBBox[0] = min[0];
     ct.DataBBox[1] = max[0];
@@ -487,7 +559,7 @@ public:
     root.MakeLeaf(0, size);
     this->m_nodes.push_back(root);
 
-    Split(0, min, max);
+    SplitRoot(min, max);
 
     ct.Nodes.resize(this->m_nodes.size());
     ct.Nodes[0] = this->m_nodes[0];
@@ -36,6 +36,7 @@
 #include "vtkPlane.h"
 #include "vtkPointData.h"
 #include "vtkPolyhedron.h"
+#include "vtkScratchPool.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
@@ -373,7 +374,7 @@ int vtkClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
   //
   int abort = 0;
   vtkIdType updateTime = numCells / 20 + 1; // update roughly every 5%
-  vtkGenericCell* cell = vtkGenericCell::New();
+  auto cell = vtkScratchPool<vtkGenericCell>::Acquire();
   int num[2];
   num[0] = num[1] = 0;
   int numNew[2];
@@ -460,7 +461,6 @@ int vtkClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
     }   // for both outputs
   }     // for each cell
 
-  cell->Delete();
   cellScalars->Delete();
 
   if (this->ClipFunction)
@@ -25,6 +25,7 @@
 #include "vtkCellDataToPointData.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -35,11 +36,15 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -805,119 +810,151 @@ int vtkGradientFilter::GetOutputArrayType(vtkDataArray* array)
 
 namespace
 {
+//------------------------------------------------------------------------------
+// Per-thread scratch space of the unstructured gradient computations.
+template <class data_type>
+struct GradientScratch
+{
+  vtkSmartPointer<vtkGenericCell> Cell;
+  std::vector<vtkIdType> CellIds;
+  std::vector<double> Values;
+  std::vector<data_type> Gradient;
+};
+
 //------------------------------------------------------------------------------
 template <class data_type>
 void ComputePointGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
   int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence,
   int highestCellDimension, int contributingCellOption)
 {
-  vtkNew<vtkIdList> currentPoint;
-  currentPoint->SetNumberOfIds(1);
-  vtkNew<vtkIdList> cellsOnPoint;
-
   vtkIdType numpts = structure->GetNumberOfPoints();
 
   int numberOfOutputComponents = 3 * numberOfInputComponents;
-  std::vector<data_type> g(numberOfOutputComponents);
 
   // if we are doing patches for contributing cell dimensions we want to keep track of
   // the maximum expected dimension so we can exit out of the check loop quicker
   const int maxCellDimension = structure->IsA("vtkPolyData") ? 2 : 3;
 
-  for (vtkIdType point = 0; point < numpts; point++)
+  // Build the cell links once, so that the cells using a point can be
+  // fetched from several threads. Calling GetCell() once on this thread
+  // also makes GetCell() thread safe afterwards.
+  vtkNew<vtkStaticCellLinks> links;
+  links->BuildLinks(structure);
   {
-    currentPoint->SetId(0, point);
-    double pointcoords[3];
-    structure->GetPoint(point, pointcoords);
-    // Get all cells touching this point.
-    structure->GetCellNeighbors(-1, currentPoint, cellsOnPoint);
-    vtkIdType numCellNeighbors = cellsOnPoint->GetNumberOfIds();
-
-    for (int i = 0; i < numberOfOutputComponents; i++)
+    vtkNew<vtkGenericCell> cell;
+    structure->GetCell(0, cell);
+  }
+
+  vtkSMPThreadLocal<GradientScratch<data_type>> scratch;
+  vtkSMPTools::For(0, numpts, [&](vtkIdType point, vtkIdType endPoint) {
+    GradientScratch<data_type>& local = scratch.Local();
+    if (!local.Cell)
     {
-      g[i] = 0;
+      local.Cell = vtkSmartPointer<vtkGenericCell>::New();
+      local.Gradient.resize(numberOfOutputComponents);
     }
+    vtkGenericCell* cell = local.Cell;
+    std::vector<data_type>& g = local.Gradient;
+    int cellDimension = highestCellDimension;
 
-    if (contributingCellOption == vtkGradientFilter::Patch)
+    for (; point < endPoint; point++)
     {
-      highestCellDimension = 0;
-      for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
+      double pointcoords[3];
+      structure->GetPoint(point, pointcoords);
+      // Get all cells touching this point. They are visited in increasing
+      // order so that the sums do not depend on how the links were built.
+      const vtkIdType* cellsOnPoint = links->GetCells(point);
+      local.CellIds.assign(cellsOnPoint, cellsOnPoint + links->GetNcells(point));
+      std::sort(local.CellIds.begin(), local.CellIds.end());
+      vtkIdType numCellNeighbors = static_cast<vtkIdType>(local.CellIds.size());
+
+      for (int i = 0; i < numberOfOutputComponents; i++)
+      {
+        g[i] = 0;
+      }
+
+      if (contributingCellOption == vtkGradientFilter::Patch)
       {
-        int cellDimension = structure->GetCell(cellsOnPoint->GetId(neighbor))->GetCellDimension();
-        if (cellDimension > highestCellDimension)
+        cellDimension = 0;
+        for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
         {
-          highestCellDimension = cellDimension;
-          if (highestCellDimension == maxCellDimension)
+          structure->GetCell(local.CellIds[neighbor], cell);
+          if (cell->GetCellDimension() > cellDimension)
           {
-            break;
+            cellDimension = cell->GetCellDimension();
+            if (cellDimension == maxCellDimension)
+            {
+              break;
+            }
           }
         }
       }
-    }
-    vtkIdType numValidCellNeighbors = 0;
+      vtkIdType numValidCellNeighbors = 0;
 
-    // Iterate on all cells and find all points connected to current point
-    // by an edge.
-    for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
-    {
-      vtkCell* cell = structure->GetCell(cellsOnPoint->GetId(neighbor));
-      if (cell->GetCellDimension() >= highestCellDimension)
+      // Iterate on all cells and find all points connected to current point
+      // by an edge.
+      for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
       {
-        int subId;
-        double parametricCoord[3];
-        if (GetCellParametricData(point, pointcoords, cell, subId, parametricCoord))
+        structure->GetCell(local.CellIds[neighbor], cell);
+        if (cell->GetCellDimension() >= cellDimension)
         {
-          numValidCellNeighbors++;
-          for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
+          int subId;
+          double parametricCoord[3];
+          if (GetCellParametricData(point, pointcoords, cell, subId, parametricCoord))
           {
+            numValidCellNeighbors++;
             int numberOfCellPoints = cell->GetNumberOfPoints();
-            std::vector<double> values(numberOfCellPoints);
-            // Get values of Array at cell points.
-            for (int i = 0; i < numberOfCellPoints; i++)
+            local.Values.resize(numberOfCellPoints);
+            for (int inputComponent = 0; inputComponent < numberOfInputComponents;
+                 inputComponent++)
             {
-              values[i] = array->GetComponent(cell->GetPointId(i), inputComponent);
-            }
-
-            double derivative[3];
-            // Get derivative of cell at point.
-            cell->Derivatives(subId, parametricCoord, &values[0], 1, derivative);
-
-            g[inputComponent * 3] += static_cast<data_type>(derivative[0]);
-            g[inputComponent * 3 + 1] += static_cast<data_type>(derivative[1]);
-            g[inputComponent * 3 + 2] += static_cast<data_type>(derivative[2]);
-          } // iterating over Components
-        }   // if(GetCellParametricData())
-      }     // if(cell->GetCellDimension () >= highestCellDimension
-    }       // iterating over neighbors
-
-    if (numValidCellNeighbors > 0)
-    {
-      for (int i = 0; i < 3 * numberOfInputComponents; i++)
+              // Get values of Array at cell points.
+              for (int i = 0; i < numberOfCellPoints; i++)
+              {
+                local.Values[i] = array->GetComponent(cell->GetPointId(i), inputComponent);
+              }
+
+              double derivative[3];
+              // Get derivative of cell at point.
+              cell->Derivatives(subId, parametricCoord, &local.Values[0], 1, derivative);
+
+              g[inputComponent * 3] += static_cast<data_type>(derivative[0]);
+              g[inputComponent * 3 + 1] += static_cast<data_type>(derivative[1]);
+              g[inputComponent * 3 + 2] += static_cast<data_type>(derivative[2]);
+            } // iterating over Components
+          }   // if(GetCellParametricData())
+        }     // if(cell->GetCellDimension () >= cellDimension
+      }       // iterating over neighbors
+
+      if (numValidCellNeighbors > 0)
       {
-        g[i] /= numValidCellNeighbors;
-      }
+        for (int i = 0; i < 3 * numberOfInputComponents; i++)
+        {
+          g[i] /= numValidCellNeighbors;
+        }
 
-      if (vorticity)
-      {
-        ComputeVorticityFromGradient(&g[0], vorticity + 3 * point);
-      }
-      if (qCriterion)
-      {
-        ComputeQCriterionFromGradient(&g[0], qCriterion + point);
-      }
-      if (divergence)
-      {
-        ComputeDivergenceFromGradient(&g[0], divergence + point);
-      }
-      if (gradients)
-      {
-        for (int i = 0; i < numberOfOutputComponents; i++)
+        if (vorticity)
+        {
+          ComputeVorticityFromGradient(&g[0], vorticity + 3 * point);
+        }
+        if (qCriterion)
+        {
+          ComputeQCriterionFromGradient(&g[0], qCriterion + point);
+        }
+        if (divergence)
         {
-          gradients[point * numberOfOutputComponents + i] = g[i];
+          ComputeDivergenceFromGradient(&g[0], divergence + point);
+        }
+        if (gradients)
+        {
+          for (int i = 0; i < numberOfOutputComponents; i++)
+          {
+            gradients[point * numberOfOutputComponents + i] = g[i];
+          }
         }
       }
-    }
-  } // iterating over points in grid
+    } // iterating over points in grid
+  });
 }
 
 //------------------------------------------------------------------------------
@@ -957,53 +994,75 @@ void ComputeCellGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_typ
   int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence)
 {
   vtkIdType numcells = structure->GetNumberOfCells();
-  std::vector<double> values(8);
-  std::vector<data_type> cellGradients(3 * numberOfInputComponents);
-  for (vtkIdType cellid = 0; cellid < numcells; cellid++)
+  if (numcells == 0)
   {
-    vtkCell* cell = structure->GetCell(cellid);
-    int subId;
-    double cellCenter[3];
-    subId = cell->GetParametricCenter(cellCenter);
+    return;
+  }
+  // Calling GetCell() once on this thread makes it thread safe afterwards.
+  {
+    vtkNew<vtkGenericCell> cell;
+    structure->GetCell(0, cell);
+  }
 
-    int numpoints = cell->GetNumberOfPoints();
-    if (static_cast<size_t>(numpoints) > values.size())
+  vtkSMPThreadLocal<GradientScratch<data_type>> scratch;
+  vtkSMPTools::For(0, numcells, [&](vtkIdType cellid, vtkIdType endCellId) {
+    GradientScratch<data_type>& local = scratch.Local();
+    if (!local.Cell)
     {
-      values.resize(numpoints);
+      local.Cell = vtkSmartPointer<vtkGenericCell>::New();
+      local.Values.resize(8);
+      local.Gradient.resize(3 * numberOfInputComponents);
     }
-    double derivative[3];
-    for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
+    vtkGenericCell* cell = local.Cell;
+    std::vector<double>& values = local.Values;
+    std::vector<data_type>& cellGradients = local.Gradient;
+
+    for (; cellid < endCellId; cellid++)
     {
-      for (int i = 0; i < numpoints; i++)
+      structure->GetCell(cellid, cell);
+      int subId;
+      double cellCenter[3];
+      subId = cell->GetParametricCenter(cellCenter);
+
+      int numpoints = cell->GetNumberOfPoints();
+      if (static_cast<size_t>(numpoints) > values.size())
       {
-        values[i] = array->GetComponent(cell->GetPointId(i), inputComponent);
+        values.resize(numpoints);
       }
+      double derivative[3];
+      for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
+      {
+        for (int i = 0; i < numpoints; i++)
+        {
+          values[i] = array->GetComponent(cell->GetPointId(i), inputComponent);
+        }
 
-      cell->Derivatives(subId, cellCenter, &values[0], 1, derivative);
-      cellGradients[inputComponent * 3] = static_cast<data_type>(derivative[0]);
-      cellGradients[inputComponent * 3 + 1] = static_cast<data_type>(derivative[1]);
-      cellGradients[inputComponent * 3 + 2] = static_cast<data_type>(derivative[2]);
-    }
-    if (gradients)
-    {
-      for (int i = 0; i < 3 * numberOfInputComponents; i++)
+        cell->Derivatives(subId, cellCenter, &values[0], 1, derivative);
+        cellGradients[inputComponent * 3] = static_cast<data_type>(derivative[0]);
+        cellGradients[inputComponent * 3 + 1] = static_cast<data_type>(derivative[1]);
+        cellGradients[inputComponent * 3 + 2] = static_cast<data_type>(derivative[2]);
+      }
+      if (gradients)
       {
-        gradients[cellid * 3 * numberOfInputComponents + i] = cellGradients[i];
+        for (int i = 0; i < 3 * numberOfInputComponents; i++)
+        {
+          gradients[cellid * 3 * numberOfInputComponents + i] = cellGradients[i];
+        }
+      }
+      if (vorticity)
+      {
+        ComputeVorticityFromGradient(&cellGradients[0], vorticity + 3 * cellid);
+      }
+      if (qCriterion)
+      {
+        ComputeQCriterionFromGradient(&cellGradients[0], qCriterion + cellid);
+      }
+      if (divergence)
+      {
+        ComputeDivergenceFromGradient(&cellGradients[0], divergence + cellid);
       }
     }
-    if (vorticity)
-    {
-      ComputeVorticityFromGradient(&cellGradients[0], vorticity + 3 * cellid);
-    }
-    if (qCriterion)
-    {
-      ComputeQCriterionFromGradient(&cellGradients[0], qCriterion + cellid);
-    }
-    if (divergence)
-    {
-      ComputeDivergenceFromGradient(&cellGradients[0], divergence + cellid);
-    }
-  }
+  });
 }
 
 //------------------------------------------------------------------------------
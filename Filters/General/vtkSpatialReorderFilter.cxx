@@ -0,0 +1,367 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpatialReorderFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSpatialReorderFilter.h"
+
+#include "vtkArrayListTemplate.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vector>
+
+vtkStandardNewMacro(vtkSpatialReorderFilter);
+
+namespace
+{
+// ArrayList, used to copy the point and cell data from several threads,
+// only handles vtkDataArrays.
+bool HasOnlyDataArrays(vtkDataSetAttributes* attributes)
+{
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    if (!attributes->GetArray(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Fills order with the identity permutation.
+void SetIdentity(vtkIdTypeArray* order, vtkIdType size)
+{
+  order->SetNumberOfComponents(1);
+  order->SetNumberOfValues(size);
+  vtkIdType* orderPtr = order->GetPointer(0);
+  vtkSMPTools::For(0, size, [orderPtr](vtkIdType i, vtkIdType end) {
+    for (; i < end; ++i)
+    {
+      orderPtr[i] = i;
+    }
+  });
+}
+
+// Computes the order of the cells along the curve, from the average of the
+// coordinates of their points.
+void ComputeCellOrder(vtkCellArray* cells, vtkPoints* points, int curve, vtkIdTypeArray* order)
+{
+  const vtkIdType numCells = cells->GetNumberOfCells();
+  vtkNew<vtkPoints> centers;
+  centers->SetDataTypeToDouble();
+  centers->SetNumberOfPoints(numCells);
+  double* centersPtr = static_cast<double*>(centers->GetVoidPointer(0));
+  vtkSMPThreadLocalObject<vtkIdList> threadPts;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* pts = threadPts.Local();
+    double x[3];
+    for (; cellId < endCellId; ++cellId)
+    {
+      cells->GetCellAtId(cellId, pts);
+      double* center = centersPtr + 3 * cellId;
+      center[0] = center[1] = center[2] = 0.0;
+      const vtkIdType npts = pts->GetNumberOfIds();
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        points->GetPoint(pts->GetId(i), x);
+        center[0] += x[0];
+        center[1] += x[1];
+        center[2] += x[2];
+      }
+      if (npts > 0)
+      {
+        center[0] /= npts;
+        center[1] /= npts;
+        center[2] /= npts;
+      }
+    }
+  });
+  vtkPointSet::ComputeSpaceFillingCurveOrder(centers, curve, order);
+}
+
+// Builds the cells of newCells from the cells order[i] of cells, with their
+// points renumbered by pointMap.
+void PermuteCells(vtkCellArray* cells, const vtkIdType* order, const vtkIdType* pointMap,
+  vtkCellArray* newCells)
+{
+  const vtkIdType numCells = cells->GetNumberOfCells();
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numCells + 1);
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      offsetsPtr[cellId] = cells->GetCellSize(order[cellId]);
+    }
+  });
+  offsetsPtr[numCells] = 0;
+  vtkSMPTools::ExclusiveScan(offsetsPtr, offsetsPtr + numCells + 1, offsetsPtr, vtkIdType(0));
+
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(offsetsPtr[numCells]);
+  vtkIdType* connPtr = connectivity->GetPointer(0);
+  vtkSMPThreadLocalObject<vtkIdList> threadPts;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* pts = threadPts.Local();
+    for (; cellId < endCellId; ++cellId)
+    {
+      cells->GetCellAtId(order[cellId], pts);
+      vtkIdType* newPts = connPtr + offsetsPtr[cellId];
+      for (vtkIdType i = 0; i < pts->GetNumberOfIds(); ++i)
+      {
+        newPts[i] = pointMap[pts->GetId(i)];
+      }
+    }
+  });
+  newCells->SetData(offsets, connectivity);
+}
+
+// Copies the tuples order[i] of the input attributes to the tuples i of the
+// output attributes.
+void PermuteAttributes(
+  vtkDataSetAttributes* inAttributes, vtkDataSetAttributes* outAttributes, vtkIdTypeArray* order)
+{
+  const vtkIdType numTuples = order->GetNumberOfValues();
+  const vtkIdType* orderPtr = order->GetPointer(0);
+  outAttributes->CopyAllocate(inAttributes, numTuples);
+  if (HasOnlyDataArrays(inAttributes))
+  {
+    ArrayList arrays;
+    arrays.AddArrays(numTuples, inAttributes, outAttributes, 0.0, false);
+    vtkSMPTools::For(0, numTuples, [&](vtkIdType i, vtkIdType end) {
+      for (; i < end; ++i)
+      {
+        arrays.Copy(orderPtr[i], i);
+      }
+    });
+  }
+  else
+  {
+    for (vtkIdType i = 0; i < numTuples; ++i)
+    {
+      outAttributes->CopyData(inAttributes, orderPtr[i], i);
+    }
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+vtkSpatialReorderFilter::vtkSpatialReorderFilter()
+{
+  this->Curve = vtkPointSet::HILBERT_CURVE;
+  this->ReorderPoints = true;
+  this->ReorderCells = true;
+  this->GeneratePermutationMaps = false;
+}
+
+//------------------------------------------------------------------------------
+int vtkSpatialReorderFilter::FillInputPortInformation(int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Remove(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE());
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkSpatialReorderFilter::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPointSet* input = vtkPointSet::GetData(inputVector[0]);
+  vtkPointSet* output = vtkPointSet::GetData(outputVector);
+  vtkPolyData* inputPolyData = vtkPolyData::SafeDownCast(input);
+  vtkUnstructuredGrid* inputGrid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (!inputPolyData && !inputGrid)
+  {
+    vtkErrorMacro(<< "The input must be a vtkPolyData or a vtkUnstructuredGrid");
+    return 0;
+  }
+
+  vtkDebugMacro(<< "Reordering points and cells");
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+
+  // The points: pointOrder gives the input point of each output point, and
+  // pointMap the output point of each input point.
+  vtkNew<vtkIdTypeArray> pointOrder;
+  if (this->ReorderPoints && numPts > 0)
+  {
+    vtkPointSet::ComputeSpaceFillingCurveOrder(inPts, this->Curve, pointOrder);
+  }
+  else
+  {
+    SetIdentity(pointOrder, numPts);
+  }
+  const vtkIdType* pointOrderPtr = pointOrder->GetPointer(0);
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkIdType* pointMapPtr = pointMap.data();
+  if (numPts > 0)
+  {
+    vtkNew<vtkPoints> newPts;
+    newPts->SetDataType(inPts->GetDataType());
+    newPts->SetNumberOfPoints(numPts);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x[3];
+      for (; ptId < endPtId; ++ptId)
+      {
+        pointMapPtr[pointOrderPtr[ptId]] = ptId;
+        inPts->GetPoint(pointOrderPtr[ptId], x);
+        newPts->SetPoint(ptId, x);
+      }
+    });
+    output->SetPoints(newPts);
+  }
+  else
+  {
+    output->SetPoints(inPts);
+  }
+  PermuteAttributes(input->GetPointData(), output->GetPointData(), pointOrder);
+  this->UpdateProgress(0.3);
+
+  // The cells, reordered within each of the cell arrays of the input.
+  vtkNew<vtkIdTypeArray> cellOrder;
+  cellOrder->SetNumberOfValues(numCells);
+  vtkIdType* cellOrderPtr = cellOrder->GetPointer(0);
+  vtkNew<vtkIdTypeArray> order;
+  auto computeOrder = [&](vtkCellArray* cells, vtkIdType firstCellId) {
+    const vtkIdType numSectionCells = cells->GetNumberOfCells();
+    if (this->ReorderCells && numSectionCells > 0)
+    {
+      ComputeCellOrder(cells, inPts, this->Curve, order);
+    }
+    else
+    {
+      SetIdentity(order, numSectionCells);
+    }
+    const vtkIdType* orderPtr = order->GetPointer(0);
+    vtkSMPTools::For(0, numSectionCells, [&](vtkIdType i, vtkIdType end) {
+      for (; i < end; ++i)
+      {
+        cellOrderPtr[firstCellId + i] = firstCellId + orderPtr[i];
+      }
+    });
+  };
+
+  if (inputPolyData)
+  {
+    vtkPolyData* outputPolyData = vtkPolyData::SafeDownCast(output);
+    vtkCellArray* inCells[4] = { inputPolyData->GetVerts(), inputPolyData->GetLines(),
+      inputPolyData->GetPolys(), inputPolyData->GetStrips() };
+    vtkNew<vtkCellArray> newCells[4];
+    vtkIdType firstCellId = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+      computeOrder(inCells[i], firstCellId);
+      PermuteCells(inCells[i], order->GetPointer(0), pointMapPtr, newCells[i]);
+      firstCellId += inCells[i]->GetNumberOfCells();
+    }
+    outputPolyData->SetVerts(newCells[0]);
+    outputPolyData->SetLines(newCells[1]);
+    outputPolyData->SetPolys(newCells[2]);
+    outputPolyData->SetStrips(newCells[3]);
+  }
+  else if (numCells > 0)
+  {
+    vtkUnstructuredGrid* outputGrid = vtkUnstructuredGrid::SafeDownCast(output);
+    computeOrder(inputGrid->GetCells(), 0);
+    if (inputGrid->GetFaces())
+    {
+      // Polyhedra: insert the cells one by one, with the point ids of their
+      // face streams renumbered.
+      outputGrid->Allocate(numCells);
+      vtkNew<vtkIdList> pts;
+      for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+        const vtkIdType inCellId = cellOrderPtr[cellId];
+        const int cellType = inputGrid->GetCellType(inCellId);
+        inputGrid->GetFaceStream(inCellId, pts);
+        vtkIdType* ids = pts->GetPointer(0);
+        if (cellType == VTK_POLYHEDRON)
+        {
+          for (vtkIdType face = 0, i = 1; face < ids[0]; ++face)
+          {
+            const vtkIdType numFacePts = ids[i++];
+            for (vtkIdType j = 0; j < numFacePts; ++j, ++i)
+            {
+              ids[i] = pointMapPtr[ids[i]];
+            }
+          }
+        }
+        else
+        {
+          for (vtkIdType i = 0; i < pts->GetNumberOfIds(); ++i)
+          {
+            ids[i] = pointMapPtr[ids[i]];
+          }
+        }
+        outputGrid->InsertNextCell(cellType, pts);
+      }
+    }
+    else
+    {
+      vtkNew<vtkCellArray> newCells;
+      PermuteCells(inputGrid->GetCells(), cellOrderPtr, pointMapPtr, newCells);
+      vtkNew<vtkUnsignedCharArray> types;
+      types->SetNumberOfValues(numCells);
+      unsigned char* typesPtr = types->GetPointer(0);
+      const unsigned char* inTypesPtr = inputGrid->GetCellTypesArray()->GetPointer(0);
+      vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+        for (; cellId < endCellId; ++cellId)
+        {
+          typesPtr[cellId] = inTypesPtr[cellOrderPtr[cellId]];
+        }
+      });
+      outputGrid->SetCells(types, newCells);
+    }
+  }
+  PermuteAttributes(input->GetCellData(), output->GetCellData(), cellOrder);
+  output->GetFieldData()->PassData(input->GetFieldData());
+  this->UpdateProgress(0.9);
+
+  if (this->GeneratePermutationMaps)
+  {
+    pointOrder->SetName("vtkOriginalPointIds");
+    output->GetPointData()->AddArray(pointOrder);
+    cellOrder->SetName("vtkOriginalCellIds");
+    output->GetCellData()->AddArray(cellOrder);
+  }
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkSpatialReorderFilter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Curve: "
+     << (this->Curve == vtkPointSet::HILBERT_CURVE ? "Hilbert" : "Morton") << "\n";
+  os << indent << "Reorder Points: " << (this->ReorderPoints ? "On\n" : "Off\n");
+  os << indent << "Reorder Cells: " << (this->ReorderCells ? "On\n" : "Off\n");
+  os << indent << "Generate Permutation Maps: "
+     << (this->GeneratePermutationMaps ? "On\n" : "Off\n");
+}
@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpatialReorderFilter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSpatialReorderFilter
+ * @brief   reorder points and cells along a space filling curve
+ *
+ * vtkSpatialReorderFilter renumbers the points and the cells of a
+ * vtkPolyData or a vtkUnstructuredGrid along a Morton (Z-order) or Hilbert
+ * space filling curve, so that points and cells close in space are close in
+ * memory. The geometry and the topology of the dataset are unchanged: the
+ * points are permuted, the cells are permuted and their point ids renumbered,
+ * and the point and cell data are permuted accordingly. Downstream filters
+ * which visit the cells and their points in order then access memory more
+ * coherently.
+ *
+ * The points are ordered by their coordinates and the cells by the average
+ * of the coordinates of their points (see
+ * vtkPointSet::ComputeSpaceFillingCurveOrder()). The vertices, lines,
+ * polygons and strips of a vtkPolyData are each reordered among themselves,
+ * as vtkPolyData numbers them in this order.
+ *
+ * Optionally, the filter generates the permutations as a point data array
+ * named "vtkOriginalPointIds" and a cell data array named
+ * "vtkOriginalCellIds", holding for each output point (resp. cell) the id of
+ * the input point (resp. cell) it comes from.
+ *
+ * The orders are computed, and the points, cells and data arrays are
+ * permuted, in parallel using vtkSMPTools.
+ *
+ * @warning
+ * Unstructured grids with polyhedral cells are reordered serially.
+ *
+ * @sa
+ * vtkPointSet vtkSpatialRepresentationFilter
+ */
+
+#ifndef vtkSpatialReorderFilter_h
+#define vtkSpatialReorderFilter_h
+
+#include "vtkFiltersGeneralModule.h" // For export macro
+#include "vtkPointSet.h"             // For SpaceFillingCurves
+#include "vtkPointSetAlgorithm.h"
+
+class VTKFILTERSGENERAL_EXPORT vtkSpatialReorderFilter : public vtkPointSetAlgorithm
+{
+public:
+  //@{
+  /**
+   * Standard methods to instantiate, print and obtain type-related information.
+   */
+  static vtkSpatialReorderFilter* New();
+  vtkTypeMacro(vtkSpatialReorderFilter, vtkPointSetAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Specify the space filling curve along which to order the points and
+   * the cells, vtkPointSet::MORTON_CURVE or vtkPointSet::HILBERT_CURVE. By
+   * default the Hilbert curve, whose consecutive cells are always adjacent,
+   * is used.
+   */
+  vtkSetClampMacro(Curve, int, vtkPointSet::MORTON_CURVE, vtkPointSet::HILBERT_CURVE);
+  vtkGetMacro(Curve, int);
+  void SetCurveToMorton() { this->SetCurve(vtkPointSet::MORTON_CURVE); }
+  void SetCurveToHilbert() { this->SetCurve(vtkPointSet::HILBERT_CURVE); }
+  //@}
+
+  //@{
+  /**
+   * Turn on/off the reordering of the points. On by default.
+   */
+  vtkSetMacro(ReorderPoints, bool);
+  vtkGetMacro(ReorderPoints, bool);
+  vtkBooleanMacro(ReorderPoints, bool);
+  //@}
+
+  //@{
+  /**
+   * Turn on/off the reordering of the cells. On by default.
+   */
+  vtkSetMacro(ReorderCells, bool);
+  vtkGetMacro(ReorderCells, bool);
+  vtkBooleanMacro(ReorderCells, bool);
+  //@}
+
+  //@{
+  /**
+   * Turn on/off the generation of the "vtkOriginalPointIds" and
+   * "vtkOriginalCellIds" arrays. Off by default.
+   */
+  vtkSetMacro(GeneratePermutationMaps, bool);
+  vtkGetMacro(GeneratePermutationMaps, bool);
+  vtkBooleanMacro(GeneratePermutationMaps, bool);
+  //@}
+
+protected:
+  vtkSpatialReorderFilter();
+  ~vtkSpatialReorderFilter() override = default;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  int Curve;
+  bool ReorderPoints;
+  bool ReorderCells;
+  bool GeneratePermutationMaps;
+
+private:
+  vtkSpatialReorderFilter(const vtkSpatialReorderFilter&) = delete;
+  void operator=(const vtkSpatialReorderFilter&) = delete;
+};
+
+#endif
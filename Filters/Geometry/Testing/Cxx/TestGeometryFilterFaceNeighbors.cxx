@@ -0,0 +1,153 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGeometryFilterFaceNeighbors.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkGeometryFilter, to which vtkDataSetSurfaceFilter delegates
+// linear unstructured grids, extracts the same surface of a grid of
+// hexahedra and tetrahedra with and without its face adjacency, and that the
+// adjacency is no longer used once the grid is modified.
+
+#include "vtkCellArray.h"
+#include "vtkGeometryFilter.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Resolution = 40;
+
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    std::cerr << message << std::endl;
+  }
+  return condition;
+}
+
+vtkIdType PointId(int i, int j, int k)
+{
+  return i + (Resolution + 1) * (j + (Resolution + 1) * k);
+}
+
+// Hexahedra in the lower half of a cube, and five tetrahedra per hexahedron
+// in the upper half.
+void FillGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= Resolution; ++k)
+  {
+    for (int j = 0; j <= Resolution; ++j)
+    {
+      for (int i = 0; i <= Resolution; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->Allocate(Resolution * Resolution * Resolution * 3);
+
+  static const int tetras[5][4] = { { 0, 1, 3, 4 }, { 1, 2, 3, 6 }, { 1, 4, 5, 6 },
+    { 3, 4, 6, 7 }, { 1, 3, 4, 6 } };
+  for (int k = 0; k < Resolution; ++k)
+  {
+    for (int j = 0; j < Resolution; ++j)
+    {
+      for (int i = 0; i < Resolution; ++i)
+      {
+        const vtkIdType hex[8] = { PointId(i, j, k), PointId(i + 1, j, k),
+          PointId(i + 1, j + 1, k), PointId(i, j + 1, k), PointId(i, j, k + 1),
+          PointId(i + 1, j, k + 1), PointId(i + 1, j + 1, k + 1), PointId(i, j + 1, k + 1) };
+        if (k < Resolution / 2)
+        {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+          continue;
+        }
+        // Alternate the splitting so that the faces of the tetrahedra match.
+        const bool flip = (i + j + k) % 2 != 0;
+        for (int t = 0; t < 5; ++t)
+        {
+          vtkIdType tetra[4];
+          for (int v = 0; v < 4; ++v)
+          {
+            const int corner = tetras[t][v];
+            tetra[v] = hex[flip ? (corner + 1) % 4 + corner / 4 * 4 : corner];
+          }
+          grid->InsertNextCell(VTK_TETRA, 4, tetra);
+        }
+      }
+    }
+  }
+}
+
+bool SameSurface(vtkPolyData* surface, vtkPolyData* reference)
+{
+  if (surface->GetNumberOfPoints() != reference->GetNumberOfPoints() ||
+    surface->GetNumberOfPolys() != reference->GetNumberOfPolys())
+  {
+    return false;
+  }
+  vtkIdType npts, nrefPts;
+  const vtkIdType *pts, *refPts;
+  for (vtkIdType cellId = 0; cellId < surface->GetNumberOfPolys(); ++cellId)
+  {
+    surface->GetPolys()->GetCellAtId(cellId, npts, pts);
+    reference->GetPolys()->GetCellAtId(cellId, nrefPts, refPts);
+    if (npts != nrefPts || !std::equal(pts, pts + npts, refPts))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestGeometryFilterFaceNeighbors(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  FillGrid(grid);
+  vtkNew<vtkGeometryFilter> surfaceFilter;
+  surfaceFilter->SetInputData(grid);
+  surfaceFilter->Update();
+  vtkNew<vtkPolyData> reference;
+  reference->DeepCopy(surfaceFilter->GetOutput());
+
+  // The sides of the cube, half of quads and half of pairs of triangles, and
+  // the top faces of the hexahedra: no tetrahedron uses all of their points,
+  // whereas the hexahedra use all the points of the faces of the tetrahedra.
+  const vtkIdType numSideQuads = Resolution * Resolution;
+  bool success = Check(reference->GetNumberOfPolys() == numSideQuads * (3 + 2 * 3 + 1),
+    "Wrong number of surface faces");
+
+  grid->BuildFaceNeighbors();
+  surfaceFilter->Modified();
+  surfaceFilter->Update();
+  success &= Check(SameSurface(surfaceFilter->GetOutput(), reference),
+    "Wrong surface with the face neighbors");
+
+  // Once the mesh is modified, the stale adjacency is not used.
+  grid->GetPoints()->Modified();
+  success &= Check(!grid->AreFaceNeighborsCurrent(), "Face neighbors current after a change");
+  surfaceFilter->Update();
+  success &= Check(SameSurface(surfaceFilter->GetOutput(), reference),
+    "Wrong surface after the grid is modified");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
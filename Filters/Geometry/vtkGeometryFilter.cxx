@@ -600,13 +600,25 @@ void ExtractStructuredCellGeometry(vtkDataSet* input, vtkIdType cellId, int cell
   } // switch
 } // ExtractStructuredCellGeometry()
 
+//--------------------------------------------------------------------------
+// Whether a face of a cell is on the boundary. When the face adjacency of the
+// grid is current (see vtkUnstructuredGrid::BuildFaceNeighbors()), the
+// neighbor of the face is read from it, otherwise the cell links are
+// intersected. The faces are numbered as in the adjacency.
+inline bool IsBoundaryFace(vtkUnstructuredGrid* input, bool faceNeighbors, vtkIdType cellId,
+  int faceId, int numFacePts, const vtkIdType* ptIds)
+{
+  return faceNeighbors ? input->GetFaceNeighbor(cellId, faceId) < 0
+                       : input->IsCellBoundary(cellId, numFacePts, ptIds);
+}
+
 //--------------------------------------------------------------------------
 // Given a cell and a bunch of supporting objects (to support computing and
 // minimize allocation/deallocation), extract boundary features from the cell.
 // This method works with unstructured grids.
 void ExtractCellGeometry(vtkUnstructuredGrid* input, vtkIdType cellId, int cellType, vtkIdType npts,
-  const vtkIdType* pts, const char* cellVis, vtkUnstructuredGridCellIterator* cellIter,
-  LocalDataType* localData)
+  const vtkIdType* pts, const char* cellVis, bool faceNeighbors,
+  vtkUnstructuredGridCellIterator* cellIter, LocalDataType* localData)
 {
   CellArrayType& verts = localData->Verts;
   CellArrayType& lines = localData->Lines;
@@ -668,7 +680,7 @@ void ExtractCellGeometry(vtkUnstructuredGrid* input, vtkIdType cellId, int cellT
         ptIds[2] = pts[faceVerts[2]];
         if (!cellVis) // most common, fastpath: geometry not cropped
         {
-          insertFace = input->IsCellBoundary(cellId, numFacePts, ptIds);
+          insertFace = IsBoundaryFace(input, faceNeighbors, cellId, faceId, numFacePts, ptIds);
         }
         else // slower path, geometry cropped via point id, cell id, and/or extent
         {
@@ -693,7 +705,7 @@ void ExtractCellGeometry(vtkUnstructuredGrid* input, vtkIdType cellId, int cellT
         ptIds[3] = pts[faceVerts[pixelConvert[3]]];
         if (!cellVis) // most common, fastpath: geometry not cropped
         {
-          insertFace = input->IsCellBoundary(cellId, numFacePts, ptIds);
+          insertFace = IsBoundaryFace(input, faceNeighbors, cellId, faceId, numFacePts, ptIds);
         }
         else // slower path, geometry cropped via point id, cell id, and/or extent
         {
@@ -718,7 +730,7 @@ void ExtractCellGeometry(vtkUnstructuredGrid* input, vtkIdType cellId, int cellT
         ptIds[3] = pts[faceVerts[3]];
         if (!cellVis) // most common, fastpath: geometry not cropped
         {
-          insertFace = input->IsCellBoundary(cellId, numFacePts, ptIds);
+          insertFace = IsBoundaryFace(input, faceNeighbors, cellId, faceId, numFacePts, ptIds);
         }
         else // slower path, geometry cropped via point id, cell id, and/or extent
         {
@@ -747,7 +759,7 @@ void ExtractCellGeometry(vtkUnstructuredGrid* input, vtkIdType cellId, int cellT
         }
         if (!cellVis) // most common, fastpath: geometry not cropped
         {
-          insertFace = input->IsCellBoundary(cellId, numFacePts, ptIds);
+          insertFace = IsBoundaryFace(input, faceNeighbors, cellId, faceId, numFacePts, ptIds);
         }
         else // slower path, geometry cropped via point id, cell id, and/or extent
         {
@@ -776,7 +788,7 @@ void ExtractCellGeometry(vtkUnstructuredGrid* input, vtkIdType cellId, int cellT
         }
         if (!cellVis) // most common, fastpath: geometry not cropped
         {
-          insertFace = input->IsCellBoundary(cellId, numFacePts, ptIds);
+          insertFace = IsBoundaryFace(input, faceNeighbors, cellId, faceId, numFacePts, ptIds);
         }
         else // slower path, geometry cropped via point id, cell id, and/or extent
         {
@@ -807,7 +819,7 @@ void ExtractCellGeometry(vtkUnstructuredGrid* input, vtkIdType cellId, int cellT
         }
         if (!cellVis) // most common, fastpath: geometry not cropped
         {
-          insertFace = input->IsCellBoundary(cellId, numFacePts, ptIds);
+          insertFace = IsBoundaryFace(input, faceNeighbors, cellId, faceId, numFacePts, ptIds);
         }
         else // slower path, geometry cropped via point id, cell id, and/or extent
         {
@@ -837,7 +849,7 @@ void ExtractCellGeometry(vtkUnstructuredGrid* input, vtkIdType cellId, int cellT
         }
         if (!cellVis) // most common, fastpath: geometry not cropped
         {
-          insertFace = input->IsCellBoundary(cellId, numFacePts, ptIds);
+          insertFace = IsBoundaryFace(input, faceNeighbors, cellId, faceId, numFacePts, ptIds);
         }
         else // slower path, geometry cropped via point id, cell id, and/or extent
         {
@@ -864,7 +876,8 @@ void ExtractCellGeometry(vtkUnstructuredGrid* input, vtkIdType cellId, int cellT
           numFacePts = face->PointIds->GetNumberOfIds();
           if (!cellVis) // most common, fastpath: geometry not cropped
           {
-            insertFace = input->IsCellBoundary(cellId, numFacePts, face->PointIds->GetPointer(0));
+            insertFace = IsBoundaryFace(
+              input, faceNeighbors, cellId, j, numFacePts, face->PointIds->GetPointer(0));
           }
           else // slower path, geometry cropped via point id, cell id, and/or extent
           {
@@ -1065,6 +1078,8 @@ struct ExtractUG : public ExtractCellBoundaries
 {
   // The unstructured grid to process
   vtkUnstructuredGrid* Grid;
+  // Whether the face adjacency of the grid is current
+  bool FaceNeighbors;
   // Each thread has its own cell iterator.
   vtkSMPThreadLocal<vtkSmartPointer<vtkUnstructuredGridCellIterator>> CellIter;
 
@@ -1073,6 +1088,7 @@ struct ExtractUG : public ExtractCellBoundaries
     vtkCellArray* strips, vtkExcludedFaces* exc, ThreadOutputType* t)
     : ExtractCellBoundaries(cellVis, ghosts, verts, lines, polys, strips, exc, t)
     , Grid(grid)
+    , FaceNeighbors(grid->AreFaceNeighborsCurrent())
     , CellIter(nullptr)
   {
     if (merging)
@@ -1110,8 +1126,8 @@ struct ExtractUG : public ExtractCellBoundaries
         vtkIdType npts = pointIdList->GetNumberOfIds();
         vtkIdType* pts = pointIdList->GetPointer(0);
 
-        ExtractCellGeometry(
-          this->Grid, cellId, type, npts, pts, this->CellVis, cellIter, &localData);
+        ExtractCellGeometry(this->Grid, cellId, type, npts, pts, this->CellVis,
+          this->FaceNeighbors, cellIter, &localData);
       } // if cell visible
     }   // for all cells in this batch
   }     // operator()
@@ -1126,6 +1142,8 @@ struct FastExtractUG : public ExtractCellBoundaries
 {
   // The unstructured grid to process
   vtkUnstructuredGrid* Grid;
+  // Whether the face adjacency of the grid is current
+  bool FaceNeighbors;
   // Each thread has its own cell iterator.
   vtkSMPThreadLocal<vtkSmartPointer<vtkUnstructuredGridCellIterator>> CellIter;
 
@@ -1140,6 +1158,7 @@ struct FastExtractUG : public ExtractCellBoundaries
     ThreadOutputType* t)
     : ExtractCellBoundaries(cellVis, ghosts, verts, lines, polys, strips, exc, t)
     , Grid(grid)
+    , FaceNeighbors(grid->AreFaceNeighborsCurrent())
     , CellIter(nullptr)
     , Links(links)
     , Degree(degree)
@@ -1184,8 +1203,8 @@ struct FastExtractUG : public ExtractCellBoundaries
         vtkIdType npts = pointIdList->GetNumberOfIds();
         vtkIdType* pts = pointIdList->GetPointer(0);
 
-        ExtractCellGeometry(
-          this->Grid, cellId, type, npts, pts, this->CellVis, cellIter, &localData);
+        ExtractCellGeometry(this->Grid, cellId, type, npts, pts, this->CellVis,
+          this->FaceNeighbors, cellIter, &localData);
 
       } // if cell visible and selected via fast mode (vertex degree)
     }   // for all cells in this batch
@@ -2157,8 +2176,12 @@ int vtkGeometryFilter::UnstructuredGridExecute(vtkDataSet* dataSetInput, vtkPoly
   output->SetPolys(polys);
   output->SetStrips(strips);
 
-  // Make sure links are built since link building is not thread safe
-  input->BuildLinks();
+  // Make sure links are built since link building is not thread safe. They
+  // are not needed if the boundary faces are read from the face adjacency.
+  if (this->FastMode || cellVis || !input->AreFaceNeighborsCurrent())
+  {
+    input->BuildLinks();
+  }
 
   // Threaded visit of each cell to extract boundary features. Each thread gathers
   // output which is then composited into the final vtkPolyData.
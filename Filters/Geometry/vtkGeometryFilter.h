@@ -56,6 +56,12 @@
  * boundary faces--thus the output is an approximation to the normal
  * execution of vtkGeometryFilter.
  *
+ * When the face adjacency of an input vtkUnstructuredGrid is current (see
+ * vtkUnstructuredGrid::BuildFaceNeighbors()), the boundary faces of the
+ * unclipped grid are read from it instead of intersecting the cell links,
+ * which are then not built. Building the adjacency once pays off when the
+ * same grid is processed by several filters, or several times.
+ *
  * Finally, this filter takes an optional second, vtkPolyData input. This
  * input represents a list of faces that are to be excluded from the output
  * of vtkGeometryFilter.
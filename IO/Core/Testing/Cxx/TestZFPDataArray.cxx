@@ -0,0 +1,269 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestZFPDataArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the accuracy and the size of the values compressed by
+// vtkZFPDataArray, reading them concurrently, writing and inserting values,
+// and the arrays compressed by vtkZFPCompressArrays.
+
+#include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkZFPCompressArrays.h"
+#include "vtkZFPDataArray.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    std::cerr << message << std::endl;
+  }
+  return condition;
+}
+
+// A smooth field with 3 components on the points of an image.
+const int Dimensions[3] = { 37, 22, 13 };
+
+template <typename ArrayT>
+void FillField(ArrayT* array)
+{
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(Dimensions[0] * Dimensions[1] * Dimensions[2]);
+  vtkIdType tupleIdx = 0;
+  for (int k = 0; k < Dimensions[2]; ++k)
+  {
+    for (int j = 0; j < Dimensions[1]; ++j)
+    {
+      for (int i = 0; i < Dimensions[0]; ++i, ++tupleIdx)
+      {
+        const double x = 0.1 * i, y = 0.15 * j, z = 0.2 * k;
+        array->SetTypedComponent(tupleIdx, 0, std::sin(x) * std::cos(y) + z);
+        array->SetTypedComponent(tupleIdx, 1, std::exp(-0.1 * (x + y + z)));
+        array->SetTypedComponent(tupleIdx, 2, 100.0 * x * y - 50.0 * z);
+      }
+    }
+  }
+}
+
+// The largest error of the values of array, relative to the range of each
+// component of expected.
+double GetMaximumError(vtkDataArray* array, vtkDataArray* expected)
+{
+  double error = 0.0;
+  for (int comp = 0; comp < expected->GetNumberOfComponents(); ++comp)
+  {
+    double range[2];
+    expected->GetRange(range, comp);
+    for (vtkIdType tupleIdx = 0; tupleIdx < expected->GetNumberOfTuples(); ++tupleIdx)
+    {
+      error = std::max(error,
+        std::abs(array->GetComponent(tupleIdx, comp) - expected->GetComponent(tupleIdx, comp)) /
+          (range[1] - range[0]));
+    }
+  }
+  return error;
+}
+
+// Reads all the values of array concurrently, in a scattered order, and
+// counts the ones which differ from values.
+struct ReadWorker
+{
+  vtkZFPDataArray<float>* Array;
+  const std::vector<float>* Values;
+  std::atomic<vtkIdType>* Errors;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const vtkIdType numValues = static_cast<vtkIdType>(this->Values->size());
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType valueIdx = (i * 7919) % numValues;
+      if (this->Array->GetValue(valueIdx) != (*this->Values)[valueIdx])
+      {
+        ++*this->Errors;
+      }
+    }
+  }
+};
+
+bool TestCompression()
+{
+  bool success = true;
+  vtkNew<vtkFloatArray> field;
+  FillField(field.GetPointer());
+
+  // Blocks of the image dimensions, and of consecutive tuples.
+  vtkNew<vtkZFPDataArray<float>> compressed;
+  compressed->SetDimensions(Dimensions[0], Dimensions[1], Dimensions[2]);
+  success &= Check(compressed->Compress(field), "Compress failed");
+  vtkNew<vtkZFPDataArray<float>> compressed1D;
+  compressed1D->SetRate(16.0);
+  compressed1D->Compress(field);
+
+  success &= Check(compressed->GetNumberOfTuples() == field->GetNumberOfTuples() &&
+      compressed->GetNumberOfComponents() == 3,
+    "Wrong shape");
+  const double error = GetMaximumError(compressed, field);
+  const double error1D = GetMaximumError(compressed1D, field);
+  success &= Check(error < 1e-2, "Compression error too large");
+  success &= Check(error1D < 1e-2, "One dimensional compression error too large");
+  // 8 and 16 bits per value, with the padding of the partial blocks and a
+  // spare word per component.
+  vtkIdType numBlocks = 1;
+  for (int i = 0; i < 3; ++i)
+  {
+    numBlocks *= (Dimensions[i] + 3) / 4;
+  }
+  success &=
+    Check(compressed->GetCompressedSize() == 3 * (numBlocks * 64 + 8), "Not compressed 4:1");
+  const vtkIdType numBlocks1D = (field->GetNumberOfTuples() + 3) / 4;
+  success &= Check(compressed1D->GetCompressedSize() <= 3 * (numBlocks1D * 8 + 16),
+    "Not compressed 2:1");
+
+  // The values read through each API and exported are the same.
+  std::vector<float> values(field->GetNumberOfValues());
+  compressed->ExportToVoidPointer(values.data());
+  const auto range = vtk::DataArrayValueRange(compressed.GetPointer());
+  success &= Check(std::equal(range.cbegin(), range.cend(), values.begin()), "Wrong values read");
+  float tuple[3];
+  compressed->GetTypedTuple(1234, tuple);
+  success &= Check(std::equal(tuple, tuple + 3, values.begin() + 3 * 1234), "Wrong tuple read");
+
+  // Concurrent reads, with caches smaller than the number of blocks.
+  compressed->SetCacheSize(8);
+  std::atomic<vtkIdType> errors(0);
+  ReadWorker worker = { compressed, &values, &errors };
+  vtkSMPTools::For(0, static_cast<vtkIdType>(values.size()), 1024, worker);
+  success &= Check(errors == 0, "Wrong values read concurrently");
+
+  // Writing a value changes its block only.
+  compressed->SetTypedComponent(1234, 2, 1000.0f);
+  success &= Check(std::abs(compressed->GetTypedComponent(1234, 2) - 1000.0f) < 10.0f,
+    "Wrong value written");
+  std::vector<float> written(values.size());
+  compressed->ExportToVoidPointer(written.data());
+  vtkIdType changed = 0;
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    changed += values[i] != written[i];
+  }
+  success &= Check(changed <= 64, "Writing a value changed other blocks");
+
+  // Copies, to compressed and regular arrays.
+  vtkNew<vtkZFPDataArray<float>> copy;
+  copy->DeepCopy(compressed);
+  std::vector<float> copied(values.size());
+  copy->ExportToVoidPointer(copied.data());
+  success &=
+    Check(copied == written && copy->GetCompressedSize() == compressed->GetCompressedSize(),
+      "Wrong compressed copy");
+  vtkSmartPointer<vtkDataArray> instance =
+    vtkSmartPointer<vtkDataArray>::Take(compressed->NewInstance());
+  vtkFloatArray* regularCopy = vtkFloatArray::SafeDownCast(instance);
+  if (!Check(regularCopy != nullptr, "NewInstance is not a regular array"))
+  {
+    return false;
+  }
+  regularCopy->DeepCopy(compressed);
+  success &= Check(std::equal(written.begin(), written.end(), regularCopy->GetPointer(0)),
+    "Wrong regular copy");
+  vtkNew<vtkZFPDataArray<double>> converted;
+  converted->DeepCopy(field);
+  success &= Check(GetMaximumError(converted, field) < 1e-3, "Wrong converted copy");
+
+  return success;
+}
+
+bool TestInsertion()
+{
+  // Tuples inserted one by one, zero initialized when skipped.
+  vtkNew<vtkZFPDataArray<double>> array;
+  array->SetNumberOfComponents(2);
+  for (int i = 0; i < 100; ++i)
+  {
+    array->InsertNextTuple2(i, -i);
+  }
+  array->InsertTuple2(150, 1.0, 2.0);
+  bool success = Check(array->GetNumberOfTuples() == 151, "Wrong number of inserted tuples");
+  for (int i = 0; i < 100; ++i)
+  {
+    success &= Check(std::abs(array->GetComponent(i, 0) - i) < 1.0 &&
+        std::abs(array->GetComponent(i, 1) + i) < 1.0,
+      "Wrong inserted tuple");
+  }
+  success &= Check(array->GetComponent(120, 0) == 0.0, "Skipped tuples are not zeros");
+  success &= Check(std::abs(array->GetComponent(150, 1) - 2.0) < 0.1, "Wrong last tuple");
+  return success;
+}
+
+bool TestFilter()
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Dimensions[0], Dimensions[1], Dimensions[2]);
+  vtkNew<vtkFloatArray> pointField;
+  FillField(pointField.GetPointer());
+  pointField->SetName("Field");
+  image->GetPointData()->SetVectors(pointField);
+  vtkNew<vtkDoubleArray> cellField;
+  cellField->SetNumberOfTuples(image->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < image->GetNumberOfCells(); ++cellId)
+  {
+    cellField->SetValue(cellId, std::cos(0.001 * cellId));
+  }
+  image->GetCellData()->SetScalars(cellField);
+
+  vtkNew<vtkZFPCompressArrays> compress;
+  compress->SetInputData(image);
+  compress->Update();
+  vtkImageData* output = vtkImageData::SafeDownCast(compress->GetOutput());
+
+  vtkDataArray* vectors = output->GetPointData()->GetVectors();
+  vtkDataArray* scalars = output->GetCellData()->GetScalars();
+  bool success = Check(vtkZFPDataArray<float>::SafeDownCast(vectors) != nullptr &&
+      vtkZFPDataArray<double>::SafeDownCast(scalars) != nullptr,
+    "Arrays not compressed");
+  if (!success)
+  {
+    return false;
+  }
+  success &= Check(std::string(vectors->GetName()) == "Field", "Wrong array name");
+  success &= Check(GetMaximumError(vectors, pointField) < 1e-2, "Wrong compressed point data");
+  success &= Check(GetMaximumError(scalars, cellField) < 1e-3, "Wrong compressed cell data");
+  success &= Check(image->GetPointData()->GetVectors() == pointField, "Input modified");
+  return success;
+}
+}
+
+int TestZFPDataArray(int, char*[])
+{
+  bool success = TestCompression();
+  success &= TestInsertion();
+  success &= TestFilter();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -27,6 +27,12 @@ void vtkDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 }
 
+//------------------------------------------------------------------------------
+void vtkDataCompressor::SetDataDescription(
+  int vtkNotUsed(dataType), const char* vtkNotUsed(arrayName))
+{
+}
+
 //------------------------------------------------------------------------------
 size_t vtkDataCompressor::Compress(unsigned char const* uncompressedData, size_t uncompressedSize,
   unsigned char* compressedData, size_t compressionSpace)
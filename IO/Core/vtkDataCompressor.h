@@ -28,6 +28,11 @@
  * should be implemented with this in mind to provide a predictable
  * compressor interface for vtkDataCompressor users.
  *
+ * @par Note:
+ * The XML writers and readers compress and decompress independent blocks
+ * concurrently with the same compressor when IsThreadSafe() returns true,
+ * and sequentially otherwise.
+ *
  * @pat Thanks:
  * Homogeneous CompressionLevel behavior contributed by Quincy Wofford
  * (qwofford@lanl.gov) and John Patchett (patchett@lanl.gov)
@@ -99,6 +104,22 @@ public:
   virtual void SetCompressionLevel(int compressionLevel) = 0;
   virtual int GetCompressionLevel() = 0;
 
+  /**
+   * Describe the data compressed by the next calls: the VTK type of its
+   * values in the native byte order, or VTK_VOID if the bytes must be kept
+   * as they are, and the name of its array. Compressors specialized for some
+   * types of values use it. The default implementation does nothing.
+   */
+  virtual void SetDataDescription(int dataType, const char* arrayName);
+
+  /**
+   * Return whether Compress() and Uncompress() may be called concurrently,
+   * i.e. whether CompressBuffer() and UncompressBuffer() do not modify the
+   * compressor. Returns false by default, so that the compressors which do
+   * not override it are called sequentially.
+   */
+  virtual bool IsThreadSafe() { return false; }
+
 protected:
   vtkDataCompressor();
   ~vtkDataCompressor() override;
@@ -54,6 +54,11 @@ public:
   vtkSetClampMacro(AccelerationLevel, int, 1, VTK_INT_MAX);
   vtkGetMacro(AccelerationLevel, int);
 
+  /**
+   * LZ4 keeps no state between calls, so the compressor is thread safe.
+   */
+  bool IsThreadSafe() override { return true; }
+
 protected:
   vtkLZ4DataCompressor();
   ~vtkLZ4DataCompressor() override;
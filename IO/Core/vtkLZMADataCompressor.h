@@ -56,6 +56,11 @@ public:
   // Compression level getter required by vtkDataCompressor.
   int GetCompressionLevel() override;
 
+  /**
+   * LZMA streams are local to each call, so the compressor is thread safe.
+   */
+  bool IsThreadSafe() override { return true; }
+
 protected:
   vtkLZMADataCompressor();
   ~vtkLZMADataCompressor() override;
@@ -0,0 +1,171 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZFPCompressArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkZFPCompressArrays.h"
+
+#include "vtkCellData.h"
+#include "vtkDataSet.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredGrid.h"
+#include "vtkZFPDataArray.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkZFPCompressArrays);
+
+namespace
+{
+// Returns a compressed copy of array, or null if it is already compressed.
+template <typename ValueType>
+vtkSmartPointer<vtkDataArray> CompressArray(
+  vtkDataArray* array, double compressionRatio, const int dimensions[3])
+{
+  if (dynamic_cast<vtkZFPDataArray<ValueType>*>(array))
+  {
+    return nullptr;
+  }
+  vtkSmartPointer<vtkZFPDataArray<ValueType>> compressed =
+    vtkSmartPointer<vtkZFPDataArray<ValueType>>::New();
+  compressed->SetRate(8.0 * sizeof(ValueType) / compressionRatio);
+  compressed->SetDimensions(dimensions);
+  compressed->DeepCopy(array);
+  return compressed;
+}
+}
+
+//------------------------------------------------------------------------------
+vtkZFPCompressArrays::vtkZFPCompressArrays()
+  : CompressionRatio(4.0)
+  , CompressPointData(true)
+  , CompressCellData(true)
+{
+}
+
+//------------------------------------------------------------------------------
+int vtkZFPCompressArrays::FillInputPortInformation(int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkZFPCompressArrays::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkDataSet* input = vtkDataSet::GetData(inputVector[0]);
+  vtkDataSet* output = vtkDataSet::GetData(outputVector);
+  output->ShallowCopy(input);
+
+  // The tuples of structured datasets are compressed in blocks of their
+  // dimensions.
+  int pointDimensions[3] = { 0, 0, 0 };
+  int cellDimensions[3] = { 0, 0, 0 };
+  if (vtkImageData* image = vtkImageData::SafeDownCast(input))
+  {
+    image->GetDimensions(pointDimensions);
+  }
+  else if (vtkRectilinearGrid* grid = vtkRectilinearGrid::SafeDownCast(input))
+  {
+    grid->GetDimensions(pointDimensions);
+  }
+  else if (vtkStructuredGrid* structuredGrid = vtkStructuredGrid::SafeDownCast(input))
+  {
+    structuredGrid->GetDimensions(pointDimensions);
+  }
+  if (pointDimensions[0] > 0)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      cellDimensions[i] = std::max(pointDimensions[i] - 1, 1);
+    }
+  }
+
+  vtkDebugMacro(<< "Compressing arrays with a ratio of " << this->CompressionRatio);
+  if (this->CompressPointData)
+  {
+    this->CompressArrays(output->GetPointData(), pointDimensions);
+  }
+  if (this->CompressCellData)
+  {
+    this->CompressArrays(output->GetCellData(), cellDimensions);
+  }
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkZFPCompressArrays::CompressArrays(vtkDataSetAttributes* data, const int dimensions[3])
+{
+  // Compress first, as replacing unnamed attributes changes the indices.
+  std::vector<std::pair<vtkSmartPointer<vtkDataArray>, int>> compressedArrays;
+  for (int i = 0; i < data->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = data->GetArray(i);
+    if (!array)
+    {
+      continue;
+    }
+    const int attribute = data->IsArrayAnAttribute(i);
+    if (!array->GetName() && attribute < 0)
+    {
+      // An unnamed array can only be replaced as an attribute.
+      continue;
+    }
+    vtkSmartPointer<vtkDataArray> compressed;
+    switch (array->GetDataType())
+    {
+      case VTK_FLOAT:
+        compressed = CompressArray<float>(array, this->CompressionRatio, dimensions);
+        break;
+      case VTK_DOUBLE:
+        compressed = CompressArray<double>(array, this->CompressionRatio, dimensions);
+        break;
+      default:
+        break;
+    }
+    if (compressed)
+    {
+      compressedArrays.push_back(std::make_pair(compressed, attribute));
+    }
+  }
+
+  for (const auto& compressed : compressedArrays)
+  {
+    if (compressed.first->GetName())
+    {
+      // Replaces the array of the same name, which keeps its attribute.
+      data->AddArray(compressed.first);
+    }
+    else
+    {
+      data->SetAttribute(compressed.first, compressed.second);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkZFPCompressArrays::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "CompressionRatio: " << this->CompressionRatio << "\n";
+  os << indent << "CompressPointData: " << (this->CompressPointData ? "On" : "Off") << "\n";
+  os << indent << "CompressCellData: " << (this->CompressCellData ? "On" : "Off") << "\n";
+}
@@ -0,0 +1,104 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZFPCompressArrays.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkZFPCompressArrays
+ * @brief   compress the float and double arrays of a dataset in memory
+ *
+ * vtkZFPCompressArrays shallow copies its input and replaces its float and
+ * double point and cell data arrays by vtkZFPDataArray, which keep them
+ * compressed with ZFP and decompress them on access. It is meant to keep more
+ * time steps of a dataset in memory, for instance in a cache of the time
+ * steps of a simulation, at the cost of a lossy compression of the values.
+ *
+ * The arrays of vtkImageData, vtkRectilinearGrid and vtkStructuredGrid are
+ * compressed in blocks of their dimensions, which compress smooth fields much
+ * more accurately than the blocks of consecutive tuples used for other
+ * datasets.
+ *
+ * The points, field data and arrays of other types are passed unchanged.
+ *
+ * @sa
+ * vtkZFPDataArray
+ */
+
+#ifndef vtkZFPCompressArrays_h
+#define vtkZFPCompressArrays_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkPassInputTypeAlgorithm.h"
+
+class vtkDataSetAttributes;
+
+class VTKIOCORE_EXPORT vtkZFPCompressArrays : public vtkPassInputTypeAlgorithm
+{
+public:
+  //@{
+  /**
+   * Standard methods to instantiate, print and obtain type-related information.
+   */
+  static vtkZFPCompressArrays* New();
+  vtkTypeMacro(vtkZFPCompressArrays, vtkPassInputTypeAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Specify the ratio of the size of the values to their compressed size.
+   * Higher ratios lose more accuracy. The default is 4, i.e. 8 bits per
+   * float value and 16 bits per double value.
+   */
+  vtkSetClampMacro(CompressionRatio, double, 1.0, 32.0);
+  vtkGetMacro(CompressionRatio, double);
+  //@}
+
+  //@{
+  /**
+   * Turn on/off the compression of the point data. On by default.
+   */
+  vtkSetMacro(CompressPointData, bool);
+  vtkGetMacro(CompressPointData, bool);
+  vtkBooleanMacro(CompressPointData, bool);
+  //@}
+
+  //@{
+  /**
+   * Turn on/off the compression of the cell data. On by default.
+   */
+  vtkSetMacro(CompressCellData, bool);
+  vtkGetMacro(CompressCellData, bool);
+  vtkBooleanMacro(CompressCellData, bool);
+  //@}
+
+protected:
+  vtkZFPCompressArrays();
+  ~vtkZFPCompressArrays() override = default;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  // Replaces the float and double arrays of data by compressed arrays of
+  // tuples laid out with the given dimensions.
+  void CompressArrays(vtkDataSetAttributes* data, const int dimensions[3]);
+
+  double CompressionRatio;
+  bool CompressPointData;
+  bool CompressCellData;
+
+private:
+  vtkZFPCompressArrays(const vtkZFPCompressArrays&) = delete;
+  void operator=(const vtkZFPCompressArrays&) = delete;
+};
+
+#endif
@@ -0,0 +1,841 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZFPDataArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#define VTK_ZFP_DATA_ARRAY_INSTANTIATING
+#include "vtkZFPDataArray.h"
+
+#include "vtkBuffer.h"
+#include "vtkLookupTable.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include "vtk_zfp.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+// Typed wrappers of the block functions of ZFP, for blocks of 1 to 3
+// dimensions. nx, ny and nz are the sizes of partial blocks.
+template <typename T>
+struct vtkZFPTraits;
+
+#define vtkZFPTraitsMacro(T)                                                                       \
+  template <>                                                                                      \
+  struct vtkZFPTraits<T>                                                                           \
+  {                                                                                                \
+    static zfp_type Type() { return zfp_type_##T; }                                                \
+    static void Encode(zfp_stream* zfp, int dims, const T* block)                                  \
+    {                                                                                              \
+      switch (dims)                                                                                \
+      {                                                                                            \
+        case 1:                                                                                    \
+          zfp_encode_block_##T##_1(zfp, block);                                                    \
+          break;                                                                                   \
+        case 2:                                                                                    \
+          zfp_encode_block_##T##_2(zfp, block);                                                    \
+          break;                                                                                   \
+        default:                                                                                   \
+          zfp_encode_block_##T##_3(zfp, block);                                                    \
+          break;                                                                                   \
+      }                                                                                            \
+    }                                                                                              \
+    static void EncodeStrided(zfp_stream* zfp, int dims, const T* p, const unsigned int n[3],      \
+      const int s[3])                                                                              \
+    {                                                                                              \
+      const bool full = n[0] == 4 && (dims < 2 || n[1] == 4) && (dims < 3 || n[2] == 4);           \
+      switch (dims)                                                                                \
+      {                                                                                            \
+        case 1:                                                                                    \
+          full ? zfp_encode_block_strided_##T##_1(zfp, p, s[0])                                    \
+               : zfp_encode_partial_block_strided_##T##_1(zfp, p, n[0], s[0]);                     \
+          break;                                                                                   \
+        case 2:                                                                                    \
+          full ? zfp_encode_block_strided_##T##_2(zfp, p, s[0], s[1])                              \
+               : zfp_encode_partial_block_strided_##T##_2(zfp, p, n[0], n[1], s[0], s[1]);         \
+          break;                                                                                   \
+        default:                                                                                   \
+          full ? zfp_encode_block_strided_##T##_3(zfp, p, s[0], s[1], s[2])                        \
+               : zfp_encode_partial_block_strided_##T##_3(                                         \
+                   zfp, p, n[0], n[1], n[2], s[0], s[1], s[2]);                                    \
+          break;                                                                                   \
+      }                                                                                            \
+    }                                                                                              \
+    static void Decode(zfp_stream* zfp, int dims, T* block)                                        \
+    {                                                                                              \
+      switch (dims)                                                                                \
+      {                                                                                            \
+        case 1:                                                                                    \
+          zfp_decode_block_##T##_1(zfp, block);                                                    \
+          break;                                                                                   \
+        case 2:                                                                                    \
+          zfp_decode_block_##T##_2(zfp, block);                                                    \
+          break;                                                                                   \
+        default:                                                                                   \
+          zfp_decode_block_##T##_3(zfp, block);                                                    \
+          break;                                                                                   \
+      }                                                                                            \
+    }                                                                                              \
+    static void DecodeStrided(                                                                     \
+      zfp_stream* zfp, int dims, T* p, const unsigned int n[3], const int s[3])                    \
+    {                                                                                              \
+      const bool full = n[0] == 4 && (dims < 2 || n[1] == 4) && (dims < 3 || n[2] == 4);           \
+      switch (dims)                                                                                \
+      {                                                                                            \
+        case 1:                                                                                    \
+          full ? zfp_decode_block_strided_##T##_1(zfp, p, s[0])                                    \
+               : zfp_decode_partial_block_strided_##T##_1(zfp, p, n[0], s[0]);                     \
+          break;                                                                                   \
+        case 2:                                                                                    \
+          full ? zfp_decode_block_strided_##T##_2(zfp, p, s[0], s[1])                              \
+               : zfp_decode_partial_block_strided_##T##_2(zfp, p, n[0], n[1], s[0], s[1]);         \
+          break;                                                                                   \
+        default:                                                                                   \
+          full ? zfp_decode_block_strided_##T##_3(zfp, p, s[0], s[1], s[2])                        \
+               : zfp_decode_partial_block_strided_##T##_3(                                         \
+                   zfp, p, n[0], n[1], n[2], s[0], s[1], s[2]);                                    \
+          break;                                                                                   \
+      }                                                                                            \
+    }                                                                                              \
+  }
+
+vtkZFPTraitsMacro(float);
+vtkZFPTraitsMacro(double);
+
+#undef vtkZFPTraitsMacro
+
+const unsigned int WordBits = 64;
+}
+
+//-----------------------------------------------------------------------------
+// The compressed values. Each component is a separate ZFP stream of
+// BlockCount blocks of BlockBits bits, which are not aligned on words: the
+// streams are written in parallel by groups of blocks starting on a word.
+template <class ValueTypeT>
+struct vtkZFPDataArray<ValueTypeT>::vtkInternals
+{
+  typedef vtkZFPTraits<ValueTypeT> Traits;
+
+  // The decompressed blocks of a thread, indexed by block and component.
+  struct ThreadCache
+  {
+    ThreadCache() = default;
+    // Each thread starts with an empty cache.
+    ThreadCache(const ThreadCache&) {}
+    ThreadCache& operator=(const ThreadCache&)
+    {
+      this->Release();
+      return *this;
+    }
+    ~ThreadCache() { this->Release(); }
+
+    void Release()
+    {
+      for (bitstream* stream : this->BitStreams)
+      {
+        stream_close(stream);
+      }
+      this->BitStreams.clear();
+      if (this->Stream)
+      {
+        zfp_stream_close(this->Stream);
+        this->Stream = nullptr;
+      }
+      this->Generation = -1;
+    }
+
+    zfp_stream* Stream = nullptr;
+    std::vector<bitstream*> BitStreams;
+    std::vector<vtkIdType> Keys;
+    std::vector<ValueTypeT> Blocks;
+    vtkIdType Generation = -1;
+  };
+
+  vtkInternals() = default;
+  ~vtkInternals()
+  {
+    if (this->AoSCopy)
+    {
+      this->AoSCopy->Delete();
+    }
+  }
+
+  // Lays out numTuples zero tuples in blocks of the dimensions of dims when
+  // they match numTuples, or in one dimensional blocks.
+  void SetLayout(vtkIdType numTuples, int numComps, const int dims[3], double rate)
+  {
+    this->NumberOfTuples = numTuples;
+    this->NumberOfComponents = numComps;
+    this->Rate = rate;
+
+    this->BlockDims = 1;
+    std::fill(this->Shape, this->Shape + 3, 1);
+    this->Shape[0] = numTuples;
+    if (dims[0] > 0 && dims[1] > 0 && dims[2] > 0 &&
+      static_cast<vtkIdType>(dims[0]) * dims[1] * dims[2] == numTuples)
+    {
+      // Squeeze the unit dimensions, which would waste 3/4 of the blocks.
+      int blockDims = 0;
+      for (int i = 0; i < 3; ++i)
+      {
+        if (dims[i] > 1)
+        {
+          this->Shape[blockDims++] = dims[i];
+        }
+      }
+      if (blockDims > 0)
+      {
+        this->BlockDims = blockDims;
+        std::fill(this->Shape + blockDims, this->Shape + 3, 1);
+      }
+    }
+
+    this->BlockSize = 1 << (2 * this->BlockDims);
+    this->BlockCount = 1;
+    for (int i = 0; i < 3; ++i)
+    {
+      this->NumberOfBlocks[i] = (this->Shape[i] + 3) / 4;
+      this->BlockCount *= this->NumberOfBlocks[i];
+    }
+
+    // Without write random access, a block takes exactly as many bits as the
+    // rate asks for, instead of a multiple of 64.
+    zfp_stream* zfp = zfp_stream_open(nullptr);
+    zfp_stream_set_rate(zfp, rate, Traits::Type(), this->BlockDims, 0);
+    unsigned int maxBits;
+    zfp_stream_params(zfp, nullptr, &maxBits, nullptr, nullptr);
+    zfp_stream_close(zfp);
+    this->BlockBits = maxBits;
+
+    this->Streams.assign(numComps, std::vector<uint64>(this->GetNumberOfWords(), 0));
+    ++this->Generation;
+  }
+
+  // Changes the number of tuples of a one dimensional layout, keeping the
+  // compressed blocks.
+  void Resize(vtkIdType numTuples)
+  {
+    this->NumberOfTuples = this->Shape[0] = numTuples;
+    this->BlockCount = this->NumberOfBlocks[0] = (numTuples + 3) / 4;
+    const size_t numBits = static_cast<size_t>(this->BlockCount) * this->BlockBits;
+    for (auto& stream : this->Streams)
+    {
+      stream.resize(this->GetNumberOfWords(), 0);
+      // Clear the bits of the removed blocks, so that the added blocks are zeros.
+      if (numBits % WordBits)
+      {
+        stream[numBits / WordBits] &= (uint64(1) << (numBits % WordBits)) - 1;
+      }
+      std::fill(stream.begin() + (numBits + WordBits - 1) / WordBits, stream.end(), uint64(0));
+    }
+    ++this->Generation;
+  }
+
+  // The number of words of the streams, with a spare word so that the tail of
+  // the last block can always be read.
+  size_t GetNumberOfWords() const
+  {
+    return (static_cast<size_t>(this->BlockCount) * this->BlockBits + WordBits - 1) / WordBits + 1;
+  }
+
+  // The number of blocks of the groups that start on a word.
+  vtkIdType GetGroupSize() const
+  {
+    vtkIdType groupSize = 1;
+    while ((groupSize * this->BlockBits) % WordBits)
+    {
+      ++groupSize;
+    }
+    return groupSize;
+  }
+
+  // The block holding a tuple and the index of the tuple in the block.
+  void Locate(vtkIdType tupleIdx, vtkIdType& blockIdx, int& inBlockIdx) const
+  {
+    if (this->BlockDims == 1)
+    {
+      blockIdx = tupleIdx >> 2;
+      inBlockIdx = static_cast<int>(tupleIdx & 3);
+      return;
+    }
+    const vtkIdType x = tupleIdx % this->Shape[0];
+    const vtkIdType yz = tupleIdx / this->Shape[0];
+    const vtkIdType y = yz % this->Shape[1];
+    const vtkIdType z = yz / this->Shape[1];
+    blockIdx = (x >> 2) + this->NumberOfBlocks[0] * ((y >> 2) + this->NumberOfBlocks[1] * (z >> 2));
+    inBlockIdx = static_cast<int>((x & 3) + 4 * ((y & 3) + 4 * (z & 3)));
+  }
+
+  // The first tuple of a block in the tuples of the layout, and the size of
+  // the block clamped to the layout.
+  vtkIdType GetBlockOrigin(vtkIdType blockIdx, unsigned int size[3]) const
+  {
+    const vtkIdType ijk[3] = { blockIdx % this->NumberOfBlocks[0],
+      (blockIdx / this->NumberOfBlocks[0]) % this->NumberOfBlocks[1],
+      blockIdx / (this->NumberOfBlocks[0] * this->NumberOfBlocks[1]) };
+    vtkIdType tupleIdx = 0;
+    vtkIdType stride = 1;
+    for (int i = 0; i < 3; ++i)
+    {
+      const vtkIdType first = 4 * ijk[i];
+      size[i] = static_cast<unsigned int>(std::min<vtkIdType>(4, this->Shape[i] - first));
+      tupleIdx += first * stride;
+      stride *= this->Shape[i];
+    }
+    return tupleIdx;
+  }
+
+  // The strides of the values of a component in an AoS array of the layout.
+  void GetStrides(int strides[3]) const
+  {
+    strides[0] = this->NumberOfComponents;
+    strides[1] = static_cast<int>(strides[0] * this->Shape[0]);
+    strides[2] = static_cast<int>(strides[1] * this->Shape[1]);
+  }
+
+  zfp_stream* OpenStream() const
+  {
+    zfp_stream* zfp = zfp_stream_open(nullptr);
+    zfp_stream_set_rate(zfp, this->Rate, Traits::Type(), this->BlockDims, 0);
+    return zfp;
+  }
+
+  bitstream* OpenBitStream(int compIdx)
+  {
+    std::vector<uint64>& stream = this->Streams[compIdx];
+    return stream_open(stream.data(), stream.size() * sizeof(uint64));
+  }
+
+  // Compresses the blocks [begin, end) of a component from AoS values. begin
+  // must be the first block of a group.
+  void Encode(const ValueTypeT* values, int compIdx, vtkIdType begin, vtkIdType end)
+  {
+    zfp_stream* zfp = this->OpenStream();
+    bitstream* stream = this->OpenBitStream(compIdx);
+    zfp_stream_set_bit_stream(zfp, stream);
+    stream_wseek(stream, static_cast<size_t>(begin) * this->BlockBits);
+    int strides[3];
+    this->GetStrides(strides);
+    unsigned int size[3];
+    for (vtkIdType blockIdx = begin; blockIdx < end; ++blockIdx)
+    {
+      const vtkIdType valueIdx =
+        this->GetBlockOrigin(blockIdx, size) * this->NumberOfComponents + compIdx;
+      Traits::EncodeStrided(zfp, this->BlockDims, values + valueIdx, size, strides);
+    }
+    stream_flush(stream);
+    stream_close(stream);
+    zfp_stream_close(zfp);
+  }
+
+  // Decompresses the blocks [begin, end) of a component into AoS values.
+  void Decode(ValueTypeT* values, int compIdx, vtkIdType begin, vtkIdType end)
+  {
+    zfp_stream* zfp = this->OpenStream();
+    bitstream* stream = this->OpenBitStream(compIdx);
+    zfp_stream_set_bit_stream(zfp, stream);
+    stream_rseek(stream, static_cast<size_t>(begin) * this->BlockBits);
+    int strides[3];
+    this->GetStrides(strides);
+    unsigned int size[3];
+    for (vtkIdType blockIdx = begin; blockIdx < end; ++blockIdx)
+    {
+      const vtkIdType valueIdx =
+        this->GetBlockOrigin(blockIdx, size) * this->NumberOfComponents + compIdx;
+      Traits::DecodeStrided(zfp, this->BlockDims, values + valueIdx, size, strides);
+    }
+    stream_close(stream);
+    zfp_stream_close(zfp);
+  }
+
+  // Compresses or decompresses groups of blocks of all the components.
+  struct EncodeFunctor
+  {
+    vtkInternals* Self;
+    const ValueTypeT* Values;
+    vtkIdType GroupSize;
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      begin *= this->GroupSize;
+      end = std::min(end * this->GroupSize, this->Self->BlockCount);
+      for (int compIdx = 0; compIdx < this->Self->NumberOfComponents; ++compIdx)
+      {
+        this->Self->Encode(this->Values, compIdx, begin, end);
+      }
+    }
+  };
+
+  struct DecodeFunctor
+  {
+    vtkInternals* Self;
+    ValueTypeT* Values;
+    vtkIdType GroupSize;
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      begin *= this->GroupSize;
+      end = std::min(end * this->GroupSize, this->Self->BlockCount);
+      for (int compIdx = 0; compIdx < this->Self->NumberOfComponents; ++compIdx)
+      {
+        this->Self->Decode(this->Values, compIdx, begin, end);
+      }
+    }
+  };
+
+  // Compresses all the tuples of the layout from AoS values.
+  void EncodeAll(const ValueTypeT* values)
+  {
+    if (this->NumberOfTuples == 0)
+    {
+      return;
+    }
+    EncodeFunctor functor = { this, values, this->GetGroupSize() };
+    vtkSMPTools::For(0, (this->BlockCount + functor.GroupSize - 1) / functor.GroupSize, functor);
+    ++this->Generation;
+  }
+
+  // Decompresses all the tuples of the layout into AoS values.
+  void DecodeAll(ValueTypeT* values)
+  {
+    if (this->NumberOfTuples == 0)
+    {
+      return;
+    }
+    DecodeFunctor functor = { this, values, this->GetGroupSize() };
+    vtkSMPTools::For(0, (this->BlockCount + functor.GroupSize - 1) / functor.GroupSize, functor);
+  }
+
+  // The cache of the calling thread, emptied if the streams changed since it
+  // was filled.
+  ThreadCache& GetLocalCache(int cacheSize)
+  {
+    ThreadCache& cache = this->Caches.Local();
+    const vtkIdType generation = this->Generation;
+    if (cache.Generation != generation || static_cast<int>(cache.Keys.size()) != cacheSize)
+    {
+      cache.Release();
+      cache.Stream = this->OpenStream();
+      for (int compIdx = 0; compIdx < this->NumberOfComponents; ++compIdx)
+      {
+        cache.BitStreams.push_back(this->OpenBitStream(compIdx));
+      }
+      cache.Keys.assign(cacheSize, -1);
+      cache.Blocks.resize(static_cast<size_t>(cacheSize) * this->BlockSize);
+      cache.Generation = generation;
+    }
+    return cache;
+  }
+
+  // The decompressed values of a block of a component.
+  ValueTypeT* GetBlock(ThreadCache& cache, int compIdx, vtkIdType blockIdx)
+  {
+    const vtkIdType key = blockIdx * this->NumberOfComponents + compIdx;
+    const size_t slot = static_cast<size_t>(key) % cache.Keys.size();
+    ValueTypeT* block = cache.Blocks.data() + slot * this->BlockSize;
+    if (cache.Keys[slot] != key)
+    {
+      bitstream* stream = cache.BitStreams[compIdx];
+      stream_rseek(stream, static_cast<size_t>(blockIdx) * this->BlockBits);
+      zfp_stream_set_bit_stream(cache.Stream, stream);
+      Traits::Decode(cache.Stream, this->BlockDims, block);
+      cache.Keys[slot] = key;
+    }
+    return block;
+  }
+
+  // Compresses the block of a component back into its stream, and replaces
+  // it by its decompressed values.
+  void SetBlock(ThreadCache& cache, int compIdx, vtkIdType blockIdx, ValueTypeT* block)
+  {
+    bitstream* stream = cache.BitStreams[compIdx];
+    zfp_stream_set_bit_stream(cache.Stream, stream);
+    const size_t begin = static_cast<size_t>(blockIdx) * this->BlockBits;
+    const size_t end = begin + this->BlockBits;
+
+    // Writing a block clears the rest of its last word, which may hold the
+    // beginning of the next block: save it, and write it back.
+    const unsigned int tailBits = static_cast<unsigned int>((WordBits - end % WordBits) % WordBits);
+    uint64 tail = 0;
+    if (tailBits)
+    {
+      stream_rseek(stream, end);
+      tail = stream_read_bits(stream, tailBits);
+    }
+    stream_wseek(stream, begin);
+    Traits::Encode(cache.Stream, this->BlockDims, block);
+    if (tailBits)
+    {
+      stream_write_bits(stream, tail, tailBits);
+    }
+    stream_flush(stream);
+
+    stream_rseek(stream, begin);
+    Traits::Decode(cache.Stream, this->BlockDims, block);
+
+    // The blocks cached by the other threads are no longer valid.
+    cache.Generation = ++this->Generation;
+  }
+
+  size_t GetCompressedSize() const
+  {
+    size_t size = 0;
+    for (const auto& stream : this->Streams)
+    {
+      size += stream.size() * sizeof(uint64);
+    }
+    return size;
+  }
+
+  vtkIdType NumberOfTuples = 0;
+  int NumberOfComponents = 1;
+  double Rate = 0.0;
+  int BlockDims = 1;
+  int BlockSize = 4;
+  vtkIdType Shape[3] = { 0, 1, 1 };
+  vtkIdType NumberOfBlocks[3] = { 0, 1, 1 };
+  vtkIdType BlockCount = 0;
+  unsigned int BlockBits = 0;
+  std::vector<std::vector<uint64>> Streams;
+
+  // Incremented each time the streams change, to invalidate the caches.
+  std::atomic<vtkIdType> Generation{ 0 };
+  vtkSMPThreadLocal<ThreadCache> Caches;
+
+  vtkBuffer<ValueTypeT>* AoSCopy = nullptr;
+};
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkZFPDataArray<ValueTypeT>* vtkZFPDataArray<ValueTypeT>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkZFPDataArray<ValueTypeT>);
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkZFPDataArray<ValueTypeT>::vtkZFPDataArray()
+  : Rate(2.0 * sizeof(ValueType))
+  , CacheSize(64)
+  , Internals(new vtkInternals)
+{
+  this->Dimensions[0] = this->Dimensions[1] = this->Dimensions[2] = 0;
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkZFPDataArray<ValueTypeT>::~vtkZFPDataArray()
+{
+  delete this->Internals;
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkZFPDataArray<ValueTypeT>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Rate: " << this->Rate << "\n";
+  os << indent << "Dimensions: (" << this->Dimensions[0] << ", " << this->Dimensions[1] << ", "
+     << this->Dimensions[2] << ")\n";
+  os << indent << "CacheSize: " << this->CacheSize << "\n";
+  os << indent << "CompressedSize: " << this->GetCompressedSize() << "\n";
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkObjectBase* vtkZFPDataArray<ValueTypeT>::NewInstanceInternal() const
+{
+  if (vtkDataArray* da = vtkDataArray::CreateDataArray(SelfType::VTK_DATA_TYPE))
+  {
+    return da;
+  }
+  return vtkAOSDataArrayTemplate<ValueType>::New();
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkZFPDataArray<ValueTypeT>::GetTypedTuple(vtkIdType tupleIdx, ValueType* tuple) const
+{
+  vtkInternals* internals = this->Internals;
+  typename vtkInternals::ThreadCache& cache = internals->GetLocalCache(this->CacheSize);
+  vtkIdType blockIdx;
+  int inBlockIdx;
+  internals->Locate(tupleIdx, blockIdx, inBlockIdx);
+  for (int compIdx = 0; compIdx < this->NumberOfComponents; ++compIdx)
+  {
+    tuple[compIdx] = internals->GetBlock(cache, compIdx, blockIdx)[inBlockIdx];
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkZFPDataArray<ValueTypeT>::SetTypedTuple(vtkIdType tupleIdx, const ValueType* tuple)
+{
+  vtkInternals* internals = this->Internals;
+  typename vtkInternals::ThreadCache& cache = internals->GetLocalCache(this->CacheSize);
+  vtkIdType blockIdx;
+  int inBlockIdx;
+  internals->Locate(tupleIdx, blockIdx, inBlockIdx);
+  for (int compIdx = 0; compIdx < this->NumberOfComponents; ++compIdx)
+  {
+    ValueType* block = internals->GetBlock(cache, compIdx, blockIdx);
+    block[inBlockIdx] = tuple[compIdx];
+    internals->SetBlock(cache, compIdx, blockIdx, block);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+typename vtkZFPDataArray<ValueTypeT>::ValueType vtkZFPDataArray<ValueTypeT>::GetTypedComponent(
+  vtkIdType tupleIdx, int compIdx) const
+{
+  vtkInternals* internals = this->Internals;
+  typename vtkInternals::ThreadCache& cache = internals->GetLocalCache(this->CacheSize);
+  vtkIdType blockIdx;
+  int inBlockIdx;
+  internals->Locate(tupleIdx, blockIdx, inBlockIdx);
+  return internals->GetBlock(cache, compIdx, blockIdx)[inBlockIdx];
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkZFPDataArray<ValueTypeT>::SetTypedComponent(
+  vtkIdType tupleIdx, int compIdx, ValueType value)
+{
+  vtkInternals* internals = this->Internals;
+  typename vtkInternals::ThreadCache& cache = internals->GetLocalCache(this->CacheSize);
+  vtkIdType blockIdx;
+  int inBlockIdx;
+  internals->Locate(tupleIdx, blockIdx, inBlockIdx);
+  ValueType* block = internals->GetBlock(cache, compIdx, blockIdx);
+  block[inBlockIdx] = value;
+  internals->SetBlock(cache, compIdx, blockIdx, block);
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkZFPDataArray<ValueTypeT>::Compress(vtkDataArray* source)
+{
+  if (!source)
+  {
+    vtkErrorMacro("Cannot compress a null array.");
+    return false;
+  }
+
+  // ZFP compresses strided AoS values of the value type.
+  vtkSmartPointer<vtkAOSDataArrayTemplate<ValueType>> values =
+    vtkAOSDataArrayTemplate<ValueType>::FastDownCast(source);
+  if (!values)
+  {
+    values = vtkSmartPointer<vtkAOSDataArrayTemplate<ValueType>>::New();
+    values->DeepCopy(source);
+  }
+
+  const vtkIdType numTuples = values->GetNumberOfTuples();
+  this->SetNumberOfComponents(values->GetNumberOfComponents());
+  this->Internals->SetLayout(numTuples, this->NumberOfComponents, this->Dimensions, this->Rate);
+  this->Internals->EncodeAll(values->GetPointer(0));
+  this->Size = numTuples * this->NumberOfComponents;
+  this->MaxId = this->Size - 1;
+  this->DataChanged();
+  this->Modified();
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkZFPDataArray<ValueTypeT>::SetCacheSize(int size)
+{
+  size = std::max(size, 1);
+  if (this->CacheSize != size)
+  {
+    this->CacheSize = size;
+    this->Modified();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+vtkIdType vtkZFPDataArray<ValueTypeT>::GetCompressedSize() const
+{
+  return static_cast<vtkIdType>(this->Internals->GetCompressedSize());
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkZFPDataArray<ValueTypeT>::DeepCopy(vtkDataArray* other)
+{
+  if (!other || other == this)
+  {
+    return;
+  }
+
+  this->vtkAbstractArray::DeepCopy(other); // copy Information object
+  SelfType* source = dynamic_cast<SelfType*>(other);
+  if (source)
+  {
+    // Copy the compressed values as they are.
+    vtkInternals* internals = this->Internals;
+    const vtkInternals* sourceInternals = source->Internals;
+    this->Rate = source->Rate;
+    std::copy(source->Dimensions, source->Dimensions + 3, this->Dimensions);
+    this->NumberOfComponents = source->NumberOfComponents;
+    internals->NumberOfTuples = sourceInternals->NumberOfTuples;
+    internals->NumberOfComponents = sourceInternals->NumberOfComponents;
+    internals->Rate = sourceInternals->Rate;
+    internals->BlockDims = sourceInternals->BlockDims;
+    internals->BlockSize = sourceInternals->BlockSize;
+    std::copy(sourceInternals->Shape, sourceInternals->Shape + 3, internals->Shape);
+    std::copy(sourceInternals->NumberOfBlocks, sourceInternals->NumberOfBlocks + 3,
+      internals->NumberOfBlocks);
+    internals->BlockCount = sourceInternals->BlockCount;
+    internals->BlockBits = sourceInternals->BlockBits;
+    internals->Streams = sourceInternals->Streams;
+    ++internals->Generation;
+    this->Size = source->Size;
+    this->MaxId = source->MaxId;
+    this->DataChanged();
+    this->Modified();
+  }
+  else
+  {
+    this->Compress(other);
+  }
+
+  this->SetLookupTable(nullptr);
+  if (other->GetLookupTable())
+  {
+    this->LookupTable = other->GetLookupTable()->NewInstance();
+    this->LookupTable->DeepCopy(other->GetLookupTable());
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void* vtkZFPDataArray<ValueTypeT>::GetVoidPointer(vtkIdType valueIdx)
+{
+  // Allow warnings to be silenced:
+  const char* silence = getenv("VTK_SILENCE_GET_VOID_POINTER_WARNINGS");
+  if (!silence)
+  {
+    vtkWarningMacro(<< "GetVoidPointer called. This is very expensive for "
+                       "compressed arrays, as all the values must be "
+                       "decompressed for each call. Using the "
+                       "vtkGenericDataArray API with vtkArrayDispatch are "
+                       "preferred. Define the environment variable "
+                       "VTK_SILENCE_GET_VOID_POINTER_WARNINGS to silence "
+                       "this warning.");
+  }
+
+  const vtkIdType numValues = this->GetNumberOfValues();
+
+  vtkBuffer<ValueType>*& aosCopy = this->Internals->AoSCopy;
+  if (!aosCopy)
+  {
+    aosCopy = vtkBuffer<ValueType>::New();
+  }
+
+  if (!aosCopy->Allocate(numValues))
+  {
+    vtkErrorMacro(<< "Error allocating a buffer of " << numValues << " '"
+                  << this->GetDataTypeAsString() << "' elements.");
+    return nullptr;
+  }
+
+  this->ExportToVoidPointer(static_cast<void*>(aosCopy->GetBuffer()));
+
+  return static_cast<void*>(aosCopy->GetBuffer() + valueIdx);
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkZFPDataArray<ValueTypeT>::ExportToVoidPointer(void* voidPtr)
+{
+  const vtkIdType numValues = this->GetNumberOfValues();
+  if (numValues == 0)
+  {
+    // Nothing to do.
+    return;
+  }
+
+  if (!voidPtr)
+  {
+    vtkErrorMacro(<< "Buffer is nullptr.");
+    return;
+  }
+
+  vtkInternals* internals = this->Internals;
+  const vtkIdType numCompressedValues = internals->NumberOfTuples * internals->NumberOfComponents;
+  if (numCompressedValues == numValues)
+  {
+    internals->DecodeAll(static_cast<ValueType*>(voidPtr));
+  }
+  else
+  {
+    // The array was allocated beyond its last value.
+    std::vector<ValueType> values(numCompressedValues);
+    internals->DecodeAll(values.data());
+    std::copy(values.begin(), values.begin() + std::min(numValues, numCompressedValues),
+      static_cast<ValueType*>(voidPtr));
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+unsigned long vtkZFPDataArray<ValueTypeT>::GetActualMemorySize() const
+{
+  const vtkBuffer<ValueType>* aosCopy = this->Internals->AoSCopy;
+  const size_t size = this->Internals->GetCompressedSize() +
+    (aosCopy ? aosCopy->GetSize() * sizeof(ValueType) : 0);
+  return static_cast<unsigned long>((size + 1023) / 1024);
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkZFPDataArray<ValueTypeT>::AllocateTuples(vtkIdType numTuples)
+{
+  // Zero bits decompress to zeros.
+  this->Internals->SetLayout(numTuples, this->NumberOfComponents, this->Dimensions, this->Rate);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkZFPDataArray<ValueTypeT>::ReallocateTuples(vtkIdType numTuples)
+{
+  vtkInternals* internals = this->Internals;
+  if (internals->BlockDims == 1 && internals->NumberOfComponents == this->NumberOfComponents)
+  {
+    internals->Resize(numTuples);
+    return true;
+  }
+
+  // Multi-dimensional blocks do not survive a change of shape: recompress.
+  std::vector<ValueType> oldValues(internals->NumberOfTuples * internals->NumberOfComponents);
+  internals->DecodeAll(oldValues.data());
+  std::vector<ValueType> values(numTuples * this->NumberOfComponents, ValueType(0));
+  std::copy(oldValues.begin(),
+    oldValues.begin() + std::min(oldValues.size(), values.size()), values.begin());
+  internals->SetLayout(numTuples, this->NumberOfComponents, this->Dimensions, this->Rate);
+  internals->EncodeAll(values.data());
+  return true;
+}
+
+template class VTKIOCORE_EXPORT vtkZFPDataArray<float>;
+template class VTKIOCORE_EXPORT vtkZFPDataArray<double>;
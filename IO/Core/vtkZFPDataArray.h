@@ -0,0 +1,225 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZFPDataArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkZFPDataArray
+ * @brief   Implementation of vtkGenericDataArray storing its values
+ * compressed with ZFP.
+ *
+ *
+ * vtkZFPDataArray<ValueType>, for float and double values, keeps each
+ * component compressed with ZFP in fixed-rate mode: every block of 4^d
+ * values takes Rate * 4^d bits, so that any block is decompressed without
+ * decompressing the others. By default the rate is a quarter of the size of
+ * the values, i.e. a 4:1 compression.
+ *
+ * The blocks are one dimensional along the tuples, or 4x4 and 4x4x4 when the
+ * tuples are the points or the cells of a structured dataset whose
+ * dimensions were given with SetDimensions(). Multi-dimensional blocks
+ * compress smooth fields much more accurately.
+ *
+ * Reading a value decompresses its block into a small cache of CacheSize
+ * blocks, so that reading the neighbouring values is cheap. Each thread has
+ * its own cache: concurrent reads are safe.
+ *
+ * Use Compress() to compress the values of another array, as
+ * vtkZFPCompressArrays does. Writing a value re-compresses its block, which
+ * is slow and, ZFP being lossy, degrades the other values of the block:
+ * writes are meant for occasional updates, and are not thread-safe.
+ *
+ * NewInstance() returns a vtkAOSDataArrayTemplate of the same value type, so
+ * that the copies the pipeline makes are regular arrays.
+ *
+ * @warning
+ * GetVoidPointer() decompresses all the values into an internal buffer at
+ * each call, as vtkSOADataArrayTemplate does.
+ *
+ * @sa
+ * vtkZFPCompressArrays vtkGenericDataArray
+ */
+
+#ifndef vtkZFPDataArray_h
+#define vtkZFPDataArray_h
+
+#include "vtkAOSDataArrayTemplate.h" // For NewInstance
+#include "vtkGenericDataArray.h"
+#include "vtkIOCoreModule.h" // For export macro
+
+#include <typeinfo> // For typeid
+
+template <class ValueTypeT>
+class VTKIOCORE_EXPORT vtkZFPDataArray
+  : public vtkGenericDataArray<vtkZFPDataArray<ValueTypeT>, ValueTypeT>
+{
+  typedef vtkGenericDataArray<vtkZFPDataArray<ValueTypeT>, ValueTypeT> GenericDataArrayType;
+
+public:
+  typedef vtkZFPDataArray<ValueTypeT> SelfType;
+  // NewInstance() returns a regular array, see NewInstanceInternal().
+  vtkAbstractTypeMacroWithNewInstanceType(SelfType, GenericDataArrayType,
+    vtkAOSDataArrayTemplate<ValueTypeT>, typeid(SelfType).name());
+  typedef typename Superclass::ValueType ValueType;
+
+  static vtkZFPDataArray* New();
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Get/Set the value at @a valueIdx. @a valueIdx assumes AOS ordering.
+   */
+  ValueType GetValue(vtkIdType valueIdx) const
+  {
+    return this->GetTypedComponent(
+      valueIdx / this->NumberOfComponents, valueIdx % this->NumberOfComponents);
+  }
+  void SetValue(vtkIdType valueIdx, ValueType value)
+  {
+    this->SetTypedComponent(
+      valueIdx / this->NumberOfComponents, valueIdx % this->NumberOfComponents, value);
+  }
+  //@}
+
+  //@{
+  /**
+   * Get/Set the tuple at @a tupleIdx.
+   */
+  void GetTypedTuple(vtkIdType tupleIdx, ValueType* tuple) const;
+  void SetTypedTuple(vtkIdType tupleIdx, const ValueType* tuple);
+  //@}
+
+  //@{
+  /**
+   * Get/Set component @a compIdx of the tuple at @a tupleIdx.
+   */
+  ValueType GetTypedComponent(vtkIdType tupleIdx, int compIdx) const;
+  void SetTypedComponent(vtkIdType tupleIdx, int compIdx, ValueType value);
+  //@}
+
+  /**
+   * Replace the values of this array by the compressed values of @a source,
+   * with its number of components and tuples. The blocks are
+   * multi-dimensional when the product of the dimensions is the number of
+   * tuples of @a source. Return false if @a source is null.
+   */
+  bool Compress(vtkDataArray* source);
+
+  //@{
+  /**
+   * Set/Get the number of compressed bits per value. ZFP rounds it so that a
+   * block takes a whole number of bits. Changing it takes effect at the next
+   * Compress(). The default is a quarter of the size of the values.
+   */
+  vtkSetClampMacro(Rate, double, 1.0, 8.0 * sizeof(ValueType));
+  vtkGetMacro(Rate, double);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the dimensions of the structured dataset whose points or cells
+   * are the tuples, in the order of vtkImageData. Changing them takes effect
+   * at the next Compress(). The default, (0, 0, 0), uses one dimensional
+   * blocks.
+   */
+  vtkSetVector3Macro(Dimensions, int);
+  vtkGetVector3Macro(Dimensions, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of decompressed blocks each thread keeps.
+   * The default is 64.
+   */
+  void SetCacheSize(int size);
+  vtkGetMacro(CacheSize, int);
+  //@}
+
+  /**
+   * Return the size of the compressed values, in bytes.
+   */
+  vtkIdType GetCompressedSize() const;
+
+  /**
+   * Copy the values and the information of @a other. The compressed values of
+   * a vtkZFPDataArray of the same type are copied as they are, other arrays
+   * are compressed.
+   */
+  using Superclass::DeepCopy;
+  void DeepCopy(vtkDataArray* other) override;
+
+  /**
+   * Use of this method is discouraged, it decompresses all the values into a
+   * contiguous AoS-ordered buffer and prints a warning.
+   */
+  void* GetVoidPointer(vtkIdType valueIdx) override;
+
+  /**
+   * Export the decompressed values in AoS ordering to the preallocated memory
+   * buffer.
+   */
+  void ExportToVoidPointer(void* ptr) override;
+
+  /**
+   * Return the memory used by the compressed values and the decompressed
+   * buffer of GetVoidPointer(), if any, in kibibytes (1024 bytes).
+   */
+  unsigned long GetActualMemorySize() const override;
+
+protected:
+  vtkZFPDataArray();
+  ~vtkZFPDataArray() override;
+
+  /**
+   * Allocate compressed space for numTuples zero tuples. Old data is not
+   * preserved.
+   */
+  bool AllocateTuples(vtkIdType numTuples);
+
+  /**
+   * Allocate compressed space for numTuples tuples. Old data is preserved.
+   */
+  bool ReallocateTuples(vtkIdType numTuples);
+
+  /**
+   * Return a vtkAOSDataArrayTemplate of the same value type, which the
+   * pipeline can copy values into.
+   */
+  vtkObjectBase* NewInstanceInternal() const override;
+
+  double Rate;
+  int Dimensions[3];
+  int CacheSize;
+
+private:
+  vtkZFPDataArray(const vtkZFPDataArray&) = delete;
+  void operator=(const vtkZFPDataArray&) = delete;
+
+  struct vtkInternals;
+  vtkInternals* Internals;
+
+  friend class vtkGenericDataArray<vtkZFPDataArray<ValueTypeT>, ValueTypeT>;
+};
+
+#endif // header guard
+
+// This portion must be OUTSIDE the include blockers. The instantiations for
+// float and double are compiled into vtkIOCore, with ZFP.
+#ifndef VTK_ZFP_DATA_ARRAY_INSTANTIATING
+#ifndef VTK_ZFP_DATA_ARRAY_EXTERN
+#define VTK_ZFP_DATA_ARRAY_EXTERN
+extern template class VTKIOCORE_EXPORT vtkZFPDataArray<float>;
+extern template class VTKIOCORE_EXPORT vtkZFPDataArray<double>;
+#endif // VTK_ZFP_DATA_ARRAY_EXTERN
+#endif
+
+// VTK-HeaderTest-Exclude: vtkZFPDataArray.h
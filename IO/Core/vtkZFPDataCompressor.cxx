@@ -0,0 +1,317 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZFPDataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkZFPDataCompressor.h"
+#include "vtkObjectFactory.h"
+
+#include "vtk_zfp.h"
+#include "vtk_zlib.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+vtkStandardNewMacro(vtkZFPDataCompressor);
+
+namespace
+{
+// The first byte of a compressed buffer tells how the rest was compressed.
+enum Codec : unsigned char
+{
+  CODEC_ZLIB = 0,
+  CODEC_ZFP = 1
+};
+
+// A ZFP stream, and a field of values of the type described.
+struct ZFPStream
+{
+  zfp_stream* Stream;
+  zfp_field* Field;
+
+  ZFPStream(zfp_type type, size_t numValues, void* values)
+    : Stream(zfp_stream_open(nullptr))
+    , Field(zfp_field_1d(values, type, static_cast<unsigned int>(numValues)))
+  {
+  }
+
+  ~ZFPStream()
+  {
+    zfp_field_free(this->Field);
+    zfp_stream_close(this->Stream);
+  }
+
+  void SetMode(int mode, double rate, int precision, double tolerance)
+  {
+    switch (mode)
+    {
+      case vtkZFPDataCompressor::FIXED_RATE:
+        zfp_stream_set_rate(this->Stream, rate, this->Field->type, 1, 0);
+        break;
+      case vtkZFPDataCompressor::FIXED_PRECISION:
+        zfp_stream_set_precision(this->Stream, static_cast<unsigned int>(precision));
+        break;
+      case vtkZFPDataCompressor::FIXED_ACCURACY:
+        zfp_stream_set_accuracy(this->Stream, tolerance);
+        break;
+      default:
+        zfp_stream_set_reversible(this->Stream);
+        break;
+    }
+  }
+
+private:
+  ZFPStream(const ZFPStream&) = delete;
+  void operator=(const ZFPStream&) = delete;
+};
+
+// Return the ZFP type of the values of a VTK type, or zfp_type_none.
+zfp_type GetZFPType(int dataType)
+{
+  switch (dataType)
+  {
+    case VTK_FLOAT:
+      return zfp_type_float;
+    case VTK_DOUBLE:
+      return zfp_type_double;
+    default:
+      return zfp_type_none;
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+vtkZFPDataCompressor::vtkZFPDataCompressor()
+{
+  this->Mode = REVERSIBLE;
+  this->Rate = 8.0;
+  this->Precision = 16;
+  this->Tolerance = 1e-3;
+  this->CompressionLevel = Z_DEFAULT_COMPRESSION;
+  this->DataType = VTK_VOID;
+  this->DataMode = -1;
+}
+
+//------------------------------------------------------------------------------
+vtkZFPDataCompressor::~vtkZFPDataCompressor() = default;
+
+//------------------------------------------------------------------------------
+void vtkZFPDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Mode: " << this->Mode << endl;
+  os << indent << "Rate: " << this->Rate << endl;
+  os << indent << "Precision: " << this->Precision << endl;
+  os << indent << "Tolerance: " << this->Tolerance << endl;
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+  os << indent << "ArrayModes: " << this->ArrayModes.size() << endl;
+}
+
+//------------------------------------------------------------------------------
+void vtkZFPDataCompressor::SetArrayMode(const char* arrayName, int mode)
+{
+  if (!arrayName)
+  {
+    return;
+  }
+  mode = std::max(static_cast<int>(FIXED_RATE), std::min(mode, static_cast<int>(REVERSIBLE)));
+  auto found = this->ArrayModes.find(arrayName);
+  if (found == this->ArrayModes.end() || found->second != mode)
+  {
+    this->ArrayModes[arrayName] = mode;
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkZFPDataCompressor::GetArrayMode(const char* arrayName)
+{
+  auto found = arrayName ? this->ArrayModes.find(arrayName) : this->ArrayModes.end();
+  return found != this->ArrayModes.end() ? found->second : this->Mode;
+}
+
+//------------------------------------------------------------------------------
+void vtkZFPDataCompressor::RemoveAllArrayModes()
+{
+  if (!this->ArrayModes.empty())
+  {
+    this->ArrayModes.clear();
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkZFPDataCompressor::SetDataDescription(int dataType, const char* arrayName)
+{
+  this->DataType = dataType;
+  auto found = arrayName ? this->ArrayModes.find(arrayName) : this->ArrayModes.end();
+  this->DataMode = found != this->ArrayModes.end() ? found->second : -1;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZFPDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+  size_t uncompressedSize, unsigned char* compressedData, size_t compressionSpace)
+{
+  if (compressionSpace < 1)
+  {
+    return 0;
+  }
+
+  const zfp_type type = GetZFPType(this->DataType);
+  const size_t valueSize = type == zfp_type_none ? 0 : zfp_type_size(type);
+  if (valueSize > 0 && uncompressedSize > 0 && uncompressedSize % valueSize == 0)
+  {
+    ZFPStream zfp(
+      type, uncompressedSize / valueSize, const_cast<unsigned char*>(uncompressedData));
+    zfp.SetMode(this->DataMode >= 0 ? this->DataMode : this->Mode, this->Rate, this->Precision,
+      this->Tolerance);
+
+    // The bit stream is written by 64-bit words, hence the aligned buffer.
+    std::vector<vtkTypeUInt64> buffer((zfp_stream_maximum_size(zfp.Stream, zfp.Field) + 7) / 8);
+    bitstream* stream = stream_open(buffer.data(), buffer.size() * sizeof(vtkTypeUInt64));
+    zfp_stream_set_bit_stream(zfp.Stream, stream);
+    zfp_stream_rewind(zfp.Stream);
+    size_t size = 0;
+    if (zfp_write_header(zfp.Stream, zfp.Field, ZFP_HEADER_FULL))
+    {
+      size = zfp_compress(zfp.Stream, zfp.Field);
+    }
+    stream_close(stream);
+
+    if (!size || size + 1 > compressionSpace)
+    {
+      vtkErrorMacro("ZFP error while compressing data.");
+      return 0;
+    }
+    compressedData[0] = CODEC_ZFP;
+    std::memcpy(compressedData + 1, buffer.data(), size);
+    return size + 1;
+  }
+
+  // Call zlib's compress function for the other values.
+  uLongf cs = static_cast<uLongf>(compressionSpace - 1);
+  if (compress2(reinterpret_cast<Bytef*>(compressedData + 1), &cs,
+        reinterpret_cast<const Bytef*>(uncompressedData), static_cast<uLong>(uncompressedSize),
+        this->CompressionLevel) != Z_OK)
+  {
+    vtkErrorMacro("Zlib error while compressing data.");
+    return 0;
+  }
+  compressedData[0] = CODEC_ZLIB;
+  return static_cast<size_t>(cs) + 1;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZFPDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+  size_t compressedSize, unsigned char* uncompressedData, size_t uncompressedSize)
+{
+  if (compressedSize < 1)
+  {
+    vtkErrorMacro("Empty compressed data.");
+    return 0;
+  }
+
+  if (compressedData[0] == CODEC_ZFP)
+  {
+    // Copy the bit stream to 64-bit words.
+    std::vector<vtkTypeUInt64> buffer((compressedSize - 1 + 7) / 8);
+    std::memcpy(buffer.data(), compressedData + 1, compressedSize - 1);
+    bitstream* stream = stream_open(buffer.data(), buffer.size() * sizeof(vtkTypeUInt64));
+    ZFPStream zfp(zfp_type_none, 0, nullptr);
+    zfp_stream_set_bit_stream(zfp.Stream, stream);
+    zfp_stream_rewind(zfp.Stream);
+
+    // The header gives the type, the number and the mode of the values.
+    size_t size = 0;
+    if (zfp_read_header(zfp.Stream, zfp.Field, ZFP_HEADER_FULL) &&
+      zfp_field_size(zfp.Field, nullptr) * zfp_type_size(zfp.Field->type) == uncompressedSize)
+    {
+      zfp_field_set_pointer(zfp.Field, uncompressedData);
+      if (zfp_decompress(zfp.Stream, zfp.Field))
+      {
+        size = uncompressedSize;
+      }
+    }
+    stream_close(stream);
+
+    if (!size)
+    {
+      vtkErrorMacro("ZFP error while uncompressing data.");
+    }
+    return size;
+  }
+  else if (compressedData[0] != CODEC_ZLIB)
+  {
+    vtkErrorMacro("Unknown compression of the data.");
+    return 0;
+  }
+
+  // Call zlib's uncompress function.
+  uLongf us = static_cast<uLongf>(uncompressedSize);
+  if (uncompress(reinterpret_cast<Bytef*>(uncompressedData), &us,
+        reinterpret_cast<const Bytef*>(compressedData + 1),
+        static_cast<uLong>(compressedSize - 1)) != Z_OK)
+  {
+    vtkErrorMacro("Zlib error while uncompressing data.");
+    return 0;
+  }
+
+  // Make sure the output size matched that expected.
+  if (us != static_cast<uLongf>(uncompressedSize))
+  {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected "
+      << uncompressedSize << " and got " << us);
+    return 0;
+  }
+
+  return static_cast<size_t>(us);
+}
+
+//------------------------------------------------------------------------------
+int vtkZFPDataCompressor::GetCompressionLevel()
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): returning CompressionLevel "
+                << this->CompressionLevel);
+  return this->CompressionLevel;
+}
+
+//------------------------------------------------------------------------------
+void vtkZFPDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  compressionLevel = std::max(1, std::min(compressionLevel, 9));
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting CompressionLevel to "
+                << compressionLevel);
+  if (this->CompressionLevel != compressionLevel)
+  {
+    this->CompressionLevel = compressionLevel;
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZFPDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  // The codec byte, and the space needed by zlib or by ZFP.
+  size_t space = static_cast<size_t>(compressBound(static_cast<uLong>(size)));
+  const zfp_type type = GetZFPType(this->DataType);
+  if (type != zfp_type_none && size >= zfp_type_size(type))
+  {
+    ZFPStream zfp(type, size / zfp_type_size(type), nullptr);
+    zfp.SetMode(this->DataMode >= 0 ? this->DataMode : this->Mode, this->Rate, this->Precision,
+      this->Tolerance);
+    space = std::max(space, zfp_stream_maximum_size(zfp.Stream, zfp.Field) + 8);
+  }
+  return space + 1;
+}
@@ -0,0 +1,176 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZFPDataCompressor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkZFPDataCompressor
+ * @brief   Data compression using ZFP for floating-point values.
+ *
+ * vtkZFPDataCompressor provides a concrete vtkDataCompressor class using
+ * ZFP to compress float and double values, in one of the ZFP modes:
+ *
+ * - FIXED_RATE: every value takes Rate bits.
+ * - FIXED_PRECISION: Precision bit planes of the values are kept.
+ * - FIXED_ACCURACY: the absolute error of the values is at most Tolerance.
+ * - REVERSIBLE: the values are compressed without loss (the default).
+ *
+ * The type of the values is given by SetDataDescription(), which the XML
+ * writers call before compressing each array. The mode of the arrays named
+ * with SetArrayMode() overrides Mode, e.g. to keep the point coordinates
+ * exact. The values of other types, such as the connectivity of the cells,
+ * or whose type is unknown, are compressed with zlib at CompressionLevel.
+ *
+ * Each compressed buffer records how it was compressed, so decompressing
+ * does not depend on the settings of the compressor.
+ *
+ * @warning
+ * ZFP streams are read in the native byte order: the files written with
+ * this compressor cannot be read on a machine of a different byte order.
+ *
+ * @sa
+ * vtkZFPDataArray vtkXMLWriter
+ */
+
+#ifndef vtkZFPDataCompressor_h
+#define vtkZFPDataCompressor_h
+
+#include "vtkDataCompressor.h"
+#include "vtkIOCoreModule.h" // For export macro
+
+#include <map>    // For ArrayModes
+#include <string> // For ArrayModes
+
+class VTKIOCORE_EXPORT vtkZFPDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkZFPDataCompressor, vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  static vtkZFPDataCompressor* New();
+
+  enum Modes
+  {
+    FIXED_RATE = 0,
+    FIXED_PRECISION,
+    FIXED_ACCURACY,
+    REVERSIBLE
+  };
+
+  //@{
+  /**
+   * Set/Get the ZFP mode of the floating-point arrays. Default is
+   * REVERSIBLE.
+   */
+  vtkSetClampMacro(Mode, int, FIXED_RATE, REVERSIBLE);
+  vtkGetMacro(Mode, int);
+  void SetModeToFixedRate() { this->SetMode(FIXED_RATE); }
+  void SetModeToFixedPrecision() { this->SetMode(FIXED_PRECISION); }
+  void SetModeToFixedAccuracy() { this->SetMode(FIXED_ACCURACY); }
+  void SetModeToReversible() { this->SetMode(REVERSIBLE); }
+  //@}
+
+  //@{
+  /**
+   * Set/Get the ZFP mode of the array named @a arrayName, which overrides
+   * Mode. RemoveAllArrayModes() restores Mode for all the arrays.
+   */
+  void SetArrayMode(const char* arrayName, int mode);
+  int GetArrayMode(const char* arrayName);
+  void RemoveAllArrayModes();
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of compressed bits per value in FIXED_RATE mode.
+   * Default is 8.
+   */
+  vtkSetClampMacro(Rate, double, 1.0, 64.0);
+  vtkGetMacro(Rate, double);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of bit planes kept in FIXED_PRECISION mode. Default
+   * is 16.
+   */
+  vtkSetClampMacro(Precision, int, 1, 64);
+  vtkGetMacro(Precision, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the maximum absolute error in FIXED_ACCURACY mode. Default is
+   * 1e-3.
+   */
+  vtkSetClampMacro(Tolerance, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(Tolerance, double);
+  //@}
+
+  /**
+   * Describe the data compressed by the next calls. Only VTK_FLOAT and
+   * VTK_DOUBLE values are compressed with ZFP.
+   */
+  void SetDataDescription(int dataType, const char* arrayName) override;
+
+  /**
+   * Get the maximum space that may be needed to store data of the
+   * given uncompressed size after compression.  This is the minimum
+   * size of the output buffer that can be passed to the four-argument
+   * Compress method.
+   */
+  size_t GetMaximumCompressionSpace(size_t size) override;
+
+  //@{
+  /**
+   * Get/Set the compression level of zlib, for the values not compressed
+   * with ZFP.
+   */
+  int GetCompressionLevel() override;
+  void SetCompressionLevel(int compressionLevel) override;
+  //@}
+
+  /**
+   * The ZFP and zlib streams are local to each call, and the data
+   * description is set before the blocks of an array are compressed, so
+   * the compressor is thread safe.
+   */
+  bool IsThreadSafe() override { return true; }
+
+protected:
+  vtkZFPDataCompressor();
+  ~vtkZFPDataCompressor() override;
+
+  int Mode;
+  double Rate;
+  int Precision;
+  double Tolerance;
+  int CompressionLevel;
+
+  std::map<std::string, int> ArrayModes;
+
+  // The type and mode of the data being compressed.
+  int DataType;
+  int DataMode;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
+    unsigned char* compressedData, size_t compressionSpace) override;
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
+    unsigned char* uncompressedData, size_t uncompressedSize) override;
+
+private:
+  vtkZFPDataCompressor(const vtkZFPDataCompressor&) = delete;
+  void operator=(const vtkZFPDataCompressor&) = delete;
+};
+
+#endif
@@ -52,6 +52,11 @@ public:
   void SetCompressionLevel(int compressionLevel) override;
   //@}
 
+  /**
+   * zlib streams are local to each call, so the compressor is thread safe.
+   */
+  bool IsThreadSafe() override { return true; }
+
 protected:
   vtkZLibDataCompressor();
   ~vtkZLibDataCompressor() override;
@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyASCIIParallelRead.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Reads an ASCII legacy file whose arrays are large enough to be parsed in
+// chunks, with tokens padded so that they span several chunks, and checks
+// the points, the cells, the arrays and the sections that follow them.
+
+#include "vtkCell.h"
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridReader.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+const int NumberOfPoints = 20000;
+
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    std::cerr << message << std::endl;
+  }
+  return condition;
+}
+
+double GetCoordinate(int i, int c)
+{
+  return ((i * 7 + c * 13) % 1001) * 0.25 - 100.0;
+}
+
+int GetId(int i)
+{
+  return (i % 2 ? -1 : 1) * i * 1000;
+}
+
+// Write a value, sometimes padded with zeros, followed by various spaces.
+void WriteValue(std::ostream& os, double value, int count)
+{
+  char digits[64];
+  std::snprintf(digits, sizeof(digits), "%.2f", value < 0 ? -value : value);
+  os << (value < 0 ? "-" : count % 5 ? "" : "+") << std::string(count % 7 ? 0 : 16, '0')
+     << digits << (count % 11 ? " " : "\n\t  ");
+}
+}
+
+int TestLegacyASCIIParallelRead(int, char*[])
+{
+  std::ostringstream content;
+  content << "# vtk DataFile Version 4.2\nchunks\nASCII\nDATASET UNSTRUCTURED_GRID\n";
+  content << "POINTS " << NumberOfPoints << " float\n";
+  for (int i = 0; i < NumberOfPoints; ++i)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      WriteValue(content, GetCoordinate(i, c), i * 3 + c);
+    }
+  }
+  const int numCells = NumberOfPoints - 1;
+  content << "\nCELLS " << numCells << " " << numCells * 3 << "\n";
+  for (int i = 0; i < numCells; ++i)
+  {
+    content << "2 " << i << " " << i + 1 << "\n";
+  }
+  content << "CELL_TYPES " << numCells << "\n";
+  for (int i = 0; i < numCells; ++i)
+  {
+    content << "3\n";
+  }
+  content << "POINT_DATA " << NumberOfPoints << "\nSCALARS ids int 1\nLOOKUP_TABLE default\n";
+  for (int i = 0; i < NumberOfPoints; ++i)
+  {
+    content << GetId(i) << (i % 9 ? " " : "\n");
+  }
+  // The denormal value is read by the stream operator.
+  content << "\nFIELD FieldData 2\nbytes 3 " << NumberOfPoints << " unsigned_char\n";
+  for (int i = 0; i < NumberOfPoints * 3; ++i)
+  {
+    content << i % 256 << " ";
+  }
+  content << "\ntiny 1 " << NumberOfPoints << " double\n";
+  for (int i = 0; i < NumberOfPoints; ++i)
+  {
+    content << (i == NumberOfPoints / 2 ? "1e-310" : "0.5") << "\n";
+  }
+
+  vtkNew<vtkUnstructuredGridReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(content.str());
+  reader->Update();
+  vtkUnstructuredGrid* output = reader->GetOutput();
+
+  bool success = Check(output->GetNumberOfPoints() == NumberOfPoints, "Wrong number of points");
+  for (int i = 0; success && i < NumberOfPoints; ++i)
+  {
+    double* point = output->GetPoint(i);
+    for (int c = 0; c < 3; ++c)
+    {
+      success &= Check(point[c] == GetCoordinate(i, c), "Wrong point");
+    }
+  }
+
+  success &= Check(output->GetNumberOfCells() == numCells, "Wrong number of cells");
+  for (int i = 0; success && i < numCells; ++i)
+  {
+    vtkCell* cell = output->GetCell(i);
+    success &= Check(cell->GetCellType() == 3 && cell->GetPointId(0) == i &&
+        cell->GetPointId(1) == i + 1,
+      "Wrong cell");
+  }
+
+  vtkDataArray* ids = output->GetPointData()->GetArray("ids");
+  vtkDataArray* bytes = output->GetPointData()->GetArray("bytes");
+  vtkDataArray* tiny = output->GetPointData()->GetArray("tiny");
+  success &= Check(ids && bytes && tiny, "Missing arrays");
+  for (int i = 0; success && i < NumberOfPoints; ++i)
+  {
+    success &= Check(ids->GetComponent(i, 0) == GetId(i), "Wrong ids");
+    for (int c = 0; c < 3; ++c)
+    {
+      success &= Check(bytes->GetComponent(i, c) == (i * 3 + c) % 256, "Wrong bytes");
+    }
+    success &=
+      Check(tiny->GetComponent(i, 0) == (i == NumberOfPoints / 2 ? 1e-310 : 0.5), "Wrong tiny");
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -45,6 +45,7 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -62,7 +63,14 @@
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cerrno>
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <locale>
 #include <sstream>
 #include <vector>
 
@@ -1468,6 +1476,373 @@ int vtkDataReader::ReadRowData(vtkTable* t, vtkIdType numEdges)
   return 1;
 }
 
+namespace
+{
+// The ASCII values of large arrays are read in chunks of at most
+// ASCIIChunkSize characters, split in pieces of about ASCIIPieceSize
+// characters parsed in parallel.
+const std::size_t ASCIIChunkSize = 1 << 22;
+const std::size_t ASCIIPieceSize = 1 << 16;
+const vtkIdType ASCIIMinimumValues = 1 << 12;
+
+// The characters skipped by the stream operators in the classic locale.
+inline bool IsASCIISpace(char c)
+{
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline bool IsASCIIDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+// vtkDataReader::Read() reads the char values through an int.
+template <class T>
+struct ASCIIReadType
+{
+  typedef T Type;
+};
+template <>
+struct ASCIIReadType<char>
+{
+  typedef int Type;
+};
+template <>
+struct ASCIIReadType<unsigned char>
+{
+  typedef int Type;
+};
+
+// Parse the decimal integer of [begin, end). Return false if it is not a
+// plain decimal integer in the range of T, so that the stream operator
+// decides what to do with it.
+template <class T>
+bool ParseASCIIInteger(const char* begin, const char* end, T& value)
+{
+  const bool negative = *begin == '-';
+  if (*begin == '-' || *begin == '+')
+  {
+    ++begin;
+  }
+  if (begin == end || (negative && !std::numeric_limits<T>::is_signed))
+  {
+    return false;
+  }
+  const long long minimum = static_cast<long long>(std::numeric_limits<T>::min());
+  const unsigned long long limit = negative
+    ? static_cast<unsigned long long>(-(minimum + 1)) + 1
+    : static_cast<unsigned long long>(std::numeric_limits<T>::max());
+  unsigned long long magnitude = 0;
+  for (; begin != end; ++begin)
+  {
+    const unsigned int digit = static_cast<unsigned int>(*begin - '0');
+    if (digit > 9 || magnitude > (limit - digit) / 10)
+    {
+      return false;
+    }
+    magnitude = magnitude * 10 + digit;
+  }
+  value = negative && magnitude != 0
+    ? static_cast<T>(-static_cast<long long>(magnitude - 1) - 1)
+    : static_cast<T>(magnitude);
+  return true;
+}
+
+// Return whether [begin, end) is a plain decimal real number, such as
+// -1.5e+3, .5 or 2.
+bool IsASCIIReal(const char* begin, const char* end)
+{
+  if (*begin == '-' || *begin == '+')
+  {
+    ++begin;
+  }
+  const char* digits = begin;
+  while (begin != end && IsASCIIDigit(*begin))
+  {
+    ++begin;
+  }
+  bool mantissa = begin != digits;
+  if (begin != end && *begin == '.')
+  {
+    digits = ++begin;
+    while (begin != end && IsASCIIDigit(*begin))
+    {
+      ++begin;
+    }
+    mantissa = mantissa || begin != digits;
+  }
+  if (!mantissa)
+  {
+    return false;
+  }
+  if (begin != end && (*begin == 'e' || *begin == 'E'))
+  {
+    ++begin;
+    if (begin != end && (*begin == '-' || *begin == '+'))
+    {
+      ++begin;
+    }
+    digits = begin;
+    while (begin != end && IsASCIIDigit(*begin))
+    {
+      ++begin;
+    }
+    if (begin == digits)
+    {
+      return false;
+    }
+  }
+  return begin == end;
+}
+
+template <class T>
+bool ParseASCIIValue(const char* begin, const char* end, T& value)
+{
+  typename ASCIIReadType<T>::Type readValue;
+  if (!ParseASCIIInteger(begin, end, readValue))
+  {
+    return false;
+  }
+  value = static_cast<T>(readValue);
+  return true;
+}
+
+// The token is followed by a space or by the null character ending the
+// chunk, so strtof() and strtod() stop at its end.
+template <>
+bool ParseASCIIValue(const char* begin, const char* end, float& value)
+{
+  if (!IsASCIIReal(begin, end))
+  {
+    return false;
+  }
+  char* last;
+  errno = 0;
+  value = std::strtof(begin, &last);
+  return last == end && errno == 0;
+}
+
+template <>
+bool ParseASCIIValue(const char* begin, const char* end, double& value)
+{
+  if (!IsASCIIReal(begin, end))
+  {
+    return false;
+  }
+  char* last;
+  errno = 0;
+  value = std::strtod(begin, &last);
+  return last == end && errno == 0;
+}
+
+// Parse the values of [begin, end) to values, up to maxValues of them.
+// Return the number of values parsed, or -1 if a token is not a plain number
+// of type T, and set last to the end of the last token parsed.
+template <class T>
+vtkIdType ParseASCIIPiece(
+  const char* begin, const char* end, T* values, vtkIdType maxValues, const char*& last)
+{
+  vtkIdType numValues = 0;
+  last = begin;
+  while (numValues < maxValues)
+  {
+    while (begin != end && IsASCIISpace(*begin))
+    {
+      ++begin;
+    }
+    if (begin == end)
+    {
+      break;
+    }
+    const char* token = begin;
+    while (begin != end && !IsASCIISpace(*begin))
+    {
+      ++begin;
+    }
+    if (!ParseASCIIValue(token, begin, values[numValues]))
+    {
+      return -1;
+    }
+    ++numValues;
+    last = begin;
+  }
+  return numValues;
+}
+
+// Parse the complete tokens of a chunk, up to maxValues of them. The chunk
+// is split at spaces in pieces whose tokens are counted, then parsed at their
+// offsets in values, in parallel. Return the number of values parsed, or -1,
+// and set used to the end of the last token parsed.
+template <class T>
+vtkIdType ParseASCIIChunk(
+  const char* chunk, std::size_t size, T* values, vtkIdType maxValues, std::size_t& used)
+{
+  std::vector<std::size_t> bounds(1, 0);
+  for (std::size_t pos = ASCIIPieceSize; pos < size; pos += ASCIIPieceSize)
+  {
+    while (pos < size && !IsASCIISpace(chunk[pos]))
+    {
+      ++pos;
+    }
+    if (pos < size && pos > bounds.back())
+    {
+      bounds.push_back(pos);
+    }
+  }
+  bounds.push_back(size);
+  const vtkIdType numPieces = static_cast<vtkIdType>(bounds.size()) - 1;
+
+  std::vector<vtkIdType> offsets(numPieces + 1, 0);
+  vtkSMPTools::For(0, numPieces, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType piece = first; piece < last; ++piece)
+    {
+      vtkIdType numTokens = 0;
+      bool space = true;
+      for (const char* c = chunk + bounds[piece]; c != chunk + bounds[piece + 1]; ++c)
+      {
+        const bool wasSpace = space;
+        space = IsASCIISpace(*c);
+        numTokens += wasSpace && !space;
+      }
+      offsets[piece + 1] = numTokens;
+    }
+  });
+  for (vtkIdType piece = 0; piece < numPieces; ++piece)
+  {
+    offsets[piece + 1] += offsets[piece];
+  }
+
+  std::vector<const char*> ends(numPieces, chunk);
+  std::atomic<bool> valid(true);
+  vtkSMPTools::For(0, numPieces, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType piece = first; piece < last && offsets[piece] < maxValues; ++piece)
+    {
+      if (ParseASCIIPiece(chunk + bounds[piece], chunk + bounds[piece + 1],
+            values + offsets[piece], maxValues - offsets[piece], ends[piece]) < 0)
+      {
+        valid = false;
+      }
+    }
+  });
+  if (!valid)
+  {
+    return -1;
+  }
+
+  const vtkIdType numValues = std::min(offsets[numPieces], maxValues);
+  used = 0;
+  for (vtkIdType piece = 0; piece < numPieces && offsets[piece] < numValues; ++piece)
+  {
+    used = static_cast<std::size_t>(ends[piece] - chunk);
+  }
+  return numValues;
+}
+
+// Read numValues ASCII values from the stream in chunks, parsed in parallel,
+// and leave the stream after the last one, as the stream operators would.
+// Return false, with the stream where it was, for the small arrays, for the
+// streams and locales that would not read plain numbers as strtod() and
+// friends do, and when a token is not a plain number of type T: the caller
+// reads the values one by one as before, so that the datasets and the errors
+// remain the same.
+template <class T>
+bool ReadASCIIChunks(istream* IS, T* data, vtkIdType numValues)
+{
+  if (numValues < ASCIIMinimumValues || !IS->good() || IS->getloc() != std::locale::classic() ||
+    (IS->flags() & (ios::basefield | ios::skipws)) != (ios::dec | ios::skipws) ||
+    std::strcmp(std::localeconv()->decimal_point, ".") != 0)
+  {
+    return false;
+  }
+  const std::streampos start = IS->tellg();
+  if (start == std::streampos(-1))
+  {
+    return false;
+  }
+
+  // A chunk holds about 16 characters per value, within bounds.
+  const std::size_t chunkSize = static_cast<std::size_t>(std::max<vtkIdType>(
+    ASCIIPieceSize, std::min<vtkIdType>(ASCIIChunkSize, numValues * 16)));
+  std::vector<char> buffer;
+  std::size_t pending = 0;
+  vtkIdType numRead = 0;
+  bool success = false;
+  while (true)
+  {
+    // The characters of an incomplete token, pending, are followed by the
+    // next chunk of the stream, and by a null character.
+    const std::streampos chunkStart = IS->tellg();
+    buffer.resize(pending + chunkSize + 1);
+    IS->read(buffer.data() + pending, static_cast<std::streamsize>(chunkSize));
+    const std::size_t size = pending + static_cast<std::size_t>(IS->gcount());
+    const bool lastChunk = size < pending + chunkSize;
+    buffer[size] = '\0';
+
+    // The tokens are complete up to the last space, or to the end of the
+    // stream.
+    std::size_t end = size;
+    while (!lastChunk && end > 0 && !IsASCIISpace(buffer[end - 1]))
+    {
+      --end;
+    }
+    std::size_t used = 0;
+    const vtkIdType numParsed =
+      end > 0 ? ParseASCIIChunk(buffer.data(), end, data + numRead, numValues - numRead, used) : 0;
+    if (numParsed < 0 || (end == 0 && !lastChunk))
+    {
+      break;
+    }
+    numRead += numParsed;
+    if (numRead == numValues)
+    {
+      IS->clear();
+      IS->seekg(chunkStart);
+      IS->ignore(static_cast<std::streamsize>(used - pending));
+      success = !IS->fail();
+      break;
+    }
+    if (lastChunk)
+    {
+      break;
+    }
+    pending = size - end;
+    std::copy(buffer.begin() + end, buffer.begin() + size, buffer.begin());
+  }
+
+  if (!success)
+  {
+    IS->clear();
+    IS->seekg(start);
+  }
+  return success;
+}
+
+// Read the ASCII legacy cells of a whole piece in chunks, if numCells cells
+// take exactly size values as declared. Otherwise, return false with the
+// stream where it was.
+bool ReadASCIILegacyCells(istream* IS, int* data, vtkIdType size, vtkIdType numCells)
+{
+  const std::streampos start = IS->tellg();
+  if (!ReadASCIIChunks(IS, data, size))
+  {
+    return false;
+  }
+  vtkIdType pos = 0;
+  vtkIdType cell = 0;
+  for (; cell < numCells && pos < size; ++cell)
+  {
+    pos += 1 + std::max(data[pos], 0);
+  }
+  if (cell == numCells && pos == size)
+  {
+    return true;
+  }
+  IS->clear();
+  IS->seekg(start);
+  return false;
+}
+}
+
 // General templated function to read data of various types.
 template <class T>
 int vtkReadBinaryData(istream* IS, T* data, vtkIdType numTuples, vtkIdType numComp)
@@ -1494,6 +1869,11 @@ int vtkReadBinaryData(istream* IS, T* data, vtkIdType numTuples, vtkIdType numCo
 template <class T>
 int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
 {
+  if (ReadASCIIChunks(self->GetIStream(), data, numTuples * numComp))
+  {
+    return 1;
+  }
+
   vtkIdType i, j;
 
   for (i = 0; i < numTuples; i++)
@@ -3221,7 +3601,7 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
     }
     vtkByteSwap::Swap4BERange(data, size);
   }
-  else // ascii
+  else if (!ReadASCIIChunks(this->IS, data, size)) // ascii
   {
     for (i = 0; i < size; i++)
     {
@@ -3297,7 +3677,7 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data, int skip1, int rea
       --read2;
     }
   }
-  else // ascii
+  else if (skip1 != 0 || skip3 != 0 || !ReadASCIILegacyCells(this->IS, data, size, read2)) // ascii
   {
     // skip cells before the piece
     for (i = 0; i < skip1; i++)
@@ -0,0 +1,198 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLBlockCompression.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the compressed XML output does not depend on the SMP backend
+// that compresses the blocks, and that the blocks decompressed concurrently
+// give back the written arrays, with each compressor and data mode. Also
+// checks that a compressor which is not thread safe is called sequentially.
+
+#include "vtkDataArray.h"
+#include "vtkDataCompressor.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+// A compressor which copies the data, and records whether it was called
+// from another thread than the one which created it.
+class CopyCompressor : public vtkDataCompressor
+{
+public:
+  static CopyCompressor* New();
+  vtkTypeMacro(CopyCompressor, vtkDataCompressor);
+
+  size_t GetMaximumCompressionSpace(size_t size) override { return size; }
+  void SetCompressionLevel(int) override {}
+  int GetCompressionLevel() override { return 1; }
+
+  std::thread::id Owner;
+  std::atomic<bool> Concurrent;
+
+protected:
+  CopyCompressor()
+    : Owner(std::this_thread::get_id())
+    , Concurrent(false)
+  {
+  }
+
+  size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
+    unsigned char* compressedData, size_t) override
+  {
+    if (std::this_thread::get_id() != this->Owner)
+    {
+      this->Concurrent = true;
+    }
+    std::memcpy(compressedData, uncompressedData, uncompressedSize);
+    return uncompressedSize;
+  }
+  size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
+    unsigned char* uncompressedData, size_t) override
+  {
+    std::memcpy(uncompressedData, compressedData, compressedSize);
+    return compressedSize;
+  }
+};
+vtkStandardNewMacro(CopyCompressor);
+
+namespace
+{
+void AddArray(vtkImageData* image, vtkDataArray* array, const char* name, int numComponents)
+{
+  const vtkIdType numTuples = image->GetNumberOfPoints();
+  array->SetName(name);
+  array->SetNumberOfComponents(numComponents);
+  array->SetNumberOfTuples(numTuples);
+  for (vtkIdType t = 0; t < numTuples; ++t)
+  {
+    for (int c = 0; c < numComponents; ++c)
+    {
+      array->SetComponent(t, c, (t * 7 + c * 13) % 251 + 0.5 * (t % 3));
+    }
+  }
+  image->GetPointData()->AddArray(array);
+}
+
+std::string Write(vtkImageData* image, int compressor, int dataMode)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->WriteToOutputStringOn();
+  writer->SetCompressorType(compressor);
+  writer->SetDataMode(dataMode);
+  writer->SetBlockSize(1024);
+  writer->Write();
+  return writer->GetOutputString();
+}
+
+bool CheckRead(vtkImageData* image, const std::string& content)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(content);
+  reader->Update();
+  vtkPointData* inputData = image->GetPointData();
+  vtkPointData* outputData = reader->GetOutput()->GetPointData();
+  for (int i = 0; i < inputData->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* input = inputData->GetArray(i);
+    vtkDataArray* output = outputData->GetArray(input->GetName());
+    if (!output || output->GetNumberOfValues() != input->GetNumberOfValues())
+    {
+      std::cerr << "Array " << input->GetName() << " not read" << std::endl;
+      return false;
+    }
+    for (vtkIdType v = 0; v < input->GetNumberOfValues(); ++v)
+    {
+      if (output->GetVariantValue(v) != input->GetVariantValue(v))
+      {
+        std::cerr << "Wrong value " << v << " of the array " << input->GetName() << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLBlockCompression(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(32, 24, 9);
+  vtkNew<vtkFloatArray> floats;
+  AddArray(image, floats, "floats", 3);
+  vtkNew<vtkDoubleArray> doubles;
+  AddArray(image, doubles, "doubles", 1);
+  vtkNew<vtkIdTypeArray> ids;
+  AddArray(image, ids, "ids", 2);
+  vtkNew<vtkUnsignedCharArray> bytes;
+  AddArray(image, bytes, "bytes", 4);
+
+  bool success = true;
+  for (int compressor : { vtkXMLWriter::ZLIB, vtkXMLWriter::LZ4, vtkXMLWriter::LZMA })
+  {
+    for (int dataMode : { vtkXMLWriter::Binary, vtkXMLWriter::Appended })
+    {
+      // The Sequential backend comes first and gives the reference output.
+      std::string reference;
+      vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+        const std::string content = Write(image, compressor, dataMode);
+        if (backend == "Sequential")
+        {
+          reference = content;
+        }
+        else if (content != reference)
+        {
+          std::cerr << "Output of the compressor " << compressor << " differs with the "
+                    << backend << " backend" << std::endl;
+          success = false;
+        }
+        success &= CheckRead(image, content);
+      });
+    }
+  }
+
+  // A compressor which is not thread safe is called sequentially, whatever
+  // the backend.
+  vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+    vtkNew<CopyCompressor> copyCompressor;
+    vtkNew<vtkXMLImageDataWriter> writer;
+    writer->SetInputData(image);
+    writer->WriteToOutputStringOn();
+    writer->SetCompressor(copyCompressor);
+    writer->SetBlockSize(64);
+    writer->Write();
+    if (copyCompressor->Concurrent)
+    {
+      std::cerr << "A compressor which is not thread safe was called concurrently with the "
+                << backend << " backend" << std::endl;
+      success = false;
+    }
+  });
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,124 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompressedSubExtent.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the sub-extents read from compressed image data, by slices or by
+// rows spanning several small blocks, in each data mode.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+void AddArray(vtkImageData* image, vtkDataArray* array, const char* name, int numComponents)
+{
+  const vtkIdType numTuples = image->GetNumberOfPoints();
+  array->SetName(name);
+  array->SetNumberOfComponents(numComponents);
+  array->SetNumberOfTuples(numTuples);
+  for (vtkIdType t = 0; t < numTuples; ++t)
+  {
+    for (int c = 0; c < numComponents; ++c)
+    {
+      array->SetComponent(t, c, t * 3 + c);
+    }
+  }
+  image->GetPointData()->AddArray(array);
+}
+
+bool CheckSubExtent(
+  vtkImageData* image, const std::string& content, const int extent[6], bool wholeSlices)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(content);
+  reader->SetWholeSlices(wholeSlices);
+  static_cast<vtkAlgorithm*>(reader)->UpdateExtent(extent);
+  vtkImageData* output = reader->GetOutput();
+
+  int* outExtent = output->GetExtent();
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        int ijk[3] = { i, j, k };
+        const vtkIdType inputId = image->ComputePointId(ijk);
+        const vtkIdType outputId = (i - outExtent[0]) +
+          (outExtent[1] - outExtent[0] + 1) *
+            ((j - outExtent[2]) + (outExtent[3] - outExtent[2] + 1) * (k - outExtent[4]));
+        for (int a = 0; a < image->GetPointData()->GetNumberOfArrays(); ++a)
+        {
+          vtkDataArray* input = image->GetPointData()->GetArray(a);
+          vtkDataArray* read = output->GetPointData()->GetArray(input->GetName());
+          for (int c = 0; c < input->GetNumberOfComponents(); ++c)
+          {
+            if (!read || read->GetComponent(outputId, c) != input->GetComponent(inputId, c))
+            {
+              std::cerr << "Wrong value of the point " << i << " " << j << " " << k
+                        << " in the array " << input->GetName() << std::endl;
+              return false;
+            }
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLCompressedSubExtent(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(33, 17, 9);
+  vtkNew<vtkFloatArray> floats;
+  AddArray(image, floats, "floats", 3);
+  vtkNew<vtkDoubleArray> doubles;
+  AddArray(image, doubles, "doubles", 1);
+
+  const int extents[][6] = { { 0, 32, 0, 16, 4, 4 }, { 5, 20, 3, 11, 2, 6 }, { 0, 32, 2, 9, 0, 8 },
+    { 32, 32, 16, 16, 8, 8 } };
+
+  bool success = true;
+  for (int dataMode : { vtkXMLWriter::Binary, vtkXMLWriter::Appended })
+  {
+    vtkNew<vtkXMLImageDataWriter> writer;
+    writer->SetInputData(image);
+    writer->WriteToOutputStringOn();
+    writer->SetDataMode(dataMode);
+    writer->SetCompressorTypeToZLib();
+    writer->SetBlockSize(200);
+    writer->Write();
+    const std::string content = writer->GetOutputString();
+
+    for (const auto& extent : extents)
+    {
+      success &= CheckSubExtent(image, content, extent, true);
+      success &= CheckSubExtent(image, content, extent, false);
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,209 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLMappedAppendedData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the arrays read with MapAppendedData use the values of the
+// file in place when they are raw and in the native byte order, that
+// modifying them does not modify the file, and that the other arrays, byte
+// orders and extents are read as usual.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkStringArray.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLDataElement.h"
+#include "vtkXMLDataParser.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    std::cerr << message << std::endl;
+  }
+  return condition;
+}
+
+void AddArray(vtkImageData* image, vtkDataArray* array, const char* name, int numComponents)
+{
+  const vtkIdType numTuples = image->GetNumberOfPoints();
+  array->SetName(name);
+  array->SetNumberOfComponents(numComponents);
+  array->SetNumberOfTuples(numTuples);
+  for (vtkIdType t = 0; t < numTuples; ++t)
+  {
+    for (int c = 0; c < numComponents; ++c)
+    {
+      array->SetComponent(t, c, (t * 7 + c * 13) % 251 + 0.5 * (t % 3));
+    }
+  }
+  image->GetPointData()->AddArray(array);
+}
+
+void Write(vtkImageData* image, const std::string& fileName, int byteOrder, int headerType)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorTypeToNone();
+  writer->SetByteOrder(byteOrder);
+  writer->SetHeaderType(headerType);
+  writer->Write();
+}
+
+bool CheckValues(vtkImageData* image, vtkImageData* output)
+{
+  vtkPointData* inputData = image->GetPointData();
+  vtkPointData* outputData = output->GetPointData();
+  for (int i = 0; i < inputData->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* input = inputData->GetAbstractArray(i);
+    vtkAbstractArray* read = outputData->GetAbstractArray(input->GetName());
+    if (!read || read->GetNumberOfValues() != input->GetNumberOfValues())
+    {
+      std::cerr << "Array " << input->GetName() << " not read" << std::endl;
+      return false;
+    }
+    for (vtkIdType v = 0; v < input->GetNumberOfValues(); ++v)
+    {
+      if (read->GetVariantValue(v) != input->GetVariantValue(v))
+      {
+        std::cerr << "Wrong value " << v << " of the array " << input->GetName() << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Return the appended data offset of the named point data array.
+vtkTypeInt64 GetOffset(vtkXMLImageDataReader* reader, const char* name)
+{
+  vtkXMLDataElement* ePointData = reader->GetXMLParser()
+                                    ->GetRootElement()
+                                    ->LookupElementWithName("Piece")
+                                    ->FindNestedElementWithName("PointData");
+  vtkTypeInt64 offset = -1;
+  ePointData->FindNestedElementWithNameAndAttribute("DataArray", "Name", name)
+    ->GetScalarAttribute("offset", offset);
+  return offset;
+}
+}
+
+int TestXMLMappedAppendedData(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fileName = std::string(tempDir) + "/TestXMLMappedAppendedData.vti";
+  delete[] tempDir;
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(20, 10, 5);
+  vtkNew<vtkUnsignedCharArray> bytes;
+  AddArray(image, bytes, "bytes", 3);
+  vtkNew<vtkFloatArray> floats;
+  AddArray(image, floats, "floats", 3);
+  vtkNew<vtkDoubleArray> doubles;
+  AddArray(image, doubles, "doubles", 1);
+  vtkNew<vtkIdTypeArray> ids;
+  AddArray(image, ids, "ids", 2);
+  vtkNew<vtkStringArray> strings;
+  strings->SetName("strings");
+  strings->SetNumberOfValues(image->GetNumberOfPoints());
+  for (vtkIdType v = 0; v < strings->GetNumberOfValues(); ++v)
+  {
+    strings->SetValue(v, std::to_string(v));
+  }
+  image->GetPointData()->AddArray(strings);
+
+#ifdef VTK_WORDS_BIGENDIAN
+  const int nativeOrder = vtkXMLWriter::BigEndian;
+  const int swappedOrder = vtkXMLWriter::LittleEndian;
+#else
+  const int nativeOrder = vtkXMLWriter::LittleEndian;
+  const int swappedOrder = vtkXMLWriter::BigEndian;
+#endif
+
+  bool success = true;
+  for (int headerType : { vtkXMLWriter::UInt32, vtkXMLWriter::UInt64 })
+  {
+    Write(image, fileName, nativeOrder, headerType);
+    {
+      vtkNew<vtkXMLImageDataReader> reader;
+      reader->SetFileName(fileName.c_str());
+      reader->MapAppendedDataOn();
+      reader->Update();
+      vtkPointData* outputData = reader->GetOutput()->GetPointData();
+      success &= CheckValues(image, reader->GetOutput());
+
+      // The mapped arrays are as far apart in memory as in the file.
+      const char* floatValues =
+        static_cast<char*>(outputData->GetArray("floats")->GetVoidPointer(0));
+      for (const char* name : { "bytes", "doubles", "ids" })
+      {
+        const char* values = static_cast<char*>(outputData->GetArray(name)->GetVoidPointer(0));
+        success &=
+          Check(values - floatValues == GetOffset(reader, name) - GetOffset(reader, "floats"),
+            "The values are not mapped in place");
+      }
+
+      // Modifying the values copies them.
+      outputData->GetArray("doubles")->SetComponent(3, 0, -1.0);
+    }
+    vtkNew<vtkXMLImageDataReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->MapAppendedDataOn();
+    reader->Update();
+    success &= Check(CheckValues(image, reader->GetOutput()), "The file was modified");
+  }
+
+  // The values in another byte order are read as usual.
+  Write(image, fileName, swappedOrder, vtkXMLWriter::UInt32);
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->MapAppendedDataOn();
+  reader->Update();
+  success &= CheckValues(image, reader->GetOutput());
+
+  // The pieces are read as usual.
+  image->GetPointData()->RemoveArray("strings");
+  Write(image, fileName, nativeOrder, vtkXMLWriter::UInt32);
+  vtkNew<vtkXMLImageDataReader> pieceReader;
+  pieceReader->SetFileName(fileName.c_str());
+  pieceReader->MapAppendedDataOn();
+  pieceReader->UpdatePiece(1, 2, 0);
+  vtkImageData* piece = pieceReader->GetOutput();
+  int* extent = piece->GetExtent();
+  int ijk[3] = { extent[0], extent[2], extent[4] };
+  success &= Check(piece->GetNumberOfPoints() < image->GetNumberOfPoints() &&
+      piece->GetPointData()->GetArray("doubles")->GetComponent(0, 0) ==
+        doubles->GetComponent(image->ComputePointId(ijk), 0),
+    "Wrong piece");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,181 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLZFPCompression.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes an unstructured grid with vtkZFPDataCompressor and checks the
+// values read back: exact for the integer arrays, the connectivity and the
+// arrays in reversible mode, within the tolerance in fixed-accuracy mode.
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkWeakPointer.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+#include "vtkZFPDataCompressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    std::cerr << message << std::endl;
+  }
+  return condition;
+}
+
+// Return the largest difference between the values of two arrays, or -1 if
+// the second one is missing or has another size.
+double GetMaximumError(vtkDataArray* expected, vtkDataArray* actual)
+{
+  if (!actual || actual->GetNumberOfValues() != expected->GetNumberOfValues())
+  {
+    return -1.0;
+  }
+  double error = 0.0;
+  const int numComponents = expected->GetNumberOfComponents();
+  for (vtkIdType v = 0; v < expected->GetNumberOfValues(); ++v)
+  {
+    const double difference = expected->GetComponent(v / numComponents, v % numComponents) -
+      actual->GetComponent(v / numComponents, v % numComponents);
+    error = std::max(error, std::fabs(difference));
+  }
+  return error;
+}
+
+void FillGrid(vtkUnstructuredGrid* grid)
+{
+  const int size = 40;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkFloatArray> smooth;
+  smooth->SetName("smooth");
+  vtkNew<vtkDoubleArray> exact;
+  exact->SetName("exact");
+  exact->SetNumberOfComponents(3);
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("ids");
+  for (int j = 0; j < size; ++j)
+  {
+    for (int i = 0; i < size; ++i)
+    {
+      const double x = 0.1 * i + 0.001 * j * j;
+      const double y = 0.1 * j;
+      points->InsertNextPoint(x, y, 0.05 * std::sin(x) * std::cos(y));
+      smooth->InsertNextValue(static_cast<float>(std::sin(0.2 * i) * std::cos(0.3 * j)));
+      exact->InsertNextTuple3(x, y, std::exp(-x * y));
+      ids->InsertNextValue(i * 1000 + j);
+    }
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->AddArray(smooth);
+  grid->GetPointData()->AddArray(exact);
+  grid->GetPointData()->AddArray(ids);
+
+  grid->Allocate((size - 1) * (size - 1));
+  for (int j = 0; j + 1 < size; ++j)
+  {
+    for (int i = 0; i + 1 < size; ++i)
+    {
+      const vtkIdType quad[4] = { j * size + i, j * size + i + 1, (j + 1) * size + i + 1,
+        (j + 1) * size + i };
+      grid->InsertNextCell(VTK_QUAD, 4, quad);
+    }
+  }
+}
+
+std::string Write(vtkUnstructuredGrid* grid, int smoothMode)
+{
+  vtkNew<vtkXMLUnstructuredGridWriter> writer;
+  writer->SetInputData(grid);
+  writer->WriteToOutputStringOn();
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetCompressorTypeToZFP();
+  writer->SetBlockSize(4096);
+  vtkZFPDataCompressor* compressor = vtkZFPDataCompressor::SafeDownCast(writer->GetCompressor());
+  compressor->SetModeToFixedAccuracy();
+  compressor->SetTolerance(1e-4);
+  compressor->SetArrayMode("smooth", smoothMode);
+  compressor->SetArrayMode("exact", vtkZFPDataCompressor::REVERSIBLE);
+  compressor->SetArrayMode("Points", vtkZFPDataCompressor::REVERSIBLE);
+  writer->Write();
+  return writer->GetOutputString();
+}
+}
+
+int TestXMLZFPCompression(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  FillGrid(grid);
+
+  const std::string content = Write(grid, vtkZFPDataCompressor::FIXED_ACCURACY);
+  vtkNew<vtkXMLUnstructuredGridReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(content);
+  reader->Update();
+  vtkUnstructuredGrid* output = reader->GetOutput();
+
+  bool success = true;
+  success &= Check(output->GetNumberOfPoints() == grid->GetNumberOfPoints() &&
+      GetMaximumError(grid->GetPoints()->GetData(), output->GetPoints()->GetData()) == 0.0,
+    "Wrong points");
+  success &=
+    Check(GetMaximumError(grid->GetCells()->GetConnectivityArray(),
+            output->GetCells()->GetConnectivityArray()) == 0.0 &&
+        GetMaximumError(grid->GetCells()->GetOffsetsArray(), output->GetCells()->GetOffsetsArray()) ==
+          0.0,
+      "Wrong cells");
+  vtkPointData* inputData = grid->GetPointData();
+  vtkPointData* outputData = output->GetPointData();
+  success &= Check(GetMaximumError(inputData->GetArray("ids"), outputData->GetArray("ids")) == 0.0,
+    "Wrong integer values");
+  success &=
+    Check(GetMaximumError(inputData->GetArray("exact"), outputData->GetArray("exact")) == 0.0,
+      "Wrong values in reversible mode");
+  const double error =
+    GetMaximumError(inputData->GetArray("smooth"), outputData->GetArray("smooth"));
+  success &= Check(error >= 0.0 && error <= 1e-4, "Values beyond the tolerance");
+
+  // Selecting the same compressor type again keeps the per-array modes,
+  // selecting another one releases the current compressor.
+  vtkNew<vtkXMLUnstructuredGridWriter> writer;
+  writer->SetCompressorTypeToZFP();
+  vtkWeakPointer<vtkZFPDataCompressor> compressor =
+    vtkZFPDataCompressor::SafeDownCast(writer->GetCompressor());
+  compressor->SetArrayMode("exact", vtkZFPDataCompressor::REVERSIBLE);
+  writer->SetCompressorTypeToZFP();
+  success &= Check(writer->GetCompressor() == compressor &&
+      compressor->GetArrayMode("exact") == vtkZFPDataCompressor::REVERSIBLE,
+    "The compressor was replaced");
+  writer->SetCompressorTypeToZLib();
+  success &= Check(compressor == nullptr, "The compressor was not released");
+
+  // The lossy mode takes less space than the reversible one.
+  const std::string reversibleContent = Write(grid, vtkZFPDataCompressor::REVERSIBLE);
+  success &= Check(content.size() < reversibleContent.size(), "The lossy mode is not smaller");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -43,6 +43,7 @@
 #include "vtkXMLDataParser.h"
 #include "vtkXMLFileReadTester.h"
 #include "vtkXMLReaderVersion.h"
+#include "vtkZFPDataCompressor.h"
 #include "vtkZLibDataCompressor.h"
 
 #include "vtksys/Encoding.hxx"
@@ -54,12 +55,125 @@
 #include <cctype>
 #include <functional>
 #include <locale> // C++ locale
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <vector>
 
+#if defined(_WIN32)
+#include "vtkWindows.h" // for the file mapping
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 vtkCxxSetObjectMacro(vtkXMLReader, ReaderErrorObserver, vtkCommand);
 vtkCxxSetObjectMacro(vtkXMLReader, ParserErrorObserver, vtkCommand);
 
+//------------------------------------------------------------------------------
+// A file mapped in memory copy-on-write.  It stays mapped as long as the
+// reader that opened it, or an array using its values, exists.
+class vtkXMLReaderMappedFile
+{
+public:
+  // The mapped file, or nullptr if the file could not be mapped.
+  char* Data = nullptr;
+  vtkTypeUInt64 Size = 0;
+
+  explicit vtkXMLReaderMappedFile(const char* fileName)
+  {
+#if defined(_WIN32)
+    HANDLE file = CreateFileW(vtksys::Encoding::ToWindowsExtendedPath(fileName).c_str(),
+      GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return;
+    }
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+      HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+      if (mapping)
+      {
+        this->Data = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+        this->Size = this->Data ? static_cast<vtkTypeUInt64>(size.QuadPart) : 0;
+        CloseHandle(mapping);
+      }
+    }
+    CloseHandle(file);
+#else
+    int file = open(fileName, O_RDONLY);
+    if (file < 0)
+    {
+      return;
+    }
+    struct stat status;
+    if (fstat(file, &status) == 0 && status.st_size > 0)
+    {
+      void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ | PROT_WRITE,
+        MAP_PRIVATE, file, 0);
+      if (data != MAP_FAILED)
+      {
+        this->Data = static_cast<char*>(data);
+        this->Size = static_cast<vtkTypeUInt64>(status.st_size);
+      }
+    }
+    close(file);
+#endif
+  }
+
+  ~vtkXMLReaderMappedFile()
+  {
+    if (this->Data)
+    {
+#if defined(_WIN32)
+      UnmapViewOfFile(this->Data);
+#else
+      munmap(this->Data, static_cast<size_t>(this->Size));
+#endif
+    }
+  }
+
+  // Keep the file mapped until Release() is called for the given values.
+  static void Register(void* values, const std::shared_ptr<vtkXMLReaderMappedFile>& file)
+  {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    registry.Files.insert(std::make_pair(values, file));
+  }
+
+  // The free function of the arrays using mapped values.
+  static void Release(void* values)
+  {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    auto found = registry.Files.find(values);
+    if (found != registry.Files.end())
+    {
+      registry.Files.erase(found);
+    }
+  }
+
+private:
+  // The files mapped for each array using their values.  The arrays
+  // released while the program exits may outlive a static registry.
+  struct Registry
+  {
+    std::mutex Mutex;
+    std::multimap<void*, std::shared_ptr<vtkXMLReaderMappedFile>> Files;
+  };
+  static Registry& GetRegistry()
+  {
+    static Registry* registry = new Registry;
+    return *registry;
+  }
+
+  vtkXMLReaderMappedFile(const vtkXMLReaderMappedFile&) = delete;
+  void operator=(const vtkXMLReaderMappedFile&) = delete;
+};
+
 //------------------------------------------------------------------------------
 #define CaseIdTypeMacro(type, size)                                                                \
   case type:                                                                                       \
@@ -138,6 +252,7 @@ vtkXMLReader::vtkXMLReader()
   this->StringStream = nullptr;
   this->ReadFromInputString = 0;
   this->InputString = "";
+  this->MapAppendedData = 0;
   this->XMLParser = nullptr;
   this->ReaderErrorObserver = nullptr;
   this->ParserErrorObserver = nullptr;
@@ -233,6 +348,7 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Stream: (none)\n";
   }
+  os << indent << "MapAppendedData: " << this->MapAppendedData << "\n";
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "ActiveTimeDataArrayName:"
      << (this->ActiveTimeDataArrayName ? this->ActiveTimeDataArrayName : "(null)") << "\n";
@@ -391,6 +507,7 @@ void vtkXMLReader::CloseVTKFile()
     delete this->FileStream;
     this->FileStream = nullptr;
   }
+  this->MappedFile.reset();
 }
 
 //------------------------------------------------------------------------------
@@ -458,6 +575,10 @@ void vtkXMLReader::SetupCompressor(const char* type)
     {
       compressor = vtkLZMADataCompressor::New();
     }
+    else if (strcmp(type, "vtkZFPDataCompressor") == 0)
+    {
+      compressor = vtkZFPDataCompressor::New();
+    }
   }
 
   if (!compressor)
@@ -876,12 +997,19 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
                                << arrayIndex + numValues << " were requested to be read");
     return 0;
   }
-  switch (array->GetDataType())
+  if (this->MapAppendedData && this->MapArrayValues(da, arrayIndex, array, startIndex, numValues))
   {
-    vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-                                    arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-    default:
-      result = 0;
+    result = 1;
+  }
+  else
+  {
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
+                                      arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
+      default:
+        result = 0;
+    }
   }
   if (iter)
   {
@@ -901,6 +1029,48 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   return result;
 }
 
+//------------------------------------------------------------------------------
+bool vtkXMLReader::MapArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
+  vtkAbstractArray* array, vtkIdType startIndex, vtkIdType numValues)
+{
+  // Only the whole arrays of contiguous values in the appended data of a
+  // file are mapped.
+  vtkTypeInt64 offset = 0;
+  if (arrayIndex != 0 || startIndex != 0 || numValues <= 0 ||
+    numValues != array->GetNumberOfValues() ||
+    array->GetArrayType() != vtkAbstractArray::AoSDataArrayTemplate || !this->FileStream ||
+    this->Stream != this->FileStream || !da->GetScalarAttribute("offset", offset))
+  {
+    return false;
+  }
+
+  // The values must be stored as they are in memory, and aligned.
+  const int wordType = array->GetDataType();
+  const vtkTypeInt64 wordSize = array->GetDataTypeSize();
+  const vtkTypeInt64 position =
+    this->XMLParser->GetRawAppendedDataPosition(offset, static_cast<size_t>(numValues), wordType);
+  if (position < 0 || position % wordSize != 0)
+  {
+    return false;
+  }
+
+  if (!this->MappedFile)
+  {
+    this->MappedFile = std::make_shared<vtkXMLReaderMappedFile>(this->FileName);
+  }
+  if (!this->MappedFile->Data ||
+    static_cast<vtkTypeUInt64>(position + numValues * wordSize) > this->MappedFile->Size)
+  {
+    return false;
+  }
+
+  char* values = this->MappedFile->Data + position;
+  vtkXMLReaderMappedFile::Register(values, this->MappedFile);
+  array->SetVoidArray(values, numValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  array->SetArrayFreeFunction(&vtkXMLReaderMappedFile::Release);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 void vtkXMLReader::ReadXMLData()
 {
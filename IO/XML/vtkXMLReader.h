@@ -27,6 +27,7 @@
 #include "vtkAlgorithm.h"
 #include "vtkIOXMLModule.h" // For export macro
 
+#include <memory> // for std::shared_ptr
 #include <string> // for std::string
 #include <vector>
 
@@ -41,6 +42,7 @@ class vtkXMLDataParser;
 class vtkInformationVector;
 class vtkInformation;
 class vtkStringArray;
+class vtkXMLReaderMappedFile;
 
 class VTKIOXML_EXPORT vtkXMLReader : public vtkAlgorithm
 {
@@ -73,6 +75,25 @@ public:
   void SetInputString(const std::string& s) { this->InputString = s; }
   //@}
 
+  //@{
+  /**
+   * Enable mapping the input file in memory to read its appended data.  The
+   * data arrays whose values are stored raw, not compressed and in the
+   * native byte order, as written with EncodeAppendedData off and no
+   * compressor, then use the mapped values in place instead of a copy: the
+   * operating system reads the values from the file, or its cache, only
+   * when they are accessed.  The file is mapped copy-on-write, so modifying
+   * the values of such an array never modifies the file.  The other arrays
+   * are read as usual.  Default is off.
+   *
+   * @warning The file must not be truncated or overwritten while the arrays
+   * read from it are in use.
+   */
+  vtkSetMacro(MapAppendedData, vtkTypeBool);
+  vtkGetMacro(MapAppendedData, vtkTypeBool);
+  vtkBooleanMacro(MapAppendedData, vtkTypeBool);
+  //@}
+
   /**
    * Test whether the file (type) with the given name can be read by this
    * reader. If the file has a newer version than the reader, we still say
@@ -345,6 +366,9 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether the raw appended data is mapped in memory instead of read.
+  vtkTypeBool MapAppendedData;
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
@@ -427,6 +451,13 @@ private:
   istream* FileStream;
   // The stream used to read the input if it is in a string.
   std::istringstream* StringStream;
+  // The input file mapped in memory, while it is open.
+  std::shared_ptr<vtkXMLReaderMappedFile> MappedFile;
+
+  // Use the values of the input file mapped in memory for the whole array,
+  // if they are stored as they are in memory.  Returns false otherwise.
+  bool MapArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
+    vtkIdType startIndex, vtkIdType numValues);
   int TimeStepWasReadOnce;
 
   int FileMajorVersion;
@@ -45,9 +45,12 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
+#include "vtkZFPDataCompressor.h"
 #include "vtkZLibDataCompressor.h"
 #define vtkXMLOffsetsManager_DoNotInclude
 #include "vtkXMLOffsetsManager.h"
@@ -63,6 +66,7 @@
 #include "vtkXMLReaderVersion.h"
 #include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
+#include <algorithm>
 #include <memory>
 
 #include <cassert>
@@ -514,49 +518,53 @@ vtkXMLWriter::~vtkXMLWriter()
 //------------------------------------------------------------------------------
 void vtkXMLWriter::SetCompressorType(int compressorType)
 {
+  // Keep the current compressor, and its settings, when it already has the
+  // requested type.
+  vtkSmartPointer<vtkDataCompressor> compressor;
   if (compressorType == NONE)
   {
-    if (this->Compressor)
-    {
-      this->Compressor->Delete();
-      this->Compressor = nullptr;
-      this->Modified();
-    }
+    this->SetCompressor(nullptr);
+    return;
   }
   else if (compressorType == ZLIB)
   {
-    if (this->Compressor && !this->Compressor->IsTypeOf("vtkZLibDataCompressor"))
+    if (vtkZLibDataCompressor::SafeDownCast(this->Compressor))
     {
-      this->Compressor->Delete();
+      return;
     }
-    this->Compressor = vtkZLibDataCompressor::New();
-    this->Compressor->SetCompressionLevel(this->CompressionLevel);
-    this->Modified();
+    compressor = vtkSmartPointer<vtkZLibDataCompressor>::New();
   }
   else if (compressorType == LZ4)
   {
-    if (this->Compressor && !this->Compressor->IsTypeOf("vtkLZ4DataCompressor"))
+    if (vtkLZ4DataCompressor::SafeDownCast(this->Compressor))
     {
-      this->Compressor->Delete();
+      return;
     }
-    this->Compressor = vtkLZ4DataCompressor::New();
-    this->Compressor->SetCompressionLevel(this->CompressionLevel);
-    this->Modified();
+    compressor = vtkSmartPointer<vtkLZ4DataCompressor>::New();
   }
   else if (compressorType == LZMA)
   {
-    if (this->Compressor && !this->Compressor->IsTypeOf("vtkLZMADataCompressor"))
+    if (vtkLZMADataCompressor::SafeDownCast(this->Compressor))
     {
-      this->Compressor->Delete();
+      return;
     }
-    this->Compressor = vtkLZMADataCompressor::New();
-    this->Compressor->SetCompressionLevel(this->CompressionLevel);
-    this->Modified();
+    compressor = vtkSmartPointer<vtkLZMADataCompressor>::New();
+  }
+  else if (compressorType == ZFP)
+  {
+    if (vtkZFPDataCompressor::SafeDownCast(this->Compressor))
+    {
+      return;
+    }
+    compressor = vtkSmartPointer<vtkZFPDataCompressor>::New();
   }
   else
   {
     vtkWarningMacro("Invalid compressorType:" << compressorType);
+    return;
   }
+  compressor->SetCompressionLevel(this->CompressionLevel);
+  this->SetCompressor(compressor);
 }
 //------------------------------------------------------------------------------
 void vtkXMLWriter::SetCompressionLevel(int compressionLevel)
@@ -1295,6 +1303,15 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
 
   if (this->Compressor)
   {
+    // Tell the compressor the type of the values, unless they are byte
+    // swapped when written.
+#ifdef VTK_WORDS_BIGENDIAN
+    const bool nativeOrder = this->ByteOrder == vtkXMLWriter::BigEndian;
+#else
+    const bool nativeOrder = this->ByteOrder == vtkXMLWriter::LittleEndian;
+#endif
+    this->Compressor->SetDataDescription(nativeOrder ? wordType : VTK_VOID, a->GetName());
+
     // Need to compress the data.  Create compression header.  This
     // reserves enough space in the output.
     if (!this->CreateCompressionHeader(dataSize))
@@ -1310,6 +1327,14 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the blocks still pending.
+    if (result && !this->FlushCompressionBlocks())
+    {
+      result = 0;
+    }
+    this->PendingBlocks.clear();
+    this->PendingBlockSizes.clear();
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1672,25 +1697,77 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  // The blocks are compressed independently, so they are queued and a few
+  // per thread are compressed at once.
+  this->PendingBlocks.insert(this->PendingBlocks.end(), data, data + size);
+  this->PendingBlockSizes.push_back(size);
+  const size_t maxPendingBlocks = 4 * std::max(vtkSMPTools::GetEstimatedNumberOfThreads(), 1);
+  if (this->PendingBlockSizes.size() < maxPendingBlocks)
+  {
+    return 1;
+  }
+  return this->FlushCompressionBlocks();
+}
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+//------------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  const size_t numBlocks = this->PendingBlockSizes.size();
+  if (numBlocks == 0)
+  {
+    return 1;
+  }
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
-  this->Stream->flush();
-  if (this->Stream->fail())
+  // Compress the data, concurrently if the compressor is thread safe.
+  std::vector<size_t> offsets(numBlocks, 0);
+  for (size_t i = 1; i < numBlocks; ++i)
   {
-    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    offsets[i] = offsets[i - 1] + this->PendingBlockSizes[i - 1];
+  }
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray>> outputArrays(numBlocks);
+  auto compress = [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      outputArrays[i].TakeReference(this->Compressor->Compress(
+        this->PendingBlocks.data() + offsets[i], this->PendingBlockSizes[i]));
+    }
+  };
+  if (this->Compressor->IsThreadSafe())
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1, compress);
   }
+  else
+  {
+    compress(0, static_cast<vtkIdType>(numBlocks));
+  }
+  this->PendingBlocks.clear();
+  this->PendingBlockSizes.clear();
 
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+  // Write the compressed data in order.
+  int result = 1;
+  for (size_t i = 0; i < numBlocks && result; ++i)
+  {
+    if (!outputArrays[i])
+    {
+      vtkErrorMacro("Error compressing block " << this->CompressionBlockNumber << ".");
+      return 0;
+    }
+
+    // Find the compressed size.
+    size_t outputSize = outputArrays[i]->GetNumberOfTuples();
+    unsigned char* outputPointer = outputArrays[i]->GetPointer(0);
+
+    // Write the compressed data.
+    result = this->DataStream->Write(outputPointer, outputSize);
+    this->Stream->flush();
+    if (this->Stream->fail())
+    {
+      this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    }
 
-  outputArray->Delete();
+    // Store the resulting compressed size in the compression header.
+    this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+  }
 
   return result;
 }
@@ -2332,6 +2409,17 @@ void vtkXMLWriter::WriteArrayAppended(vtkAbstractArray* a, vtkIndent indent, Off
 void vtkXMLWriter::WriteArrayAppendedData(
   vtkAbstractArray* a, vtkTypeInt64 pos, vtkTypeInt64& lastoffset)
 {
+  // Align the raw values in the file so that readers can map them in memory
+  // and use them in place.  The offsets skip the padding bytes.
+  if (!this->EncodeAppendedData && !this->Compressor)
+  {
+    ostream& os = *(this->Stream);
+    vtkTypeInt64 valuesPos = static_cast<vtkTypeInt64>(os.tellp()) + this->HeaderType / 8;
+    for (; valuesPos % 8 != 0; ++valuesPos)
+    {
+      os.put('\0');
+    }
+  }
   this->WriteAppendedDataOffset(pos, lastoffset, "offset");
   this->WriteBinaryData(a);
 }
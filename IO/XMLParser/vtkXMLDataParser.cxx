@@ -21,12 +21,14 @@
 #include "vtkEndian.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
 #undef vtkXMLDataHeaderPrivate_DoNotInclude
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
 #include <memory>
@@ -53,6 +55,11 @@ vtkXMLDataParser::vtkXMLDataParser()
 
   this->BlockCompressedSizes = nullptr;
   this->BlockStartOffsets = nullptr;
+  this->BlockHeaderPosition = -1;
+  this->BlockDataPosition = -1;
+  this->CachedBlock = -1;
+  this->CachedBlockData = nullptr;
+  this->CachedBlockDataSize = 0;
   this->Compressor = nullptr;
 
   this->AsciiDataBuffer = nullptr;
@@ -87,6 +94,7 @@ vtkXMLDataParser::~vtkXMLDataParser()
   this->AppendedDataStream->Delete();
   delete[] this->BlockCompressedSizes;
   delete[] this->BlockStartOffsets;
+  delete[] this->CachedBlockData;
   this->SetCompressor(nullptr);
   if (this->AsciiDataBuffer)
   {
@@ -134,6 +142,14 @@ int vtkXMLDataParser::Parse()
   return result;
 }
 
+//------------------------------------------------------------------------------
+void vtkXMLDataParser::SetStream(istream* stream)
+{
+  this->Superclass::SetStream(stream);
+  this->BlockHeaderPosition = -1;
+  this->CachedBlock = -1;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLDataParser::Parse(const char*)
 {
@@ -627,6 +643,29 @@ int vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block, unsigned char* buffer)
   return result > 0;
 }
 
+//------------------------------------------------------------------------------
+const unsigned char* vtkXMLDataParser::ReadCachedBlock(vtkTypeUInt64 block)
+{
+  if (this->CachedBlock == static_cast<vtkTypeInt64>(block))
+  {
+    return this->CachedBlockData;
+  }
+
+  if (this->CachedBlockDataSize < this->BlockUncompressedSize)
+  {
+    delete[] this->CachedBlockData;
+    this->CachedBlockData = new unsigned char[this->BlockUncompressedSize];
+    this->CachedBlockDataSize = this->BlockUncompressedSize;
+  }
+  if (!this->ReadBlock(block, this->CachedBlockData))
+  {
+    this->CachedBlock = -1;
+    return nullptr;
+  }
+  this->CachedBlock = static_cast<vtkTypeInt64>(block);
+  return this->CachedBlockData;
+}
+
 //------------------------------------------------------------------------------
 unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
 {
@@ -639,6 +678,57 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLDataParser::ReadCompleteBlocks(
+  vtkTypeUInt64 firstBlock, size_t numBlocks, unsigned char* buffer, size_t wordSize)
+{
+  // The blocks are contiguous in the stream: read them at once.
+  const vtkTypeUInt64 lastBlock = firstBlock + numBlocks - 1;
+  const vtkTypeInt64 startOffset = this->BlockStartOffsets[firstBlock];
+  const size_t compressedSize = static_cast<size_t>(
+    this->BlockStartOffsets[lastBlock] + this->BlockCompressedSizes[lastBlock] - startOffset);
+  if (!this->DataStream->Seek(startOffset))
+  {
+    return 0;
+  }
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if (this->DataStream->Read(readBuffer.data(), compressedSize) < compressedSize)
+  {
+    return 0;
+  }
+
+  // Decompress and byte swap them, concurrently if the compressor is thread
+  // safe.  Note that the block size will always be an integer multiple of
+  // the word size.
+  const size_t blockSize = this->BlockUncompressedSize;
+  std::atomic<bool> success(true);
+  auto uncompress = [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkTypeUInt64 block = firstBlock + i;
+      unsigned char* outputPointer = buffer + i * blockSize;
+      const unsigned char* compressedData =
+        readBuffer.data() + (this->BlockStartOffsets[block] - startOffset);
+      if (!this->Compressor->Uncompress(
+            compressedData, this->BlockCompressedSizes[block], outputPointer, blockSize))
+      {
+        success = false;
+        return;
+      }
+      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
+    }
+  };
+  if (this->Compressor->IsThreadSafe())
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1, uncompress);
+  }
+  else
+  {
+    uncompress(0, static_cast<vtkIdType>(numBlocks));
+  }
+  return success ? 1 : 0;
+}
+
 //------------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(
   unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize)
@@ -771,14 +861,13 @@ size_t vtkXMLDataParser::ReadCompressedData(
   if (firstBlock == lastBlock)
   {
     // Everything fits in one block.
-    unsigned char* blockBuffer = this->ReadBlock(firstBlock);
+    const unsigned char* blockBuffer = this->ReadCachedBlock(firstBlock);
     if (!blockBuffer)
     {
       return 0;
     }
     size_t n = endBlockOffset - beginBlockOffset;
     memcpy(data, blockBuffer + beginBlockOffset, n);
-    delete[] blockBuffer;
 
     // Byte swap this block.  Note that n will always be an integer
     // multiple of the word size.
@@ -792,14 +881,13 @@ size_t vtkXMLDataParser::ReadCompressedData(
     size_t blockSize = this->FindBlockSize(firstBlock);
 
     // Read the first block.
-    unsigned char* blockBuffer = this->ReadBlock(firstBlock);
+    const unsigned char* blockBuffer = this->ReadCachedBlock(firstBlock);
     if (!blockBuffer)
     {
       return 0;
     }
     size_t n = blockSize - beginBlockOffset;
     memcpy(outputPointer, blockBuffer + beginBlockOffset, n);
-    delete[] blockBuffer;
 
     // Byte swap the first block.  Note that n will always be an
     // integer multiple of the word size.
@@ -811,21 +899,24 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Report progress.
     this->UpdateProgress(float(outputPointer - data) / length);
 
-    unsigned int currentBlock = firstBlock + 1;
-    for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks in batches of a few per thread, which are
+    // decompressed concurrently.
+    const vtkTypeUInt64 maxBatchBlocks =
+      4 * std::max(vtkSMPTools::GetEstimatedNumberOfThreads(), 1);
+    vtkTypeUInt64 currentBlock = firstBlock + 1;
+    while (currentBlock < lastBlock && !this->Abort)
     {
-      // Read this block.
-      if (!this->ReadBlock(currentBlock, outputPointer))
+      // Read these blocks.
+      const vtkTypeUInt64 numBlocks = std::min(maxBatchBlocks, lastBlock - currentBlock);
+      if (!this->ReadCompleteBlocks(
+            currentBlock, static_cast<size_t>(numBlocks), outputPointer, wordSize))
       {
         return 0;
       }
 
-      // Byte swap this block.  Note that blockSize will always be an
-      // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
-
       // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      outputPointer += numBlocks * this->BlockUncompressedSize;
+      currentBlock += numBlocks;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer - data) / length);
@@ -834,13 +925,12 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Now read the final block, which is incomplete if it exists.
     if (endBlockOffset > 0 && !this->Abort)
     {
-      blockBuffer = this->ReadBlock(lastBlock);
+      blockBuffer = this->ReadCachedBlock(lastBlock);
       if (!blockBuffer)
       {
         return 0;
       }
       memcpy(outputPointer, blockBuffer, endBlockOffset);
-      delete[] blockBuffer;
 
       // Byte swap the partial block.  Note that endBlockOffset will
       // always be an integer multiple of the word size.
@@ -880,10 +970,23 @@ size_t vtkXMLDataParser::ReadBinaryData(
   size_t actualWords;
   if (this->Compressor)
   {
-    if (!this->ReadCompressionHeader())
+    // Read the header, unless it is the one read last.
+    const vtkTypeInt64 headerPosition = this->TellG();
+    if (headerPosition < 0 || headerPosition != this->BlockHeaderPosition)
     {
-      vtkErrorMacro("ReadCompressionHeader failed. Aborting read.");
-      return 0;
+      this->BlockHeaderPosition = -1;
+      this->CachedBlock = -1;
+      if (!this->ReadCompressionHeader())
+      {
+        vtkErrorMacro("ReadCompressionHeader failed. Aborting read.");
+        return 0;
+      }
+      this->BlockHeaderPosition = headerPosition;
+      this->BlockDataPosition = this->TellG();
+    }
+    else
+    {
+      this->SeekG(this->BlockDataPosition);
     }
     this->DataStream->StartReading();
     actualWords = this->ReadCompressedData(d, startWord, numWords, wordSize);
@@ -973,6 +1076,37 @@ size_t vtkXMLDataParser::ReadAppendedData(
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//------------------------------------------------------------------------------
+vtkTypeInt64 vtkXMLDataParser::GetRawAppendedDataPosition(
+  vtkTypeInt64 offset, size_t numWords, int wordType)
+{
+#ifdef VTK_WORDS_BIGENDIAN
+  const int nativeOrder = vtkXMLDataParser::BigEndian;
+#else
+  const int nativeOrder = vtkXMLDataParser::LittleEndian;
+#endif
+  if (!this->AppendedDataPosition || this->Compressor || this->ByteOrder != nativeOrder ||
+    this->AppendedDataStream->IsA("vtkBase64InputStream"))
+  {
+    return -1;
+  }
+
+  // Read the length of the data.
+  std::unique_ptr<vtkXMLDataHeader> uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  this->DataStream = this->AppendedDataStream;
+  this->SeekG(this->AppendedDataPosition + offset);
+  this->DataStream->SetStream(this->Stream);
+  this->DataStream->StartReading();
+  size_t r = this->DataStream->Read(uh->Data(), headerSize);
+  this->DataStream->EndReading();
+  if (r < headerSize || uh->Get(0) != numWords * this->GetWordTypeSize(wordType))
+  {
+    return -1;
+  }
+  return this->AppendedDataPosition + offset + static_cast<vtkTypeInt64>(headerSize);
+}
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
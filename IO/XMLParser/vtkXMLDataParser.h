@@ -81,6 +81,14 @@ public:
     return this->ReadAppendedData(offset, buffer, startWord, numWords, VTK_CHAR);
   }
 
+  /**
+   * Return the position in the input stream of the values of the appended
+   * data at the given offset if they can be used as they are in the input:
+   * raw, not compressed, in the native byte order, and exactly @a numWords
+   * words of the given type.  Otherwise, return -1.
+   */
+  vtkTypeInt64 GetRawAppendedDataPosition(vtkTypeInt64 offset, size_t numWords, int wordType);
+
   /**
    * Read from an ascii data section starting at the current position in
    * the stream.  Returns the number of words read.
@@ -107,6 +115,13 @@ public:
    */
   size_t GetWordTypeSize(int wordType);
 
+  /**
+   * Set the stream from which the XML and the data are read.  This
+   * discards the compression header and block kept from the previous
+   * stream.
+   */
+  void SetStream(istream* stream) override;
+
   /**
    * Parse the XML input and check that the file is safe to read.
    * Returns 1 for okay, 0 for error.
@@ -186,6 +201,9 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  const unsigned char* ReadCachedBlock(vtkTypeUInt64 block);
+  int ReadCompleteBlocks(
+    vtkTypeUInt64 firstBlock, size_t numBlocks, unsigned char* buffer, size_t wordSize);
   size_t ReadUncompressedData(
     unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize);
   size_t ReadCompressedData(
@@ -240,6 +258,16 @@ protected:
   size_t* BlockCompressedSizes;
   vtkTypeInt64* BlockStartOffsets;
 
+  // The stream positions of the compression header read last and of its
+  // blocks, or -1, and its block decompressed last, or -1.  Reading parts
+  // of the same data repeatedly, e.g. the rows of a sub-extent, then reads
+  // the header once and decompresses each block once.
+  vtkTypeInt64 BlockHeaderPosition;
+  vtkTypeInt64 BlockDataPosition;
+  vtkTypeInt64 CachedBlock;
+  unsigned char* CachedBlockData;
+  size_t CachedBlockDataSize;
+
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;
   size_t AsciiDataBufferLength;
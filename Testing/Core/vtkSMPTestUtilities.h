@@ -0,0 +1,63 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTestUtilities.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @file   vtkSMPTestUtilities.h
+ * @brief  Runs a test with every vtkSMPTools backend.
+ *
+ * vtkTest::ForEachSMPBackend() calls a test once per vtkSMPTools backend
+ * built with VTK, with several threads even on a single core machine:
+ *
+ * \code
+ * vtkTest::ForEachSMPBackend([&](const std::string& backend) {
+ *   filter->Modified();
+ *   filter->Update();
+ *   ...
+ * });
+ * \endcode
+ *
+ * The backend in use is restored when it returns.
+ */
+
+#ifndef vtkSMPTestUtilities_h
+#define vtkSMPTestUtilities_h
+
+#include "vtkSMPTools.h"
+
+#include <string> // Needed for std::string
+
+namespace vtkTest
+{
+/**
+ * Call test(backend) with each backend of vtkSMPTools::GetAvailableBackends(),
+ * initialized with numberOfThreads threads. The backend in use is restored
+ * afterwards, numberOfThreads stays the number of threads requested with
+ * vtkSMPTools::Initialize().
+ */
+template <typename T>
+void ForEachSMPBackend(T&& test, int numberOfThreads = 4)
+{
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ vtkSMPTools::GetBackend() }, [&]() {
+    for (const std::string& backend : vtkSMPTools::GetAvailableBackends())
+    {
+      vtkSMPTools::SetBackend(backend.c_str());
+      vtkSMPTools::Initialize(numberOfThreads);
+      test(backend);
+    }
+  });
+}
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPTestUtilities.h